@@ -100,7 +100,8 @@ static int runQtApplication(int argc, char* argv[], qtwebapp::LoggerWithFile *lo
           // This will run the task from the application event loop
           QTimer::singleShot(0, &m, SLOT(run()));
 
-          return a.exec();
+          int res = a.exec();
+          return res == 0 ? m.getResult() : res;
           }
 
       int main(int argc, char* argv[])
@@ -0,0 +1,319 @@
+/*
+ * asynclogwriter.cpp
+ *
+ *  Created on: Apr 18, 2020
+ *      Author: f4exb
+ */
+
+#include <QDateTime>
+#include <QMutexLocker>
+
+#include "logger.h"
+#include "logmessage.h"
+#include "asynclogwriter.h"
+
+using namespace qtwebapp;
+
+AsyncLogWriter::Ring::Ring(int size) :
+    entries(size),
+    mask(2*size - 1),
+    head(0),
+    tail(0),
+    free(0),
+    next(0),
+    windowStartMs(0),
+    windowCount(0),
+    dropped(0),
+    rateLimited(0),
+    hasLast(false),
+    repeated(0),
+    repeatStartMs(0)
+{}
+
+AsyncLogWriter::AsyncLogWriter(Logger* logger, const int ringSize, const int maxRate, const int pollInterval) :
+    QThread(),
+    logger(logger),
+    ringSize(1),
+    maxRate(maxRate),
+    pollInterval(pollInterval),
+    running(0),
+    posting(0),
+    rings(0),
+    droppedCount(0),
+    rateLimitedCount(0),
+    repeatedCount(0),
+    pendingDropped(0),
+    pendingRateLimited(0),
+    lastReportMs(0)
+{
+    while (this->ringSize < ringSize) {
+        this->ringSize <<= 1;
+    }
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    stopWriter();
+    Ring *ring = rings.loadAcquire();
+
+    while (ring)
+    {
+        Ring *next = ring->next;
+        delete ring;
+        ring = next;
+    }
+}
+
+void AsyncLogWriter::startWriter()
+{
+    if (isWriting()) {
+        return;
+    }
+
+    running.storeRelease(1);
+    start();
+}
+
+void AsyncLogWriter::stopWriter()
+{
+    if (!isWriting()) {
+        return;
+    }
+
+    // Full barrier: a post() either sees the writer stopped or is counted in posting
+    running.fetchAndStoreOrdered(0);
+    wait();
+
+    // Messages queued by posts that were in progress are written by the last drain
+    while (posting.loadAcquire() != 0) {
+        QThread::yieldCurrentThread();
+    }
+
+    drain();
+}
+
+bool AsyncLogWriter::post(const QtMsgType type, const QString& message, const char *file, const char *function, const int line, const QHash<QString,QString>* logVars)
+{
+    if (QThread::currentThread() == this) {
+        return false;
+    }
+
+    // Full barrier: pairs with the one of stopWriter()
+    posting.fetchAndAddOrdered(1);
+
+    if (!isWriting())
+    {
+        posting.fetchAndAddRelease(-1);
+        return false;
+    }
+
+    bool queued = enqueue(type, message, file, function, line, logVars);
+    posting.fetchAndAddRelease(-1);
+    return queued;
+}
+
+bool AsyncLogWriter::enqueue(const QtMsgType type, const QString& message, const char *file, const char *function, const int line, const QHash<QString,QString>* logVars)
+{
+    Ring *ring = getThreadRing();
+    qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    bool limited = (type == QtDebugMsg) || (type == QtInfoMsg);
+
+    if (limited && (maxRate > 0))
+    {
+        if (nowMs - ring->windowStartMs >= 1000)
+        {
+            ring->windowStartMs = nowMs;
+            ring->windowCount = 0;
+        }
+
+        if (++ring->windowCount > maxRate)
+        {
+            ring->rateLimited.fetchAndAddRelaxed(1);
+            return true;
+        }
+    }
+
+    int head = ring->head.load();
+
+    if (((head - ring->tail.loadAcquire()) & ring->mask) == ringSize)
+    {
+        if (!limited) {
+            return false; // never drop warnings
+        }
+
+        ring->dropped.fetchAndAddRelaxed(1);
+        return true;
+    }
+
+    Entry& entry = ring->entries[head & (ringSize - 1)];
+    entry.type = type;
+    entry.message = message;
+    entry.file = file;
+    entry.function = function;
+    entry.line = line;
+    entry.timestampMs = nowMs;
+    entry.threadId = QThread::currentThreadId();
+
+    if (logVars) {
+        entry.logVars = *logVars;
+    }
+
+    ring->head.storeRelease((head + 1) & ring->mask);
+    return true;
+}
+
+void AsyncLogWriter::flush()
+{
+    if (QThread::currentThread() != this) {
+        drain();
+    }
+}
+
+void AsyncLogWriter::run()
+{
+    while (isWriting())
+    {
+        drain();
+        msleep(pollInterval);
+    }
+}
+
+AsyncLogWriter::Ring *AsyncLogWriter::getThreadRing()
+{
+    if (threadRing.hasLocalData()) {
+        return threadRing.localData()->ring;
+    }
+
+    Ring *ring = 0;
+
+    // reuse the ring of a finished thread
+    for (Ring *r = rings.loadAcquire(); r; r = r->next)
+    {
+        if (r->free.testAndSetAcquire(1, 0))
+        {
+            ring = r;
+            break;
+        }
+    }
+
+    if (ring)
+    {
+        ring->windowStartMs = 0;
+        ring->windowCount = 0;
+    }
+    else
+    {
+        ring = new Ring(ringSize);
+        Ring *first;
+
+        do {
+            first = rings.loadAcquire();
+            ring->next = first;
+        } while (!rings.testAndSetRelease(first, ring));
+    }
+
+    threadRing.setLocalData(new RingHolder(ring));
+    return ring;
+}
+
+void AsyncLogWriter::drain()
+{
+    QMutexLocker locker(&drainMutex);
+    qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+
+    for (Ring *ring = rings.loadAcquire(); ring; ring = ring->next) {
+        drainRing(ring, nowMs);
+    }
+
+    reportDropped(nowMs);
+}
+
+void AsyncLogWriter::drainRing(Ring *ring, qint64 nowMs)
+{
+    int dropped = ring->dropped.fetchAndStoreRelaxed(0);
+    int rateLimited = ring->rateLimited.fetchAndStoreRelaxed(0);
+    droppedCount.fetchAndAddRelaxed(dropped);
+    rateLimitedCount.fetchAndAddRelaxed(rateLimited);
+    pendingDropped += dropped;
+    pendingRateLimited += rateLimited;
+
+    int tail = ring->tail.load();
+    int head = ring->head.loadAcquire();
+
+    while (tail != head)
+    {
+        Entry& entry = ring->entries[tail & (ringSize - 1)];
+        Entry& last = ring->last;
+
+        if (ring->hasLast && (entry.type == last.type) && (entry.threadId == last.threadId)
+            && (entry.line == last.line) && (entry.message == last.message))
+        {
+            if (ring->repeated == 0) {
+                ring->repeatStartMs = nowMs;
+            }
+
+            ring->repeated++;
+            last.timestampMs = entry.timestampMs;
+            repeatedCount.fetchAndAddRelaxed(1);
+        }
+        else
+        {
+            if (ring->repeated > 0) {
+                writeRepeated(ring);
+            }
+
+            write(entry);
+            last = entry;
+            ring->hasLast = true;
+        }
+
+        // release the message memory here rather than in the producer
+        entry.message.clear();
+        entry.logVars.clear();
+        tail = (tail + 1) & ring->mask;
+    }
+
+    ring->tail.storeRelease(tail);
+
+    if ((ring->repeated > 0) && (nowMs - ring->repeatStartMs >= 1000)) {
+        writeRepeated(ring);
+    }
+}
+
+void AsyncLogWriter::write(const Entry& entry)
+{
+    QDateTime timestamp = QDateTime::fromMSecsSinceEpoch(entry.timestampMs);
+    LogMessage::setOrigin(&timestamp, entry.threadId, &entry.logVars);
+    logger->log(entry.type, entry.message, entry.file, entry.function, entry.line);
+    LogMessage::setOrigin(0, 0, 0);
+}
+
+void AsyncLogWriter::writeRepeated(Ring *ring)
+{
+    Entry entry = ring->last;
+    entry.message = QString("last message repeated %1 times").arg(ring->repeated);
+    write(entry);
+    ring->repeated = 0;
+}
+
+void AsyncLogWriter::reportDropped(qint64 nowMs)
+{
+    if (((pendingDropped == 0) && (pendingRateLimited == 0)) || (nowMs - lastReportMs < 1000)) {
+        return;
+    }
+
+    Entry entry;
+    entry.type = QtWarningMsg;
+    entry.message = QString("AsyncLogWriter: dropped %1 messages (queue full) %2 messages (rate limit)")
+        .arg(pendingDropped).arg(pendingRateLimited);
+    entry.file = 0;
+    entry.function = 0;
+    entry.line = 0;
+    entry.timestampMs = nowMs;
+    entry.threadId = QThread::currentThreadId();
+    write(entry);
+
+    pendingDropped = 0;
+    pendingRateLimited = 0;
+    lastReportMs = nowMs;
+}
@@ -0,0 +1,205 @@
+/*
+ * asynclogwriter.h
+ *
+ *  Created on: Apr 18, 2020
+ *      Author: f4exb
+ */
+
+#ifndef LOGGING_ASYNCLOGWRITER_H_
+#define LOGGING_ASYNCLOGWRITER_H_
+
+#include <vector>
+
+#include <QtGlobal>
+#include <QThread>
+#include <QThreadStorage>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QAtomicInteger>
+#include <QMutex>
+#include <QHash>
+#include <QString>
+
+#include "export.h"
+
+namespace qtwebapp {
+
+class Logger;
+
+/**
+  Background writer of the asynchronous logging mode of a Logger.
+  <p>
+  Each producing thread gets its own single producer single consumer ring of messages
+  so that posting a message takes no lock and does no I/O. The rings are drained by
+  this thread that forwards the messages to the logger synchronously. The messages keep
+  the timestamp, thread and logger variables of the thread that produced them.
+  <p>
+  Under pressure debug and info messages are dropped rather than blocking the producer:
+  <ul>
+  <li>when the ring of the producing thread is full,</li>
+  <li>when the producing thread exceeds its rate of messages per second.</li>
+  </ul>
+  Warnings are not rate limited and are logged synchronously by the caller when the ring is full
+  so that they are never dropped.
+  Consecutive identical messages of a thread are written once followed by a
+  "last message repeated N times" line. Counts of dropped messages are reported in
+  the log once per second and are available from the getters.
+  <p>
+  Messages of different threads may be written slightly out of order but each keeps its
+  own timestamp. The rings of threads that have finished are reused by new threads.
+*/
+
+class LOGGING_API AsyncLogWriter : public QThread {
+    Q_OBJECT
+    Q_DISABLE_COPY(AsyncLogWriter)
+public:
+
+    /**
+      Constructor.
+      @param logger Logger the messages are forwarded to from the writer thread
+      @param ringSize Number of messages each producing thread can queue (rounded up to a power of 2)
+      @param maxRate Maximum number of debug and info messages per second of each producing thread, 0=unlimited
+      @param pollInterval Interval of the writer thread in msec
+    */
+    AsyncLogWriter(Logger* logger, const int ringSize=1024, const int maxRate=1000, const int pollInterval=10);
+
+    /** Destructor. Stops the writer thread after draining the remaining messages. */
+    virtual ~AsyncLogWriter();
+
+    /** Start the writer thread */
+    void startWriter();
+
+    /** Drain the remaining messages and stop the writer thread */
+    void stopWriter();
+
+    /** Whether messages are posted asynchronously */
+    bool isWriting() const { return running.loadAcquire() != 0; }
+
+    /**
+      Post a message from the calling thread. Does not block.
+      @param type Message type (level)
+      @param message Message text
+      @param file Source file where the message was generated, must be a static string
+      @param function Function where the message was generated, must be a static string
+      @param line Line Number of the source file, where the message was generated
+      @param logVars Logger variables of the calling thread, 0 is allowed
+      @return false if the message must be logged synchronously by the caller i.e. when the
+        writer is not running or stopping, when called from the writer thread or when a warning
+        does not fit in the ring. true when queued or dropped.
+    */
+    bool post(const QtMsgType type, const QString& message, const char *file, const char *function, const int line, const QHash<QString,QString>* logVars);
+
+    /**
+      Write out all queued messages now. Used to keep the order of the messages logged
+      synchronously (critical and fatal messages). Does nothing in the writer thread.
+    */
+    void flush();
+
+    /** Number of messages dropped because the ring of the producing thread was full */
+    quint64 getDroppedCount() const { return droppedCount.load(); }
+
+    /** Number of messages dropped because the producing thread exceeded its rate */
+    quint64 getRateLimitedCount() const { return rateLimitedCount.load(); }
+
+    /** Number of consecutive identical messages that were not written out */
+    quint64 getRepeatedCount() const { return repeatedCount.load(); }
+
+protected:
+    virtual void run();
+
+private:
+
+    /** Queued message */
+    struct Entry
+    {
+        QtMsgType type;
+        QString message;
+        const char *file;
+        const char *function;
+        int line;
+        qint64 timestampMs;
+        Qt::HANDLE threadId;
+        QHash<QString,QString> logVars;
+    };
+
+    /** Ring of a producing thread */
+    struct Ring
+    {
+        std::vector<Entry> entries;
+        int mask;        //!< indexes run over twice the size to tell full from empty
+        QAtomicInt head; //!< written by the producer only
+        QAtomicInt tail; //!< written by the writer only
+        QAtomicInt free; //!< 1 when the producing thread has finished
+        Ring *next;      //!< immutable once published
+        // producer side rate window
+        qint64 windowStartMs;
+        int windowCount;
+        QAtomicInt dropped;
+        QAtomicInt rateLimited;
+        // writer side repeated messages detection
+        Entry last;
+        bool hasLast;
+        int repeated;
+        qint64 repeatStartMs;
+
+        Ring(int size);
+    };
+
+    /** Releases the ring of a thread when the thread finishes */
+    struct RingHolder
+    {
+        Ring *ring;
+        RingHolder(Ring *ring) : ring(ring) {}
+        ~RingHolder() { ring->free.storeRelease(1); }
+    };
+
+    /** Logger messages are forwarded to */
+    Logger* logger;
+
+    /** Number of messages per ring */
+    int ringSize;
+
+    /** Maximum debug and info messages per second and thread */
+    int maxRate;
+
+    /** Writer thread interval in msec */
+    int pollInterval;
+
+    /** Writer thread running indicator */
+    QAtomicInt running;
+
+    /** Number of post() calls in progress, stopWriter() waits for them before the last drain */
+    QAtomicInt posting;
+
+    /** Lock free list of all rings */
+    QAtomicPointer<Ring> rings;
+
+    /** Ring of the current thread */
+    QThreadStorage<RingHolder*> threadRing;
+
+    /** Serializes draining between the writer thread and flush() */
+    QMutex drainMutex;
+
+    QAtomicInteger<quint64> droppedCount;
+    QAtomicInteger<quint64> rateLimitedCount;
+    QAtomicInteger<quint64> repeatedCount;
+
+    /** Dropped messages not reported yet */
+    quint64 pendingDropped;
+    quint64 pendingRateLimited;
+
+    /** Last time dropped messages were reported */
+    qint64 lastReportMs;
+
+    Ring *getThreadRing();
+    bool enqueue(const QtMsgType type, const QString& message, const char *file, const char *function, const int line, const QHash<QString,QString>* logVars);
+    void drain();
+    void drainRing(Ring *ring, qint64 nowMs);
+    void write(const Entry& entry);
+    void writeRepeated(Ring *ring);
+    void reportDropped(qint64 nowMs);
+};
+
+} // end of namespace
+
+#endif /* LOGGING_ASYNCLOGWRITER_H_ */
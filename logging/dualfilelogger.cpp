@@ -14,12 +14,22 @@ DualFileLogger::DualFileLogger(QSettings* firstSettings, QSettings* secondSettin
      secondLogger=new FileLogger(secondSettings, refreshInterval, this);
 }
 
+DualFileLogger::~DualFileLogger()
+{
+    setAsynchronous(false);
+}
+
 void DualFileLogger::log(const QtMsgType type, const QString& message, const QString &file, const QString &function, const int line)
 {
     firstLogger->log(type,message,file,function,line);
     secondLogger->log(type,message,file,function,line);
 }
 
+bool DualFileLogger::isLoggable(const QtMsgType type) const
+{
+    return firstLogger->isLoggable(type) || secondLogger->isLoggable(type);
+}
+
 void DualFileLogger::clear(const bool buffer, const bool variables)
 {
     firstLogger->clear(buffer,variables);
@@ -41,6 +41,11 @@ public:
     */
     DualFileLogger(QSettings* firstSettings, QSettings* secondSettings, const int refreshInterval=10000, QObject *parent = 0);
 
+    /**
+      Destructor.
+    */
+    virtual ~DualFileLogger();
+
     /**
       Decorate and log the message, if type>=minLevel.
       This method is thread safe.
@@ -53,6 +58,12 @@ public:
     */
     virtual void log(const QtMsgType type, const QString& message, const QString &file="", const QString &function="", const int line=0);
 
+    /**
+      Whether a message of this type may produce an output in any of the loggers.
+      @param type Message type (level)
+    */
+    virtual bool isLoggable(const QtMsgType type) const;
+
     /**
       Clear the thread-local data of the current thread.
       This method is thread safe.
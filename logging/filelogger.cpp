@@ -131,6 +131,7 @@ FileLogger::FileLogger(const FileLoggerSettings& settings, const int refreshInte
 
 FileLogger::~FileLogger()
 {
+    setAsynchronous(false);
     close();
 }
 
@@ -4,6 +4,7 @@
 */
 
 #include "logger.h"
+#include "asynclogwriter.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <QMutex>
@@ -27,12 +28,14 @@ Logger::Logger(QObject* parent)
     msgFormat("{timestamp} {type} {msg}"),
     timestampFormat("yyyy-MM-dd HH:mm:ss.zzz"),
     minLevel(QtDebugMsg),
-    bufferSize(0)
+    bufferSize(0),
+    asyncLogWriter(0)
     {}
 
 
 Logger::Logger(const QString msgFormat, const QString timestampFormat, const QtMsgType minLevel, const int bufferSize, QObject* parent)
-    :QObject(parent)
+    :QObject(parent),
+    asyncLogWriter(0)
 {
     this->msgFormat=msgFormat;
     this->timestampFormat=timestampFormat;
@@ -76,7 +79,25 @@ void Logger::msgHandler(const QtMsgType type, const QString &message, const QStr
 #if QT_VERSION >= 0x050000
     void Logger::msgHandler5(const QtMsgType type, const QMessageLogContext &context, const QString &message)
     {
-      (void)(context); // suppress "unused parameter" warning
+      // Skip the messages that no output would take before doing any work
+      if (defaultLogger && (type!=QtFatalMsg) && !defaultLogger->isLoggable(type)) {
+          return;
+      }
+
+      AsyncLogWriter* asyncLogWriter=defaultLogger ? defaultLogger->asyncLogWriter : 0;
+
+      if (asyncLogWriter)
+      {
+          // Queue without locking, critical and fatal messages are written synchronously
+          if ((type!=QtCriticalMsg) && (type!=QtFatalMsg)
+              && asyncLogWriter->post(type,message,context.file,context.function,context.line,logVars.localData()))
+          {
+              return;
+          }
+          // Write out the queued messages first to keep the order
+          asyncLogWriter->flush();
+      }
+
       msgHandler(type,message,context.file,context.function,context.line);
     }
 #else
@@ -89,6 +110,8 @@ void Logger::msgHandler(const QtMsgType type, const QString &message, const QStr
 
 Logger::~Logger()
 {
+    delete asyncLogWriter;
+
     if (defaultLogger==this)
     {
 #if QT_VERSION >= 0x050000
@@ -119,6 +142,28 @@ void Logger::installMsgHandler()
 }
 
 
+void Logger::setAsynchronous(bool asynchronous)
+{
+    if (asynchronous)
+    {
+        if (!asyncLogWriter) {
+            asyncLogWriter=new AsyncLogWriter(this);
+        }
+        asyncLogWriter->startWriter();
+    }
+    else if (asyncLogWriter)
+    {
+        asyncLogWriter->stopWriter();
+    }
+}
+
+
+bool Logger::getAsynchronous() const
+{
+    return asyncLogWriter && asyncLogWriter->isWriting();
+}
+
+
 void Logger::set(const QString& name, const QString& value)
 {
     mutex.lock();
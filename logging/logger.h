@@ -19,6 +19,8 @@
 
 namespace qtwebapp {
 
+class AsyncLogWriter;
+
 /**
   Decorates and writes log messages to the console, stderr.
   <p>
@@ -40,6 +42,10 @@ namespace qtwebapp {
   <p>
   Each thread has it's own buffer.
   <p>
+  In asynchronous mode the messages of the global static logging functions are
+  queued without locking and written out by a background thread. Critical and
+  fatal messages are still written out synchronously.
+  <p>
   The logger can be registered to handle messages from
   the static global functions qDebug(), qWarning(), qCritical() and qFatal().
 
@@ -88,12 +94,42 @@ public:
     */
     virtual void log(const QtMsgType type, const QString& message, const QString &file="", const QString &function="", const int line=0);
 
+    /**
+      Whether a message of this type may produce an output. Messages below the minimum level
+      are still needed when the backtrace buffer is enabled.
+      @param type Message type (level)
+    */
+    virtual bool isLoggable(const QtMsgType type) const {
+        return (bufferSize>0) || (type>=minLevel);
+    }
+
     /**
       Installs this logger as the default message handler, so it
       can be used through the global static logging functions (e.g. qDebug()).
     */
     void installMsgHandler();
 
+    /**
+      Enable or disable the asynchronous mode of the messages handled by the
+      default logger (see installMsgHandler()). Derived loggers must disable it
+      in their destructor before their output media are destroyed.
+      @param asynchronous True to enable
+      @see AsyncLogWriter
+    */
+    void setAsynchronous(bool asynchronous);
+
+    /**
+      Whether the asynchronous mode is enabled
+    */
+    bool getAsynchronous() const;
+
+    /**
+      Get the asynchronous writer for its statistics, 0 if the asynchronous mode was never enabled
+    */
+    const AsyncLogWriter* getAsyncLogWriter() const {
+        return asyncLogWriter;
+    }
+
     /**
      * Sets the minimum message level on the fly
      */
@@ -197,6 +233,9 @@ private:
     /** Thread local backtrace buffers */
     QThreadStorage<QList<LogMessage*>*> buffers;
 
+    /** Background writer of the asynchronous mode, 0 if never enabled */
+    AsyncLogWriter* asyncLogWriter;
+
 };
 
 } // end of namespace
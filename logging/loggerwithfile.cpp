@@ -17,6 +17,7 @@ LoggerWithFile::LoggerWithFile(QObject* parent)
 
 LoggerWithFile::~LoggerWithFile()
 {
+    setAsynchronous(false);
     destroyFileLogger();
     delete consoleLogger;
 }
@@ -48,6 +49,11 @@ void LoggerWithFile::log(const QtMsgType type, const QString& message, const QSt
     }
 }
 
+bool LoggerWithFile::isLoggable(const QtMsgType type) const
+{
+    return consoleLogger->isLoggable(type) || (fileLogger && useFileFlogger && fileLogger->isLoggable(type));
+}
+
 void LoggerWithFile::logToFile(const QtMsgType type, const QString& message, const QString &file, const QString &function, const int line)
 {
     if (fileLogger && useFileFlogger) {
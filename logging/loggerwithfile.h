@@ -45,6 +45,12 @@ public:
     */
     virtual void log(const QtMsgType type, const QString& message, const QString &file="", const QString &function="", const int line=0);
 
+    /**
+      Whether a message of this type may produce an output in any of the loggers.
+      @param type Message type (level)
+    */
+    virtual bool isLoggable(const QtMsgType type) const;
+
     /**
       Clear the thread-local data of the current thread.
       This method is thread safe.
@@ -8,6 +8,19 @@
 
 using namespace qtwebapp;
 
+namespace {
+
+struct Origin
+{
+    const QDateTime* timestamp;
+    Qt::HANDLE threadId;
+    const QHash<QString,QString>* logVars;
+};
+
+thread_local Origin origin = {0, 0, 0};
+
+}
+
 LogMessage::LogMessage(const QtMsgType type, const QString& message, QHash<QString, QString>* logVars, const QString &file, const QString &function, const int line)
 {
     this->type=type;
@@ -15,17 +28,35 @@ LogMessage::LogMessage(const QtMsgType type, const QString& message, QHash<QStri
     this->file=file;
     this->function=function;
     this->line=line;
-    timestamp=QDateTime::currentDateTime();
-    threadId=QThread::currentThreadId();
+    const QHash<QString, QString>* vars=logVars;
+
+    if (origin.timestamp)
+    {
+        timestamp=*origin.timestamp;
+        threadId=origin.threadId;
+        vars=origin.logVars;
+    }
+    else
+    {
+        timestamp=QDateTime::currentDateTime();
+        threadId=QThread::currentThreadId();
+    }
 
     // Copy the logVars if not null,
     // so that later changes in the original do not affect the copy
-    if (logVars)
+    if (vars)
     {
-        this->logVars=*logVars;
+        this->logVars=*vars;
     }
 }
 
+void LogMessage::setOrigin(const QDateTime* timestamp, Qt::HANDLE threadId, const QHash<QString,QString>* logVars)
+{
+    origin.timestamp=timestamp;
+    origin.threadId=threadId;
+    origin.logVars=logVars;
+}
+
 QString LogMessage::toString(const QString& msgFormat, const QString& timestampFormat) const
 {
     QString decorated=msgFormat+"\n";
@@ -67,9 +98,9 @@ QString LogMessage::toString(const QString& msgFormat, const QString& timestampF
     decorated.replace("{function}",function);
     decorated.replace("{line}",QString::number(line));
 
-    QString threadId;
-    threadId.setNum((std::size_t)QThread::currentThreadId());
-    decorated.replace("{thread}",threadId);
+    QString threadIdStr;
+    threadIdStr.setNum((std::size_t)threadId);
+    decorated.replace("{thread}",threadIdStr);
 
     // Fill in variables
     if (decorated.contains("{") && !logVars.isEmpty())
@@ -66,6 +66,17 @@ public:
     */
     QtMsgType getType() const;
 
+    /**
+      Set the origin of the messages created afterwards by the current thread.
+      Used by the asynchronous writer so that its messages keep the timestamp, thread and
+      logger variables of the thread that produced them.
+      @param timestamp Date and time of creation, 0 to reset
+      @param threadId ID number of the producing thread
+      @param logVars Logger variables of the producing thread, 0 is allowed
+      @see AsyncLogWriter
+    */
+    static void setOrigin(const QDateTime* timestamp, Qt::HANDLE threadId, const QHash<QString,QString>* logVars);
+
 private:
 
     /** Logger variables */
@@ -16,9 +16,12 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QTime>
+#include <QFile>
 #include <QDebug>
 #include <QThread>
 
+#include <algorithm>
+
 #include <stdio.h>
 
 #include "device/deviceapi.h"
@@ -42,6 +45,7 @@ ChannelAnalyzer::ChannelAnalyzer(DeviceAPI *deviceAPI) :
 
     m_basebandSink = new ChannelAnalyzerBaseband();
     m_basebandSink->moveToThread(&m_thread);
+    m_basebandSink->setSampleSink(&m_scopeVis); // the GUI replaces it with its spectrum and scope combo
 
 	applySettings(m_settings, true);
 
@@ -81,6 +85,7 @@ void ChannelAnalyzer::start()
     ChannelAnalyzerBaseband::MsgConfigureChannelAnalyzerBaseband *msg =
         ChannelAnalyzerBaseband::MsgConfigureChannelAnalyzerBaseband::create(m_settings, true);
     m_basebandSink->getInputMessageQueue()->push(msg);
+    sendCorrelator(); // reset() dropped any correlator queued while stopped
 }
 
 void ChannelAnalyzer::stop()
@@ -116,6 +121,8 @@ bool ChannelAnalyzer::handleMessage(const Message& cmd)
             getMessageQueueToGUI()->push(notifToGUI);
         }
 
+        setScopeLiveRate();
+
         return true;
     }
 	else
@@ -138,11 +145,66 @@ void ChannelAnalyzer::applySettings(const ChannelAnalyzerSettings& settings, boo
             << " m_pll: " << settings.m_pll
             << " m_fll: " << settings.m_fll
             << " m_pllPskOrder: " << settings.m_pllPskOrder
-            << " m_inputType: " << (int) settings.m_inputType;
+            << " m_inputType: " << (int) settings.m_inputType
+            << " m_corrReferenceFileName: " << settings.m_corrReferenceFileName;
 
     ChannelAnalyzerBaseband::MsgConfigureChannelAnalyzerBaseband *msg
         = ChannelAnalyzerBaseband::MsgConfigureChannelAnalyzerBaseband::create(settings, force);
     m_basebandSink->getInputMessageQueue()->push(msg);
 
+    if ((settings.m_corrReferenceFileName != m_settings.m_corrReferenceFileName) || force)
+    {
+        loadCorrReference(settings.m_corrReferenceFileName);
+        sendCorrelator();
+    }
+
     m_settings = settings;
+    setScopeLiveRate();
+}
+
+void ChannelAnalyzer::loadCorrReference(const QString& fileName)
+{
+    m_corrReference.clear();
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QFile file(fileName);
+
+    if (file.open(QIODevice::ReadOnly))
+    {
+        qint64 size = std::min(
+            file.size() / (qint64) sizeof(FFTCorrBlock::cmplx),
+            (qint64) ChannelAnalyzerSink::m_xcorrMaxReferenceSize
+        );
+        m_corrReference.resize(size);
+        file.read((char *) m_corrReference.data(), size * sizeof(FFTCorrBlock::cmplx));
+        qDebug("ChannelAnalyzer::loadCorrReference: %u samples", (unsigned int) m_corrReference.size());
+    }
+    else
+    {
+        qWarning("ChannelAnalyzer::loadCorrReference: cannot open %s", qPrintable(fileName));
+    }
+}
+
+void ChannelAnalyzer::sendCorrelator()
+{
+    // the reference spectra are computed here rather than in the DSP thread
+    FFTCorrBlock *xcorr = new FFTCorrBlock(ChannelAnalyzerSink::m_xcorrLog2BlockSize);
+    xcorr->setReference(m_corrReference.data(), m_corrReference.size());
+    ChannelAnalyzerBaseband::MsgSetCorrelator *msg = ChannelAnalyzerBaseband::MsgSetCorrelator::create(xcorr);
+    m_basebandSink->getInputMessageQueue()->push(msg);
+}
+
+void ChannelAnalyzer::setScopeLiveRate()
+{
+    if (getMessageQueueToGUI()) { // the GUI does it
+        return;
+    }
+
+    int sinkSampleRate = m_settings.m_rationalDownSample ?
+        m_settings.m_rationalDownSamplerRate
+        : m_basebandSampleRate / (1<<m_settings.m_log2Decim);
+    m_scopeVis.setLiveRate(sinkSampleRate == 0 ? 48000 : sinkSampleRate);
 }
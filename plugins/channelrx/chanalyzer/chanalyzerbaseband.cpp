@@ -24,6 +24,7 @@
 #include "chanalyzerbaseband.h"
 
 MESSAGE_CLASS_DEFINITION(ChannelAnalyzerBaseband::MsgConfigureChannelAnalyzerBaseband, Message)
+MESSAGE_CLASS_DEFINITION(ChannelAnalyzerBaseband::MsgSetCorrelator, Message)
 
 ChannelAnalyzerBaseband::ChannelAnalyzerBaseband() :
     m_running(false),
@@ -143,6 +144,15 @@ bool ChannelAnalyzerBaseband::handleMessage(const Message& cmd)
 
 		return true;
     }
+    else if (MsgSetCorrelator::match(cmd))
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        MsgSetCorrelator& cfg = (MsgSetCorrelator&) cmd;
+        qDebug() << "ChannelAnalyzerBaseband::handleMessage: MsgSetCorrelator";
+        m_sink.setCorrelator(cfg.takeCorrelator());
+
+        return true;
+    }
     else
     {
         return false;
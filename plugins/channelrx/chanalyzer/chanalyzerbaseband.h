@@ -56,6 +56,36 @@ public:
         { }
     };
 
+    /**
+     * Cross correlator with its reference spectra already computed so that the DSP thread
+     * only swaps it in. The message owns it until the baseband takes it.
+     */
+    class MsgSetCorrelator : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        FFTCorrBlock *takeCorrelator()
+        {
+            FFTCorrBlock *xcorr = m_xcorr;
+            m_xcorr = nullptr;
+            return xcorr;
+        }
+
+        static MsgSetCorrelator* create(FFTCorrBlock *xcorr) {
+            return new MsgSetCorrelator(xcorr);
+        }
+
+        ~MsgSetCorrelator() { delete m_xcorr; }
+
+    private:
+        FFTCorrBlock *m_xcorr;
+
+        MsgSetCorrelator(FFTCorrBlock *xcorr) :
+            Message(),
+            m_xcorr(xcorr)
+        { }
+    };
+
     ChannelAnalyzerBaseband();
     ~ChannelAnalyzerBaseband();
     void reset();
@@ -16,6 +16,7 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QDockWidget>
+#include <QFileDialog>
 #include <QMainWindow>
 
 #include "device/deviceuiset.h"
@@ -116,6 +117,7 @@ void ChannelAnalyzerGUI::displaySettings()
     ui->log2Decim->setCurrentIndex(m_settings.m_log2Decim);
     displayPLLSettings();
     ui->signalSelect->setCurrentIndex((int) m_settings.m_inputType);
+    displayCorrReference();
     ui->rrcFilter->setChecked(m_settings.m_rrc);
     QString rolloffStr = QString::number(m_settings.m_rrcRolloff/100.0, 'f', 2);
     ui->rrcRolloffText->setText(rolloffStr);
@@ -288,6 +290,42 @@ void ChannelAnalyzerGUI::on_signalSelect_currentIndexChanged(int index)
     applySettings();
 }
 
+void ChannelAnalyzerGUI::on_corrReference_clicked(bool checked)
+{
+    (void) checked;
+    QFileDialog fileDialog(
+        this,
+        tr("Open cross correlation reference file"),
+        m_settings.m_corrReferenceFileName,
+        tr("Raw complex float32 I/Q files (*.cf32 *.raw);;All files (*)")
+    );
+
+    fileDialog.setOptions(QFileDialog::DontUseNativeDialog);
+    fileDialog.setFileMode(QFileDialog::ExistingFile);
+    QStringList fileNames;
+
+    if (fileDialog.exec())
+    {
+        fileNames = fileDialog.selectedFiles();
+
+        if (fileNames.size() > 0)
+        {
+            m_settings.m_corrReferenceFileName = fileNames.at(0);
+            displayCorrReference();
+            applySettings();
+        }
+    }
+}
+
+void ChannelAnalyzerGUI::displayCorrReference()
+{
+    if (m_settings.m_corrReferenceFileName.isEmpty()) {
+        ui->corrReference->setToolTip(tr("Cross correlation reference file (raw complex float32 I/Q)"));
+    } else {
+        ui->corrReference->setToolTip(tr("Cross correlation reference file: %1").arg(m_settings.m_corrReferenceFileName));
+    }
+}
+
 void ChannelAnalyzerGUI::on_deltaFrequency_changed(qint64 value)
 {
     m_channelMarker.setCenterFrequency(value);
@@ -394,7 +432,8 @@ ChannelAnalyzerGUI::ChannelAnalyzerGUI(PluginAPI* pluginAPI, DeviceUISet *device
 	m_channelAnalyzer = (ChannelAnalyzer*) rxChannel; //new ChannelAnalyzer(m_deviceUISet->m_deviceSourceAPI);
     m_spectrumVis = m_channelAnalyzer->getSpectrumVis();
 	m_spectrumVis->setGLSpectrum(ui->glSpectrum);
-	m_scopeVis = new ScopeVis(ui->glScope);
+	m_scopeVis = m_channelAnalyzer->getScopeVis();
+	m_scopeVis->setGLScope(ui->glScope);
 	m_spectrumScopeComboVis = new SpectrumScopeComboVis(m_spectrumVis, m_scopeVis);
     m_channelAnalyzer->setSampleSink(m_spectrumScopeComboVis);
 	m_channelAnalyzer->setMessageQueueToGUI(getInputMessageQueue());
@@ -449,7 +488,6 @@ ChannelAnalyzerGUI::~ChannelAnalyzerGUI()
 {
     m_deviceUISet->removeRxChannelInstance(this);
 	delete m_channelAnalyzer; // TODO: check this: when the GUI closes it has to delete the demodulator
-	delete m_scopeVis;
 	delete m_spectrumScopeComboVis;
 	delete ui;
 }
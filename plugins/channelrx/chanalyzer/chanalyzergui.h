@@ -88,6 +88,7 @@ private:
 	void applySettings(bool force = false);
 	void displaySettings();
 	void displayPLLSettings();
+	void displayCorrReference();
 	void setSpectrumDisplay();
 
 	void leaveEvent(QEvent*);
@@ -100,6 +101,7 @@ private slots:
     void on_pllPskOrder_currentIndexChanged(int index);
     void on_useRationalDownsampler_toggled(bool checked);
     void on_signalSelect_currentIndexChanged(int index);
+    void on_corrReference_clicked(bool checked);
     void on_rrcFilter_toggled(bool checked);
     void on_rrcRolloff_valueChanged(int value);
 	void on_BW_valueChanged(int value);
@@ -46,6 +46,7 @@ void ChannelAnalyzerSettings::resetToDefaults()
     m_rrcRolloff = 35; // 0.35
     m_pllPskOrder = 1;
     m_inputType = InputSignal;
+    m_corrReferenceFileName = "";
     m_rgbColor = QColor(128, 128, 128).rgb();
     m_title = "Channel Analyzer";
 }
@@ -71,6 +72,7 @@ QByteArray ChannelAnalyzerSettings::serialize() const
     s.writeString(15, m_title);
     s.writeBool(16, m_rrc);
     s.writeU32(17, m_rrcRolloff);
+    s.writeString(18, m_corrReferenceFileName);
 
     return s.final();
 }
@@ -118,6 +120,7 @@ bool ChannelAnalyzerSettings::deserialize(const QByteArray& data)
         d.readString(15, &m_title, "Channel Analyzer");
         d.readBool(16, &m_rrc, false);
         d.readU32(17, &m_rrcRolloff, 35);
+        d.readString(18, &m_corrReferenceFileName, "");
 
         return true;
     }
@@ -19,6 +19,7 @@
 #define PLUGINS_CHANNELRX_CHANALYZERNG_CHANALYZERSETTINGS_H_
 
 #include <QByteArray>
+#include <QString>
 
 class Serializable;
 
@@ -28,7 +29,8 @@ struct ChannelAnalyzerSettings
     {
         InputSignal,
         InputPLL,
-        InputAutoCorr
+        InputAutoCorr,
+        InputCrossCorr //!< with the reference sequence read from m_corrReferenceFileName
     };
 
     int m_inputFrequencyOffset;
@@ -44,6 +46,7 @@ struct ChannelAnalyzerSettings
     quint32 m_rrcRolloff; //!< in 100ths
     unsigned int m_pllPskOrder;
     InputType m_inputType;
+    QString m_corrReferenceFileName; //!< raw complex float32 I/Q reference for cross correlation
     quint32 m_rgbColor;
     QString m_title;
     Serializable *m_channelMarker;
@@ -25,6 +25,8 @@
 
 const unsigned int ChannelAnalyzerSink::m_ssbFftLen = 1024;
 const unsigned int ChannelAnalyzerSink::m_corrFFTLen = 4*m_ssbFftLen;
+const unsigned int ChannelAnalyzerSink::m_xcorrLog2BlockSize = 10;
+const unsigned int ChannelAnalyzerSink::m_xcorrMaxReferenceSize = 1<<20;
 
 ChannelAnalyzerSink::ChannelAnalyzerSink() :
     m_channelSampleRate(48000),
@@ -38,6 +40,7 @@ ChannelAnalyzerSink::ChannelAnalyzerSink() :
 	DSBFilter = new fftfilt(m_settings.m_bandwidth / m_channelSampleRate, 2*m_ssbFftLen);
 	RRCFilter = new fftfilt(m_settings.m_bandwidth / m_channelSampleRate, 2*m_ssbFftLen);
 	m_corr = new fftcorr(2*m_corrFFTLen); // 8k for 4k effective samples
+    m_xcorr = new FFTCorrBlock(m_xcorrLog2BlockSize);
 	m_pll.computeCoefficients(0.002f, 0.5f, 10.0f); // bandwidth, damping factor, loop gain
 
     applyChannelSettings(m_channelSampleRate, m_sinkSampleRate, m_channelFrequencyOffset, true);
@@ -50,6 +53,7 @@ ChannelAnalyzerSink::~ChannelAnalyzerSink()
     delete DSBFilter;
     delete RRCFilter;
     delete m_corr;
+    delete m_xcorr;
 }
 
 void ChannelAnalyzerSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
@@ -88,6 +92,10 @@ void ChannelAnalyzerSink::feed(const SampleVector::const_iterator& begin, const
         }
 	}
 
+    if (m_corrBuffer.size() > 0) {
+        feedCorrelation();
+    }
+
 	if (m_sampleSink) {
 		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), m_settings.m_ssb); // m_ssb = positive only
 	}
@@ -231,7 +239,8 @@ void ChannelAnalyzerSink::applySettings(const ChannelAnalyzerSettings& settings,
             << " m_pll: " << settings.m_pll
             << " m_fll: " << settings.m_fll
             << " m_pllPskOrder: " << settings.m_pllPskOrder
-            << " m_inputType: " << (int) settings.m_inputType;
+            << " m_inputType: " << (int) settings.m_inputType
+            << " m_corrReferenceFileName: " << settings.m_corrReferenceFileName;
     bool doApplySampleRate = false;
 
     if ((settings.m_bandwidth != m_settings.m_bandwidth) ||
@@ -308,4 +317,33 @@ void ChannelAnalyzerSink::applySampleRate()
     m_pll.setSampleRate(sampleRate);
     m_fll.setSampleRate(sampleRate);
     RRCFilter->create_rrc_filter(m_settings.m_bandwidth / (float) sampleRate, m_settings.m_rrcRolloff / 100.0);
-}
\ No newline at end of file
+}
+
+void ChannelAnalyzerSink::setCorrelator(FFTCorrBlock *xcorr)
+{
+    delete m_xcorr;
+    m_xcorr = xcorr;
+}
+
+void ChannelAnalyzerSink::feedCorrelation()
+{
+    if (m_settings.m_inputType == ChannelAnalyzerSettings::InputCrossCorr) {
+        m_xcorr->run(m_corrBuffer.data(), m_corrBuffer.size(), m_corrBuffer.data());
+    } else {
+        m_corr->run(m_corrBuffer.data(), nullptr, m_corrBuffer.size(), m_corrBuffer.data());
+    }
+
+    // cross correlation is normalized to the signal amplitude, auto correlation is not
+    float scale = m_settings.m_inputType == ChannelAnalyzerSettings::InputCrossCorr ? SDR_RX_SCALEF : 1.0f;
+
+    for (const fftcorr::cmplx& a : m_corrBuffer)
+    {
+        if (m_settings.m_ssb & !m_usb) { // invert spectrum for LSB
+            m_sampleBuffer.push_back(Sample(a.imag()*scale, a.real()*scale));
+        } else {
+            m_sampleBuffer.push_back(Sample(a.real()*scale, a.imag()*scale));
+        }
+    }
+
+    m_corrBuffer.clear();
+}
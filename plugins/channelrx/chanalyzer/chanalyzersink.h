@@ -18,11 +18,14 @@
 #ifndef INCLUDE_CHANALYZERSINK_H
 #define INCLUDE_CHANALYZERSINK_H
 
+#include <vector>
+
 #include "dsp/channelsamplesink.h"
 #include "dsp/interpolator.h"
 #include "dsp/decimatorc.h"
 #include "dsp/ncof.h"
 #include "dsp/fftcorr.h"
+#include "dsp/fftcorrblock.h"
 #include "dsp/fftfilt.h"
 #include "dsp/phaselockcomplex.h"
 #include "dsp/freqlockcomplex.h"
@@ -51,9 +54,12 @@ public:
 	Real getPllDeltaPhase() const { return m_pll.getDeltaPhi(); }
     Real getPllPhase() const { return m_pll.getPhiHat(); }
     void setSampleSink(BasebandSampleSink* sampleSink) { m_sampleSink = sampleSink; }
+    void setCorrelator(FFTCorrBlock *xcorr); //!< Takes ownership
 
     static const unsigned int m_corrFFTLen;
     static const unsigned int m_ssbFftLen;
+    static const unsigned int m_xcorrLog2BlockSize;
+    static const unsigned int m_xcorrMaxReferenceSize;
 
 private:
     int m_channelSampleRate;
@@ -76,6 +82,8 @@ private:
 	fftfilt* DSBFilter;
 	fftfilt* RRCFilter;
 	fftcorr* m_corr;
+    FFTCorrBlock* m_xcorr;
+    std::vector<fftcorr::cmplx> m_corrBuffer; //!< correlator input and output of one feed
 
 	SampleVector m_sampleBuffer;
 	MovingAverageUtil<double, double, 480> m_channelPowerAvg;
@@ -86,6 +94,7 @@ private:
 	void processOneSample(Complex& c, fftfilt::cmplx *sideband);
     int getActualSampleRate();
     void applySampleRate();
+    void feedCorrelation();
 
 	inline void feedOneSample(const fftfilt::cmplx& s, const fftfilt::cmplx& pll)
 	{
@@ -101,15 +110,8 @@ private:
             }
 	            break;
 	        case ChannelAnalyzerSettings::InputAutoCorr:
-	        {
-                std::complex<float> a = m_corr->run(s/SDR_RX_SCALEF, 0);
-
-                if (m_settings.m_ssb & !m_usb) { // invert spectrum for LSB
-                    m_sampleBuffer.push_back(Sample(a.imag(), a.real()));
-                } else {
-                    m_sampleBuffer.push_back(Sample(a.real(), a.imag()));
-                }
-	        }
+	        case ChannelAnalyzerSettings::InputCrossCorr:
+                m_corrBuffer.push_back(s/SDR_RX_SCALEF); // correlated by blocks (see feedCorrelation)
 	            break;
             case ChannelAnalyzerSettings::InputSignal:
             default:
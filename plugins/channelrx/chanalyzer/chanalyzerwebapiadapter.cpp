@@ -61,6 +61,7 @@ void ChannelAnalyzerWebAPIAdapter::webapiFormatChannelSettings(
     response.getChannelAnalyzerSettings()->setInputType((int) settings.m_inputType);
     response.getChannelAnalyzerSettings()->setRgbColor(settings.m_rgbColor);
     response.getChannelAnalyzerSettings()->setTitle(new QString(settings.m_title));
+    response.getChannelAnalyzerSettings()->setCorrReferenceFileName(new QString(settings.m_corrReferenceFileName));
 
     // scope
     SWGSDRangel::SWGGLScope *swgScope = new SWGSDRangel::SWGGLScope();
@@ -210,6 +211,9 @@ void ChannelAnalyzerWebAPIAdapter::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("title")) {
         settings.m_title = *response.getChannelAnalyzerSettings()->getTitle();
     }
+    if (channelSettingsKeys.contains("corrReferenceFileName")) {
+        settings.m_corrReferenceFileName = *response.getChannelAnalyzerSettings()->getCorrReferenceFileName();
+    }
     // scope
     if (channelSettingsKeys.contains("scopeConfig"))
     {
@@ -359,6 +359,15 @@ int AMDemod::webapiReportGet(
     return 200;
 }
 
+bool AMDemod::getMetrics(Metrics& metrics) const
+{
+    metrics.m_channelPowerDB = CalcDb::dbPower(m_basebandSink->getMagSq());
+    metrics.m_squelch = m_basebandSink->getSquelchOpen() ? 1 : 0;
+    metrics.m_channelSampleRate = m_basebandSink->getChannelSampleRate();
+    metrics.m_audioSampleRate = m_basebandSink->getAudioSampleRate();
+    return true;
+}
+
 void AMDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const AMDemodSettings& settings)
 {
     response.getAmDemodSettings()->setAudioMute(settings.m_audioMute ? 1 : 0);
@@ -94,6 +94,8 @@ private:
 	Interpolator m_interpolator;
 	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
+	std::vector<Complex> m_interpolatorIn;
+	std::vector<Complex> m_interpolatorOut;
 
 	Real m_squelchLevel;
 	uint32_t m_squelchCount;
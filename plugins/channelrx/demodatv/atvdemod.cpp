@@ -148,6 +148,7 @@ void ATVDemod::applySettings(const ATVDemodSettings& settings, bool force)
             << "m_halfFrames:" << settings.m_halfFrames
             << "m_levelSynchroTop:" << settings.m_levelSynchroTop
             << "m_levelBlack:" << settings.m_levelBlack
+            << "m_lineProcessing:" << settings.m_lineProcessing
             << "m_rgbColor:" << settings.m_rgbColor
             << "m_title:" << settings.m_title
             << "m_udpAddress:" << settings.m_udpAddress
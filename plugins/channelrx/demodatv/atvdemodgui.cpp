@@ -123,6 +123,7 @@ void ATVDemodGUI::displaySettings()
     ui->vSync->setChecked(m_settings.m_vSync);
     ui->halfImage->setChecked(m_settings.m_halfFrames);
     ui->invertVideo->setChecked(m_settings.m_invertVideo);
+    ui->lineProcessing->setChecked(m_settings.m_lineProcessing);
     ui->standard->setCurrentIndex((int) m_settings.m_atvStd);
     lineTimeUpdate();
     topTimeUpdate();
@@ -452,6 +453,12 @@ void ATVDemodGUI::on_halfImage_clicked()
     applySettings();
 }
 
+void ATVDemodGUI::on_lineProcessing_clicked()
+{
+    m_settings.m_lineProcessing = ui->lineProcessing->isChecked();
+    applySettings();
+}
+
 void ATVDemodGUI::on_nbLines_currentIndexChanged(int index)
 {
     m_settings.m_nbLines = ATVDemodSettings::getNumberOfLines(index);
@@ -106,6 +106,7 @@ private slots:
     void on_vSync_clicked();
     void on_invertVideo_clicked();
     void on_halfImage_clicked();
+    void on_lineProcessing_clicked();
     void on_modulation_currentIndexChanged(int index);
     void on_nbLines_currentIndexChanged(int index);
     void on_fps_currentIndexChanged(int index);
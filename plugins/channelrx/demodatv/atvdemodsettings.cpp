@@ -48,6 +48,7 @@ void ATVDemodSettings::resetToDefaults()
     m_halfFrames = false; // m_fltRatioOfRowsToDisplay = 1.0
     m_levelSynchroTop = 0.15f;
     m_levelBlack = 0.3f;
+    m_lineProcessing = false;
     m_rgbColor = QColor(255, 255, 255).rgb();
     m_title = "ATV Demodulator";
     m_udpAddress = "127.0.0.1";
@@ -85,6 +86,7 @@ QByteArray ATVDemodSettings::serialize() const
     s.writeS32(22, m_amScalingFactor);
     s.writeS32(23, m_amOffsetFactor);
     s.writeBool(24, m_fftFiltering);
+    s.writeBool(25, m_lineProcessing);
 
     return s.final();
 }
@@ -133,6 +135,7 @@ bool ATVDemodSettings::deserialize(const QByteArray& arrData)
         d.readS32(22, &m_amScalingFactor, 100);
         d.readS32(23, &m_amOffsetFactor, 0);
         d.readBool(24, &m_fftFiltering, false);
+        d.readBool(25, &m_lineProcessing, false);
 
         return true;
     }
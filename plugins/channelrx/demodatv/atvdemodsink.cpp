@@ -19,13 +19,16 @@
 #include <QDebug>
 
 #include <stdio.h>
+#include <algorithm>
 #include <complex.h>
 
 #include "audio/audiooutput.h"
+#include "dsp/atvlinekernels.h"
 
 #include "atvdemodsink.h"
 
 const int ATVDemodSink::m_ssbFftLen = 1024;
+const int ATVDemodSink::m_lineHistory = 6;
 
 ATVDemodSink::ATVDemodSink() :
     m_channelSampleRate(1000000),
@@ -48,8 +51,11 @@ ATVDemodSink::ATVDemodSink() :
     m_sampleOffsetDetected(0),
 	m_hSyncShift(0.0f),
     m_hSyncErrorCount(0),
+    m_hSyncCount(0),
+    m_vSyncCount(0),
     m_amSampleIndex(0),
     m_lineIndex(0),
+    m_lineSize(0),
     m_ampAverage(4800),
     m_bfoPLL(200/1000000, 100/1000000, 0.01),
     m_bfoFilter(200.0, 1000000.0, 0.9),
@@ -86,15 +92,22 @@ void ATVDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
 
     //********** Accessing ATV Screen context **********
 
-    for (SampleVector::const_iterator it = begin; it != end; ++it /* ++it **/)
+    if (m_settings.m_lineProcessing)
     {
-        Complex c(it->real(), it->imag());
+        feedLines(begin, end);
+    }
+    else
+    {
+        for (SampleVector::const_iterator it = begin; it != end; ++it /* ++it **/)
+        {
+            Complex c(it->real(), it->imag());
 
-        if (m_settings.m_inputFrequencyOffset != 0) {
-            c *= m_nco.nextIQ();
-        }
+            if (m_settings.m_inputFrequencyOffset != 0) {
+                c *= m_nco.nextIQ();
+            }
 
-        demod(c);
+            demod(c);
+        }
     }
 
     if ((m_videoTabIndex == 1) && (m_scopeSink)) // do only if scope tab is selected and scope is available
@@ -256,32 +269,10 @@ void ATVDemodSink::demod(Complex& c)
             m_effMax = sample;
         }
 
-        if (m_amSampleIndex < m_samplesPerLine * m_settings.m_nbLines * 2) // calculate on two full images
-        {
+        if (m_amSampleIndex < m_samplesPerLine * m_settings.m_nbLines * 2) { // calculate on two full images
             m_amSampleIndex++;
-        }
-        else
-        {
-            // scale signal based on extrema on the estimation period
-            m_ampMin = m_effMin;
-            m_ampMax = m_effMax;
-            m_ampDelta = (m_ampMax - m_ampMin);
-
-            if (m_ampDelta <= 0.0) {
-                m_ampDelta = 1.0f;
-            }
-
-            // readjustment
-            m_ampDelta /= m_settings.m_amScalingFactor / 100.0f;
-            m_ampMin += m_ampDelta * (m_settings.m_amOffsetFactor / 100.0f);
-
-            // qDebug("ATVDemod::demod: m_ampMin: %f m_ampMax: %f m_ampDelta: %f", m_ampMin, m_ampMax, m_ampDelta);
-
-            //Reset extrema
-            m_effMin = 20.0f;
-            m_effMax = -20.0f;
-
-            m_amSampleIndex = 0;
+        } else {
+            updateAMScale();
         }
 
         //Normalisation of current sample
@@ -312,6 +303,284 @@ void ATVDemodSink::demod(Complex& c)
     }
 }
 
+void ATVDemodSink::updateAMScale()
+{
+    // scale signal based on extrema on the estimation period
+    m_ampMin = m_effMin;
+    m_ampMax = m_effMax;
+    m_ampDelta = (m_ampMax - m_ampMin);
+
+    if (m_ampDelta <= 0.0) {
+        m_ampDelta = 1.0f;
+    }
+
+    // readjustment
+    m_ampDelta /= m_settings.m_amScalingFactor / 100.0f;
+    m_ampMin += m_ampDelta * (m_settings.m_amOffsetFactor / 100.0f);
+
+    // qDebug("ATVDemod::demod: m_ampMin: %f m_ampMax: %f m_ampDelta: %f", m_ampMin, m_ampMax, m_ampDelta);
+
+    //Reset extrema
+    m_effMin = 20.0f;
+    m_effMax = -20.0f;
+
+    m_amSampleIndex = 0;
+}
+
+void ATVDemodSink::feedLines(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    SampleVector::const_iterator it = begin;
+
+    while (it != end)
+    {
+        // the line ends when the sample offset reaches the number of samples per line
+        int lineLength = m_samplesPerLine - m_sampleOffset;
+        lineLength = lineLength < 1 ? 1 : lineLength > (int) m_lineIQ.size() ? (int) m_lineIQ.size() : lineLength;
+        int count = std::min((int) (end - it), lineLength - m_lineSize);
+
+        if (count > 0)
+        {
+            Complex *iq = &m_lineIQ[m_lineSize];
+
+            if (m_settings.m_inputFrequencyOffset != 0)
+            {
+                m_nco.nextIQMul(&(*it), iq, count);
+            }
+            else
+            {
+                for (int i = 0; i < count; i++) {
+                    iq[i] = Complex(it[i].real(), it[i].imag());
+                }
+            }
+
+            // FM3 works on the unfiltered signal
+            if (m_settings.m_fftFiltering && (m_settings.m_atvModulation != ATVDemodSettings::ATV_FM3))
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    Complex *filtered;
+                    int n_out = m_DSBFilter->runAsym(iq[i], &filtered, m_settings.m_atvModulation != ATVDemodSettings::ATV_LSB);
+
+                    if (n_out > 0)
+                    {
+                        std::copy(filtered, filtered + n_out, m_DSBFilterBuffer);
+                        m_DSBFilterBufferIndex = 0;
+                    }
+                    else if (m_DSBFilterBufferIndex < m_ssbFftLen - 1) // safe
+                    {
+                        m_DSBFilterBufferIndex++;
+                    }
+
+                    iq[i] = m_DSBFilterBuffer[m_DSBFilterBufferIndex];
+                }
+            }
+
+            m_lineSize += count;
+            it += count;
+        }
+
+        if (m_lineSize >= lineLength)
+        {
+            processLine(m_lineSize);
+            m_lineSize = 0;
+        }
+    }
+}
+
+void ATVDemodSink::demodLine(int n)
+{
+    const Complex *iq = m_lineIQ.data();
+    float *mag = m_lineMag.data();
+    float *samples = m_lineSamples.data();
+    float videoScale = 1.0f;  // applied to the samples before clipping
+    float videoOffset = 0.0f;
+
+    //********** demodulation **********
+
+    ATVLineKernels::magnitude(iq, m_lineMagSq.data(), mag, n);
+
+    // the moving average only depends on its last 32 samples
+    for (int i = n > 32 ? n - 32 : 0; i < n; i++) {
+        m_magSqAverage(m_lineMagSq[i]);
+    }
+
+    if ((m_settings.m_atvModulation == ATVDemodSettings::ATV_FM1) || (m_settings.m_atvModulation == ATVDemodSettings::ATV_FM2))
+    {
+        float *normI = m_lineNormI.data() + m_lineHistory;
+        float *normQ = m_lineNormQ.data() + m_lineHistory;
+        ATVLineKernels::normalize(iq, mag, normI, normQ, n);
+
+        if (m_settings.m_atvModulation == ATVDemodSettings::ATV_FM1) {
+            ATVLineKernels::discriminator1(normI, normQ, samples, n);
+        } else {
+            ATVLineKernels::discriminator2(normI, normQ, samples, n);
+        }
+
+        // last samples are the history of the next line
+        std::copy(m_lineNormI.begin() + n, m_lineNormI.begin() + n + m_lineHistory, m_lineNormI.begin());
+        std::copy(m_lineNormQ.begin() + n, m_lineNormQ.begin() + n + m_lineHistory, m_lineNormQ.begin());
+
+        if (m_settings.m_fmDeviation != 1.0f)
+        {
+            videoScale = 1.0f / m_settings.m_fmDeviation;
+            videoOffset = 0.5f - 0.5f / m_settings.m_fmDeviation;
+        }
+    }
+    else if (m_settings.m_atvModulation == ATVDemodSettings::ATV_AM)
+    {
+        for (int i = 0; i < n; i++) {
+            m_ampAverage(mag[i] / SDR_RX_SCALEF);
+        }
+
+        // AGC is updated once per line
+        ATVLineKernels::scale(mag, samples, n, 1.0f / (SDR_RX_SCALEF * 2.0f * m_ampAverage.asFloat()), 0.0f);
+    }
+    else if ((m_settings.m_atvModulation == ATVDemodSettings::ATV_USB) || (m_settings.m_atvModulation == ATVDemodSettings::ATV_LSB))
+    {
+        // the BFO PLL runs sample by sample
+        for (int i = 0; i < n; i++)
+        {
+            Real bfoValues[2];
+            float fltFiltered = m_bfoFilter.run(iq[i].real());
+            m_bfoPLL.process(fltFiltered, bfoValues);
+
+            float mixI = iq[i].real() * bfoValues[0] - iq[i].imag() * bfoValues[1];
+            float mixQ = iq[i].real() * bfoValues[1] + iq[i].imag() * bfoValues[0];
+
+            if (m_settings.m_atvModulation == ATVDemodSettings::ATV_USB) {
+                samples[i] = (mixI + mixQ);
+            } else {
+                samples[i] = (mixI - mixQ);
+            }
+        }
+    }
+    else if (m_settings.m_atvModulation == ATVDemodSettings::ATV_FM3)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            double magSq;
+            float rawDeviation;
+            samples[i] = m_objPhaseDiscri.phaseDiscriminatorDelta(iq[i], magSq, rawDeviation) + 0.5f;
+        }
+    }
+    else
+    {
+        std::fill(samples, samples + n, 0.0f);
+    }
+
+    //********** AM sample normalization and coarse scale estimation **********
+
+    if ((m_settings.m_atvModulation == ATVDemodSettings::ATV_AM)
+        || (m_settings.m_atvModulation == ATVDemodSettings::ATV_USB)
+        || (m_settings.m_atvModulation == ATVDemodSettings::ATV_LSB))
+    {
+        ATVLineKernels::minMax(samples, n, m_effMin, m_effMax);
+        m_amSampleIndex += n;
+
+        if (m_amSampleIndex >= m_samplesPerLine * m_settings.m_nbLines * 2) { // calculate on two full images
+            updateAMScale();
+        }
+
+        videoScale = 1.0f / m_ampDelta;
+        videoOffset = -m_ampMin / m_ampDelta;
+    }
+
+    if (m_settings.m_invertVideo)
+    {
+        videoScale = -videoScale;
+        videoOffset = 1.0f - videoOffset;
+    }
+
+    //********** clipping and gray level **********
+
+    ATVLineKernels::toVideo(samples, m_lineVideo.data(), n, videoScale, videoOffset, m_settings.m_levelBlack, m_sampleRangeCorrection);
+
+    if ((m_videoTabIndex == 1) && (m_scopeSink != 0)) // feed scope buffer only if scope is present and visible
+    {
+        for (int i = 0; i < n; i++) {
+            m_scopeSampleBuffer.push_back(Sample(samples[i] * (SDR_RX_SCALEF - 1.0f), 0.0f));
+        }
+    }
+}
+
+void ATVDemodSink::processLine(int n)
+{
+    demodLine(n);
+
+    if (!m_registeredTVScreen) { // can process only if the screen is available (set via the GUI)
+        return;
+    }
+
+    const float *samples = m_lineSamples.data();
+    const float level = m_settings.m_levelSynchroTop;
+
+    // Filling pixels of the line - reference index 0 at start of sync pulse
+    m_tvScreenBuffer->setSampleValues(m_sampleOffset - m_numberSamplesPerHSync, m_lineVideo.data(), n);
+
+    if (m_settings.m_hSync)
+    {
+        // Horizontal synchro detection. A pulse is accepted only when far enough from the previous one.
+        int from = 0;
+
+        while (true)
+        {
+            int start = from + m_samplesPerLine - m_numberSamplesPerHTop + 1 - m_sampleOffsetDetected;
+            start = start < from ? from : start;
+            int i = start < n ? ATVLineKernels::findFallingEdge(samples, start, n, prevSample, level) : -1;
+
+            if (i < 0)
+            {
+                m_sampleOffsetDetected += n - from;
+                break;
+            }
+
+            processHSync(samples[i], i > 0 ? samples[i-1] : prevSample, m_sampleOffset + i);
+            m_sampleOffsetDetected = 0;
+            from = i + 1;
+        }
+    }
+
+    if (m_settings.m_vSync)
+    {
+        // a sample is counted when the sample offset that follows it is strictly inside the detection window
+        int lo = std::max(m_fieldDetectStartPos - m_sampleOffset, 0);
+        int hi = std::min(m_fieldDetectEndPos - m_sampleOffset - 1, n);
+
+        if (lo < hi) {
+            m_fieldDetectSampleCount += ATVLineKernels::countBelow(samples + lo, hi - lo, level);
+        }
+
+        lo = std::max(m_vSyncDetectStartPos - m_sampleOffset, 0);
+        hi = std::min(m_vSyncDetectEndPos - m_sampleOffset - 1, n);
+
+        if (lo < hi) {
+            m_vSyncDetectSampleCount += ATVLineKernels::countBelow(samples + lo, hi - lo, level);
+        }
+    }
+
+    m_sampleOffset += n;
+    prevSample = samples[n-1];
+
+    // end of line
+    if (m_sampleOffset >= m_samplesPerLine) {
+        processEOL();
+    }
+}
+
+void ATVDemodSink::resizeLineBuffers()
+{
+    // the line length varies by up to half a line with the horizontal synchronization shift
+    int size = 2 * m_samplesPerLine;
+    m_lineIQ.resize(size);
+    m_lineMagSq.resize(size);
+    m_lineMag.resize(size);
+    m_lineNormI.resize(size + m_lineHistory);
+    m_lineNormQ.resize(size + m_lineHistory);
+    m_lineSamples.resize(size);
+    m_lineVideo.resize(size);
+    m_lineSize = 0;
+}
+
 void ATVDemodSink::applyStandard(int sampleRate, ATVDemodSettings::ATVStd atvStd, float lineDuration)
 {
     switch(atvStd)
@@ -426,6 +695,7 @@ void ATVDemodSink::applyChannelSettings(int channelSampleRate, int channelFreque
         ATVDemodSettings::getBaseValues(channelSampleRate, m_settings.m_nbLines * m_settings.m_fps, samplesPerLineNom);
         m_samplesPerLine = samplesPerLineNom;
 		m_samplesPerLineFrac = (float)channelSampleRate / (m_settings.m_nbLines * m_settings.m_fps) - m_samplesPerLine;
+        resizeLineBuffers();
         qDebug() << "ATVDemodSink::applyChannelSettings:"
                 << " m_channelSampleRate: " << m_channelSampleRate
                 << " m_fftBandwidth: " << m_settings.m_fftBandwidth
@@ -483,6 +753,7 @@ void ATVDemodSink::applySettings(const ATVDemodSettings& settings, bool force)
             << "m_halfFrames:" << settings.m_halfFrames
             << "m_levelSynchroTop:" << settings.m_levelSynchroTop
             << "m_levelBlack:" << settings.m_levelBlack
+            << "m_lineProcessing:" << settings.m_lineProcessing
             << "m_rgbColor:" << settings.m_rgbColor
             << "m_title:" << settings.m_title
             << "m_udpAddress:" << settings.m_udpAddress
@@ -517,6 +788,7 @@ void ATVDemodSink::applySettings(const ATVDemodSettings& settings, bool force)
         m_samplesPerLine = samplesPerLineNom;
 		m_samplesPerLineFrac = (float)m_channelSampleRate / (settings.m_nbLines * settings.m_fps) - m_samplesPerLine;
 		m_ampAverage.resize(m_samplesPerLine * settings.m_nbLines * 2); // AGC average in two full images
+        resizeLineBuffers();
 
         qDebug() << "ATVDemodSink::applySettings:"
                 << " m_channelSampleRate: " << m_channelSampleRate
@@ -538,6 +810,10 @@ void ATVDemodSink::applySettings(const ATVDemodSettings& settings, bool force)
         m_fieldIndex = 0;
     }
 
+    if ((settings.m_lineProcessing != m_settings.m_lineProcessing) || force) {
+        m_lineSize = 0; // start a new line
+    }
+
     if ((settings.m_fmDeviation != m_settings.m_fmDeviation) || force) {
         m_objPhaseDiscri.setFMScaling(1.0f / settings.m_fmDeviation);
     }
@@ -33,7 +33,7 @@
 #include "dsp/phasediscri.h"
 #include "audio/audiofifo.h"
 #include "util/movingaverage.h"
-#include "gui/tvscreenanalog.h"
+#include "gui/tvscreenanalogbuffer.h"
 
 #include "atvdemodsettings.h"
 
@@ -45,10 +45,12 @@ public:
     virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
 
   	void setScopeSink(BasebandSampleSink* scopeSink) { m_scopeSink = scopeSink; }
-    void setTVScreen(TVScreenAnalog *tvScreen) { m_registeredTVScreen = tvScreen; } //!< set by the GUI
+    void setTVScreen(TVScreenAnalogBuffers *tvScreen) { m_registeredTVScreen = tvScreen; } //!< set by the GUI
     double getMagSq() const { return m_magSqAverage; } //!< Beware this is scaled to 2^30
     bool getBFOLocked();
     void setVideoTabIndex(int videoTabIndex) { m_videoTabIndex = videoTabIndex; }
+    unsigned int getHSyncCount() const { return m_hSyncCount; } //!< number of horizontal synchronizations detected
+    unsigned int getVSyncCount() const { return m_vSyncCount; } //!< number of vertical synchronizations detected
 
     void applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force = false);
     void applySettings(const ATVDemodSettings& settings, bool force = false);
@@ -108,7 +110,7 @@ private:
     SampleVector m_scopeSampleBuffer;
 
     //*************** ATV PARAMETERS  ***************
-    TVScreenAnalog *m_registeredTVScreen;
+    TVScreenAnalogBuffers *m_registeredTVScreen;
 	std::shared_ptr<TVScreenAnalogBuffer> m_tvScreenBuffer;
 
     //int m_intNumberSamplePerLine;
@@ -158,6 +160,8 @@ private:
 
 	float m_hSyncShift;
     int m_hSyncErrorCount;
+    unsigned int m_hSyncCount;
+    unsigned int m_vSyncCount;
 
     float prevSample;
     int m_avgColIndex;
@@ -166,6 +170,18 @@ private:
 
     float m_sampleRangeCorrection;
 
+    //*************** LINE PROCESSING  ***************
+
+    std::vector<Complex> m_lineIQ;    //!< mixed (and filtered) samples of the current line
+    std::vector<float> m_lineMagSq;
+    std::vector<float> m_lineMag;
+    std::vector<float> m_lineNormI;   //!< normalized samples for the FM discriminators preceded by history
+    std::vector<float> m_lineNormQ;
+    std::vector<float> m_lineSamples; //!< video samples (0.0 to 1.0 scale)
+    std::vector<int> m_lineVideo;     //!< gray levels
+    int m_lineSize;                   //!< number of samples collected in the current line
+    static const int m_lineHistory;   //!< number of past samples needed by the FM discriminators
+
     //*************** RF  ***************
 
     MovingAverageUtil<double, double, 32> m_magSqAverage;
@@ -185,6 +201,11 @@ private:
     PhaseDiscriminators m_objPhaseDiscri;
 
     void demod(Complex& c);
+    void updateAMScale();
+    void feedLines(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void demodLine(int n);
+    void processLine(int n);
+    void resizeLineBuffers();
     void applyStandard(int sampleRate, ATVDemodSettings::ATVStd atvStd, float lineDuration);
 
     inline void processSample(float& sample, int& sampleVideo)
@@ -199,30 +220,7 @@ private:
                 sample < m_settings.m_levelSynchroTop) // horizontal synchro detected
                 && (m_sampleOffsetDetected > m_samplesPerLine - m_numberSamplesPerHTop))
             {
-                float sampleOffsetDetectedFrac =
-                    (sample - m_settings.m_levelSynchroTop) / (prevSample - sample);
-                float hSyncShift = -m_sampleOffset - m_sampleOffsetFrac - sampleOffsetDetectedFrac;
-                if (hSyncShift > m_samplesPerLine / 2)
-					hSyncShift -= m_samplesPerLine;
-                else if (hSyncShift < -m_samplesPerLine / 2)
-					hSyncShift += m_samplesPerLine;
-
-                if (fabs(hSyncShift) > m_numberSamplesPerHTop)
-                {
-                    m_hSyncErrorCount++;
-                    if (m_hSyncErrorCount >= 4)
-                    {
-                        // Fast sync: shift is too large, needs to be fixed ASAP
-						m_hSyncShift = hSyncShift;
-                        m_hSyncErrorCount = 0;
-                    }
-                }
-                else
-                {
-					// Slow sync: slight adjustment is needed
-					m_hSyncShift = hSyncShift * 0.2f;
-                    m_hSyncErrorCount = 0;
-                }
+                processHSync(sample, prevSample, m_sampleOffset);
 				m_sampleOffsetDetected = 0;
             }
             else
@@ -239,22 +237,56 @@ private:
         }
 
         // end of line
-        if (m_sampleOffset >= m_samplesPerLine)
+        if (m_sampleOffset >= m_samplesPerLine) {
+            processEOL();
+        }
+
+        prevSample = sample;
+    }
+
+    // Horizontal synchro detected at sample with previous sample prev and offset sampleOffset from line start
+    inline void processHSync(float sample, float prev, int sampleOffset)
+    {
+        m_hSyncCount++;
+        float sampleOffsetDetectedFrac =
+            (sample - m_settings.m_levelSynchroTop) / (prev - sample);
+        float hSyncShift = -sampleOffset - m_sampleOffsetFrac - sampleOffsetDetectedFrac;
+        if (hSyncShift > m_samplesPerLine / 2)
+            hSyncShift -= m_samplesPerLine;
+        else if (hSyncShift < -m_samplesPerLine / 2)
+            hSyncShift += m_samplesPerLine;
+
+        if (fabs(hSyncShift) > m_numberSamplesPerHTop)
         {
-            float sampleOffsetFloat = m_hSyncShift + m_sampleOffsetFrac - m_samplesPerLineFrac;
-            m_sampleOffset = sampleOffsetFloat;
-            m_sampleOffsetFrac = sampleOffsetFloat - m_sampleOffset;
-			m_hSyncShift = 0.0f;
-
-			m_lineIndex++;
-			if (m_settings.m_atvStd == ATVDemodSettings::ATVStdHSkip) {
-                processEOLHSkip();
-            } else {
-                processEOLClassic();
+            m_hSyncErrorCount++;
+            if (m_hSyncErrorCount >= 4)
+            {
+                // Fast sync: shift is too large, needs to be fixed ASAP
+                m_hSyncShift = hSyncShift;
+                m_hSyncErrorCount = 0;
             }
         }
+        else
+        {
+            // Slow sync: slight adjustment is needed
+            m_hSyncShift = hSyncShift * 0.2f;
+            m_hSyncErrorCount = 0;
+        }
+    }
 
-        prevSample = sample;
+    inline void processEOL()
+    {
+        float sampleOffsetFloat = m_hSyncShift + m_sampleOffsetFrac - m_samplesPerLineFrac;
+        m_sampleOffset = sampleOffsetFloat;
+        m_sampleOffsetFrac = sampleOffsetFloat - m_sampleOffset;
+        m_hSyncShift = 0.0f;
+
+        m_lineIndex++;
+        if (m_settings.m_atvStd == ATVDemodSettings::ATVStdHSkip) {
+            processEOLHSkip();
+        } else {
+            processEOLClassic();
+        }
     }
 
     // Standard vertical sync
@@ -268,6 +300,7 @@ private:
         if (m_vSyncDetectSampleCount > m_vSyncDetectThreshold &&
             (m_lineIndex < 3 || m_lineIndex > m_numberOfVSyncLines + 1) && m_settings.m_vSync)
         {
+            m_vSyncCount++;
             if (m_interleaved)
             {
                 if (m_fieldDetectSampleCount > m_fieldDetectThreshold1)
@@ -304,6 +337,7 @@ private:
 		if ((m_sampleOffsetDetected > (3 * m_samplesPerLine) / 2) // Vertical sync is first horizontal sync after skip (count at least 1.5 line length)
             || (!m_settings.m_vSync && (m_lineIndex >= m_settings.m_nbLines))) // Vsync ignored and reached nominal number of lines per frame
         {
+            m_vSyncCount++;
 			m_tvScreenBuffer = m_registeredTVScreen->swapBuffers();
 			m_lineIndex = 0;
         }
@@ -345,6 +345,14 @@ int BFMDemod::webapiReportGet(
     return 200;
 }
 
+bool BFMDemod::getMetrics(Metrics& metrics) const
+{
+    metrics.m_channelPowerDB = CalcDb::dbPower(m_basebandSink->getMagSq());
+    metrics.m_channelSampleRate = m_basebandSink->getChannelSampleRate();
+    metrics.m_audioSampleRate = m_basebandSink->getAudioSampleRate();
+    return true;
+}
+
 void BFMDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const BFMDemodSettings& settings)
 {
     response.getBfmDemodSettings()->setInputFrequencyOffset(settings.m_inputFrequencyOffset);
@@ -410,6 +418,7 @@ void BFMDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response
 
 void BFMDemod::webapiFormatRDSReport(SWGSDRangel::SWGRDSReport *report)
 {
+    QMutexLocker parserLocker(getRDSParserMutex());
     report->setDemodStatus(round(getDemodQua()));
     report->setDecodStatus(round(getDecoderQua()));
     report->setRdsDemodAccumDb(CalcDb::dbPower(std::fabs(getDemodAcc())));
@@ -110,6 +110,7 @@ public:
     void getMagSqLevels(double& avg, double& peak, int& nbSamples) { m_basebandSink->getMagSqLevels(avg, peak, nbSamples); }
 
     RDSParser& getRDSParser() { return m_basebandSink->getRDSParser(); }
+    QMutex *getRDSParserMutex() { return m_basebandSink->getRDSParserMutex(); }
 
     virtual int webapiSettingsGet(
             SWGSDRangel::SWGChannelSettings& response,
@@ -125,6 +126,8 @@ public:
             SWGSDRangel::SWGChannelReport& response,
             QString& errorMessage);
 
+    virtual bool getMetrics(Metrics& metrics) const;
+
     static void webapiFormatChannelSettings(
             SWGSDRangel::SWGChannelSettings& response,
             const BFMDemodSettings& settings);
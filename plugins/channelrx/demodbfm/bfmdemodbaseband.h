@@ -78,6 +78,7 @@ public:
 	Real getDemodFclk() const { return m_sink.getDemodFclk(); }
     void getMagSqLevels(double& avg, double& peak, int& nbSamples) { m_sink.getMagSqLevels(avg, peak, nbSamples); }
     RDSParser& getRDSParser() { return m_sink.getRDSParser(); }
+    QMutex *getRDSParserMutex() { return m_sink.getRDSParserMutex(); }
 
 private:
     SampleSinkFifo m_sampleFifo;
@@ -230,6 +230,7 @@ void BFMDemodGUI::on_clearData_clicked(bool checked)
     (void) checked;
 	if (ui->rds->isChecked())
 	{
+		QMutexLocker parserLocker(m_bfmDemod->getRDSParserMutex());
 		m_bfmDemod->getRDSParser().clearAllFields();
 
 		ui->g14ProgServiceNames->clear();
@@ -250,6 +251,7 @@ void BFMDemodGUI::on_g14ProgServiceNames_currentIndexChanged(int _index)
 
 	if (index < m_g14ComboIndex.size())
 	{
+		QMutexLocker parserLocker(m_bfmDemod->getRDSParserMutex());
 		unsigned int piKey = m_g14ComboIndex[index];
 		RDSParser::freqs_map_t::const_iterator mIt = m_bfmDemod->getRDSParser().m_g14_mapped_freqs.find(piKey);
 
@@ -610,6 +612,8 @@ void BFMDemodGUI::rdsUpdateFixedFields()
 
 void BFMDemodGUI::rdsUpdate(bool force)
 {
+	QMutexLocker parserLocker(m_bfmDemod->getRDSParserMutex());
+
 	// Quality metrics
 	ui->demodQText->setText(QString("%1 %").arg(m_bfmDemod->getDemodQua(), 0, 'f', 0));
 	ui->decoderQText->setText(QString("%1 %").arg(m_bfmDemod->getDecoderQua(), 0, 'f', 0));
@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "rdsparser.h"
+#include "bfmdemodrdsworker.h"
+
+const int BFMDemodRDSWorker::m_rdsSampleRate = 250000;
+
+BFMDemodRDSWorker::BFMDemodRDSWorker(RDSParser& rdsParser) :
+    m_parserMutex(QMutex::Recursive),
+    m_running(false),
+    m_channelSampleRate(48000),
+    m_channelSampleRateChanged(false),
+    m_maxBacklog(48000),
+    m_droppedSamples(0),
+    m_interpolatorRDSDistance(0.0f),
+    m_interpolatorRDSDistanceRemain(0.0f),
+    m_rdsParser(rdsParser),
+    m_decoderQua(0.0f),
+    m_decoderSynced(false),
+    m_demodAcc(0.0f),
+    m_demodQua(0.0f),
+    m_demodFclk(0.0f)
+{
+    applyChannelSampleRate();
+}
+
+BFMDemodRDSWorker::~BFMDemodRDSWorker()
+{
+    stopWork();
+}
+
+void BFMDemodRDSWorker::startWork()
+{
+    if (m_running) {
+        return;
+    }
+
+    m_running = true;
+    start();
+}
+
+void BFMDemodRDSWorker::stopWork()
+{
+    if (!m_running) {
+        return;
+    }
+
+    m_mutex.lock();
+    m_running = false;
+    m_dataReady.wakeAll();
+    m_mutex.unlock();
+    wait();
+}
+
+void BFMDemodRDSWorker::setChannelSampleRate(int channelSampleRate)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_channelSampleRate = channelSampleRate;
+    m_channelSampleRateChanged = true;
+    m_maxBacklog = channelSampleRate; // 1s
+    m_inputBuffer.clear();
+}
+
+void BFMDemodRDSWorker::feed(const Real *samples, int nbSamples)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_inputBuffer.size() + nbSamples > m_maxBacklog)
+    {
+        if (m_droppedSamples == 0) {
+            qDebug("BFMDemodRDSWorker::feed: RDS thread does not keep up: dropping samples");
+        }
+
+        m_droppedSamples += nbSamples;
+        return;
+    }
+
+    m_inputBuffer.insert(m_inputBuffer.end(), samples, samples + nbSamples);
+    m_dataReady.wakeOne();
+}
+
+void BFMDemodRDSWorker::run()
+{
+    qDebug("BFMDemodRDSWorker::run: start");
+    m_mutex.lock();
+
+    while (m_running)
+    {
+        if (m_inputBuffer.size() == 0)
+        {
+            m_dataReady.wait(&m_mutex);
+            continue;
+        }
+
+        if (m_channelSampleRateChanged)
+        {
+            applyChannelSampleRate();
+            m_channelSampleRateChanged = false;
+        }
+
+        m_inputBuffer.swap(m_processBuffer);
+        m_inputBuffer.clear();
+        m_mutex.unlock();
+        process();
+        m_mutex.lock();
+        m_decoderQua = m_rdsDecoder.m_qua;
+        m_decoderSynced = m_rdsDecoder.synced();
+        m_demodAcc = m_rdsDemod.m_report.acc;
+        m_demodQua = m_rdsDemod.m_report.qua;
+        m_demodFclk = m_rdsDemod.m_report.fclk;
+    }
+
+    m_mutex.unlock();
+    qDebug("BFMDemodRDSWorker::run: end");
+}
+
+void BFMDemodRDSWorker::applyChannelSampleRate()
+{
+    m_interpolatorRDS.create(4, m_channelSampleRate, 600.0);
+    m_interpolatorRDSDistanceRemain = (Real) m_channelSampleRate / m_rdsSampleRate;
+    m_interpolatorRDSDistance =  (Real) m_channelSampleRate / m_rdsSampleRate;
+}
+
+void BFMDemodRDSWorker::process()
+{
+    int nbSamples = m_processBuffer.size();
+
+    if (m_workBuffer.size() < (unsigned int) nbSamples) {
+        m_workBuffer.resize(nbSamples);
+    }
+
+    for (int i = 0; i < nbSamples; i++) {
+        m_workBuffer[i] = Complex(m_processBuffer[i], 0.0f);
+    }
+
+    int nbRDS = m_interpolatorRDS.decimate(
+        &m_interpolatorRDSDistanceRemain,
+        m_interpolatorRDSDistance,
+        m_workBuffer.data(),
+        nbSamples,
+        m_rdsBuffer
+    );
+
+    for (int i = 0; i < nbRDS; i++)
+    {
+        bool bit;
+
+        if (m_rdsDemod.process(m_rdsBuffer[i].real(), bit))
+        {
+            if (m_rdsDecoder.frameSync(bit))
+            {
+                QMutexLocker parserLocker(&m_parserMutex);
+                m_rdsParser.parseGroup(m_rdsDecoder.getGroup());
+            }
+        }
+    }
+}
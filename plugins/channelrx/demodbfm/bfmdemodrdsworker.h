@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_BFMDEMODRDSWORKER_H
+#define INCLUDE_BFMDEMODRDSWORKER_H
+
+#include <vector>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "dsp/dsptypes.h"
+#include "dsp/interpolator.h"
+
+#include "rdsdemod.h"
+#include "rdsdecoder.h"
+
+class RDSParser;
+
+/**
+ * RDS stage of the broadcast FM demodulator running in its own thread.
+ * It is fed with blocks of the 57 kHz subcarrier mixed down to baseband at channel sample rate
+ * and does the decimation to the RDS demodulator rate, biphase demodulation, block decoding
+ * and group parsing (including TMC) so that the channel thread only does the FM discriminator
+ * and the audio matrix.
+ */
+class BFMDemodRDSWorker : public QThread
+{
+    Q_OBJECT
+public:
+    BFMDemodRDSWorker(RDSParser& rdsParser);
+    ~BFMDemodRDSWorker();
+
+    void startWork();
+    void stopWork();
+    void setChannelSampleRate(int channelSampleRate); //!< Data still queued is discarded
+    void feed(const Real *samples, int nbSamples);    //!< Queue samples for processing. Drops them if the backlog is too large.
+
+    Real getDecoderQua() const { QMutexLocker mutexLocker(&m_mutex); return m_decoderQua; }
+    bool getDecoderSynced() const { QMutexLocker mutexLocker(&m_mutex); return m_decoderSynced; }
+    Real getDemodAcc() const { QMutexLocker mutexLocker(&m_mutex); return m_demodAcc; }
+    Real getDemodQua() const { QMutexLocker mutexLocker(&m_mutex); return m_demodQua; }
+    Real getDemodFclk() const { QMutexLocker mutexLocker(&m_mutex); return m_demodFclk; }
+    quint64 getDroppedSamples() const { QMutexLocker mutexLocker(&m_mutex); return m_droppedSamples; }
+    QMutex *getRDSParserMutex() { return &m_parserMutex; } //!< Hold it while accessing the RDS parser from another thread
+
+private:
+    mutable QMutex m_mutex;
+    QMutex m_parserMutex; //!< Recursive: GUI slots reading the parser can be triggered from within the RDS update
+    QWaitCondition m_dataReady;
+    volatile bool m_running;
+    std::vector<Real> m_inputBuffer; //!< Filled by the channel thread
+    std::vector<Real> m_processBuffer; //!< Swapped with the input buffer by the RDS thread
+    std::vector<Complex> m_workBuffer; //!< Interpolator input
+    std::vector<Complex> m_rdsBuffer;  //!< Decimated to RDS demodulator rate
+    int m_channelSampleRate;
+    bool m_channelSampleRateChanged;
+    unsigned int m_maxBacklog;
+    quint64 m_droppedSamples;
+
+    Interpolator m_interpolatorRDS;
+    Real m_interpolatorRDSDistance;
+    Real m_interpolatorRDSDistanceRemain;
+    RDSDemod m_rdsDemod;
+    RDSDecoder m_rdsDecoder;
+    RDSParser& m_rdsParser;
+    Real m_decoderQua;   //!< Snapshots of the demodulator and decoder state published under m_mutex
+    bool m_decoderSynced;
+    Real m_demodAcc;
+    Real m_demodQua;
+    Real m_demodFclk;
+
+    void run();
+    void applyChannelSampleRate();
+    void process();
+
+    static const int m_rdsSampleRate;
+};
+
+#endif // INCLUDE_BFMDEMODRDSWORKER_H
@@ -18,6 +18,7 @@
 #include "boost/format.hpp"
 #include <stdio.h>
 #include <complex.h>
+#include <algorithm>
 
 #include <QTime>
 #include <QDebug>
@@ -42,6 +43,7 @@ BFMDemodSink::BFMDemodSink() :
     m_audioBufferFill(0),
     m_audioFifo(48000),
     m_pilotPLL(19000/384000, 50/384000, 0.01),
+    m_rdsWorker(m_rdsParser),
     m_deemphasisFilterX(default_deemphasis * 48000 * 1.0e-6),
     m_deemphasisFilterY(default_deemphasis * 48000 * 1.0e-6),
 	m_fmExcursion(default_excursion)
@@ -57,14 +59,12 @@ BFMDemodSink::BFMDemodSink() :
     m_interpolatorDistance = 0.0f;
     m_interpolatorDistanceRemain = 0.0f;
 
-    m_interpolatorRDSDistance = 0.0f;
-    m_interpolatorRDSDistanceRemain = 0.0f;
-
     m_interpolatorStereoDistance = 0.0f;
     m_interpolatorStereoDistanceRemain = 0.0f;
 
     m_spectrumSink = nullptr;
     m_m1Arg = 0;
+    std::fill(m_pilotPLLSamples, m_pilotPLLSamples + 4, 0.0f);
 
     m_rfFilter = new fftfilt(-50000.0 / 384000.0, 50000.0 / 384000.0, filtFftLen);
 
@@ -81,52 +81,89 @@ BFMDemodSink::BFMDemodSink() :
 
 BFMDemodSink::~BFMDemodSink()
 {
+    m_rdsWorker.stopWork();
     delete m_rfFilter;
 }
 
 void BFMDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-	Complex ci, cs, cr;
+	m_sampleBuffer.clear();
+
+	int nbDemod = discriminate(begin, end);
+
+	if (m_settings.m_audioStereo || m_settings.m_rdsActive) {
+		processPilot(nbDemod);
+	}
+
+	if (m_settings.m_rdsActive) {
+		m_rdsWorker.feed(m_rdsBuffer.data(), nbDemod);
+	}
+
+	processAudio(nbDemod);
+
+	if (m_audioBufferFill > 0)
+	{
+		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+
+		if (res != m_audioBufferFill) {
+			qDebug("BFMDemodSink::feed: %u/%u tail samples written", res, m_audioBufferFill);
+		}
+
+		m_audioBufferFill = 0;
+	}
+
+	if (m_spectrumSink) {
+		m_spectrumSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), true);
+	}
+
+	m_sampleBuffer.clear();
+}
+
+int BFMDemodSink::discriminate(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
 	fftfilt::cmplx *rf;
 	int rf_out;
 	double msq;
 	Real demod;
+	int nbIn = end - begin;
 
-	m_sampleBuffer.clear();
+	if (m_rfBuffer.size() < (unsigned int) nbIn) {
+		m_rfBuffer.resize(nbIn);
+	}
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
-	{
-		Complex c(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
-		c *= m_nco.nextIQ();
+	m_nco.nextIQMul(&(*begin), m_rfBuffer.data(), nbIn);
+	m_demodBuffer.clear();
 
-		rf_out = m_rfFilter->runFilt(c, &rf); // filter RF before demod
+	for (int i = 0; i < nbIn; i++)
+	{
+		rf_out = m_rfFilter->runFilt(m_rfBuffer[i] / SDR_RX_SCALEF, &rf); // filter RF before demod
 
-		for (int i =0 ; i  <rf_out; i++)
+		for (int j = 0; j < rf_out; j++)
 		{
-			msq = rf[i].real()*rf[i].real() + rf[i].imag()*rf[i].imag();
-            m_magsqSum += msq;
+			msq = rf[j].real()*rf[j].real() + rf[j].imag()*rf[j].imag();
+			m_magsqSum += msq;
 
-            if (msq > m_magsqPeak) {
-                m_magsqPeak = msq;
-            }
+			if (msq > m_magsqPeak) {
+				m_magsqPeak = msq;
+			}
 
-            m_magsqCount++;
+			m_magsqCount++;
 
 			if (msq >= m_squelchLevel)
 			{
-			    if (m_squelchState < m_settings.m_rfBandwidth / 10) { // twice attack and decay rate
-			        m_squelchState++;
-			    }
+				if (m_squelchState < m_settings.m_rfBandwidth / 10) { // twice attack and decay rate
+					m_squelchState++;
+				}
 			}
 			else
 			{
-			    if (m_squelchState > 0) {
-			        m_squelchState--;
-			    }
+				if (m_squelchState > 0) {
+					m_squelchState--;
+				}
 			}
 
 			if (m_squelchState > m_settings.m_rfBandwidth / 20) { // squelch open
-				demod = m_phaseDiscri.phaseDiscriminator(rf[i]);
+				demod = m_phaseDiscri.phaseDiscriminator(rf[j]);
 			} else {
 				demod = 0;
 			}
@@ -135,116 +172,101 @@ void BFMDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
 				m_sampleBuffer.push_back(Sample(demod * SDR_RX_SCALEF, 0.0));
 			}
 
-			if (m_settings.m_rdsActive)
-			{
-				//Complex r(demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]), 0.0);
-				Complex r(demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]), 0.0);
-
-				if (m_interpolatorRDS.decimate(&m_interpolatorRDSDistanceRemain, r, &cr))
-				{
-					bool bit;
-
-					if (m_rdsDemod.process(cr.real(), bit))
-					{
-						if (m_rdsDecoder.frameSync(bit)) {
-						    m_rdsParser.parseGroup(m_rdsDecoder.getGroup());
-						}
-					}
+			m_demodBuffer.push_back(demod);
+		}
+	}
 
-					m_interpolatorRDSDistanceRemain += m_interpolatorRDSDistance;
-				}
-			}
+	return m_demodBuffer.size();
+}
 
-			Real sampleStereo = 0.0f;
+void BFMDemodSink::processPilot(int nbDemod)
+{
+	if (m_settings.m_rdsActive && (m_rdsBuffer.size() < (unsigned int) nbDemod)) {
+		m_rdsBuffer.resize(nbDemod);
+	}
 
-			// Process stereo if stereo mode is selected
+	if (m_settings.m_audioStereo && (m_stereoBuffer.size() < (unsigned int) nbDemod)) {
+		m_stereoBuffer.resize(nbDemod);
+	}
 
-			if (m_settings.m_audioStereo)
-			{
-				m_pilotPLL.process(demod, m_pilotPLLSamples);
+	for (int i = 0; i < nbDemod; i++)
+	{
+		Real demod = m_demodBuffer[i];
 
-				if (m_settings.m_showPilot) {
-					m_sampleBuffer.push_back(Sample(m_pilotPLLSamples[1] * SDR_RX_SCALEF, 0.0)); // debug 38 kHz pilot
-				}
+		if (m_settings.m_rdsActive) {
+			m_rdsBuffer[i] = demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]);
+		}
 
-				if (m_settings.m_lsbStereo)
-				{
-					// 1.17 * 0.7 = 0.819
-					Complex s(demod * m_pilotPLLSamples[1], demod * m_pilotPLLSamples[2]);
+		m_pilotPLL.process(demod, m_pilotPLLSamples);
 
-					if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
-					{
-						sampleStereo = cs.real() + cs.imag();
-						m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
-					}
-				}
-				else
-				{
-					Complex s(demod * 1.17 * m_pilotPLLSamples[1], 0);
-
-					if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
-					{
-						sampleStereo = cs.real();
-						m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
-					}
-				}
-			}
+		if (!m_settings.m_audioStereo) {
+			continue;
+		}
 
-			Complex e(demod, 0);
+		if (m_settings.m_showPilot) {
+			m_sampleBuffer.push_back(Sample(m_pilotPLLSamples[1] * SDR_RX_SCALEF, 0.0)); // debug 38 kHz pilot
+		}
 
-			if (m_interpolator.decimate(&m_interpolatorDistanceRemain, e, &ci))
-			{
-				if (m_settings.m_audioStereo)
-				{
-					Real deemph_l, deemph_r; // Pre-emphasis is applied on each channel before multiplexing
-					m_deemphasisFilterX.process(ci.real() + sampleStereo, deemph_l);
-					m_deemphasisFilterY.process(ci.real() - sampleStereo, deemph_r);
-                    m_audioBuffer[m_audioBufferFill].l = (qint16)(deemph_l * (1<<12) * m_settings.m_volume);
-                    m_audioBuffer[m_audioBufferFill].r = (qint16)(deemph_r * (1<<12) * m_settings.m_volume);
-				}
-				else
-				{
-					Real deemph;
-					m_deemphasisFilterX.process(ci.real(), deemph);
-					quint16 sample = (qint16)(deemph * (1<<12) * m_settings.m_volume);
-					m_audioBuffer[m_audioBufferFill].l = sample;
-					m_audioBuffer[m_audioBufferFill].r = sample;
-				}
+		if (m_settings.m_lsbStereo) {
+			m_stereoBuffer[i] = Complex(demod * m_pilotPLLSamples[1], demod * m_pilotPLLSamples[2]); // 1.17 * 0.7 = 0.819
+		} else {
+			m_stereoBuffer[i] = Complex(demod * 1.17 * m_pilotPLLSamples[1], 0);
+		}
+	}
+}
 
-				++m_audioBufferFill;
+void BFMDemodSink::processAudio(int nbDemod)
+{
+	int nbStereo = 0;
 
-				if (m_audioBufferFill >= m_audioBuffer.size())
-				{
-					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+	if (m_monoBuffer.size() < (unsigned int) nbDemod) {
+		m_monoBuffer.resize(nbDemod);
+	}
 
-					if(res != m_audioBufferFill) {
-						qDebug("BFMDemodSink::feed: %u/%u audio samples written", res, m_audioBufferFill);
-					}
+	for (int i = 0; i < nbDemod; i++) {
+		m_monoBuffer[i] = Complex(m_demodBuffer[i], 0);
+	}
 
-					m_audioBufferFill = 0;
-				}
+	int nbMono = m_interpolator.decimate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_monoBuffer.data(), nbDemod, m_monoOut);
 
-				m_interpolatorDistanceRemain += m_interpolatorDistance;
-			}
-		}
+	if (m_settings.m_audioStereo) {
+		nbStereo = m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, m_interpolatorStereoDistance, m_stereoBuffer.data(), nbDemod, m_stereoOut);
 	}
 
-	if (m_audioBufferFill > 0)
+	for (int i = 0; i < nbMono; i++)
 	{
-		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
-
-		if (res != m_audioBufferFill) {
-			qDebug("BFMDemodSink::feed: %u/%u tail samples written", res, m_audioBufferFill);
+		if (m_settings.m_audioStereo)
+		{
+			// imaginary part is null for USB stereo
+			Real sampleStereo = i < nbStereo ? m_stereoOut[i].real() + m_stereoOut[i].imag() : 0.0f;
+			Real deemph_l, deemph_r; // Pre-emphasis is applied on each channel before multiplexing
+			m_deemphasisFilterX.process(m_monoOut[i].real() + sampleStereo, deemph_l);
+			m_deemphasisFilterY.process(m_monoOut[i].real() - sampleStereo, deemph_r);
+			m_audioBuffer[m_audioBufferFill].l = (qint16)(deemph_l * (1<<12) * m_settings.m_volume);
+			m_audioBuffer[m_audioBufferFill].r = (qint16)(deemph_r * (1<<12) * m_settings.m_volume);
+		}
+		else
+		{
+			Real deemph;
+			m_deemphasisFilterX.process(m_monoOut[i].real(), deemph);
+			quint16 sample = (qint16)(deemph * (1<<12) * m_settings.m_volume);
+			m_audioBuffer[m_audioBufferFill].l = sample;
+			m_audioBuffer[m_audioBufferFill].r = sample;
 		}
 
-		m_audioBufferFill = 0;
-	}
+		++m_audioBufferFill;
 
-	if (m_spectrumSink) {
-		m_spectrumSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), true);
-	}
+		if (m_audioBufferFill >= m_audioBuffer.size())
+		{
+			uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
-	m_sampleBuffer.clear();
+			if(res != m_audioBufferFill) {
+				qDebug("BFMDemodSink::processAudio: %u/%u audio samples written", res, m_audioBufferFill);
+			}
+
+			m_audioBufferFill = 0;
+		}
+	}
 }
 
 void BFMDemodSink::applyAudioSampleRate(int sampleRate)
@@ -295,9 +317,7 @@ void BFMDemodSink::applyChannelSettings(int channelSampleRate, int channelFreque
         m_interpolatorStereoDistanceRemain = (Real) channelSampleRate / m_audioSampleRate;
         m_interpolatorStereoDistance =  (Real) channelSampleRate / (Real) m_audioSampleRate;
 
-        m_interpolatorRDS.create(4, channelSampleRate, 600.0);
-        m_interpolatorRDSDistanceRemain = (Real) channelSampleRate / 250000.0;
-        m_interpolatorRDSDistance =  (Real) channelSampleRate / 250000.0;
+        m_rdsWorker.setChannelSampleRate(channelSampleRate);
 
         Real lowCut = -(m_settings.m_rfBandwidth / 2.0) / channelSampleRate;
         Real hiCut  = (m_settings.m_rfBandwidth / 2.0) / channelSampleRate;
@@ -326,8 +346,20 @@ void BFMDemodSink::applySettings(const BFMDemodSettings& settings, bool force)
             << " m_useReverseAPI: " << settings.m_useReverseAPI
             << " force: " << force;
 
-    if ((settings.m_audioStereo && (settings.m_audioStereo != m_settings.m_audioStereo)) || force) {
+    if ((settings.m_audioStereo && (settings.m_audioStereo != m_settings.m_audioStereo)) || force)
+    {
         m_pilotPLL.configure(19000.0/m_channelSampleRate, 50.0/m_channelSampleRate, 0.01);
+        // stereo subcarrier samples are matched by index with mono samples
+        m_interpolatorStereoDistanceRemain = m_interpolatorDistanceRemain;
+    }
+
+    if ((settings.m_rdsActive != m_settings.m_rdsActive) || force)
+    {
+        if (settings.m_rdsActive) {
+            m_rdsWorker.startWork();
+        } else {
+            m_rdsWorker.stopWork();
+        }
     }
 
     if ((settings.m_afBandwidth != m_settings.m_afBandwidth) || force)
@@ -340,10 +372,6 @@ void BFMDemodSink::applySettings(const BFMDemodSettings& settings, bool force)
         m_interpolatorStereoDistanceRemain = (Real) m_channelSampleRate / m_audioSampleRate;
         m_interpolatorStereoDistance =  (Real) m_channelSampleRate / (Real) m_audioSampleRate;
 
-        m_interpolatorRDS.create(4, m_channelSampleRate, 600.0);
-        m_interpolatorRDSDistanceRemain = (Real) m_channelSampleRate / 250000.0;
-        m_interpolatorRDSDistance =  (Real) m_channelSampleRate / 250000.0;
-
         m_lowpass.create(21, m_audioSampleRate, settings.m_afBandwidth);
     }
 
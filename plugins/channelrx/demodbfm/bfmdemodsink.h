@@ -34,6 +34,7 @@
 #include "rdsparser.h"
 #include "rdsdecoder.h"
 #include "rdsdemod.h"
+#include "bfmdemodrdsworker.h"
 #include "bfmdemodsettings.h"
 
 class BasebandSampleSink;
@@ -52,11 +53,11 @@ public:
 	bool getPilotLock() const { return m_pilotPLL.locked(); }
 	Real getPilotLevel() const { return m_pilotPLL.get_pilot_level(); }
 
-	Real getDecoderQua() const { return m_rdsDecoder.m_qua; }
-	bool getDecoderSynced() const { return m_rdsDecoder.synced(); }
-	Real getDemodAcc() const { return m_rdsDemod.m_report.acc; }
-	Real getDemodQua() const { return m_rdsDemod.m_report.qua; }
-	Real getDemodFclk() const { return m_rdsDemod.m_report.fclk; }
+	Real getDecoderQua() const { return m_rdsWorker.getDecoderQua(); }
+	bool getDecoderSynced() const { return m_rdsWorker.getDecoderSynced(); }
+	Real getDemodAcc() const { return m_rdsWorker.getDemodAcc(); }
+	Real getDemodQua() const { return m_rdsWorker.getDemodQua(); }
+	Real getDemodFclk() const { return m_rdsWorker.getDemodFclk(); }
     int getSquelchState() const { return m_squelchState; }
 
     void getMagSqLevels(double& avg, double& peak, int& nbSamples)
@@ -78,6 +79,7 @@ public:
     }
 
     RDSParser& getRDSParser() { return m_rdsParser; }
+    QMutex *getRDSParserMutex() { return m_rdsWorker.getRDSParserMutex(); }
 
     void applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force = false);
     void applySettings(const BFMDemodSettings& settings, bool force = false);
@@ -121,9 +123,13 @@ private:
 	Real m_interpolatorStereoDistance;
 	Real m_interpolatorStereoDistanceRemain;
 
-	Interpolator m_interpolatorRDS; //!< Twin Interpolator for stereo subcarrier
-	Real m_interpolatorRDSDistance;
-	Real m_interpolatorRDSDistanceRemain;
+	std::vector<Complex> m_rfBuffer;     //!< Frequency shifted channel samples
+	std::vector<Real> m_demodBuffer;     //!< FM discriminator output
+	std::vector<Complex> m_monoBuffer;   //!< Mono (L+R) interpolator input
+	std::vector<Complex> m_monoOut;
+	std::vector<Complex> m_stereoBuffer; //!< Stereo subcarrier (L-R) interpolator input
+	std::vector<Complex> m_stereoOut;
+	std::vector<Real> m_rdsBuffer;       //!< RDS subcarrier shifted to baseband fed to the RDS thread
 
 	Lowpass<Real> m_lowpass;
 	fftfilt* m_rfFilter;
@@ -143,9 +149,8 @@ private:
 	RDSPhaseLock m_pilotPLL;
 	Real m_pilotPLLSamples[4];
 
-	RDSDemod m_rdsDemod;
-	RDSDecoder m_rdsDecoder;
 	RDSParser m_rdsParser;
+	BFMDemodRDSWorker m_rdsWorker; //!< RDS demodulation, decoding and parsing stage
 
 	LowPassFilterRC m_deemphasisFilterX;
 	LowPassFilterRC m_deemphasisFilterY;
@@ -157,6 +162,10 @@ private:
 	PhaseDiscriminators m_phaseDiscri;
 
     BasebandSampleSink *m_spectrumSink;
+
+    int discriminate(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end); //!< Returns number of demodulated samples
+    void processPilot(int nbDemod); //!< Pilot PLL and subcarriers
+    void processAudio(int nbDemod); //!< Stereo matrix, de-emphasis and audio output
 };
 
 #endif // INCLUDE_BFMDEMODSINK_H
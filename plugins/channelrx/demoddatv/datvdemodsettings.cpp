@@ -58,6 +58,9 @@ void DATVDemodSettings::resetToDefaults()
     m_udpTSAddress = "127.0.0.1";
     m_udpTSPort = 8882;
     m_udpTS = false;
+    m_ldpcThreads = 2;
+    m_ldpcMaxIterations = 25;
+    m_pipelinedDecoding = false;
 }
 
 QByteArray DATVDemodSettings::serialize() const
@@ -91,6 +94,9 @@ QByteArray DATVDemodSettings::serialize() const
     s.writeString(23, m_udpTSAddress);
     s.writeU32(24, m_udpTSPort);
     s.writeBool(25, m_udpTS);
+    s.writeS32(26, m_ldpcThreads);
+    s.writeS32(27, m_ldpcMaxIterations);
+    s.writeBool(28, m_pipelinedDecoding);
 
     return s.final();
 }
@@ -157,6 +163,11 @@ bool DATVDemodSettings::deserialize(const QByteArray& data)
         d.readU32(24, &utmp, 8882);
         m_udpTSPort = utmp < 1024 ? 1024 : utmp > 65536 ? 65535 : utmp;
         d.readBool(25, &m_udpTS, false);
+        d.readS32(26, &tmp, 2);
+        m_ldpcThreads = tmp < 1 ? 1 : tmp > 32 ? 32 : tmp;
+        d.readS32(27, &tmp, 25);
+        m_ldpcMaxIterations = tmp < 0 ? 0 : tmp > 100 ? 100 : tmp;
+        d.readBool(28, &m_pipelinedDecoding, false);
 
         validateSystemConfiguration();
 
@@ -190,7 +201,10 @@ void DATVDemodSettings::debug(const QString& msg) const
         << " m_audioMute: " << m_audioMute
         << " m_audioDeviceName: " << m_audioDeviceName
         << " m_audioVolume: " << m_audioVolume
-        << " m_videoMute: " << m_videoMute;
+        << " m_videoMute: " << m_videoMute
+        << " m_ldpcThreads: " << m_ldpcThreads
+        << " m_ldpcMaxIterations: " << m_ldpcMaxIterations
+        << " m_pipelinedDecoding: " << m_pipelinedDecoding;
 }
 
 bool DATVDemodSettings::isDifferent(const DATVDemodSettings& other)
@@ -207,6 +221,9 @@ bool DATVDemodSettings::isDifferent(const DATVDemodSettings& other)
         || (m_notchFilters != other.m_notchFilters)
         || (m_symbolRate != other.m_symbolRate)
         || (m_excursion != other.m_excursion)
+        || (m_ldpcThreads != other.m_ldpcThreads)
+        || (m_ldpcMaxIterations != other.m_ldpcMaxIterations)
+        || (m_pipelinedDecoding != other.m_pipelinedDecoding)
         || (m_standard != other.m_standard));
 }
 
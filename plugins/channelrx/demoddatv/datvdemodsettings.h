@@ -96,6 +96,9 @@ struct DATVDemodSettings
     QString m_udpTSAddress;
     quint32 m_udpTSPort;
     bool m_udpTS;
+    int m_ldpcThreads;       //!< DVB-S2 LDPC decoder worker threads
+    int m_ldpcMaxIterations; //!< DVB-S2 LDPC decoder iterations (0: no LDPC, hard decisions to BCH)
+    bool m_pipelinedDecoding; //!< Run FEC decoding stages in their own thread in parallel with demodulation
 
     DATVDemodSettings();
     void resetToDefaults();
@@ -376,7 +376,7 @@ void DATVDemodSink::CleanUpDATVFramework(bool blnRelease)
 
         if(p_fecframes != nullptr)
         {
-            delete (leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> >*) p_fecframes;
+            delete (leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> >*) p_fecframes;
         }
 
         if(p_bbframes != nullptr)
@@ -386,12 +386,12 @@ void DATVDemodSink::CleanUpDATVFramework(bool blnRelease)
 
         if(p_s2_deinterleaver != nullptr)
         {
-            delete (leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::hard_sb>*) p_s2_deinterleaver;
+            delete (leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::llr_sb>*) p_s2_deinterleaver;
         }
 
         if(r_fecdec != nullptr)
         {
-            delete (leansdr::s2_fecdec<bool, leansdr::hard_sb>*) r_fecdec;
+            delete (leansdr::s2_fecdec_mt*) r_fecdec;
         }
 
         if(p_deframer != nullptr)
@@ -612,7 +612,8 @@ void DATVDemodSink::InitDATVFramework()
 
     m_lngExpectedReadIQ  = BUF_BASEBAND;
 
-    m_objScheduler = new leansdr::scheduler();
+    // With pipelined decoding the FEC stages run in a worker thread
+    m_objScheduler = new leansdr::scheduler(m_settings.m_pipelinedDecoding ? 1 : 0);
 
     //***************
     p_rawiq = new leansdr::pipebuf<leansdr::cf32>(m_objScheduler, "rawiq", BUF_BASEBAND);
@@ -833,6 +834,25 @@ void DATVDemodSink::InitDATVFramework()
     // OUTPUT
     r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(m_objScheduler, *p_tspackets, m_objVideoStream, &m_udpStream);
 
+    // PIPELINING
+    // Demodulation, scopes and video output stay in the DSP thread.
+    // mpeg_sync drives the deconvolver so they share the same thread.
+
+    if (m_objScheduler->threaded())
+    {
+        if (r) {
+            m_objScheduler->pin(r, 1);
+        }
+        if (r_deconv) {
+            m_objScheduler->pin(r_deconv, 1);
+        }
+
+        m_objScheduler->pin(r_sync_mpeg, 1);
+        m_objScheduler->pin(r_deinter, 1);
+        m_objScheduler->pin(r_rsdec, 1);
+        m_objScheduler->pin(r_derand, 1);
+    }
+
     m_blnDVBInitialized = true;
 }
 
@@ -937,7 +957,8 @@ void DATVDemodSink::InitDATVS2Framework()
 
     m_lngExpectedReadIQ  = BUF_BASEBAND;
 
-    m_objScheduler = new leansdr::scheduler();
+    // With pipelined decoding the FEC stages run in a worker thread
+    m_objScheduler = new leansdr::scheduler(m_settings.m_pipelinedDecoding ? 1 : 0);
 
     //***************
     p_rawiq = new leansdr::pipebuf<leansdr::cf32>(m_objScheduler, "rawiq", BUF_BASEBAND);
@@ -1071,37 +1092,32 @@ void DATVDemodSink::InitDATVS2Framework()
         r_scope_symbols_dvbs2->calculate_cstln_points();
     }
 
-    // Bit-flipping mode.
-    // Deinterleave into hard bits.
+    // Soft decision mode.
+    // Deinterleave into soft bits and decode LDPC in a pool of worker threads.
 
     p_bbframes = new leansdr::pipebuf<leansdr::bbframe>(m_objScheduler, "BB frames", BUF_FRAMES);
 
-    p_fecframes = new leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> >(m_objScheduler, "FEC frames", BUF_FRAMES);
+    p_fecframes = new leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> >(m_objScheduler, "FEC frames", BUF_FRAMES);
 
-    p_s2_deinterleaver = new leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::hard_sb>(
+    p_s2_deinterleaver = new leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::llr_sb>(
         m_objScheduler,
         *(leansdr::pipebuf< leansdr::plslot<leansdr::llr_ss> > *) p_slots_dvbs2,
-        *(leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> > * ) p_fecframes
+        *(leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> > * ) p_fecframes
     );
 
     p_vbitcount= new leansdr::pipebuf<int>(m_objScheduler, "Bits processed", BUF_S2PACKETS);
     p_verrcount = new leansdr::pipebuf<int>(m_objScheduler, "Bits corrected", BUF_S2PACKETS);
 
-    r_fecdec =  new leansdr::s2_fecdec<bool, leansdr::hard_sb>(
-        m_objScheduler, *(leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> > * ) p_fecframes,
+    r_fecdec =  new leansdr::s2_fecdec_mt(
+        m_objScheduler, *(leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> > * ) p_fecframes,
         *(leansdr::pipebuf<leansdr::bbframe> *) p_bbframes,
+        m_settings.m_ldpcThreads,
         p_vbitcount,
         p_verrcount
     );
-    leansdr::s2_fecdec<bool, leansdr::hard_sb> *fecdec = (leansdr::s2_fecdec<bool, leansdr::hard_sb> * ) r_fecdec;
+    leansdr::s2_fecdec_mt *fecdec = (leansdr::s2_fecdec_mt * ) r_fecdec;
 
-    fecdec->bitflips=0;
-
-    /*
-    fecdec->bitflips = cfg.ldpc_bf; //int TODO
-    if ( ! cfg.ldpc_bf )
-    fprintf(stderr, "Warning: No LDPC error correction selected.\n")
-    */
+    fecdec->max_iterations = m_settings.m_ldpcMaxIterations;
 
     // Deframe BB frames to TS packets
     p_lock = new leansdr::pipebuf<int> (m_objScheduler, "lock", BUF_SLOW);
@@ -1118,6 +1134,16 @@ void DATVDemodSink::InitDATVS2Framework()
     // OUTPUT
     r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(m_objScheduler, *p_tspackets, m_objVideoStream, &m_udpStream);
 
+    // PIPELINING
+    // Frame reception, scopes and video output stay in the DSP thread.
+
+    if (m_objScheduler->threaded())
+    {
+        m_objScheduler->pin((leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::llr_sb> *) p_s2_deinterleaver, 1);
+        m_objScheduler->pin((leansdr::s2_fecdec_mt *) r_fecdec, 1);
+        m_objScheduler->pin((leansdr::s2_deframer *) p_deframer, 1);
+    }
+
     m_blnDVBInitialized = true;
 }
 
@@ -1207,8 +1233,12 @@ void DATVDemodSink::feed(const SampleVector::const_iterator& begin, const Sample
                && (p_rawiq_writer!=nullptr)
                && (m_objScheduler!=nullptr))
             {
-                p_rawiq_writer->write(objIQ);
-                m_lngReadIQ++;
+                // Drop samples rather than overflow when decoding lags behind
+                if (p_rawiq_writer->writable() > 0)
+                {
+                    p_rawiq_writer->write(objIQ);
+                    m_lngReadIQ++;
+                }
 
                 lngWritable = p_rawiq_writer->writable();
 
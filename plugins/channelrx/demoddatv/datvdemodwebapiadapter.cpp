@@ -61,8 +61,11 @@ void DATVDemodWebAPIAdapter::webapiFormatChannelSettings(
     response.getDatvDemodSettings()->setFec((int) settings.m_fec);
     response.getDatvDemodSettings()->setFilter((int) settings.m_filter);
     response.getDatvDemodSettings()->setHardMetric(settings.m_hardMetric ? 1 : 0);
+    response.getDatvDemodSettings()->setLdpcMaxIterations(settings.m_ldpcMaxIterations);
+    response.getDatvDemodSettings()->setLdpcThreads(settings.m_ldpcThreads);
     response.getDatvDemodSettings()->setModulation((int) settings.m_modulation);
     response.getDatvDemodSettings()->setNotchFilters(settings.m_notchFilters);
+    response.getDatvDemodSettings()->setPipelinedDecoding(settings.m_pipelinedDecoding ? 1 : 0);
     response.getDatvDemodSettings()->setRfBandwidth(settings.m_rfBandwidth);
     response.getDatvDemodSettings()->setRgbColor(settings.m_rgbColor);
     response.getDatvDemodSettings()->setRollOff(settings.m_rollOff);
@@ -111,12 +114,25 @@ void DATVDemodWebAPIAdapter::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("hardMetric")) {
         settings.m_hardMetric = response.getDatvDemodSettings()->getHardMetric() != 0;
     }
+    if (channelSettingsKeys.contains("ldpcMaxIterations"))
+    {
+        int ldpcMaxIterations = response.getDatvDemodSettings()->getLdpcMaxIterations();
+        settings.m_ldpcMaxIterations = ldpcMaxIterations < 0 ? 0 : ldpcMaxIterations > 100 ? 100 : ldpcMaxIterations; // same limits as deserialize
+    }
+    if (channelSettingsKeys.contains("ldpcThreads"))
+    {
+        int ldpcThreads = response.getDatvDemodSettings()->getLdpcThreads();
+        settings.m_ldpcThreads = ldpcThreads < 1 ? 1 : ldpcThreads > 32 ? 32 : ldpcThreads;
+    }
     if (channelSettingsKeys.contains("modulation")) {
         settings.m_modulation = (DATVDemodSettings::DATVModulation) response.getDatvDemodSettings()->getModulation();
     }
     if (channelSettingsKeys.contains("notchFilters")) {
         settings.m_notchFilters = response.getDatvDemodSettings()->getNotchFilters();
     }
+    if (channelSettingsKeys.contains("pipelinedDecoding")) {
+        settings.m_pipelinedDecoding = response.getDatvDemodSettings()->getPipelinedDecoding() != 0;
+    }
     if (channelSettingsKeys.contains("rfBandwidth")) {
         settings.m_rfBandwidth = response.getDatvDemodSettings()->getRfBandwidth();
     }
@@ -17,6 +17,12 @@
 #ifndef LEANSDR_DVBS2_H
 #define LEANSDR_DVBS2_H
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 /*
 #include "leansdr/bch.h"
 #include "leansdr/crc.h"
@@ -33,6 +39,7 @@
 #include "dvb.h"
 #include "softword.h"
 #include "ldpc.h"
+#include "ldpc_minsum.h"
 #include "sdr.h"
 
 namespace leansdr
@@ -2174,6 +2181,337 @@ struct s2_fecdec : runnable
     pipewriter<int> *bitcount, *errcount;
 }; // s2_fecdec
 
+// S2 MULTI-THREADED SOFT FEC DECODER AND BASEBAND DESCRAMBLER
+// Layered min-sum LDPC (see ldpc_minsum.h) then BCH and descrambling.
+// Frames are copied out of the input pipe into batches of up to
+// ldpc_minsum_decoder::LANES frames with the same MODCOD and frame size.
+// Batches are decoded in parallel by a pool of worker threads and
+// results are output in the order frames were received.
+// A partial batch is submitted as soon as a worker is idle so latency
+// stays low at low frame rates while batches fill up at high rates.
+
+struct s2_fecdec_mt : runnable
+{
+    int max_iterations; // LDPC iterations. 0 skips LDPC (hard decisions to BCH).
+
+    s2_fecdec_mt(scheduler *sch,
+                 pipebuf<fecframe<llr_sb>> &_in, pipebuf<bbframe> &_out,
+                 int nthreads,
+                 pipebuf<int> *_bitcount = NULL,
+                 pipebuf<int> *_errcount = NULL)
+        : runnable(sch, "S2 fecdec MT"),
+          max_iterations(25),
+          in(_in), out(_out),
+          bitcount(opt_writer(_bitcount, 1)),
+          errcount(opt_writer(_errcount, 1)),
+          filling(nullptr),
+          nidle(0),
+          stopping(false)
+    {
+        memset(graphs, 0, sizeof(graphs));
+        nthreads = nthreads < 1 ? 1 : nthreads;
+
+        // Two batches per worker: one being decoded, one being filled or output
+        for (int i = 0; i < 2 * nthreads; ++i) {
+            free_jobs.push_back(new job);
+        }
+
+        for (int i = 0; i < nthreads; ++i)
+        {
+            workers.push_back(new worker);
+            workers.back()->thread = std::thread(&s2_fecdec_mt::work, this, workers.back());
+        }
+    }
+
+    ~s2_fecdec_mt()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+
+        cv_work.notify_all();
+
+        for (std::vector<worker*>::iterator it = workers.begin(); it != workers.end(); ++it)
+        {
+            (*it)->thread.join();
+            delete *it;
+        }
+
+        for (std::vector<job*>::iterator it = free_jobs.begin(); it != free_jobs.end(); ++it) {
+            delete *it;
+        }
+
+        for (std::deque<job*>::iterator it = inflight.begin(); it != inflight.end(); ++it) {
+            delete *it;
+        }
+
+        delete filling;
+
+        for (int sf = 0; sf <= 1; ++sf)
+        {
+            for (int fec = 0; fec < FEC_COUNT; ++fec) {
+                delete graphs[sf][fec];
+            }
+        }
+    }
+
+    void run()
+    {
+        output_jobs();
+
+        while (in.readable() >= 1)
+        {
+            fecframe<llr_sb> *pin = in.rd();
+            const modcod_info *mcinfo = check_modcod(pin->pls.modcod);
+            int sf = pin->pls.sf ? 1 : 0;
+
+            if (filling && ((filling->nframes == LANES) || (filling->sf != sf) || (filling->fec != mcinfo->rate))) {
+                submit_job();
+            }
+
+            if (!filling)
+            {
+                if (free_jobs.empty()) {
+                    break; // All batches busy: leave frames in the pipe
+                }
+
+                filling = free_jobs.back();
+                free_jobs.pop_back();
+                filling->sf = sf;
+                filling->fec = mcinfo->rate;
+                filling->nframes = 0;
+                filling->noutput = 0;
+                filling->done = false;
+            }
+
+            filling->frames[filling->nframes++] = *pin;
+            in.read(1);
+        }
+
+        if (filling && (filling->nframes != 0))
+        {
+            bool idle;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                idle = nidle > (int) pending.size();
+            }
+
+            if (idle) {
+                submit_job();
+            }
+        }
+
+        output_jobs();
+    }
+
+  private:
+    typedef ldpc_minsum_graph<uint16_t> s2_ldpc_graph;
+    typedef ldpc_minsum_decoder<uint16_t> s2_ldpc_decoder;
+    static const int LANES = s2_ldpc_decoder::LANES;
+
+    struct job
+    {
+        int sf;
+        int fec;
+        int nframes;
+        int noutput;                    // Frames already output
+        bool done;                      // Set by worker under mutex
+        fecframe<llr_sb> frames[LANES]; // Soft input
+        bbframe bbframes[LANES];        // Descrambled output
+        int ncorr[LANES];               // Bits corrected, -1 if BCH failed
+    };
+
+    struct worker
+    {
+        std::thread thread;
+        s2_ldpc_decoder decoder;
+        std::vector<int8_t> llrs;
+        uint8_t hard[64800 / 8];
+        s2_bch_engines s2bch; // BCH decoders keep state
+    };
+
+    void submit_job()
+    {
+        inflight.push_back(filling);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(filling);
+        }
+        filling = nullptr;
+        cv_work.notify_one();
+    }
+
+    // Output completed batches in submission order
+    void output_jobs()
+    {
+        while (!inflight.empty())
+        {
+            job *j = inflight.front();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!j->done) {
+                    return;
+                }
+            }
+
+            const fec_info *fi = &fec_infos[j->sf][j->fec];
+
+            for (; j->noutput < j->nframes; ++j->noutput)
+            {
+                int ncorr = j->ncorr[j->noutput];
+
+                if (!opt_writable(bitcount, 1) || !opt_writable(errcount, 1) ||
+                    ((ncorr >= 0) && (out.writable() < 1)))
+                {
+                    return;
+                }
+
+                // Report VER
+                opt_write(bitcount, fi->kldpc);
+                opt_write(errcount, (ncorr >= 0) ? ncorr : fi->kldpc);
+
+                if (ncorr >= 0)
+                {
+                    *out.wr() = j->bbframes[j->noutput];
+                    out.written(1);
+                }
+
+                if (sch->debug)
+                    fprintf(stderr, "%c", (ncorr < 0) ? ':' : ncorr ? '.' : '_');
+            }
+
+            inflight.pop_front();
+            free_jobs.push_back(j);
+        }
+    }
+
+    void work(worker *w)
+    {
+        for (;;)
+        {
+            job *j;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                nidle++;
+                cv_work.wait(lock, [this]{ return stopping || !pending.empty(); });
+                nidle--;
+
+                if (stopping) {
+                    return;
+                }
+
+                j = pending.front();
+                pending.pop_front();
+            }
+
+            decode_job(w, j);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                j->done = true;
+            }
+        }
+    }
+
+    void decode_job(worker *w, job *j)
+    {
+        const fec_info *fi = &fec_infos[j->sf][j->fec];
+        int cwbytes = fi->kldpc / 8;
+        int8_t *llrs = nullptr;
+
+        if (max_iterations > 0)
+        {
+            const s2_ldpc_graph *graph = get_graph(j->sf, j->fec);
+            w->llrs.resize(graph->n * LANES);
+            llrs = w->llrs.data();
+
+            // Interleave frames bit-major. Halve LLRs to leave headroom for
+            // accumulation. Unused lanes hold the all-zero codeword.
+            for (int b = 0; b < graph->n; ++b)
+            {
+                int8_t *p = &llrs[b * LANES];
+
+                for (int lane = 0; lane < LANES; ++lane) {
+                    p[lane] = lane < j->nframes ? softwords_get(j->frames[lane].bytes, b) >> 1 : 63;
+                }
+            }
+
+            w->decoder.decode(*graph, llrs, max_iterations);
+        }
+
+        for (int lane = 0; lane < j->nframes; ++lane)
+        {
+            const llr_sb *soft = j->frames[lane].bytes;
+            int nflips = 0;
+
+            for (int i = 0; i < cwbytes; ++i)
+            {
+                uint8_t byte = softbyte_harden(soft[i]);
+
+                if (llrs)
+                {
+                    const int8_t *p = &llrs[i * 8 * LANES + lane];
+                    uint8_t decoded = 0;
+
+                    for (int bit = 0; bit < 8; ++bit, p += LANES) {
+                        decoded = (decoded << 1) | (*p < 0);
+                    }
+
+                    for (uint8_t x = byte ^ decoded; x; x &= x - 1) {
+                        nflips++;
+                    }
+
+                    byte = decoded;
+                }
+
+                w->hard[i] = byte;
+            }
+
+            // Decode with suitable BCH decoder for this MODCOD
+            bch_interface *bch = w->s2bch.bchs[j->sf][j->fec];
+            int ncorr = bch->decode(w->hard, cwbytes);
+            j->ncorr[lane] = ncorr < 0 ? -1 : nflips + ncorr;
+
+            if (ncorr >= 0)
+            {
+                j->bbframes[lane].pls = j->frames[lane].pls;
+                bbscrambling.transform(w->hard, fi->Kbch / 8, j->bbframes[lane].bytes);
+            }
+        }
+    }
+
+    // Graphs are built on first use and shared read-only by workers
+    const s2_ldpc_graph *get_graph(int sf, int fec)
+    {
+        std::lock_guard<std::mutex> lock(graphs_mutex);
+
+        if (!graphs[sf][fec])
+        {
+            const fec_info *fi = &fec_infos[sf][fec];
+            graphs[sf][fec] = new s2_ldpc_graph(fi->ldpc, fi->kldpc, sf ? 64800 / 4 : 64800);
+        }
+
+        return graphs[sf][fec];
+    }
+
+    pipereader<fecframe<llr_sb>> in;
+    pipewriter<bbframe> out;
+    pipewriter<int> *bitcount, *errcount;
+    s2_bbscrambling bbscrambling; // Read-only after construction
+    std::vector<worker*> workers;
+    std::vector<job*> free_jobs;    // Scheduler thread only
+    std::deque<job*> inflight;      // Scheduler thread only, submission order
+    job *filling;                   // Batch being filled
+    std::deque<job*> pending;       // Waiting for a worker, guarded by mutex
+    int nidle;                      // Idle workers, guarded by mutex
+    bool stopping;                  // Guarded by mutex
+    std::mutex mutex;
+    std::condition_variable cv_work;
+    std::mutex graphs_mutex;
+    s2_ldpc_graph *graphs[2][FEC_COUNT];
+}; // s2_fecdec_mt
+
 // External LDPC decoder
 // Spawns a user-specified command, FEC frames on stdin/stdout.
 
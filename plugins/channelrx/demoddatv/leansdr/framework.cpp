@@ -3,6 +3,8 @@
 namespace leansdr
 {
 
+thread_local unsigned long scheduler::progress = 0;
+
 void fatal(const char *s)
 {
     perror(s);
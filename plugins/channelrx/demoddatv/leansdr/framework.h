@@ -19,6 +19,11 @@
 
 #include <cstddef>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <math.h>
 #include <stdint.h>
@@ -45,6 +50,10 @@ void fail(const char *s);
 // [pipereader] is a client-side hook reading from a [pipebuf].
 // [runnable] is anything that moves data between [pipebufs].
 // [scheduler] is a global context which invokes [runnables] until fixpoint.
+//
+// With a threaded scheduler runnables can be pinned to worker threads.
+// Pipebufs then become lock-free single writer queues so that stages in
+// different threads run in parallel. Unpinned runnables run in step().
 
 static const int MAX_PIPES = 64;
 static const int MAX_RUNNABLES = 64;
@@ -120,15 +129,34 @@ struct scheduler
     window_placement *windows;
     bool verbose, debug, debug2;
 
-    scheduler() : npipes(0),
+    // Threaded mode: nthreads worker threads, 0 for the classic mode
+    // where step() runs every runnable in the calling thread.
+    int nthreads;
+    int threadof[MAX_RUNNABLES]; // 0: thread calling step(), 1..nthreads: workers
+
+    // Items moved by pipereaders and pipewriters of the current thread.
+    // Used by threaded mode to tell whether a pass made progress.
+    static thread_local unsigned long progress;
+
+    scheduler(int _nthreads = 0) : npipes(0),
                   nrunnables(0),
                   windows(NULL),
                   verbose(false),
                   debug(false),
-                  debug2(false)
+                  debug2(false),
+                  nthreads(_nthreads < 0 ? 0 : _nthreads),
+                  wake_gen(0),
+                  stopping(false)
+    {
+    }
+
+    ~scheduler()
     {
+        stop_threads();
     }
 
+    bool threaded() const { return nthreads > 0; }
+
     void add_pipe(pipebuf_common *p)
     {
         if (npipes == MAX_PIPES)
@@ -140,17 +168,49 @@ struct scheduler
     {
         if (nrunnables == MAX_RUNNABLES)
             fail("MAX_RUNNABLES");
+        threadof[nrunnables] = 0;
         runnables[nrunnables++] = r;
     }
 
+    // Run r in worker thread 1..nthreads. Must be done before the first step().
+    // Runnables calling each other's methods must be pinned to the same thread.
+    void pin(runnable_common *r, int thread)
+    {
+        if (thread < 0 || thread > nthreads)
+            fail("pin: no such thread");
+        for (int i = 0; i < nrunnables; ++i)
+            if (runnables[i] == r)
+                threadof[i] = thread;
+    }
+
     void step()
     {
+        if (threaded())
+        {
+            if (workers.empty())
+                start_threads();
+            run_thread(0);
+            wake();
+            return;
+        }
+
         for (int i = 0; i < nrunnables; ++i)
             runnables[i]->run();
     }
 
     void run()
     {
+        if (threaded())
+        {
+            unsigned long before;
+            do
+            {
+                before = progress;
+                step();
+            } while (progress != before);
+            return;
+        }
+
         unsigned long long prev_hash = 0;
 
         while (1)
@@ -165,6 +225,7 @@ struct scheduler
 
     void shutdown()
     {
+        stop_threads();
         for (int i = 0; i < nrunnables; ++i)
             runnables[i]->shutdown();
     }
@@ -186,6 +247,79 @@ struct scheduler
         fprintf(stderr, "Total buffer memory: %ld KiB\n",
                 (unsigned long)total_bufs / 1024);
     }
+
+  private:
+    std::vector<std::thread> workers;
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    unsigned long wake_gen; // Bumped whenever some thread made progress
+    std::atomic<bool> stopping;
+
+    void run_thread(int thread)
+    {
+        for (int i = 0; i < nrunnables; ++i)
+            if (threadof[i] == thread)
+                runnables[i]->run();
+    }
+
+    void wake()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            ++wake_gen;
+        }
+        wake_cv.notify_all();
+    }
+
+    // Workers run their runnables until they stall then sleep until
+    // another thread makes progress.
+    void work(int thread)
+    {
+        unsigned long seen = 0;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                wake_cv.wait(lock, [&]{ return stopping.load() || (wake_gen != seen); });
+                if (stopping.load())
+                    return;
+                seen = wake_gen;
+            }
+
+            unsigned long start = progress, before;
+
+            do
+            {
+                before = progress;
+                run_thread(thread);
+            } while ((progress != before) && !stopping.load(std::memory_order_relaxed));
+
+            if (progress != start)
+                wake();
+        }
+    }
+
+    void start_threads()
+    {
+        stopping = false;
+        for (int t = 1; t <= nthreads; ++t)
+            workers.push_back(std::thread(&scheduler::work, this, t));
+    }
+
+    void stop_threads()
+    {
+        if (workers.empty())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopping = true;
+        }
+        wake_cv.notify_all();
+        for (std::vector<std::thread>::iterator it = workers.begin(); it != workers.end(); ++it)
+            it->join();
+        workers.clear();
+    }
 };
 
 struct runnable : runnable_common
@@ -214,13 +348,23 @@ struct pipebuf : pipebuf_common
     }
 
     pipebuf(scheduler *sch, const char *name, unsigned long size) : pipebuf_common(name),
-                                                                    buf(new T[size]),
+                                                                    buf(new T[sch->threaded() ? 2 * size : size]),
                                                                     nrd(0), wr(buf),
                                                                     end(buf + size),
                                                                     min_write(1),
                                                                     total_written(0),
-                                                                    total_read(0)
+                                                                    total_read(0),
+                                                                    threaded(sch->threaded()),
+                                                                    wstate(0),
+                                                                    wrap_at(0)
     {
+        if (threaded)
+        {
+            // Unread items are copied to [buf-size,buf) on wrap
+            buf += size;
+            wr = buf;
+            end = buf + size;
+        }
         sch->add_pipe(this);
     }
 
@@ -229,6 +373,7 @@ struct pipebuf : pipebuf_common
         if (nrd == MAX_READERS)
             fail("too many readers");
         rds[nrd] = wr;
+        rstates[nrd].store(wstate.load());
         return nrd++;
     }
 
@@ -246,21 +391,29 @@ struct pipebuf : pipebuf_common
 
     long long hash()
     {
-        return total_written + total_read;
+        return total_written.load(std::memory_order_relaxed) + total_read.load(std::memory_order_relaxed);
     }
 
     void dump(std::size_t *total_bufs)
     {
-        if (total_written < 10000)
-            fprintf(stderr, ".%-16s : %4ld/%4ld", name, total_read,
-                    total_written);
-        else if (total_written < 1000000)
-            fprintf(stderr, ".%-16s : %3ldk/%3ldk", name, total_read / 1000,
-                    total_written / 1000);
+        unsigned long nread = total_read.load(std::memory_order_relaxed);
+        unsigned long nwritten = total_written.load(std::memory_order_relaxed);
+
+        if (nwritten < 10000)
+            fprintf(stderr, ".%-16s : %4ld/%4ld", name, nread,
+                    nwritten);
+        else if (nwritten < 1000000)
+            fprintf(stderr, ".%-16s : %3ldk/%3ldk", name, nread / 1000,
+                    nwritten / 1000);
         else
-            fprintf(stderr, ".%-16s : %3ldM/%3ldM", name, total_read / 1000000,
-                    total_written / 1000000);
+            fprintf(stderr, ".%-16s : %3ldM/%3ldM", name, nread / 1000000,
+                    nwritten / 1000000);
         *total_bufs += (end - buf) * sizeof(T);
+        if (threaded)
+        {
+            fprintf(stderr, " threaded\n");
+            return;
+        }
         unsigned long nw = end - wr;
         fprintf(stderr, " %6ld writable %c,", nw, (nw < min_write) ? '!' : ' ');
         T *rd = wr;
@@ -273,7 +426,105 @@ struct pipebuf : pipebuf_common
         fprintf(stderr, " )\n");
     }
     unsigned long min_write;
-    unsigned long total_written, total_read;
+    std::atomic<unsigned long> total_written, total_read;
+
+    // Threaded mode: the writer and each reader may run in different threads.
+    // Their positions are published as lap count and index relative to buf.
+    // When less than min_write items are left at the end the writer copies
+    // the unread items just before buf and starts a new lap at index 0.
+    // Readers still on the previous lap jump into that copy so that rd()
+    // and wr() always address contiguous items, like after pack().
+    bool threaded;
+    std::atomic<uint64_t> wstate;
+    std::atomic<uint64_t> rstates[MAX_READERS];
+    long wrap_at; // Index where the previous lap ended
+
+    static uint64_t mt_state(uint32_t lap, long index)
+    {
+        return ((uint64_t)lap << 32) | (uint32_t)index;
+    }
+
+    static uint32_t mt_lap(uint64_t state)
+    {
+        return state >> 32;
+    }
+
+    static long mt_index(uint64_t state)
+    {
+        return (int32_t)(uint32_t)state;
+    }
+
+    long mt_writable()
+    {
+        uint64_t ws = wstate.load(std::memory_order_relaxed);
+        uint32_t lap = mt_lap(ws);
+        long index = mt_index(ws);
+        long space = (end - buf) - index;
+        long rmin = index;
+        bool canwrap = true;
+
+        for (int i = 0; i < nrd; ++i)
+        {
+            uint64_t rs = rstates[i].load(std::memory_order_acquire);
+            long rindex = mt_index(rs);
+
+            if (mt_lap(rs) != lap)
+            {
+                // Reader still on the previous lap
+                space = std::min(space, rindex - index);
+                canwrap = false;
+            }
+            else
+            {
+                // Reader in the copy of the previous lap prevents a new copy
+                canwrap = canwrap && (rindex >= 0);
+                rmin = std::min(rmin, rindex);
+            }
+        }
+
+        if ((space >= (long)min_write) || !canwrap)
+            return space;
+
+        memcpy(buf - (index - rmin), buf + rmin, (index - rmin) * sizeof(T));
+        wrap_at = index;
+        wstate.store(mt_state(lap + 1, 0), std::memory_order_release);
+
+        return mt_writable();
+    }
+
+    void mt_written(unsigned long n)
+    {
+        uint64_t ws = wstate.load(std::memory_order_relaxed);
+        wstate.store(mt_state(mt_lap(ws), mt_index(ws) + n), std::memory_order_release);
+    }
+
+    // Follow the writer into a new lap. ws must be loaded once by the
+    // caller since the writer may start another lap as soon as we follow.
+    uint64_t mt_follow(int id, uint64_t ws)
+    {
+        uint64_t rs = rstates[id].load(std::memory_order_relaxed);
+
+        if (mt_lap(ws) != mt_lap(rs))
+        {
+            rs = mt_state(mt_lap(ws), mt_index(rs) - wrap_at);
+            rstates[id].store(rs, std::memory_order_release);
+        }
+
+        return rs;
+    }
+
+    long mt_readable(int id)
+    {
+        uint64_t ws = wstate.load(std::memory_order_acquire);
+        return mt_index(ws) - mt_index(mt_follow(id, ws));
+    }
+
+    void mt_read(int id, unsigned long n)
+    {
+        uint64_t rs = rstates[id].load(std::memory_order_relaxed);
+        rstates[id].store(mt_state(mt_lap(rs), mt_index(rs) + n), std::memory_order_release);
+    }
+
 #ifdef DEBUG
     ~pipebuf()
     {
@@ -295,6 +546,8 @@ struct pipewriter
     // Return number of items writable at this->wr, 0 if full.
     long writable()
     {
+        if (buf.threaded)
+            return buf.mt_writable();
         if (buf.end < buf.min_write + buf.wr)
             buf.pack();
         return buf.end - buf.wr;
@@ -302,18 +555,31 @@ struct pipewriter
 
     T *wr()
     {
+        if (buf.threaded)
+            return buf.buf + buf.mt_index(buf.wstate.load(std::memory_order_relaxed));
         return buf.wr;
     }
 
     void written(unsigned long n)
     {
-        if (buf.wr + n > buf.end)
+        if (buf.threaded)
         {
-            fprintf(stderr, "Bug: overflow to %s\n", buf.name);
+            if (buf.mt_index(buf.wstate.load(std::memory_order_relaxed)) + n > (unsigned long)(buf.end - buf.buf))
+                fprintf(stderr, "Bug: overflow to %s\n", buf.name);
+            buf.mt_written(n);
+            scheduler::progress += n;
         }
+        else
+        {
+            if (buf.wr + n > buf.end)
+            {
+                fprintf(stderr, "Bug: overflow to %s\n", buf.name);
+            }
 
-        buf.wr += n;
-        buf.total_written += n;
+            buf.wr += n;
+        }
+
+        buf.total_written.store(buf.total_written.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
     }
 
     void write(const T &e)
@@ -356,23 +622,37 @@ struct pipereader
 
     long readable()
     {
+        if (buf.threaded)
+            return buf.mt_readable(id);
         return buf.wr - buf.rds[id];
     }
 
     T *rd()
     {
+        if (buf.threaded)
+            return buf.buf + buf.mt_index(buf.mt_follow(id, buf.wstate.load(std::memory_order_acquire)));
         return buf.rds[id];
     }
 
     void read(unsigned long n)
     {
+        if (buf.threaded)
+        {
+            if ((long)n > buf.mt_readable(id))
+                fprintf(stderr, "Bug: underflow from %s\n", buf.name);
+            buf.mt_read(id, n);
+            buf.total_read.fetch_add(n, std::memory_order_relaxed);
+            scheduler::progress += n;
+            return;
+        }
+
         if (buf.rds[id] + n > buf.wr)
         {
             fprintf(stderr, "Bug: underflow from %s\n", buf.name);
         }
 
         buf.rds[id] += n;
-        buf.total_read += n;
+        buf.total_read.store(buf.total_read.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
     }
 };
 
@@ -0,0 +1,317 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LEANSDR_LDPC_MINSUM_H
+#define LEANSDR_LDPC_MINSUM_H
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
+#include "ldpc.h"
+
+namespace leansdr
+{
+
+// LDPC MIN-SUM GRAPH
+// Parity check matrix of a S2-style LDPC code expanded from its ldpc_table
+// into check node adjacency lists. Unlike ldpc_engine the parity bits are
+// part of the graph: with the S2 accumulator check c involves parity bits
+// c and c-1 in addition to the message bits listed in the table.
+// Variable nodes are codeword bit indexes (k message bits then n-k parity bits).
+
+template <typename Taddr>
+struct ldpc_minsum_graph
+{
+    int k;        // Message size in bits
+    int n;        // Codeword size in bits
+    int maxdeg;   // Largest check node degree
+    std::vector<int> offsets; // [n-k+1] First edge of each check node
+    std::vector<int> vars;    // [nedges] Variable node of each edge
+
+    ldpc_minsum_graph(const ldpc_table<Taddr> *table, int _k, int _n) :
+        k(_k), n(_n), maxdeg(0)
+    {
+        int n_k = n - k;
+
+        if (k != table->nrows * 360)
+            fatal("Bad table");
+        if (table->q * 360 != n_k)
+            fatal("Bad q");
+
+        // Count message edges of each check node
+        std::vector<int> degs(n_k, 0);
+        expand(table, degs, nullptr);
+
+        offsets.resize(n_k + 1);
+        offsets[0] = 0;
+
+        for (int c = 0; c < n_k; ++c)
+        {
+            int deg = degs[c] + (c == 0 ? 1 : 2);
+            offsets[c + 1] = offsets[c] + deg;
+            maxdeg = deg > maxdeg ? deg : maxdeg;
+        }
+
+        vars.resize(offsets[n_k]);
+
+        // Message edges first then the accumulator edges
+        std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+        expand(table, degs, &fill);
+
+        for (int c = 0; c < n_k; ++c)
+        {
+            vars[fill[c]++] = k + c;
+
+            if (c > 0) {
+                vars[fill[c]++] = k + c - 1;
+            }
+        }
+    }
+
+    int nedges() const { return vars.size(); }
+
+  private:
+    // Same expansion as ldpc_engine: either count (fill null) or store edges
+    void expand(const ldpc_table<Taddr> *table, std::vector<int>& degs, std::vector<int> *fill)
+    {
+        int n_k = n - k;
+        int m = 0;
+
+        for (const typename ldpc_table<Taddr>::row *prow = table->rows;
+             prow < table->rows + table->nrows;
+             ++prow)
+        {
+            int q = table->q;
+            int qoffs = 0;
+
+            for (int mw = 360; mw--; ++m, qoffs += q)
+            {
+                const Taddr *pa = prow->cols;
+
+                for (int nc = prow->ncols; nc--; ++pa)
+                {
+                    int a = (int)*pa + qoffs;
+
+                    if (a >= n_k)
+                        a -= n_k; // Modulo n-k. Note qoffs<360*q.
+                    if (a >= n_k)
+                        fail("Invalid LDPC table");
+
+                    if (fill) {
+                        vars[(*fill)[a]++] = m;
+                    } else {
+                        degs[a]++;
+                    }
+                }
+            }
+        }
+    }
+}; // ldpc_minsum_graph
+
+// LDPC MIN-SUM DECODER
+// Layered normalized min-sum decoding of LANES codewords at once.
+// LLRs are int8 with leansdr convention (positive means bit 0) and are
+// interleaved bit-major: llrs[bit*LANES + lane]. Each lane is an independent
+// frame so that one SIMD instruction processes the same edge of all frames.
+// LLRs saturate at +/-127. Check node messages are scaled by 3/4 and
+// clamped to +/-MAX_C2V, otherwise saturated LLRs get eroded by large
+// messages and converged frames drift away when iterations go on.
+
+template <typename Taddr>
+struct ldpc_minsum_decoder
+{
+    static const int LANES = 16;
+    static const int MAX_C2V = 31; // Keeps t = L - R meaningful when L saturates
+
+    // Decode in place. Returns the number of iterations used or -1 if
+    // some lane still has unsatisfied parity checks after max_iterations.
+    int decode(const ldpc_minsum_graph<Taddr>& g, int8_t *llrs, int max_iterations)
+    {
+        int n_k = g.n - g.k;
+        c2v.assign(g.nedges() * LANES, 0);
+        tmp.resize(g.maxdeg * LANES);
+
+        for (int it = 0; it < max_iterations; ++it)
+        {
+            if (syndrome_ok(g, llrs)) {
+                return it;
+            }
+
+            for (int c = 0; c < n_k; ++c) {
+                update_check(&g.vars[g.offsets[c]], g.offsets[c + 1] - g.offsets[c], &c2v[g.offsets[c] * LANES], llrs);
+            }
+        }
+
+        return syndrome_ok(g, llrs) ? max_iterations : -1;
+    }
+
+  private:
+    std::vector<int8_t> c2v; // [nedges*LANES] Check to variable messages
+    std::vector<int8_t> tmp; // [maxdeg*LANES] Variable to check messages of the current check
+
+    bool syndrome_ok(const ldpc_minsum_graph<Taddr>& g, const int8_t *llrs)
+    {
+        int n_k = g.n - g.k;
+        const int *v = g.vars.data();
+
+        for (int c = 0; c < n_k; ++c)
+        {
+            const int *vend = &g.vars[g.offsets[c + 1]];
+#if defined(USE_SSE2)
+            __m128i parity = _mm_setzero_si128();
+
+            for (; v < vend; ++v) {
+                parity = _mm_xor_si128(parity, _mm_loadu_si128((const __m128i*) &llrs[*v * LANES]));
+            }
+
+            if (_mm_movemask_epi8(parity)) {
+                return false;
+            }
+#else
+            int8_t parity[LANES];
+            memset(parity, 0, sizeof(parity));
+
+            for (; v < vend; ++v)
+            {
+                for (int l = 0; l < LANES; ++l) {
+                    parity[l] ^= llrs[*v * LANES + l];
+                }
+            }
+
+            for (int l = 0; l < LANES; ++l)
+            {
+                if (parity[l] < 0) {
+                    return false;
+                }
+            }
+#endif
+        }
+
+        return true;
+    }
+
+#if defined(USE_SSE2)
+    // Clip -128 to -127 so that negation stays in range
+    static inline __m128i clip(__m128i x)
+    {
+        return _mm_sub_epi8(x, _mm_cmpeq_epi8(x, _mm_set1_epi8(-128)));
+    }
+
+    // min(x * 3/4, MAX_C2V) for x in [0,127]
+    static inline __m128i scale(__m128i x)
+    {
+        x = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi16(x, 2), _mm_set1_epi8(0x3f)));
+        return _mm_min_epu8(x, _mm_set1_epi8(MAX_C2V));
+    }
+
+    void update_check(const int *vars, int deg, int8_t *r, int8_t *llrs)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i min1 = _mm_set1_epi8(127);
+        __m128i min2 = min1;
+        __m128i sgn = zero;
+
+        for (int e = 0; e < deg; ++e)
+        {
+            __m128i l = _mm_loadu_si128((const __m128i*) &llrs[vars[e] * LANES]);
+            __m128i t = clip(_mm_subs_epi8(l, _mm_loadu_si128((const __m128i*) &r[e * LANES])));
+            __m128i s = _mm_cmpgt_epi8(zero, t);
+            __m128i a = _mm_sub_epi8(_mm_xor_si128(t, s), s); // |t| in [0,127]
+            _mm_storeu_si128((__m128i*) &tmp[e * LANES], t);
+            sgn = _mm_xor_si128(sgn, s);
+            min2 = _mm_min_epu8(min2, _mm_max_epu8(min1, a));
+            min1 = _mm_min_epu8(min1, a);
+        }
+
+        __m128i m1 = scale(min1);
+        __m128i m2 = scale(min2);
+
+        for (int e = 0; e < deg; ++e)
+        {
+            __m128i t = _mm_loadu_si128((const __m128i*) &tmp[e * LANES]);
+            __m128i s = _mm_cmpgt_epi8(zero, t);
+            __m128i a = _mm_sub_epi8(_mm_xor_si128(t, s), s);
+            __m128i isMin = _mm_cmpeq_epi8(a, min1);
+            __m128i mag = _mm_or_si128(_mm_and_si128(isMin, m2), _mm_andnot_si128(isMin, m1));
+            __m128i rs = _mm_xor_si128(sgn, s); // Sign of the product of the other edges
+            __m128i rn = _mm_sub_epi8(_mm_xor_si128(mag, rs), rs);
+            _mm_storeu_si128((__m128i*) &r[e * LANES], rn);
+            _mm_storeu_si128((__m128i*) &llrs[vars[e] * LANES], clip(_mm_adds_epi8(t, rn)));
+        }
+    }
+#else
+    static inline int8_t sat(int x)
+    {
+        return x > 127 ? 127 : x < -127 ? -127 : x;
+    }
+
+    void update_check(const int *vars, int deg, int8_t *r, int8_t *llrs)
+    {
+        int min1[LANES], min2[LANES], sgn[LANES];
+
+        for (int l = 0; l < LANES; ++l)
+        {
+            min1[l] = min2[l] = 127;
+            sgn[l] = 0;
+        }
+
+        for (int e = 0; e < deg; ++e)
+        {
+            for (int l = 0; l < LANES; ++l)
+            {
+                int8_t t = sat(llrs[vars[e] * LANES + l] - r[e * LANES + l]);
+                int a = t < 0 ? -t : t;
+                tmp[e * LANES + l] = t;
+                sgn[l] ^= t < 0;
+
+                if (a < min1[l])
+                {
+                    min2[l] = min1[l];
+                    min1[l] = a;
+                }
+                else if (a < min2[l])
+                {
+                    min2[l] = a;
+                }
+            }
+        }
+
+        for (int e = 0; e < deg; ++e)
+        {
+            for (int l = 0; l < LANES; ++l)
+            {
+                int8_t t = tmp[e * LANES + l];
+                int a = t < 0 ? -t : t;
+                int mag = a == min1[l] ? min2[l] - (min2[l] >> 2) : min1[l] - (min1[l] >> 2);
+                mag = mag > MAX_C2V ? MAX_C2V : mag;
+                int8_t rn = (sgn[l] ^ (t < 0)) ? -mag : mag;
+                r[e * LANES + l] = rn;
+                llrs[vars[e] * LANES + l] = sat(t + rn);
+            }
+        }
+    }
+#endif
+}; // ldpc_minsum_decoder
+
+} // namespace leansdr
+
+#endif // LEANSDR_LDPC_MINSUM_H
@@ -413,6 +413,15 @@ int DSDDemod::webapiReportGet(
     return 200;
 }
 
+bool DSDDemod::getMetrics(Metrics& metrics) const
+{
+    metrics.m_channelPowerDB = CalcDb::dbPower(m_basebandSink->getMagSq());
+    metrics.m_squelch = m_basebandSink->getSquelchOpen() ? 1 : 0;
+    metrics.m_channelSampleRate = m_basebandSink->getChannelSampleRate();
+    metrics.m_audioSampleRate = m_basebandSink->getAudioSampleRate();
+    return true;
+}
+
 void DSDDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const DSDDemodSettings& settings)
 {
     response.getDsdDemodSettings()->setInputFrequencyOffset(settings.m_inputFrequencyOffset);
@@ -102,6 +102,8 @@ public:
             SWGSDRangel::SWGChannelReport& response,
             QString& errorMessage);
 
+    virtual bool getMetrics(Metrics& metrics) const;
+
     static void webapiFormatChannelSettings(
         SWGSDRangel::SWGChannelSettings& response,
         const DSDDemodSettings& settings);
@@ -114,7 +116,7 @@ public:
     uint32_t getNumberOfDeviceStreams() const;
 	void setScopeXYSink(BasebandSampleSink* sampleSink) { m_basebandSink->setScopeXYSink(sampleSink); }
 	void configureMyPosition(float myLatitude, float myLongitude) { m_basebandSink->configureMyPosition(myLatitude, myLongitude); }
-	double getMagSq() { return m_basebandSink->getMagSq(); }
+	double getMagSq() const { return m_basebandSink->getMagSq(); }
 	bool getSquelchOpen() const { return m_basebandSink->getSquelchOpen(); }
 	const DSDDecoder& getDecoder() const { return m_basebandSink->getDecoder(); }
     void getMagSqLevels(double& avg, double& peak, int& nbSamples) { m_basebandSink->getMagSqLevels(avg, peak, nbSamples); }
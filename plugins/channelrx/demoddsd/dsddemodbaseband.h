@@ -63,7 +63,7 @@ public:
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     int getChannelSampleRate() const;
     int getAudioSampleRate() const { return m_sink.getAudioSampleRate(); }
-    double getMagSq() { return m_sink.getMagSq(); }
+    double getMagSq() const { return m_sink.getMagSq(); }
     void getMagSqLevels(double& avg, double& peak, int& nbSamples) { m_sink.getMagSqLevels(avg, peak, nbSamples); }
     bool getSquelchOpen() const { return m_sink.getSquelchOpen(); }
     void setBasebandSampleRate(int sampleRate);
@@ -0,0 +1,276 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <math.h>
+
+#include <QThreadPool>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include "dsddemodmbevocoder.h"
+
+const unsigned int DSDDemodMbeVocoder::m_maxFrames = 25; // 500 ms of 20 ms frames
+
+DSDDemodMbeVocoder::DSDDemodMbeVocoder(AudioFifo *audioFifo) :
+    m_audioFifo(audioFifo),
+    m_scheduled(false),
+    m_audioBufferFill(0),
+    m_upsamplerLastValue(0.0f),
+    m_upsampling(1),
+    m_volume(1.0f)
+{
+    setAutoDelete(false);
+    mbe_initMbeParms(&m_curMp, &m_prevMp, &m_prevMpEnhanced);
+    memset(m_audioSamples, 0, sizeof(m_audioSamples));
+    m_audioBuffer.resize(8*160); // room for one frame at maximum upsampling (6)
+    setVolumeFactors();
+}
+
+DSDDemodMbeVocoder::~DSDDemodMbeVocoder()
+{
+    QMutexLocker locker(&m_mutex);
+    m_frames.clear();
+
+    while (m_scheduled) {
+        m_idle.wait(&m_mutex);
+    }
+}
+
+QThreadPool *DSDDemodMbeVocoder::getThreadPool()
+{
+    static QThreadPool threadPool; // shared by all DSD demodulators with one thread per core
+    return &threadPool;
+}
+
+bool DSDDemodMbeVocoder::isRateSupported(int mbeRateIndex)
+{
+    switch (mbeRateIndex)
+    {
+    case MbeRate3600x2450:
+    case MbeRate7200x4400:
+    case MbeRate2400:
+    case MbeRate2450:
+    case MbeRate4400:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void DSDDemodMbeVocoder::pushMbeFrame(const unsigned char *mbeFrame,
+        int mbeRateIndex,
+        int mbeVolumeIndex,
+        unsigned char channels,
+        bool useHP,
+        int upsampling)
+{
+    int nbBytes;
+
+    switch (mbeRateIndex)
+    {
+    case MbeRate3600x2450:
+        nbBytes = 9;  // 72 bits
+        break;
+    case MbeRate7200x4400:
+        nbBytes = 18; // 144 bits
+        break;
+    case MbeRate2400:
+    case MbeRate2450:
+        nbBytes = 7;  // 49 bits
+        break;
+    case MbeRate4400:
+        nbBytes = 11; // 88 bits
+        break;
+    default:
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    if (m_frames.size() >= m_maxFrames)
+    {
+        qDebug("DSDDemodMbeVocoder::pushMbeFrame: queue full: drop oldest frame");
+        m_frames.pop_front();
+    }
+
+    m_frames.push_back(Frame());
+    Frame& frame = m_frames.back();
+    memcpy(frame.m_mbeFrame, mbeFrame, nbBytes);
+    frame.m_mbeRateIndex = mbeRateIndex;
+    frame.m_volumeIndex = mbeVolumeIndex;
+    frame.m_channels = channels % 4;
+    frame.m_useHP = useHP;
+    frame.m_upsampling = upsampling;
+
+    if (!m_scheduled)
+    {
+        m_scheduled = true;
+        getThreadPool()->start(this);
+    }
+}
+
+void DSDDemodMbeVocoder::run()
+{
+    while (true)
+    {
+        m_mutex.lock();
+
+        if (m_frames.empty())
+        {
+            m_scheduled = false;
+            m_idle.wakeAll();
+            m_mutex.unlock();
+            return;
+        }
+
+        Frame frame = m_frames.front();
+        m_frames.pop_front();
+        m_mutex.unlock();
+
+        vocode(frame); // vocoder state is only used by the single running job
+    }
+}
+
+void DSDDemodMbeVocoder::vocode(const Frame& frame)
+{
+    static const int ambe3600x2450Sizes[4] = {24, 23, 11, 14};
+    static const int imbe7200x4400Sizes[8] = {23, 23, 23, 23, 15, 15, 15, 7};
+    char ambe_fr[4][24];
+    char imbe_fr[8][23];
+    char ambe_d[49];
+    char imbe_d[88];
+    char err_str[64];
+    int errs = 0;
+    int errs2 = 0;
+    int uvQuality = 3; // as set in the DSDcc decoder
+
+    switch (frame.m_mbeRateIndex)
+    {
+    case MbeRate3600x2450:
+        unpackCodeVectors(frame.m_mbeFrame, &ambe_fr[0][0], 24, ambe3600x2450Sizes, 4);
+        mbe_processAmbe3600x2450Frame(m_audioSamples, &errs, &errs2, err_str, ambe_fr, ambe_d, &m_curMp, &m_prevMp, &m_prevMpEnhanced, uvQuality);
+        break;
+    case MbeRate7200x4400:
+        unpackCodeVectors(frame.m_mbeFrame, &imbe_fr[0][0], 23, imbe7200x4400Sizes, 8);
+        mbe_processImbe7200x4400Frame(m_audioSamples, &errs, &errs2, err_str, imbe_fr, imbe_d, &m_curMp, &m_prevMp, &m_prevMpEnhanced, uvQuality);
+        break;
+    case MbeRate2400:
+    case MbeRate2450:
+        for (int i = 0; i < 49; i++) {
+            ambe_d[i] = (frame.m_mbeFrame[i/8] >> (7 - (i%8))) & 1;
+        }
+
+        if (frame.m_mbeRateIndex == MbeRate2400) {
+            mbe_processAmbe2400Data(m_audioSamples, &errs, &errs2, err_str, ambe_d, &m_curMp, &m_prevMp, &m_prevMpEnhanced, uvQuality);
+        } else {
+            mbe_processAmbe2450Data(m_audioSamples, &errs, &errs2, err_str, ambe_d, &m_curMp, &m_prevMp, &m_prevMpEnhanced, uvQuality);
+        }
+        break;
+    case MbeRate4400:
+        for (int i = 0; i < 88; i++) {
+            imbe_d[i] = (frame.m_mbeFrame[i/8] >> (7 - (i%8))) & 1;
+        }
+
+        mbe_processImbe4400Data(m_audioSamples, &errs, &errs2, err_str, imbe_d, &m_curMp, &m_prevMp, &m_prevMpEnhanced, uvQuality);
+        break;
+    default:
+        return;
+    }
+
+    int dBVolume = (frame.m_volumeIndex - 30) / 4; // as AMBEWorker
+    float volume = pow(10.0, dBVolume / 10.0f);
+    int upsampling = frame.m_upsampling > 6 ? 6 : frame.m_upsampling < 1 ? 1 : frame.m_upsampling;
+
+    if ((volume != m_volume) || (upsampling != m_upsampling))
+    {
+        m_volume = volume;
+        m_upsampling = upsampling;
+        setVolumeFactors();
+    }
+
+    m_upsampleFilter.useHP(frame.m_useHP);
+    m_audioBufferFill = 0;
+    upsample(m_audioSamples, 160, frame.m_channels);
+
+    uint res = m_audioFifo->write((const quint8*) &m_audioBuffer[0], m_audioBufferFill);
+
+    if (res != m_audioBufferFill) {
+        qDebug("DSDDemodMbeVocoder::vocode: %u/%u audio samples written", res, m_audioBufferFill);
+    }
+}
+
+void DSDDemodMbeVocoder::unpackCodeVectors(const unsigned char *mbeFrame, char *codeVectors, int rowSize, const int *sizes, int nbRows)
+{
+    int bitIndex = 0;
+
+    // mbelib code vectors have their most significant bit at the highest index
+    for (int row = 0; row < nbRows; row++)
+    {
+        for (int j = sizes[row] - 1; j >= 0; j--, bitIndex++) {
+            codeVectors[row*rowSize + j] = (mbeFrame[bitIndex/8] >> (7 - (bitIndex%8))) & 1;
+        }
+    }
+}
+
+void DSDDemodMbeVocoder::upsample(const short *in, int nbSamplesIn, unsigned char channels)
+{
+    if (m_upsampling == 1) // native 8k
+    {
+        for (int i = 0; i < nbSamplesIn; i++)
+        {
+            float cur = m_upsampleFilter.usesHP() ? m_upsampleFilter.runHP((float) in[i]) : (float) in[i];
+            m_audioBuffer[m_audioBufferFill].l = channels & 1 ? cur*m_upsamplingFactors[0] : 0;
+            m_audioBuffer[m_audioBufferFill].r = (channels>>1) & 1 ? cur*m_upsamplingFactors[0] : 0;
+
+            if (m_audioBufferFill < m_audioBuffer.size() - 1) {
+                ++m_audioBufferFill;
+            }
+        }
+
+        return;
+    }
+
+    for (int i = 0; i < nbSamplesIn; i++)
+    {
+        float cur = m_upsampleFilter.usesHP() ? m_upsampleFilter.runHP((float) in[i]) : (float) in[i];
+        float prev = m_upsamplerLastValue;
+        qint16 upsample;
+
+        for (int j = 1; j <= m_upsampling; j++)
+        {
+            upsample = (qint16) m_upsampleFilter.runLP(cur*m_upsamplingFactors[j] + prev*m_upsamplingFactors[m_upsampling-j]);
+            m_audioBuffer[m_audioBufferFill].l = channels & 1 ? m_compressor.compress(upsample) : 0;
+            m_audioBuffer[m_audioBufferFill].r = (channels>>1) & 1 ? m_compressor.compress(upsample) : 0;
+
+            if (m_audioBufferFill < m_audioBuffer.size() - 1) {
+                ++m_audioBufferFill;
+            }
+        }
+
+        m_upsamplerLastValue = cur;
+    }
+}
+
+void DSDDemodMbeVocoder::setVolumeFactors()
+{
+    m_upsamplingFactors[0] = m_volume;
+
+    for (int i = 1; i <= m_upsampling; i++) {
+        m_upsamplingFactors[i] = (i*m_volume) / (float) m_upsampling;
+    }
+}
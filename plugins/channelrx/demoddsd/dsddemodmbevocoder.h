@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_DSDDEMODMBEVOCODER_H
+#define INCLUDE_DSDDEMODMBEVOCODER_H
+
+#include <deque>
+
+#include <QRunnable>
+#include <QMutex>
+#include <QWaitCondition>
+
+extern "C" {
+#include "mbelib.h"
+}
+
+#include "dsp/filtermbe.h"
+#include "audio/audiocompressor.h"
+#include "audio/audiofifo.h"
+
+class QThreadPool;
+
+/**
+ * Vocodes with mbelib the MBE frames of one slot of a DSD demodulator in a thread pool shared
+ * by all DSD demodulators. The DSD decoder stays in the channel thread with its own mbelib
+ * vocoding disabled and pushes each MBE frame here as it would to an AMBE device. The frames
+ * of a slot are queued and vocoded in order by a single job at a time since mbelib keeps
+ * the speech parameters of the previous frame. The audio is written to the slot audio FIFO
+ * from the pool thread.
+ *
+ * The frames are in the AMBE-3000 channel format: FEC coded code vectors in order or plain
+ * data bits for the rates without FEC, most significant bit first. D-Star (3600x2400) and
+ * 7100x4400 frames are not handled and are vocoded by the decoder instead.
+ */
+class DSDDemodMbeVocoder : public QRunnable
+{
+public:
+    DSDDemodMbeVocoder(AudioFifo *audioFifo);
+    virtual ~DSDDemodMbeVocoder(); //!< waits for the job in progress if any
+
+    static bool isRateSupported(int mbeRateIndex);
+    /** same arguments as DSPEngine::pushMbeFrame. Never blocks the caller. */
+    void pushMbeFrame(const unsigned char *mbeFrame,
+            int mbeRateIndex,
+            int mbeVolumeIndex,
+            unsigned char channels,
+            bool useHP,
+            int upsampling);
+    virtual void run();
+
+    static QThreadPool *getThreadPool();
+
+private:
+    enum MbeRate // same order as DSDcc DSDMBERate and SerialDV DVRate
+    {
+        MbeRate3600x2400,
+        MbeRate3600x2450,
+        MbeRate7200x4400,
+        MbeRate7100x4400,
+        MbeRate2400,
+        MbeRate2450,
+        MbeRate4400
+    };
+
+    struct Frame
+    {
+        unsigned char m_mbeFrame[18]; //!< 144 bits at most (7200x4400)
+        int m_mbeRateIndex;
+        int m_volumeIndex;
+        unsigned char m_channels;
+        bool m_useHP;
+        int m_upsampling;
+    };
+
+    void vocode(const Frame& frame);
+    void upsample(const short *in, int nbSamplesIn, unsigned char channels);
+    void setVolumeFactors();
+    static void unpackCodeVectors(const unsigned char *mbeFrame, char *codeVectors, int rowSize, const int *sizes, int nbRows);
+
+    AudioFifo *m_audioFifo;
+    QMutex m_mutex;              //!< protects the frames queue and the scheduled flag
+    QWaitCondition m_idle;
+    std::deque<Frame> m_frames;
+    bool m_scheduled;            //!< a job is queued or running in the pool
+
+    mbe_parms m_curMp;
+    mbe_parms m_prevMp;
+    mbe_parms m_prevMpEnhanced;
+    short m_audioSamples[160];   //!< one frame of 20 ms at 8 kS/s
+    AudioVector m_audioBuffer;
+    uint m_audioBufferFill;
+    float m_upsamplerLastValue;
+    MBEAudioInterpolatorFilter m_upsampleFilter;
+    AudioCompressor m_compressor;
+    int m_upsampling;
+    float m_volume;
+    float m_upsamplingFactors[7];
+
+    static const unsigned int m_maxFrames; //!< queue limit
+};
+
+#endif // INCLUDE_DSDDEMODMBEVOCODER_H
@@ -55,6 +55,8 @@ DSDDemodSink::DSDDemodSink() :
     m_scopeXY(0),
     m_scopeEnabled(true),
     m_dsdDecoder(),
+    m_mbeVocoder1(&m_audioFifo1),
+    m_mbeVocoder2(&m_audioFifo2),
     m_signalFormat(signalFormatNone)
 {
 	m_audioBuffer.resize(1<<14);
@@ -84,7 +86,11 @@ void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
 
 	m_scopeSampleBuffer.clear();
 
-	m_dsdDecoder.enableMbelib(!DSPEngine::instance()->hasDVSerialSupport()); // disable mbelib if DV serial support is present and activated else enable it
+    // MBE frames are vocoded by the AMBE devices if present and activated else by mbelib in the shared pool.
+    // The decoder only vocodes with mbelib the rates the pool vocoders do not handle.
+    bool dvSerial = DSPEngine::instance()->hasDVSerialSupport();
+    bool frameVocoding = dvSerial || DSDDemodMbeVocoder::isRateSupported(m_dsdDecoder.getMbeRateIndex());
+	m_dsdDecoder.enableMbelib(!frameVocoding);
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
@@ -199,20 +205,33 @@ void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
                 m_scopeSampleBuffer.push_back(s);
             }
 
-            if (DSPEngine::instance()->hasDVSerialSupport())
+            if (frameVocoding)
             {
                 if ((m_settings.m_slot1On) && m_dsdDecoder.mbeDVReady1())
                 {
                     if (!m_settings.m_audioMute)
                     {
-                        DSPEngine::instance()->pushMbeFrame(
-                                m_dsdDecoder.getMbeDVFrame1(),
-                                m_dsdDecoder.getMbeRateIndex(),
-                                m_settings.m_volume * 10.0,
-                                m_settings.m_tdmaStereo ? 1 : 3, // left or both channels
-                                m_settings.m_highPassFilter,
-                                m_audioSampleRate/8000, // upsample from native 8k
-                                &m_audioFifo1);
+                        if (dvSerial)
+                        {
+                            DSPEngine::instance()->pushMbeFrame(
+                                    m_dsdDecoder.getMbeDVFrame1(),
+                                    m_dsdDecoder.getMbeRateIndex(),
+                                    m_settings.m_volume * 10.0,
+                                    m_settings.m_tdmaStereo ? 1 : 3, // left or both channels
+                                    m_settings.m_highPassFilter,
+                                    m_audioSampleRate/8000, // upsample from native 8k
+                                    &m_audioFifo1);
+                        }
+                        else
+                        {
+                            m_mbeVocoder1.pushMbeFrame(
+                                    m_dsdDecoder.getMbeDVFrame1(),
+                                    m_dsdDecoder.getMbeRateIndex(),
+                                    m_settings.m_volume * 10.0,
+                                    m_settings.m_tdmaStereo ? 1 : 3, // left or both channels
+                                    m_settings.m_highPassFilter,
+                                    m_audioSampleRate/8000); // upsample from native 8k
+                        }
                     }
 
                     m_dsdDecoder.resetMbeDV1();
@@ -222,14 +241,27 @@ void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
                 {
                     if (!m_settings.m_audioMute)
                     {
-                        DSPEngine::instance()->pushMbeFrame(
-                                m_dsdDecoder.getMbeDVFrame2(),
-                                m_dsdDecoder.getMbeRateIndex(),
-                                m_settings.m_volume * 10.0,
-                                m_settings.m_tdmaStereo ? 2 : 3, // right or both channels
-                                m_settings.m_highPassFilter,
-                                m_audioSampleRate/8000, // upsample from native 8k
-                                &m_audioFifo2);
+                        if (dvSerial)
+                        {
+                            DSPEngine::instance()->pushMbeFrame(
+                                    m_dsdDecoder.getMbeDVFrame2(),
+                                    m_dsdDecoder.getMbeRateIndex(),
+                                    m_settings.m_volume * 10.0,
+                                    m_settings.m_tdmaStereo ? 2 : 3, // right or both channels
+                                    m_settings.m_highPassFilter,
+                                    m_audioSampleRate/8000, // upsample from native 8k
+                                    &m_audioFifo2);
+                        }
+                        else
+                        {
+                            m_mbeVocoder2.pushMbeFrame(
+                                    m_dsdDecoder.getMbeDVFrame2(),
+                                    m_dsdDecoder.getMbeRateIndex(),
+                                    m_settings.m_volume * 10.0,
+                                    m_settings.m_tdmaStereo ? 2 : 3, // right or both channels
+                                    m_settings.m_highPassFilter,
+                                    m_audioSampleRate/8000); // upsample from native 8k
+                        }
                     }
 
                     m_dsdDecoder.resetMbeDV2();
@@ -240,7 +272,7 @@ void DSDDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
         }
 	}
 
-	if (!DSPEngine::instance()->hasDVSerialSupport())
+	if (!frameVocoding)
 	{
 	    if (m_settings.m_slot1On)
 	    {
@@ -32,6 +32,7 @@
 
 #include "dsddemodsettings.h"
 #include "dsddecoder.h"
+#include "dsddemodmbevocoder.h"
 
 class BasebandSampleSink;
 
@@ -52,7 +53,7 @@ public:
 	void setScopeXYSink(BasebandSampleSink* scopeSink) { m_scopeXY = scopeSink; }
 	void configureMyPosition(float myLatitude, float myLongitude);
 
-	double getMagSq() { return m_magsq; }
+	double getMagSq() const { return m_magsq; }
 	bool getSquelchOpen() const { return m_squelchOpen; }
 
 	const DSDDecoder& getDecoder() const { return m_dsdDecoder; }
@@ -139,6 +140,8 @@ private:
 	bool m_scopeEnabled;
 
 	DSDDecoder m_dsdDecoder;
+    DSDDemodMbeVocoder m_mbeVocoder1; //!< slot 1 mbelib vocoding in the shared pool
+    DSDDemodMbeVocoder m_mbeVocoder2; //!< slot 2 mbelib vocoding in the shared pool
 
 	char m_formatStatusText[82+1]; //!< Fixed signal format dependent status text
     SignalFormat m_signalFormat;   //!< Used to keep formatting during successive calls for the same standard type
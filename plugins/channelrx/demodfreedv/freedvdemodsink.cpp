@@ -184,34 +184,30 @@ void FreeDVDemodSink::feed(const SampleVector::const_iterator& begin, const Samp
         return;
     }
 
-	Complex ci;
 	fftfilt::cmplx *sideband;
 	int n_out;
 
 	int decim = 1<<(m_spanLog2 - 1);
 	unsigned char decim_mask = decim - 1; // counter LSB bit mask for decimation by 2^(m_scaleLog2 - 1)
 
-	for(SampleVector::const_iterator it = begin; it < end; ++it)
-	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+	int nbIn = end - begin;
 
-        if (m_interpolatorDistance < 1.0f) // interpolate
-        {
-            while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
-        }
-        else
-        {
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
-        }
+	if (m_interpolatorIn.size() < (unsigned int) nbIn) {
+		m_interpolatorIn.resize(nbIn);
+	}
+
+	m_nco.nextIQMul(&(*begin), m_interpolatorIn.data(), nbIn);
+
+	int nbOut;
+
+	if (m_interpolatorDistance < 1.0f) { // interpolate
+		nbOut = m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_interpolatorIn.data(), nbIn, m_interpolatorOut);
+	} else { // decimate
+		nbOut = m_interpolator.decimate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_interpolatorIn.data(), nbIn, m_interpolatorOut);
+	}
+
+	for (int i = 0; i < nbOut; i++) {
+		processOneSample(m_interpolatorOut[i]);
 	}
 
 	uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
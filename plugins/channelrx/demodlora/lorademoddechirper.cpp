@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cmath>
+
+#include <QString>
+#include <QDebug>
+
+#include "dsp/dspengine.h"
+#include "dsp/fftfactory.h"
+#include "dsp/fftengine.h"
+
+#include "lorademoddechirper.h"
+
+const int LoRaDemodDechirper::m_minSpreadFactor = 7;
+const int LoRaDemodDechirper::m_maxSpreadFactor = 12;
+const float LoRaDemodDechirper::m_peakRatioThreshold = 10.0f;
+const int LoRaDemodDechirper::m_minPreambleChirps = 4;
+const int LoRaDemodDechirper::m_maxPreambleChirps = 16;
+const int LoRaDemodDechirper::m_maxSymbols = 512;
+
+namespace {
+
+std::vector<std::vector<Complex>> makeDownChirps(int minSpreadFactor, int maxSpreadFactor)
+{
+    std::vector<std::vector<Complex>> downChirps;
+
+    for (int spreadFactor = minSpreadFactor; spreadFactor <= maxSpreadFactor; spreadFactor++)
+    {
+        int nbSymbols = 1 << spreadFactor;
+        downChirps.push_back(std::vector<Complex>(nbSymbols));
+        std::vector<Complex>& downChirp = downChirps.back();
+
+        for (int n = 0; n < nbSymbols; n++)
+        {
+            // up chirp from -BW/2 to +BW/2 sampled at the chip rate is exp(j*phi)
+            double phi = M_PI * ((double) n * n / nbSymbols - n);
+            downChirp[n] = Complex(std::cos(phi), -std::sin(phi));
+        }
+    }
+
+    return downChirps;
+}
+
+int binDistance(int a, int b, int nbSymbols)
+{
+    int d = (a - b) & (nbSymbols - 1);
+    return d < nbSymbols - d ? d : nbSymbols - d;
+}
+
+}
+
+const std::vector<Complex>& LoRaDemodDechirper::getDownChirp(int spreadFactor)
+{
+    // computed once and shared by all instances
+    static const std::vector<std::vector<Complex>> downChirps = makeDownChirps(m_minSpreadFactor, m_maxSpreadFactor);
+    return downChirps[spreadFactor - m_minSpreadFactor];
+}
+
+LoRaDemodDechirper::LoRaDemodDechirper(int spreadFactor) :
+    m_spreadFactor(spreadFactor < m_minSpreadFactor ? m_minSpreadFactor : spreadFactor > m_maxSpreadFactor ? m_maxSpreadFactor : spreadFactor),
+    m_nbSymbols(1 << m_spreadFactor),
+    m_downChirp(getDownChirp(m_spreadFactor)),
+    m_fft(nullptr),
+    m_window(m_nbSymbols),
+    m_windowFill(0),
+    m_skip(0),
+    m_state(StateDetect),
+    m_lastBin(0),
+    m_count(0),
+    m_preambleBin(0),
+    m_nbFrames(0),
+    m_blockBegin(nullptr),
+    m_blockSize(0)
+{
+    setAutoDelete(false);
+    FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
+    m_fftSequence = fftFactory->getEngine(m_nbSymbols, false, &m_fft);
+    m_symbols.reserve(m_maxSymbols);
+}
+
+LoRaDemodDechirper::~LoRaDemodDechirper()
+{
+    FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
+    fftFactory->releaseEngine(m_nbSymbols, false, m_fftSequence);
+}
+
+void LoRaDemodDechirper::run()
+{
+    for (int i = 0; i < m_blockSize; i++)
+    {
+        if (m_skip > 0)
+        {
+            m_skip--;
+            continue;
+        }
+
+        m_window[m_windowFill++] = m_blockBegin[i];
+
+        if (m_windowFill == m_nbSymbols)
+        {
+            processWindow();
+            m_windowFill = 0;
+        }
+    }
+}
+
+void LoRaDemodDechirper::processWindow()
+{
+    Complex *in = m_fft->in();
+
+    for (int n = 0; n < m_nbSymbols; n++) {
+        in[n] = m_window[n] * m_downChirp[n];
+    }
+
+    m_fft->transform();
+    const Complex *out = m_fft->out();
+    Real peak = 0.0f;
+    Real total = 0.0f;
+    int bin = 0;
+
+    for (int n = 0; n < m_nbSymbols; n++)
+    {
+        Real magsq = std::norm(out[n]);
+        total += magsq;
+
+        if (magsq > peak)
+        {
+            peak = magsq;
+            bin = n;
+        }
+    }
+
+    // a dechirped chirp concentrates its energy in one bin, noise and down chirps do not
+    bool locked = (total > 0.0f) && (peak * m_nbSymbols > m_peakRatioThreshold * total);
+
+    switch (m_state)
+    {
+    case StateDetect:
+        if (locked && (m_count > 0) && (binDistance(bin, m_lastBin, m_nbSymbols) <= 1)) {
+            m_count++;
+        } else {
+            m_count = locked ? 1 : 0;
+        }
+
+        m_lastBin = bin;
+
+        if (m_count >= m_minPreambleChirps)
+        {
+            // a window starting d samples after the chirp start peaks at bin d
+            m_skip = (m_nbSymbols - bin) & (m_nbSymbols - 1);
+            m_preambleBin = 0;
+            m_count = 0;
+            m_state = StatePreamble;
+        }
+        break;
+    case StatePreamble:
+        if (locked)
+        {
+            if ((m_count == 0) || (binDistance(bin, m_preambleBin, m_nbSymbols) <= 1)) {
+                m_preambleBin = bin; // residual frequency offset
+            } // else sync word
+
+            if (++m_count > m_maxPreambleChirps) {
+                m_state = StateDetect;
+                m_count = 0;
+            }
+        }
+        else
+        {
+            // first down chirp of the 2.25 symbols long start of frame delimiter
+            m_skip = m_nbSymbols + m_nbSymbols/4;
+            m_symbols.clear();
+            m_state = StatePayload;
+        }
+        break;
+    case StatePayload:
+        if (locked) {
+            m_symbols.push_back((bin - m_preambleBin) & (m_nbSymbols - 1));
+        }
+
+        if (!locked || ((int) m_symbols.size() >= m_maxSymbols))
+        {
+            reportFrame();
+            m_count = 0;
+            m_state = StateDetect;
+        }
+        break;
+    }
+}
+
+void LoRaDemodDechirper::reportFrame()
+{
+    if (m_symbols.empty()) {
+        return;
+    }
+
+    m_nbFrames++;
+    QString symbolsStr;
+
+    for (unsigned short symbol : m_symbols) {
+        symbolsStr.append(QString(" %1").arg(symbol, 0, 16));
+    }
+
+    qDebug("LoRaDemodDechirper::reportFrame: SF%d %u symbols:%s",
+        m_spreadFactor, (unsigned int) m_symbols.size(), qPrintable(symbolsStr));
+}
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef INCLUDE_LORADEMODDECHIRPER_H
+#define INCLUDE_LORADEMODDECHIRPER_H
+
+#include <vector>
+
+#include <QRunnable>
+
+#include "dsp/dsptypes.h"
+
+class FFTEngine;
+
+/**
+ * Dechirp and FFT LoRa demodulator for one spreading factor. Chip rate samples
+ * (one sample per chip at the LoRa bandwidth) are cut into symbol windows of 2^SF
+ * samples that are multiplied by the reference down chirp and transformed by an
+ * FFT engine of the FFTFactory. The position of the FFT peak is the symbol value.
+ *
+ * The preamble (repeated up chirps) gives the symbol timing that is realigned
+ * on the FFT peak and its bin is the reference of the payload symbols. The sync
+ * word down chirps are detected by their low peak to average ratio and the payload
+ * is collected until the signal is lost.
+ *
+ * Several instances for different spreading factors can process the same block
+ * of samples concurrently: the block is read only and the reference chirps are
+ * shared by all instances of the same spreading factor.
+ */
+class LoRaDemodDechirper : public QRunnable
+{
+public:
+    LoRaDemodDechirper(int spreadFactor);
+    virtual ~LoRaDemodDechirper();
+
+    void setBlock(const Complex *begin, int size) { m_blockBegin = begin; m_blockSize = size; }
+    virtual void run(); //!< process the block set with setBlock
+    int getSpreadFactor() const { return m_spreadFactor; }
+    unsigned int getNbFrames() const { return m_nbFrames; }
+
+    static const int m_minSpreadFactor;
+    static const int m_maxSpreadFactor;
+
+private:
+    enum State
+    {
+        StateDetect,   //!< look for repeated up chirps
+        StatePreamble, //!< aligned on the preamble up chirps
+        StatePayload   //!< collect payload symbols
+    };
+
+    int m_spreadFactor;
+    int m_nbSymbols;                   //!< 2^SF
+    const std::vector<Complex>& m_downChirp; //!< shared reference
+    FFTEngine *m_fft;
+    unsigned int m_fftSequence;
+    std::vector<Complex> m_window;
+    int m_windowFill;
+    int m_skip;                        //!< samples to drop before the next window
+    State m_state;
+    int m_lastBin;
+    int m_count;
+    int m_preambleBin;
+    std::vector<unsigned short> m_symbols;
+    unsigned int m_nbFrames;
+    const Complex *m_blockBegin;
+    int m_blockSize;
+
+    static const float m_peakRatioThreshold;
+    static const int m_minPreambleChirps;
+    static const int m_maxPreambleChirps;
+    static const int m_maxSymbols;
+
+    void processWindow();
+    void reportFrame();
+    static const std::vector<Complex>& getDownChirp(int spreadFactor);
+};
+
+#endif // INCLUDE_LORADEMODDECHIRPER_H
@@ -98,7 +98,9 @@ void LoRaDemodGUI::on_BW_valueChanged(int value)
 
 void LoRaDemodGUI::on_Spread_valueChanged(int value)
 {
-    (void) value;
+    m_settings.m_spread = value < 0 ? 0 : value > LoRaDemodSettings::nb_spreadFactors + 1 ? LoRaDemodSettings::nb_spreadFactors + 1 : value;
+    displaySpreadText(m_settings.m_spread);
+    applySettings();
 }
 
 void LoRaDemodGUI::onWidgetRolled(QWidget* widget, bool rollDown)
@@ -182,5 +184,20 @@ void LoRaDemodGUI::displaySettings()
     blockApplySettings(true);
     ui->BWText->setText(QString("%1 Hz").arg(thisBW));
     ui->BW->setValue(m_settings.m_bandwidthIndex);
+    ui->Spread->setValue(m_settings.m_spread);
+    displaySpreadText(m_settings.m_spread);
     blockApplySettings(false);
 }
+
+void LoRaDemodGUI::displaySpreadText(int spread)
+{
+    if (spread <= 0) {
+        ui->SpreadText->setText("6:4 2^8");
+    } else if (spread <= LoRaDemodSettings::nb_spreadFactors) {
+        ui->SpreadText->setText(QString("SF%1").arg(LoRaDemodSettings::spreadFactors[spread - 1]));
+    } else {
+        ui->SpreadText->setText(QString("SF%1-%2")
+            .arg(LoRaDemodSettings::spreadFactors[0])
+            .arg(LoRaDemodSettings::spreadFactors[LoRaDemodSettings::nb_spreadFactors - 1]));
+    }
+}
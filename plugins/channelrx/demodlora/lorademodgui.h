@@ -60,6 +60,7 @@ private:
     void blockApplySettings(bool block);
 	void applySettings(bool force = false);
 	void displaySettings();
+	void displaySpreadText(int spread);
 };
 
 #endif // INCLUDE_LoRaDEMODGUI_H
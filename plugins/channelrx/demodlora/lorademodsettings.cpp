@@ -9,6 +9,8 @@
 
 const int LoRaDemodSettings::bandwidths[] = {7813,15625,20833,31250,62500};
 const int LoRaDemodSettings::nb_bandwidths = 5;
+const int LoRaDemodSettings::spreadFactors[] = {7, 8, 9, 10, 11, 12};
+const int LoRaDemodSettings::nb_spreadFactors = 6;
 
 LoRaDemodSettings::LoRaDemodSettings() :
     m_centerFrequency(0),
@@ -31,7 +33,6 @@ QByteArray LoRaDemodSettings::serialize() const
     SimpleSerializer s(1);
     s.writeS32(1, m_centerFrequency);
     s.writeS32(2, m_bandwidthIndex);
-    s.writeS32(3, m_spread);
 
     if (m_spectrumGUI) {
         s.writeBlob(4, m_spectrumGUI->serialize());
@@ -42,6 +43,7 @@ QByteArray LoRaDemodSettings::serialize() const
     }
 
     s.writeString(6, m_title);
+    s.writeS32(7, m_spread);
 
     return s.final();
 }
@@ -59,10 +61,10 @@ bool LoRaDemodSettings::deserialize(const QByteArray& data)
     if(d.getVersion() == 1)
     {
         QByteArray bytetmp;
+        int tmp;
 
         d.readS32(1, &m_centerFrequency, 0);
         d.readS32(2, &m_bandwidthIndex, 0);
-        d.readS32(3, &m_spread, 0);
 
         if (m_spectrumGUI) {
             d.readBlob(4, &bytetmp);
@@ -75,6 +77,9 @@ bool LoRaDemodSettings::deserialize(const QByteArray& data)
         }
 
         d.readString(6, &m_title, "LoRa Demodulator");
+        // key 3 held an unused spread value with another meaning: it is not migrated
+        d.readS32(7, &tmp, 0);
+        m_spread = tmp < 0 ? 0 : tmp > nb_spreadFactors + 1 ? nb_spreadFactors + 1 : tmp;
 
         return true;
     }
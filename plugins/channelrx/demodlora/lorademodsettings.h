@@ -13,7 +13,7 @@ struct LoRaDemodSettings
 {
     int m_centerFrequency;
     int m_bandwidthIndex;
-    int m_spread;
+    int m_spread; //!< 0: legacy 6:4 2^8, 1 to nb_spreadFactors: one spreading factor, nb_spreadFactors + 1: all spreading factors
     uint32_t m_rgbColor;
     QString m_title;
 
@@ -22,6 +22,8 @@ struct LoRaDemodSettings
 
     static const int bandwidths[];
     static const int nb_bandwidths;
+    static const int spreadFactors[];
+    static const int nb_spreadFactors;
 
     LoRaDemodSettings();
     void resetToDefaults();
@@ -15,13 +15,17 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <QTime>
+#include <QThread>
 #include <QDebug>
 #include <stdio.h>
 
 #include "dsp/dsptypes.h"
 #include "dsp/basebandsamplesink.h"
 
+#include "lorademoddechirper.h"
 #include "lorademodsink.h"
 
 const int LoRaDemodSink::DATA_BITS = 6;
@@ -31,7 +35,8 @@ const int LoRaDemodSink::LORA_SFFT_LEN = (LoRaDemodSink::SPREADFACTOR / 2);
 const int LoRaDemodSink::LORA_SQUELCH = 3;
 
 LoRaDemodSink::LoRaDemodSink() :
-        m_spectrumSink(nullptr)
+        m_spectrumSink(nullptr),
+        m_chipBatchSize(1)
 {
 	m_Bandwidth = LoRaDemodSettings::bandwidths[0];
 	m_channelSampleRate = 96000;
@@ -58,6 +63,7 @@ LoRaDemodSink::LoRaDemodSink() :
 
 LoRaDemodSink::~LoRaDemodSink()
 {
+    destroyDechirpers();
     delete loraFilter;
 	delete negaFilter;
 	delete [] mov;
@@ -231,18 +237,33 @@ void LoRaDemodSink::feed(const SampleVector::const_iterator& begin, const Sample
 
 		if (m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
-			m_chirp = (m_chirp + 1) & (SPREADFACTOR - 1);
-                        m_angle = (m_angle + m_chirp) & (SPREADFACTOR - 1);
-			Complex cangle(cos(M_PI*2*m_angle/SPREADFACTOR),-sin(M_PI*2*m_angle/SPREADFACTOR));
-			newangle = detect(ci, cangle);
-
-			m_bin = (m_bin + newangle) & (LORA_SFFT_LEN - 1);
-			Complex nangle(cos(M_PI*2*m_bin/LORA_SFFT_LEN),sin(M_PI*2*m_bin/LORA_SFFT_LEN));
-			m_sampleBuffer.push_back(Sample(nangle.real() * 100, nangle.imag() * 100));
+            if (m_dechirpers.size() > 0)
+            {
+                m_chipBuffer.push_back(ci);
+                m_sampleBuffer.push_back(Sample(ci.real() * SDR_RX_SCALEF, ci.imag() * SDR_RX_SCALEF));
+            }
+            else
+            {
+                m_chirp = (m_chirp + 1) & (SPREADFACTOR - 1);
+                m_angle = (m_angle + m_chirp) & (SPREADFACTOR - 1);
+                Complex cangle(cos(M_PI*2*m_angle/SPREADFACTOR),-sin(M_PI*2*m_angle/SPREADFACTOR));
+                newangle = detect(ci, cangle);
+
+                m_bin = (m_bin + newangle) & (LORA_SFFT_LEN - 1);
+                Complex nangle(cos(M_PI*2*m_bin/LORA_SFFT_LEN),sin(M_PI*2*m_bin/LORA_SFFT_LEN));
+                m_sampleBuffer.push_back(Sample(nangle.real() * 100, nangle.imag() * 100));
+            }
+
 			m_sampleDistanceRemain += (Real) m_channelSampleRate / m_Bandwidth;
 		}
 	}
 
+    if ((m_dechirpers.size() > 0) && (m_chipBuffer.size() >= m_chipBatchSize)) // whole symbols of the largest spreading factor
+    {
+        runDechirpers();
+        m_chipBuffer.clear();
+    }
+
 	if (m_spectrumSink) {
 		m_spectrumSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), false);
 	}
@@ -282,5 +303,64 @@ void LoRaDemodSink::applySettings(const LoRaDemodSettings& settings, bool force)
             << " m_title: " << settings.m_title
             << " force: " << force;
 
+    if ((settings.m_spread != m_settings.m_spread) || force) {
+        createDechirpers(settings.m_spread);
+    }
+
     m_settings = settings;
 }
+
+void LoRaDemodSink::createDechirpers(int spread)
+{
+    destroyDechirpers();
+
+    if ((spread > 0) && (spread <= LoRaDemodSettings::nb_spreadFactors)) { // one spreading factor
+        m_dechirpers.push_back(new LoRaDemodDechirper(LoRaDemodSettings::spreadFactors[spread - 1]));
+    }
+    else if (spread > LoRaDemodSettings::nb_spreadFactors) // all spreading factors
+    {
+        for (int i = 0; i < LoRaDemodSettings::nb_spreadFactors; i++) {
+            m_dechirpers.push_back(new LoRaDemodDechirper(LoRaDemodSettings::spreadFactors[i]));
+        }
+    }
+
+    int maxSpreadFactor = 0;
+
+    for (LoRaDemodDechirper *dechirper : m_dechirpers) {
+        maxSpreadFactor = std::max(maxSpreadFactor, dechirper->getSpreadFactor());
+    }
+
+    m_chipBatchSize = 1 << maxSpreadFactor;
+    m_chipBuffer.reserve(2*m_chipBatchSize);
+
+    // the first dechirper runs in the sink thread
+    m_threadPool.setMaxThreadCount(std::max(1, std::min((int) m_dechirpers.size() - 1, QThread::idealThreadCount())));
+    qDebug("LoRaDemodSink::createDechirpers: %u dechirpers", (unsigned int) m_dechirpers.size());
+}
+
+void LoRaDemodSink::destroyDechirpers()
+{
+    for (LoRaDemodDechirper *dechirper : m_dechirpers) {
+        delete dechirper;
+    }
+
+    m_dechirpers.clear();
+    m_chipBuffer.clear();
+}
+
+void LoRaDemodSink::runDechirpers()
+{
+    for (LoRaDemodDechirper *dechirper : m_dechirpers) {
+        dechirper->setBlock(m_chipBuffer.data(), m_chipBuffer.size());
+    }
+
+    for (unsigned int i = 1; i < m_dechirpers.size(); i++) {
+        m_threadPool.start(m_dechirpers[i]);
+    }
+
+    m_dechirpers[0]->run();
+
+    if (m_dechirpers.size() > 1) {
+        m_threadPool.waitForDone();
+    }
+}
@@ -20,6 +20,8 @@
 
 #include <vector>
 
+#include <QThreadPool>
+
 #include "dsp/channelsamplesink.h"
 #include "dsp/nco.h"
 #include "dsp/interpolator.h"
@@ -29,6 +31,7 @@
 #include "lorademodsettings.h"
 
 class BasebandSampleSink;
+class LoRaDemodDechirper;
 
 class LoRaDemodSink : public ChannelSampleSink {
 public:
@@ -68,6 +71,11 @@ private:
 	BasebandSampleSink* m_spectrumSink;
 	SampleVector m_sampleBuffer;
 
+    std::vector<LoRaDemodDechirper*> m_dechirpers; //!< dechirp and FFT demodulators one per spreading factor
+    std::vector<Complex> m_chipBuffer;             //!< chip rate samples shared by the dechirpers
+    unsigned int m_chipBatchSize;                  //!< dechirpers run when the chip buffer holds at least this many samples
+    QThreadPool m_threadPool;                      //!< runs the dechirpers in parallel
+
     static const int DATA_BITS;
     static const int SAMPLEBITS;
     static const int SPREADFACTOR;
@@ -77,6 +85,9 @@ private:
 	int  detect(Complex sample, Complex angle);
 	void dumpRaw(void);
 	short synch (short bin);
+    void createDechirpers(int spread);
+    void destroyDechirpers();
+    void runDechirpers();
 
     /*
     Interleaving is "easiest" if the same number of bits is used per symbol as for FEC
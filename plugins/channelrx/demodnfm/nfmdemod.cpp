@@ -373,6 +373,15 @@ int NFMDemod::webapiReportGet(
     return 200;
 }
 
+bool NFMDemod::getMetrics(Metrics& metrics) const
+{
+    metrics.m_channelPowerDB = CalcDb::dbPower(m_basebandSink->getMagSq());
+    metrics.m_squelch = m_basebandSink->getSquelchOpen() ? 1 : 0;
+    metrics.m_channelSampleRate = m_basebandSink->getChannelSampleRate();
+    metrics.m_audioSampleRate = m_basebandSink->getAudioSampleRate();
+    return true;
+}
+
 void NFMDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const NFMDemodSettings& settings)
 {
     response.getNfmDemodSettings()->setAfBandwidth(settings.m_afBandwidth);
@@ -101,6 +101,8 @@ public:
             SWGSDRangel::SWGChannelReport& response,
             QString& errorMessage);
 
+    virtual bool getMetrics(Metrics& metrics) const;
+
     static void webapiFormatChannelSettings(
         SWGSDRangel::SWGChannelSettings& response,
         const NFMDemodSettings& settings);
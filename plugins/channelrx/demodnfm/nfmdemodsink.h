@@ -52,6 +52,7 @@ public:
 	}
 
 	bool getSquelchOpen() const { return m_squelchOpen; }
+	double getMagSq() const { return m_movingAverage.asDouble(); } //!< Squelch moving average, does not reset
 
     void getMagSqLevels(double& avg, double& peak, int& nbSamples)
     {
@@ -110,6 +111,8 @@ private:
 	Interpolator m_interpolator;
 	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
+	std::vector<Complex> m_interpolatorIn;
+	std::vector<Complex> m_interpolatorOut;
 	Lowpass<Real> m_ctcssLowpass;
 	Bandpass<Real> m_bandpass;
     Lowpass<Real> m_lowpass;
@@ -383,6 +383,14 @@ int SSBDemod::webapiReportGet(
     return 200;
 }
 
+bool SSBDemod::getMetrics(Metrics& metrics) const
+{
+    metrics.m_channelPowerDB = CalcDb::dbPower(m_basebandSink->getMagSq());
+    metrics.m_channelSampleRate = m_basebandSink->getChannelSampleRate();
+    metrics.m_audioSampleRate = m_basebandSink->getAudioSampleRate();
+    return true;
+}
+
 void SSBDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const SSBDemodSettings& settings)
 {
     response.getSsbDemodSettings()->setAudioMute(settings.m_audioMute ? 1 : 0);
@@ -86,29 +86,24 @@ SSBDemodSink::~SSBDemodSink()
 
 void SSBDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
-    Complex ci;
+    int nbIn = end - begin;
 
-	for(SampleVector::const_iterator it = begin; it < end; ++it)
-	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+    if (m_interpolatorIn.size() < (unsigned int) nbIn) {
+        m_interpolatorIn.resize(nbIn);
+    }
 
-        if (m_interpolatorDistance < 1.0f) // interpolate
-        {
-            while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
-        }
-        else
-        {
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
-            }
-        }
+    m_nco.nextIQMul(&(*begin), m_interpolatorIn.data(), nbIn);
+
+    int nbOut;
+
+    if (m_interpolatorDistance < 1.0f) { // interpolate
+        nbOut = m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_interpolatorIn.data(), nbIn, m_interpolatorOut);
+    } else { // decimate
+        nbOut = m_interpolator.decimate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_interpolatorIn.data(), nbIn, m_interpolatorOut);
+    }
+
+    for (int i = 0; i < nbOut; i++) {
+        processOneSample(m_interpolatorOut[i]);
     }
 }
 
@@ -110,6 +110,8 @@ private:
     Interpolator m_interpolator;
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
+    std::vector<Complex> m_interpolatorIn;
+    std::vector<Complex> m_interpolatorOut;
 	fftfilt* SSBFilter;
 	fftfilt* DSBFilter;
 
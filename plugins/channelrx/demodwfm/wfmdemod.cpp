@@ -335,6 +335,15 @@ int WFMDemod::webapiReportGet(
     return 200;
 }
 
+bool WFMDemod::getMetrics(Metrics& metrics) const
+{
+    metrics.m_channelPowerDB = CalcDb::dbPower(m_basebandSink->getMagSq());
+    metrics.m_squelch = m_basebandSink->getSquelchOpen() ? 1 : 0;
+    metrics.m_channelSampleRate = m_basebandSink->getChannelSampleRate();
+    metrics.m_audioSampleRate = m_basebandSink->getAudioSampleRate();
+    return true;
+}
+
 void WFMDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const WFMDemodSettings& settings)
 {
     response.getWfmDemodSettings()->setInputFrequencyOffset(settings.m_inputFrequencyOffset);
@@ -106,6 +106,8 @@ public:
             SWGSDRangel::SWGChannelReport& response,
             QString& errorMessage);
 
+    virtual bool getMetrics(Metrics& metrics) const;
+
     static void webapiFormatChannelSettings(
         SWGSDRangel::SWGChannelSettings& response,
         const WFMDemodSettings& settings);
@@ -39,6 +39,8 @@ AMModSource::AMModSource() :
 	m_feedbackAudioBufferFill = 0;
 
 	m_magsq = 0.0;
+    m_mixBlockIndex = 0;
+    m_mixBlockFill = 0;
 
     applySettings(m_settings, true);
     applyChannelSettings(m_channelSampleRate, m_channelFrequencyOffset, true);
@@ -50,13 +52,75 @@ AMModSource::~AMModSource()
 
 void AMModSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
 {
-    std::for_each(
-        begin,
-        begin + nbSamples,
-        [this](Sample& s) {
-            pullOne(s);
+	if (m_settings.m_channelMute)
+	{
+        std::fill(begin, begin + nbSamples, Sample());
+		return;
+	}
+
+    unsigned int i = 0;
+
+    while (i < nbSamples)
+    {
+        if (m_mixBlockIndex == m_mixBlockFill) {
+            modulateBlock(nbSamples - i);
+        }
+
+        unsigned int n = std::min(nbSamples - i, m_mixBlockFill - m_mixBlockIndex);
+
+        for (unsigned int k = 0; k < n; k++) {
+            outputSample(m_mixBlock[m_mixBlockIndex + k], *(begin + i + k));
         }
-    );
+
+        m_mixBlockIndex += n;
+        i += n;
+    }
+}
+
+/**
+ * Modulate a block of audio samples yielding about nbSamples samples at channel rate.
+ * Samples in excess are output by the next pull() or pullOne() calls.
+ */
+void AMModSource::modulateBlock(unsigned int nbSamples)
+{
+    int nbIn = std::max(1, (int) (nbSamples * m_interpolatorDistance));
+
+    if (m_modBlock.size() < (unsigned int) nbIn) {
+        m_modBlock.resize(nbIn);
+    }
+
+    for (int i = 0; i < nbIn; i++)
+    {
+        modulateSample();
+        m_modBlock[i] = m_modSample;
+    }
+
+    int nbOut;
+
+    if (m_interpolatorDistance > 1.0f) { // decimate
+        nbOut = m_interpolator.decimate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_modBlock.data(), nbIn, m_interpBlock);
+    } else {
+        nbOut = m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_modBlock.data(), nbIn, m_interpBlock);
+    }
+
+    if (m_mixBlock.size() < (unsigned int) nbOut) {
+        m_mixBlock.resize(nbOut);
+    }
+
+    m_carrierNco.nextIQMul(m_interpBlock.data(), m_mixBlock.data(), nbOut); // shift to carrier frequency
+    m_mixBlockIndex = 0;
+    m_mixBlockFill = nbOut;
+}
+
+void AMModSource::outputSample(const Complex& ci, Sample& sample)
+{
+    double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
+	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
+	m_movingAverage(magsq);
+	m_magsq = m_movingAverage.asDouble();
+
+	sample.m_real = (FixReal) ci.real();
+	sample.m_imag = (FixReal) ci.imag();
 }
 
 void AMModSource::pullOne(Sample& sample)
@@ -68,6 +132,12 @@ void AMModSource::pullOne(Sample& sample)
 		return;
 	}
 
+    if (m_mixBlockIndex < m_mixBlockFill) // leftover of the last block
+    {
+        outputSample(m_mixBlock[m_mixBlockIndex++], sample);
+        return;
+    }
+
 	Complex ci;
 
     if (m_interpolatorDistance > 1.0f) // decimate
@@ -90,13 +160,7 @@ void AMModSource::pullOne(Sample& sample)
     m_interpolatorDistanceRemain += m_interpolatorDistance;
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
-    double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
-	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
-	m_movingAverage(magsq);
-	m_magsq = m_movingAverage.asDouble();
-
-	sample.m_real = (FixReal) ci.real();
-	sample.m_imag = (FixReal) ci.imag();
+    outputSample(ci, sample);
 }
 
 void AMModSource::prefetch(unsigned int nbSamples)
@@ -274,6 +338,8 @@ void AMModSource::applyAudioSampleRate(int sampleRate)
 
     m_interpolatorDistanceRemain = 0;
     m_interpolatorConsumed = false;
+    m_mixBlockIndex = 0;
+    m_mixBlockFill = 0;
     m_interpolatorDistance = (Real) sampleRate / (Real) m_channelSampleRate;
     m_interpolator.create(48, sampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
     m_toneNco.setFreq(m_settings.m_toneFrequency, sampleRate);
@@ -333,6 +399,8 @@ void AMModSource::applyChannelSettings(int channelSampleRate, int channelFrequen
     {
         m_interpolatorDistanceRemain = 0;
         m_interpolatorConsumed = false;
+        m_mixBlockIndex = 0;
+        m_mixBlockFill = 0;
         m_interpolatorDistance = (Real) m_audioSampleRate / (Real) channelSampleRate;
         m_interpolator.create(48, m_audioSampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
     }
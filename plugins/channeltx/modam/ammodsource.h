@@ -74,6 +74,11 @@ private:
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
     bool m_interpolatorConsumed;
+    std::vector<Complex> m_modBlock;    //!< block of modulated samples at audio rate
+    std::vector<Complex> m_interpBlock; //!< modulated samples at channel rate
+    std::vector<Complex> m_mixBlock;    //!< modulated samples shifted to carrier frequency
+    unsigned int m_mixBlockIndex;       //!< next sample of m_mixBlock to output
+    unsigned int m_mixBlockFill;        //!< number of valid samples in m_mixBlock
 
     Interpolator m_feedbackInterpolator;
     Real m_feedbackInterpolatorDistance;
@@ -110,6 +115,8 @@ private:
     void pushFeedback(Real sample);
     void calculateLevel(Real& sample);
     void modulateSample();
+    void modulateBlock(unsigned int nbSamples);
+    void outputSample(const Complex& ci, Sample& sample);
 };
 
 
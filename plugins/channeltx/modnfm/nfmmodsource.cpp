@@ -26,6 +26,8 @@ NFMModSource::NFMModSource() :
     m_channelSampleRate(48000),
     m_channelFrequencyOffset(0),
     m_modPhasor(0.0f),
+    m_mixBlockIndex(0),
+    m_mixBlockFill(0),
     m_audioFifo(4800),
     m_feedbackAudioFifo(48000),
 	m_levelCalcCount(0),
@@ -53,13 +55,75 @@ NFMModSource::~NFMModSource()
 
 void NFMModSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
 {
-    std::for_each(
-        begin,
-        begin + nbSamples,
-        [this](Sample& s) {
-            pullOne(s);
+	if (m_settings.m_channelMute)
+	{
+        std::fill(begin, begin + nbSamples, Sample());
+		return;
+	}
+
+    unsigned int i = 0;
+
+    while (i < nbSamples)
+    {
+        if (m_mixBlockIndex == m_mixBlockFill) {
+            modulateBlock(nbSamples - i);
+        }
+
+        unsigned int n = std::min(nbSamples - i, m_mixBlockFill - m_mixBlockIndex);
+
+        for (unsigned int k = 0; k < n; k++) {
+            outputSample(m_mixBlock[m_mixBlockIndex + k], *(begin + i + k));
         }
-    );
+
+        m_mixBlockIndex += n;
+        i += n;
+    }
+}
+
+/**
+ * Modulate a block of audio samples yielding about nbSamples samples at channel rate.
+ * Samples in excess are output by the next pull() or pullOne() calls.
+ */
+void NFMModSource::modulateBlock(unsigned int nbSamples)
+{
+    int nbIn = std::max(1, (int) (nbSamples * m_interpolatorDistance));
+
+    if (m_modBlock.size() < (unsigned int) nbIn) {
+        m_modBlock.resize(nbIn);
+    }
+
+    for (int i = 0; i < nbIn; i++)
+    {
+        modulateSample();
+        m_modBlock[i] = m_modSample;
+    }
+
+    int nbOut;
+
+    if (m_interpolatorDistance > 1.0f) { // decimate
+        nbOut = m_interpolator.decimate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_modBlock.data(), nbIn, m_interpBlock);
+    } else {
+        nbOut = m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_interpolatorDistance, m_modBlock.data(), nbIn, m_interpBlock);
+    }
+
+    if (m_mixBlock.size() < (unsigned int) nbOut) {
+        m_mixBlock.resize(nbOut);
+    }
+
+    m_carrierNco.nextIQMul(m_interpBlock.data(), m_mixBlock.data(), nbOut); // shift to carrier frequency
+    m_mixBlockIndex = 0;
+    m_mixBlockFill = nbOut;
+}
+
+void NFMModSource::outputSample(const Complex& ci, Sample& sample)
+{
+    double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
+	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
+	m_movingAverage(magsq);
+	m_magsq = m_movingAverage.asDouble();
+
+	sample.m_real = (FixReal) ci.real();
+	sample.m_imag = (FixReal) ci.imag();
 }
 
 void NFMModSource::pullOne(Sample& sample)
@@ -71,6 +135,12 @@ void NFMModSource::pullOne(Sample& sample)
 		return;
 	}
 
+    if (m_mixBlockIndex < m_mixBlockFill) // leftover of the last block
+    {
+        outputSample(m_mixBlock[m_mixBlockIndex++], sample);
+        return;
+    }
+
 	Complex ci;
 
     if (m_interpolatorDistance > 1.0f) // decimate
@@ -93,14 +163,7 @@ void NFMModSource::pullOne(Sample& sample)
     m_interpolatorDistanceRemain += m_interpolatorDistance;
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
-
-    double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
-	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
-	m_movingAverage(magsq);
-	m_magsq = m_movingAverage.asDouble();
-
-	sample.m_real = (FixReal) ci.real();
-	sample.m_imag = (FixReal) ci.imag();
+    outputSample(ci, sample);
 }
 
 void NFMModSource::prefetch(unsigned int nbSamples)
@@ -294,6 +357,8 @@ void NFMModSource::applyAudioSampleRate(int sampleRate)
 
     m_interpolatorDistanceRemain = 0;
     m_interpolatorConsumed = false;
+    m_mixBlockIndex = 0;
+    m_mixBlockFill = 0;
     m_interpolatorDistance = (Real) sampleRate / (Real) m_channelSampleRate;
     m_interpolator.create(48, sampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
     m_lowpass.create(301, sampleRate, 250.0);
@@ -362,6 +427,8 @@ void NFMModSource::applyChannelSettings(int channelSampleRate, int channelFreque
     {
         m_interpolatorDistanceRemain = 0;
         m_interpolatorConsumed = false;
+        m_mixBlockIndex = 0;
+        m_mixBlockFill = 0;
         m_interpolatorDistance = (Real) m_audioSampleRate / (Real) channelSampleRate;
         m_interpolator.create(48, m_audioSampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
     }
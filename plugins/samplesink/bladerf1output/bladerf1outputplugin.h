@@ -37,6 +37,7 @@ public:
 	void initPlugin(PluginAPI* pluginAPI);
 
 	virtual void enumOriginDevices(QStringList& listedHwIds, OriginDevices& originDevices);
+	virtual bool isEnumerationThreadSafe() const { return false; } // libbladeRF
 	virtual SamplingDevices enumSampleSinks(const OriginDevices& originDevices);
 
 	virtual PluginInstanceGUI* createSampleSinkPluginInstanceGUI(
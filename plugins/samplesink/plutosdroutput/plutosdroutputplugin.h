@@ -37,6 +37,7 @@ public:
 	void initPlugin(PluginAPI* pluginAPI);
 
 	virtual void enumOriginDevices(QStringList& listedHwIds, OriginDevices& originDevices);
+	virtual bool isEnumerationCacheable() const { return false; } // DevicePlutoSDR scan, devices over IP
 	virtual SamplingDevices enumSampleSinks(const OriginDevices& originDevices);
 	virtual PluginInstanceGUI* createSampleSinkPluginInstanceGUI(
 	        const QString& sinkId,
@@ -33,6 +33,7 @@
 #include "gui/basicdevicesettingsdialog.h"
 #include "dsp/dspengine.h"
 #include "dsp/dspcommands.h"
+#include "dsp/deviceresampler.h"
 
 AirspyGui::AirspyGui(DeviceUISet *deviceUISet, QWidget* parent) :
 	QWidget(parent),
@@ -50,6 +51,9 @@ AirspyGui::AirspyGui(DeviceUISet *deviceUISet, QWidget* parent) :
 	ui->centerFrequency->setColorMapper(ColorMapper(ColorMapper::GrayGold));
 	updateFrequencyLimits();
 
+    ui->resampleRate->setColorMapper(ColorMapper(ColorMapper::GrayGreenYellow));
+    ui->resampleRate->setValueRange(8, 0, 99999999);
+
 	connect(&m_updateTimer, SIGNAL(timeout()), this, SLOT(updateHardware()));
 	connect(&m_statusTimer, SIGNAL(timeout()), this, SLOT(updateStatus()));
 	m_statusTimer.start(500);
@@ -214,6 +218,8 @@ void AirspyGui::displaySettings()
 	ui->sampleRate->setCurrentIndex(m_settings.m_devSampleRateIndex);
 
 	ui->biasT->setChecked(m_settings.m_biasT);
+	ui->pipelined->setChecked(m_settings.m_pipelined);
+	ui->resampleRate->setValue(m_settings.m_resampleRate);
 	ui->dcOffset->setChecked(m_settings.m_dcBlock);
 	ui->iqImbalance->setChecked(m_settings.m_iqCorrection);
 
@@ -304,6 +310,33 @@ void AirspyGui::on_biasT_stateChanged(int state)
 	sendSettings();
 }
 
+void AirspyGui::on_pipelined_toggled(bool checked)
+{
+	m_settings.m_pipelined = checked;
+	sendSettings();
+}
+
+void AirspyGui::on_resampleRate_changed(quint64 value)
+{
+	m_settings.m_resampleRate = value;
+	sendSettings();
+}
+
+void AirspyGui::clampResampleRate()
+{
+	if (m_settings.m_devSampleRateIndex >= m_rates.size()) {
+		return;
+	}
+
+	int resampleRate = DeviceResampler::clampOutputRate(m_rates[m_settings.m_devSampleRateIndex] >> m_settings.m_log2Decim, m_settings.m_resampleRate);
+
+	if (resampleRate != m_settings.m_resampleRate)
+	{
+		m_settings.m_resampleRate = resampleRate;
+		ui->resampleRate->setValue(resampleRate);
+	}
+}
+
 void AirspyGui::on_lnaAGC_stateChanged(int state)
 {
 	m_settings.m_lnaAGC = (state == Qt::Checked);
@@ -391,6 +424,7 @@ void AirspyGui::on_transverter_clicked()
 void AirspyGui::updateHardware()
 {
 	qDebug() << "AirspyGui::updateHardware";
+	clampResampleRate();
 	AirspyInput::MsgConfigureAirspy* message = AirspyInput::MsgConfigureAirspy::create(m_settings, m_forceSettings);
 	m_sampleSource->getInputMessageQueue()->push(message);
 	m_forceSettings = false;
@@ -73,6 +73,7 @@ private:
 	void displaySettings();
 	void displaySampleRates();
 	void sendSettings();
+	void clampResampleRate(); //!< keep the resampler ratio within the supported range
     void updateSampleRateAndFrequency();
     void updateFrequencyLimits();
 
@@ -83,6 +84,8 @@ private slots:
 	void on_iqImbalance_toggled(bool checked);
 	void on_sampleRate_currentIndexChanged(int index);
 	void on_biasT_stateChanged(int state);
+	void on_pipelined_toggled(bool checked);
+	void on_resampleRate_changed(quint64 value);
 	void on_decim_currentIndexChanged(int index);
 	void on_fcPos_currentIndexChanged(int index);
 	void on_lna_valueChanged(int value);
@@ -34,6 +34,7 @@
 #include "device/deviceapi.h"
 #include "dsp/dspcommands.h"
 #include "dsp/dspengine.h"
+#include "dsp/deviceresampler.h"
 #include "airspysettings.h"
 #include "airspyworker.h"
 
@@ -172,12 +173,14 @@ bool AirspyInput::start()
         stop();
     }
 
-	m_airspyWorker = new AirspyWorker(m_dev, &m_sampleFifo);
+	m_airspyWorker = new AirspyWorker(m_dev, &m_sampleFifo, &m_callbackStats);
     m_airspyWorker->moveToThread(&m_airspyWorkerThread);
 	m_airspyWorker->setSamplerate(m_sampleRates[m_settings.m_devSampleRateIndex]);
 	m_airspyWorker->setLog2Decimation(m_settings.m_log2Decim);
     m_airspyWorker->setIQOrder(m_settings.m_iqOrder);
 	m_airspyWorker->setFcPos((int) m_settings.m_fcPos);
+    m_airspyWorker->setPipelined(m_settings.m_pipelined);
+    m_airspyWorker->setResampleRate(m_settings.m_resampleRate);
     mutexLocker.unlock();
 
     if (startWorker())
@@ -277,7 +280,7 @@ const QString& AirspyInput::getDeviceDescription() const
 int AirspyInput::getSampleRate() const
 {
 	int rate = m_sampleRates[m_settings.m_devSampleRateIndex];
-	return (rate / (1<<m_settings.m_log2Decim));
+	return DeviceResampler::getOutputRate(rate / (1<<m_settings.m_log2Decim), m_settings.m_resampleRate);
 }
 
 quint64 AirspyInput::getCenterFrequency() const
@@ -427,6 +430,30 @@ bool AirspyInput::applySettings(const AirspySettings& settings, bool force)
 		}
 	}
 
+	if (m_settings.m_pipelined != settings.m_pipelined)
+	{
+        reverseAPIKeys.append("pipelined");
+
+		if (m_airspyWorker) // the decimation stage is set up when the worker starts
+		{
+			stopWorker();
+			m_airspyWorker->setPipelined(settings.m_pipelined);
+			startWorker();
+		}
+	}
+
+	if ((m_settings.m_resampleRate != settings.m_resampleRate) || force)
+	{
+        reverseAPIKeys.append("resampleRate");
+		forwardChange = true;
+
+		if (m_airspyWorker)
+		{
+			m_airspyWorker->setResampleRate(settings.m_resampleRate);
+			qDebug("AirspyInput::applySettings: resample rate set to %d", settings.m_resampleRate);
+		}
+	}
+
     if ((m_settings.m_centerFrequency != settings.m_centerFrequency) || force) {
         reverseAPIKeys.append("centerFrequency");
     }
@@ -582,7 +609,7 @@ bool AirspyInput::applySettings(const AirspySettings& settings, bool force)
 
 	if (forwardChange)
 	{
-		int sampleRate = m_sampleRates[m_settings.m_devSampleRateIndex]/(1<<m_settings.m_log2Decim);
+		int sampleRate = getSampleRate();
 		DSPSignalNotification *notif = new DSPSignalNotification(sampleRate, m_settings.m_centerFrequency);
         m_deviceAPI->getDeviceEngineInputMessageQueue()->push(notif);
 	}
@@ -665,6 +692,12 @@ int AirspyInput::webapiSettingsPutPatch(
     AirspySettings settings = m_settings;
     webapiUpdateDeviceSettings(settings, deviceSettingsKeys, response);
 
+    if (settings.m_devSampleRateIndex < m_sampleRates.size())
+    {
+        settings.m_resampleRate = DeviceResampler::clampOutputRate(
+            m_sampleRates[settings.m_devSampleRateIndex] >> settings.m_log2Decim, settings.m_resampleRate);
+    }
+
     MsgConfigureAirspy *msg = MsgConfigureAirspy::create(settings, force);
     m_inputMessageQueue.push(msg);
 
@@ -713,6 +746,12 @@ void AirspyInput::webapiUpdateDeviceSettings(
     if (deviceSettingsKeys.contains("iqOrder")) {
         settings.m_iqOrder = response.getAirspySettings()->getIqOrder() != 0;
     }
+    if (deviceSettingsKeys.contains("resampleRate")) {
+        settings.m_resampleRate = response.getAirspySettings()->getResampleRate();
+    }
+    if (deviceSettingsKeys.contains("pipelined")) {
+        settings.m_pipelined = response.getAirspySettings()->getPipelined() != 0;
+    }
     if (deviceSettingsKeys.contains("fcPos")) {
         int fcPos = response.getAirspySettings()->getFcPos();
         fcPos = fcPos < 0 ? 0 : fcPos > 2 ? 2 : fcPos;
@@ -770,6 +809,8 @@ void AirspyInput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings& res
     response.getAirspySettings()->setMixerAgc(settings.m_mixerAGC ? 1 : 0);
     response.getAirspySettings()->setLog2Decim(settings.m_log2Decim);
     response.getAirspySettings()->setIqOrder(settings.m_iqOrder ? 1 : 0);
+    response.getAirspySettings()->setResampleRate(settings.m_resampleRate);
+    response.getAirspySettings()->setPipelined(settings.m_pipelined ? 1 : 0);
     response.getAirspySettings()->setFcPos((int) settings.m_fcPos);
     response.getAirspySettings()->setBiasT(settings.m_biasT ? 1 : 0);
     response.getAirspySettings()->setDcBlock(settings.m_dcBlock ? 1 : 0);
@@ -841,6 +882,12 @@ void AirspyInput::webapiReverseSendSettings(QList<QString>& deviceSettingsKeys,
     if (deviceSettingsKeys.contains("iqOrder") || force) {
         swgAirspySettings->setIqOrder(settings.m_iqOrder ? 1 : 0);
     }
+    if (deviceSettingsKeys.contains("resampleRate") || force) {
+        swgAirspySettings->setResampleRate(settings.m_resampleRate);
+    }
+    if (deviceSettingsKeys.contains("pipelined") || force) {
+        swgAirspySettings->setPipelined(settings.m_pipelined ? 1 : 0);
+    }
     if (deviceSettingsKeys.contains("fcPos") || force) {
         swgAirspySettings->setFcPos((int) settings.m_fcPos);
     }
@@ -25,6 +25,7 @@
 
 #include <libairspy/airspy.h>
 #include <dsp/devicesamplesource.h>
+#include <dsp/devicecallbackstats.h>
 #include "airspysettings.h"
 
 class QNetworkAccessManager;
@@ -93,6 +94,7 @@ public:
 	virtual int getSampleRate() const;
     virtual void setSampleRate(int sampleRate) { (void) sampleRate; }
 	virtual quint64 getCenterFrequency() const;
+    virtual const DeviceCallbackStats* getCallbackStats() const { return &m_callbackStats; }
 	virtual void setCenterFrequency(qint64 centerFrequency);
 	const std::vector<uint32_t>& getSampleRates() const { return m_sampleRates; }
 
@@ -139,6 +141,7 @@ private:
 	AirspySettings m_settings;
 	struct airspy_device* m_dev;
 	AirspyWorker* m_airspyWorker;
+    DeviceCallbackStats m_callbackStats;
     QThread m_airspyWorkerThread;
 	QString m_deviceDescription;
 	std::vector<uint32_t> m_sampleRates;
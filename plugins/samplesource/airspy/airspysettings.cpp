@@ -42,6 +42,8 @@ void AirspySettings::resetToDefaults()
     m_transverterMode = false;
     m_transverterDeltaFrequency = 0;
     m_iqOrder = true;
+    m_pipelined = false;
+    m_resampleRate = 0;
     m_useReverseAPI = false;
     m_reverseAPIAddress = "127.0.0.1";
     m_reverseAPIPort = 8888;
@@ -71,6 +73,8 @@ QByteArray AirspySettings::serialize() const
     s.writeU32(17, m_reverseAPIPort);
     s.writeU32(18, m_reverseAPIDeviceIndex);
     s.writeBool(19, m_iqOrder);
+    s.writeBool(20, m_pipelined);
+    s.writeS32(21, m_resampleRate);
 
 	return s.final();
 }
@@ -118,6 +122,9 @@ bool AirspySettings::deserialize(const QByteArray& data)
         d.readU32(18, &uintval, 0);
         m_reverseAPIDeviceIndex = uintval > 99 ? 99 : uintval;
         d.readBool(19, &m_iqOrder, true);
+        d.readBool(20, &m_pipelined, false);
+        d.readS32(21, &intval, 0);
+        m_resampleRate = intval < 0 ? 0 : intval;
 
 		return true;
 	}
@@ -43,6 +43,8 @@ struct AirspySettings {
     bool m_transverterMode;
     qint64 m_transverterDeltaFrequency;
     bool m_iqOrder;
+    bool m_pipelined; //!< decimation in a separate thread from the USB callback
+    qint32 m_resampleRate; //!< baseband rate after the device resampler (S/s). 0 for none
     bool     m_useReverseAPI;
     QString  m_reverseAPIAddress;
     uint16_t m_reverseAPIPort;
@@ -19,11 +19,16 @@
 #include <errno.h>
 #include <algorithm>
 
+#include <QElapsedTimer>
+
 #include "airspyworker.h"
 
 #include "dsp/samplesinkfifo.h"
+#include "dsp/devicecallbackstats.h"
+
+#define AIRSPY_NB_BLOCKS 8
 
-AirspyWorker::AirspyWorker(struct airspy_device* dev, SampleSinkFifo* sampleFifo, QObject* parent) :
+AirspyWorker::AirspyWorker(struct airspy_device* dev, SampleSinkFifo* sampleFifo, DeviceCallbackStats* callbackStats, QObject* parent) :
 	QObject(parent),
 	m_running(false),
 	m_dev(dev),
@@ -32,7 +37,11 @@ AirspyWorker::AirspyWorker(struct airspy_device* dev, SampleSinkFifo* sampleFifo
 	m_samplerate(10),
 	m_log2Decim(0),
 	m_fcPos(0),
-    m_iqOrder(true)
+    m_iqOrder(true),
+    m_pipelined(false),
+    m_callbackStats(callbackStats),
+    m_pipeline(this, 2*AIRSPY_BLOCKSIZE*sizeof(qint16), AIRSPY_NB_BLOCKS, callbackStats),
+    m_resampleRate(0)
 {
 	std::fill(m_buf, m_buf + 2*AIRSPY_BLOCKSIZE, 0);
 }
@@ -46,6 +55,14 @@ bool AirspyWorker::startWork()
 {
 	airspy_error rc;
 
+	if (m_callbackStats) {
+		m_callbackStats->reset();
+	}
+
+	if (m_pipelined) {
+		m_pipeline.startWork();
+	}
+
 	rc = (airspy_error) airspy_start_rx(m_dev, rx_callback, this);
 
 	if (rc == AIRSPY_SUCCESS)
@@ -58,6 +75,10 @@ bool AirspyWorker::startWork()
         m_running = false;
     }
 
+    if (!m_running) {
+        m_pipeline.stopWork();
+    }
+
     return m_running;
 }
 
@@ -72,16 +93,35 @@ void AirspyWorker::stopWork()
 	}
 
 	m_running = false;
+	m_pipeline.stopWork();
+
+	if (m_callbackStats && (m_callbackStats->getCallbacks() != 0))
+	{
+		qDebug("AirspyWorker::stopWork: %llu callbacks avg: %llu us max: %llu us late: %llu overruns: %llu",
+			m_callbackStats->getCallbacks(),
+			m_callbackStats->getTotalNs() / (1000 * m_callbackStats->getCallbacks()),
+			m_callbackStats->getMaxNs() / 1000,
+			m_callbackStats->getLateCallbacks(),
+			m_callbackStats->getOverruns());
+	}
 }
 
 void AirspyWorker::setSamplerate(uint32_t samplerate)
 {
 	m_samplerate = samplerate;
+    m_resampler.configure(m_samplerate >> m_log2Decim, m_resampleRate);
 }
 
 void AirspyWorker::setLog2Decimation(unsigned int log2_decim)
 {
 	m_log2Decim = log2_decim;
+    m_resampler.configure(m_samplerate >> m_log2Decim, m_resampleRate);
+}
+
+void AirspyWorker::setResampleRate(int resampleRate)
+{
+    m_resampleRate = resampleRate;
+    m_resampler.configure(m_samplerate >> m_log2Decim, m_resampleRate);
 }
 
 void AirspyWorker::setFcPos(int fcPos)
@@ -180,7 +220,7 @@ void AirspyWorker::callbackIQ(const qint16* buf, qint32 len)
 		}
 	}
 
-	m_sampleFifo->write(m_convertBuffer.begin(), it);
+	m_resampler.write(m_sampleFifo, m_convertBuffer.begin(), it);
 }
 
 void AirspyWorker::callbackQI(const qint16* buf, qint32 len)
@@ -273,19 +313,34 @@ void AirspyWorker::callbackQI(const qint16* buf, qint32 len)
 		}
 	}
 
-	m_sampleFifo->write(m_convertBuffer.begin(), it);
+	m_resampler.write(m_sampleFifo, m_convertBuffer.begin(), it);
+}
+
+void AirspyWorker::processBlock(const quint8* buf, qint32 len)
+{
+    if (m_iqOrder) {
+    	callbackIQ((const qint16 *) buf, len);
+    } else {
+        callbackQI((const qint16 *) buf, len);
+    }
 }
 
 int AirspyWorker::rx_callback(airspy_transfer_t* transfer)
 {
     AirspyWorker *worker = (AirspyWorker*) transfer->ctx;
 	qint32 bytes_to_write = transfer->sample_count * sizeof(qint16);
+	QElapsedTimer timer;
+	timer.start();
 
-    if (worker->m_iqOrder) {
-    	worker->callbackIQ((qint16 *) transfer->samples, bytes_to_write);
-    } else {
-        worker->callbackQI((qint16 *) transfer->samples, bytes_to_write);
-    }
+	if (worker->m_pipelined) { // only copy: conversion and decimation are done in the pipeline thread
+		worker->m_pipeline.push(transfer->samples, bytes_to_write, sizeof(qint16));
+	} else {
+		worker->processBlock((const quint8 *) transfer->samples, bytes_to_write);
+	}
+
+	if (worker->m_callbackStats) {
+		worker->m_callbackStats->record(timer.nsecsElapsed(), worker->m_samplerate > 0 ? transfer->sample_count * 1000000000LL / worker->m_samplerate : 0);
+	}
 
     return 0;
 }
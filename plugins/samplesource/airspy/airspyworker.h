@@ -23,14 +23,18 @@
 
 #include "dsp/samplesinkfifo.h"
 #include "dsp/decimators.h"
+#include "dsp/rawblockpipeline.h"
+#include "dsp/deviceresampler.h"
 
 #define AIRSPY_BLOCKSIZE (1<<17)
 
-class AirspyWorker : public QObject {
+class DeviceCallbackStats;
+
+class AirspyWorker : public QObject, public RawBlockPipeline::Processor {
 	Q_OBJECT
 
 public:
-	AirspyWorker(struct airspy_device* dev, SampleSinkFifo* sampleFifo, QObject* parent = NULL);
+	AirspyWorker(struct airspy_device* dev, SampleSinkFifo* sampleFifo, DeviceCallbackStats* callbackStats, QObject* parent = NULL);
 	~AirspyWorker();
 
 	bool startWork();
@@ -39,6 +43,8 @@ public:
 	void setLog2Decimation(unsigned int log2_decim);
 	void setFcPos(int fcPos);
     void setIQOrder(bool iqOrder) { m_iqOrder = iqOrder; }
+    void setPipelined(bool pipelined) { m_pipelined = pipelined; } //!< applies on next start
+    void setResampleRate(int resampleRate); //!< 0 for no resampling
 
 private:
 	bool m_running;
@@ -52,12 +58,18 @@ private:
 	unsigned int m_log2Decim;
 	int m_fcPos;
     bool m_iqOrder;
+    bool m_pipelined;
+    DeviceCallbackStats* m_callbackStats;
+    RawBlockPipeline m_pipeline;
+    int m_resampleRate;
+    DeviceResampler m_resampler;
 
 	Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12, true> m_decimatorsIQ;
 	Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12, false> m_decimatorsQI;
 
 	void callbackIQ(const qint16* buf, qint32 len);
 	void callbackQI(const qint16* buf, qint32 len);
+	virtual void processBlock(const quint8* buf, qint32 len);
 	static int rx_callback(airspy_transfer_t* transfer);
 };
 
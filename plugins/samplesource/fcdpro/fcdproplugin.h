@@ -20,6 +20,7 @@ public:
 	void initPlugin(PluginAPI* pluginAPI);
 
 	virtual void enumOriginDevices(QStringList& listedHwIds, OriginDevices& originDevices);
+	virtual bool isEnumerationThreadSafe() const { return false; } // hidapi
 	virtual SamplingDevices enumSampleSources(const OriginDevices& originDevices);
 	virtual PluginInstanceGUI* createSampleSourcePluginInstanceGUI(
 	        const QString& sourceId,
@@ -37,6 +37,7 @@ public:
 	void initPlugin(PluginAPI* pluginAPI);
 
 	virtual void enumOriginDevices(QStringList& listedHwIds, OriginDevices& originDevices);
+	virtual bool isEnumerationCacheable() const { return false; } // DevicePerseus scan
 	virtual SamplingDevices enumSampleSources(const OriginDevices& originDevices);
 	virtual PluginInstanceGUI* createSampleSourcePluginInstanceGUI(
 	        const QString& sourceId,
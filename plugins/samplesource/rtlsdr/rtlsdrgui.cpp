@@ -31,6 +31,7 @@
 #include "gui/basicdevicesettingsdialog.h"
 #include "dsp/dspengine.h"
 #include "dsp/dspcommands.h"
+#include "dsp/deviceresampler.h"
 
 RTLSDRGui::RTLSDRGui(DeviceUISet *deviceUISet, QWidget* parent) :
 	QWidget(parent),
@@ -54,6 +55,9 @@ RTLSDRGui::RTLSDRGui(DeviceUISet *deviceUISet, QWidget* parent) :
     ui->rfBW->setColorMapper(ColorMapper(ColorMapper::GrayYellow));
     ui->rfBW->setValueRange(4, 350, 8000);
 
+    ui->resampleRate->setColorMapper(ColorMapper(ColorMapper::GrayGreenYellow));
+    ui->resampleRate->setValueRange(7, 0, 9999999);
+
 	connect(&m_updateTimer, SIGNAL(timeout()), this, SLOT(updateHardware()));
 	connect(&m_statusTimer, SIGNAL(timeout()), this, SLOT(updateStatus()));
 	m_statusTimer.start(500);
@@ -321,6 +325,8 @@ void RTLSDRGui::displaySettings()
 	ui->agc->setChecked(m_settings.m_agc);
 	ui->lowSampleRate->setChecked(m_settings.m_lowSampleRate);
 	ui->offsetTuning->setChecked(m_settings.m_offsetTuning);
+	ui->pipelined->setChecked(m_settings.m_pipelined);
+	ui->resampleRate->setValue(m_settings.m_resampleRate);
 }
 
 void RTLSDRGui::sendSettings()
@@ -425,6 +431,7 @@ void RTLSDRGui::updateHardware()
 {
     if (m_doApplySettings)
     {
+        clampResampleRate();
         RTLSDRInput::MsgConfigureRTLSDR* message = RTLSDRInput::MsgConfigureRTLSDR::create(m_settings, m_forceSettings);
         m_sampleSource->getInputMessageQueue()->push(message);
         m_forceSettings = false;
@@ -513,6 +520,29 @@ void RTLSDRGui::on_offsetTuning_toggled(bool checked)
     sendSettings();
 }
 
+void RTLSDRGui::on_pipelined_toggled(bool checked)
+{
+    m_settings.m_pipelined = checked;
+    sendSettings();
+}
+
+void RTLSDRGui::on_resampleRate_changed(quint64 value)
+{
+    m_settings.m_resampleRate = value;
+    sendSettings();
+}
+
+void RTLSDRGui::clampResampleRate()
+{
+    int resampleRate = DeviceResampler::clampOutputRate(m_settings.m_devSampleRate >> m_settings.m_log2Decim, m_settings.m_resampleRate);
+
+    if (resampleRate != m_settings.m_resampleRate)
+    {
+        m_settings.m_resampleRate = resampleRate;
+        ui->resampleRate->setValue(resampleRate);
+    }
+}
+
 void RTLSDRGui::on_rfBW_changed(quint64 value)
 {
     m_settings.m_rfBandwidth = value * 1000;
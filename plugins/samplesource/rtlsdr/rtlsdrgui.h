@@ -75,6 +75,7 @@ private:
     void displayFcTooltip();
 	void displaySettings();
 	void sendSettings();
+    void clampResampleRate(); //!< keep the resampler ratio within the supported range
 	void updateSampleRateAndFrequency();
 	void updateFrequencyLimits();
     void blockApplySettings(bool block);
@@ -84,6 +85,8 @@ private slots:
 	void on_centerFrequency_changed(quint64 value);
 	void on_sampleRate_changed(quint64 value);
 	void on_offsetTuning_toggled(bool checked);
+	void on_pipelined_toggled(bool checked);
+    void on_resampleRate_changed(quint64 value);
     void on_rfBW_changed(quint64 value);
 	void on_lowSampleRate_toggled(bool checked);
 	void on_dcOffset_toggled(bool checked);
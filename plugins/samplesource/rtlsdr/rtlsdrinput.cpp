@@ -35,6 +35,7 @@
 #include "rtlsdrthread.h"
 #include "dsp/dspcommands.h"
 #include "dsp/dspengine.h"
+#include "dsp/deviceresampler.h"
 
 MESSAGE_CLASS_DEFINITION(RTLSDRInput::MsgConfigureRTLSDR, Message)
 MESSAGE_CLASS_DEFINITION(RTLSDRInput::MsgStartStop, Message)
@@ -196,11 +197,13 @@ bool RTLSDRInput::start()
 
     if (m_running) stop();
 
-	m_rtlSDRThread = new RTLSDRThread(m_dev, &m_sampleFifo);
+	m_rtlSDRThread = new RTLSDRThread(m_dev, &m_sampleFifo, &m_callbackStats);
 	m_rtlSDRThread->setSamplerate(m_settings.m_devSampleRate);
 	m_rtlSDRThread->setLog2Decimation(m_settings.m_log2Decim);
 	m_rtlSDRThread->setFcPos((int) m_settings.m_fcPos);
     m_rtlSDRThread->setIQOrder(m_settings.m_iqOrder);
+    m_rtlSDRThread->setPipelined(m_settings.m_pipelined);
+    m_rtlSDRThread->setResampleRate(m_settings.m_resampleRate);
 	m_rtlSDRThread->startWork();
 
 	mutexLocker.unlock();
@@ -271,7 +274,7 @@ const QString& RTLSDRInput::getDeviceDescription() const
 int RTLSDRInput::getSampleRate() const
 {
 	int rate = m_settings.m_devSampleRate;
-	return (rate / (1<<m_settings.m_log2Decim));
+	return DeviceResampler::getOutputRate(rate / (1<<m_settings.m_log2Decim), m_settings.m_resampleRate);
 }
 
 quint64 RTLSDRInput::getCenterFrequency() const
@@ -445,6 +448,30 @@ bool RTLSDRInput::applySettings(const RTLSDRSettings& settings, bool force)
         }
     }
 
+    if (m_settings.m_pipelined != settings.m_pipelined)
+    {
+        reverseAPIKeys.append("pipelined");
+
+        if (m_rtlSDRThread) // the decimation stage is set up when the thread starts
+        {
+            m_rtlSDRThread->stopWork();
+            m_rtlSDRThread->setPipelined(settings.m_pipelined);
+            m_rtlSDRThread->startWork();
+        }
+    }
+
+    if ((m_settings.m_resampleRate != settings.m_resampleRate) || force)
+    {
+        reverseAPIKeys.append("resampleRate");
+        forwardChange = true;
+
+        if (m_rtlSDRThread) {
+            m_rtlSDRThread->setResampleRate(settings.m_resampleRate);
+        }
+
+        qDebug("RTLSDRInput::applySettings: resample rate set to %d", settings.m_resampleRate);
+    }
+
     if ((m_settings.m_centerFrequency != settings.m_centerFrequency)
         || (m_settings.m_fcPos != settings.m_fcPos)
         || (m_settings.m_log2Decim != settings.m_log2Decim)
@@ -560,7 +587,7 @@ bool RTLSDRInput::applySettings(const RTLSDRSettings& settings, bool force)
 
     if (forwardChange)
     {
-        int sampleRate = m_settings.m_devSampleRate/(1<<m_settings.m_log2Decim);
+        int sampleRate = getSampleRate();
         DSPSignalNotification *notif = new DSPSignalNotification(sampleRate, m_settings.m_centerFrequency);
         m_deviceAPI->getDeviceEngineInputMessageQueue()->push(notif);
     }
@@ -593,6 +620,7 @@ int RTLSDRInput::webapiSettingsPutPatch(
     (void) errorMessage;
     RTLSDRSettings settings = m_settings;
     webapiUpdateDeviceSettings(settings, deviceSettingsKeys, response);
+    settings.m_resampleRate = DeviceResampler::clampOutputRate(settings.m_devSampleRate >> settings.m_log2Decim, settings.m_resampleRate);
 
     MsgConfigureRTLSDR *msg = MsgConfigureRTLSDR::create(settings, force);
     m_inputMessageQueue.push(msg);
@@ -663,6 +691,12 @@ void RTLSDRInput::webapiUpdateDeviceSettings(
     if (deviceSettingsKeys.contains("biasTee")) {
         settings.m_biasTee = response.getRtlSdrSettings()->getBiasTee() != 0;
     }
+    if (deviceSettingsKeys.contains("resampleRate")) {
+        settings.m_resampleRate = response.getRtlSdrSettings()->getResampleRate();
+    }
+    if (deviceSettingsKeys.contains("pipelined")) {
+        settings.m_pipelined = response.getRtlSdrSettings()->getPipelined() != 0;
+    }
     if (deviceSettingsKeys.contains("useReverseAPI")) {
         settings.m_useReverseAPI = response.getRtlSdrSettings()->getUseReverseApi() != 0;
     }
@@ -693,6 +727,8 @@ void RTLSDRInput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings& res
     response.getRtlSdrSettings()->setNoModMode(settings.m_noModMode ? 1 : 0);
     response.getRtlSdrSettings()->setOffsetTuning(settings.m_offsetTuning ? 1 : 0);
     response.getRtlSdrSettings()->setBiasTee(settings.m_biasTee ? 1 : 0);
+    response.getRtlSdrSettings()->setResampleRate(settings.m_resampleRate);
+    response.getRtlSdrSettings()->setPipelined(settings.m_pipelined ? 1 : 0);
     response.getRtlSdrSettings()->setTransverterDeltaFrequency(settings.m_transverterDeltaFrequency);
     response.getRtlSdrSettings()->setTransverterMode(settings.m_transverterMode ? 1 : 0);
     response.getRtlSdrSettings()->setRfBandwidth(settings.m_rfBandwidth);
@@ -821,6 +857,12 @@ void RTLSDRInput::webapiReverseSendSettings(QList<QString>& deviceSettingsKeys,
     if (deviceSettingsKeys.contains("biasTee") || force) {
         swgRtlSdrSettings->setBiasTee(settings.m_biasTee ? 1 : 0);
     }
+    if (deviceSettingsKeys.contains("resampleRate") || force) {
+        swgRtlSdrSettings->setResampleRate(settings.m_resampleRate);
+    }
+    if (deviceSettingsKeys.contains("pipelined") || force) {
+        swgRtlSdrSettings->setPipelined(settings.m_pipelined ? 1 : 0);
+    }
 
     QString channelSettingsURL = QString("http://%1:%2/sdrangel/deviceset/%3/device/settings")
             .arg(settings.m_reverseAPIAddress)
@@ -24,6 +24,7 @@
 #include <QNetworkRequest>
 
 #include "dsp/devicesamplesource.h"
+#include "dsp/devicecallbackstats.h"
 #include "rtlsdrsettings.h"
 #include <rtl-sdr.h>
 
@@ -93,6 +94,7 @@ public:
 	virtual int getSampleRate() const;
     virtual void setSampleRate(int sampleRate) { (void) sampleRate; }
 	virtual quint64 getCenterFrequency() const;
+    virtual const DeviceCallbackStats* getCallbackStats() const { return &m_callbackStats; }
     virtual void setCenterFrequency(qint64 centerFrequency);
 
 	virtual bool handleMessage(const Message& message);
@@ -147,6 +149,7 @@ private:
 	RTLSDRSettings m_settings;
 	rtlsdr_dev_t* m_dev;
 	RTLSDRThread* m_rtlSDRThread;
+    DeviceCallbackStats m_callbackStats;
 	QString m_deviceDescription;
 	std::vector<int> m_gains;
 	bool m_running;
@@ -43,6 +43,8 @@ void RTLSDRSettings::resetToDefaults()
 	m_rfBandwidth = 2500 * 1000; // Hz
 	m_offsetTuning = false;
     m_biasTee = false;
+    m_pipelined = false;
+    m_resampleRate = 0;
     m_useReverseAPI = false;
     m_reverseAPIAddress = "127.0.0.1";
     m_reverseAPIPort = 8888;
@@ -73,6 +75,8 @@ QByteArray RTLSDRSettings::serialize() const
     s.writeU32(19, m_reverseAPIDeviceIndex);
     s.writeBool(20, m_iqOrder);
     s.writeBool(21, m_biasTee);
+    s.writeBool(22, m_pipelined);
+    s.writeS32(23, m_resampleRate);
 
 	return s.final();
 }
@@ -121,6 +125,9 @@ bool RTLSDRSettings::deserialize(const QByteArray& data)
         m_reverseAPIDeviceIndex = utmp > 99 ? 99 : utmp;
         d.readBool(20, &m_iqOrder, true);
         d.readBool(21, &m_biasTee, false);
+        d.readBool(22, &m_pipelined, false);
+        d.readS32(23, &intval, 0);
+        m_resampleRate = intval < 0 ? 0 : intval;
 
 		return true;
 	}
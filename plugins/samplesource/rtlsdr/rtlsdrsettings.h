@@ -44,6 +44,8 @@ struct RTLSDRSettings {
 	quint32 m_rfBandwidth; //!< RF filter bandwidth in Hz
 	bool m_offsetTuning;
     bool m_biasTee;
+    bool m_pipelined; //!< decimation in a separate thread from the USB callback
+    qint32 m_resampleRate; //!< baseband rate after the device resampler (S/s). 0 for none
     bool m_useReverseAPI;
     QString m_reverseAPIAddress;
     uint16_t m_reverseAPIPort;
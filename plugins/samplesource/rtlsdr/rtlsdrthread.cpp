@@ -18,13 +18,18 @@
 
 #include <stdio.h>
 #include <errno.h>
+
+#include <QElapsedTimer>
+
 #include "rtlsdrthread.h"
 
 #include "dsp/samplesinkfifo.h"
+#include "dsp/devicecallbackstats.h"
 
 #define FCD_BLOCKSIZE 16384
+#define RTLSDR_NB_BLOCKS 32
 
-RTLSDRThread::RTLSDRThread(rtlsdr_dev_t* dev, SampleSinkFifo* sampleFifo, QObject* parent) :
+RTLSDRThread::RTLSDRThread(rtlsdr_dev_t* dev, SampleSinkFifo* sampleFifo, DeviceCallbackStats* callbackStats, QObject* parent) :
 	QThread(parent),
 	m_running(false),
 	m_dev(dev),
@@ -33,7 +38,11 @@ RTLSDRThread::RTLSDRThread(rtlsdr_dev_t* dev, SampleSinkFifo* sampleFifo, QObjec
 	m_samplerate(288000),
 	m_log2Decim(4),
 	m_fcPos(0),
-    m_iqOrder(true)
+    m_iqOrder(true),
+    m_pipelined(false),
+    m_callbackStats(callbackStats),
+    m_pipeline(this, FCD_BLOCKSIZE, 2*RTLSDR_NB_BLOCKS, callbackStats),
+    m_resampleRate(0)
 {
 }
 
@@ -60,11 +69,19 @@ void RTLSDRThread::stopWork()
 void RTLSDRThread::setSamplerate(int samplerate)
 {
 	m_samplerate = samplerate;
+    m_resampler.configure(m_samplerate >> m_log2Decim, m_resampleRate);
 }
 
 void RTLSDRThread::setLog2Decimation(unsigned int log2_decim)
 {
 	m_log2Decim = log2_decim;
+    m_resampler.configure(m_samplerate >> m_log2Decim, m_resampleRate);
+}
+
+void RTLSDRThread::setResampleRate(int resampleRate)
+{
+    m_resampleRate = resampleRate;
+    m_resampler.configure(m_samplerate >> m_log2Decim, m_resampleRate);
 }
 
 void RTLSDRThread::setFcPos(int fcPos)
@@ -76,17 +93,36 @@ void RTLSDRThread::run()
 {
 	int res;
 
+	if (m_callbackStats) {
+		m_callbackStats->reset();
+	}
+
+	if (m_pipelined) {
+		m_pipeline.startWork();
+	}
+
 	m_running = true;
 	m_startWaiter.wakeAll();
 
 	while(m_running) {
-		if((res = rtlsdr_read_async(m_dev, &RTLSDRThread::callbackHelper, this, 32, FCD_BLOCKSIZE)) < 0) {
+		if((res = rtlsdr_read_async(m_dev, &RTLSDRThread::callbackHelper, this, RTLSDR_NB_BLOCKS, FCD_BLOCKSIZE)) < 0) {
 			qCritical("RTLSDRThread: async error: %s", strerror(errno));
 			break;
 		}
 	}
 
 	m_running = false;
+	m_pipeline.stopWork();
+
+	if (m_callbackStats && (m_callbackStats->getCallbacks() != 0))
+	{
+		qDebug("RTLSDRThread::run: %llu callbacks avg: %llu us max: %llu us late: %llu overruns: %llu",
+			m_callbackStats->getCallbacks(),
+			m_callbackStats->getTotalNs() / (1000 * m_callbackStats->getCallbacks()),
+			m_callbackStats->getMaxNs() / 1000,
+			m_callbackStats->getLateCallbacks(),
+			m_callbackStats->getOverruns());
+	}
 }
 
 //  Decimate according to specified log2 (ex: log2=4 => decim=16)
@@ -180,10 +216,7 @@ void RTLSDRThread::callbackIQ(const quint8* buf, qint32 len)
 		}
 	}
 
-	m_sampleFifo->write(m_convertBuffer.begin(), it);
-
-	if(!m_running)
-		rtlsdr_cancel_async(m_dev);
+	m_resampler.write(m_sampleFifo, m_convertBuffer.begin(), it);
 }
 
 void RTLSDRThread::callbackQI(const quint8* buf, qint32 len)
@@ -276,20 +309,35 @@ void RTLSDRThread::callbackQI(const quint8* buf, qint32 len)
 		}
 	}
 
-	m_sampleFifo->write(m_convertBuffer.begin(), it);
+	m_resampler.write(m_sampleFifo, m_convertBuffer.begin(), it);
+}
 
-	if(!m_running)
-		rtlsdr_cancel_async(m_dev);
+void RTLSDRThread::processBlock(const quint8* buf, qint32 len)
+{
+    if (m_iqOrder) {
+    	callbackIQ(buf, len);
+    } else {
+        callbackQI(buf, len);
+    }
 }
 
 void RTLSDRThread::callbackHelper(unsigned char* buf, uint32_t len, void* ctx)
 {
 	RTLSDRThread* thread = (RTLSDRThread*) ctx;
+	QElapsedTimer timer;
+	timer.start();
 
-    if (thread->m_iqOrder) {
-    	thread->callbackIQ(buf, len);
-    } else {
-        thread->callbackQI(buf, len);
-    }
+	if (thread->m_pipelined) { // only copy: conversion and decimation are done in the pipeline thread
+		thread->m_pipeline.push(buf, len);
+	} else {
+		thread->processBlock(buf, len);
+	}
+
+	if (thread->m_callbackStats) {
+		thread->m_callbackStats->record(timer.nsecsElapsed(), thread->m_samplerate > 0 ? (len / 2) * 1000000000LL / thread->m_samplerate : 0);
+	}
+
+	if(!thread->m_running)
+		rtlsdr_cancel_async(thread->m_dev);
 }
 
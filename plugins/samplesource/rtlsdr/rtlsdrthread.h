@@ -26,12 +26,16 @@
 
 #include "dsp/samplesinkfifo.h"
 #include "dsp/decimatorsu.h"
+#include "dsp/rawblockpipeline.h"
+#include "dsp/deviceresampler.h"
 
-class RTLSDRThread : public QThread {
+class DeviceCallbackStats;
+
+class RTLSDRThread : public QThread, public RawBlockPipeline::Processor {
 	Q_OBJECT
 
 public:
-	RTLSDRThread(rtlsdr_dev_t* dev, SampleSinkFifo* sampleFifo, QObject* parent = NULL);
+	RTLSDRThread(rtlsdr_dev_t* dev, SampleSinkFifo* sampleFifo, DeviceCallbackStats* callbackStats, QObject* parent = NULL);
 	~RTLSDRThread();
 
 	void startWork();
@@ -40,6 +44,8 @@ public:
 	void setLog2Decimation(unsigned int log2_decim);
 	void setFcPos(int fcPos);
     void setIQOrder(bool iqOrder) { m_iqOrder = iqOrder; }
+    void setPipelined(bool pipelined) { m_pipelined = pipelined; } //!< applies on next start
+    void setResampleRate(int resampleRate); //!< 0 for no resampling
 
 private:
 	QMutex m_startWaitMutex;
@@ -54,6 +60,11 @@ private:
 	unsigned int m_log2Decim;
 	int m_fcPos;
     bool m_iqOrder;
+    bool m_pipelined;
+    DeviceCallbackStats* m_callbackStats;
+    RawBlockPipeline m_pipeline;
+    int m_resampleRate;
+    DeviceResampler m_resampler;
 
 	DecimatorsU<qint32, quint8, SDR_RX_SAMP_SZ, 8, 127, true> m_decimatorsIQ;
 	DecimatorsU<qint32, quint8, SDR_RX_SAMP_SZ, 8, 127, false> m_decimatorsQI;
@@ -61,6 +72,7 @@ private:
 	void run();
 	void callbackIQ(const quint8* buf, qint32 len);
 	void callbackQI(const quint8* buf, qint32 len);
+	virtual void processBlock(const quint8* buf, qint32 len);
 
 	static void callbackHelper(unsigned char* buf, uint32_t len, void* ctx);
 };
@@ -39,6 +39,8 @@ public:
     void initPlugin(PluginAPI* pluginAPI);
 
 	virtual void enumOriginDevices(QStringList& listedHwIds, OriginDevices& originDevices);
+	virtual bool isEnumerationThreadSafe() const { return false; } // SoapySDR module loading and DeviceSoapySDR scan
+	virtual bool isEnumerationCacheable() const { return false; } // DeviceSoapySDR scan, remote devices
 	virtual SamplingDevices enumSampleSources(const OriginDevices& originDevices);
     virtual PluginInstanceGUI* createSampleSourcePluginInstanceGUI(
             const QString& sourceId,
@@ -236,6 +236,7 @@ bool AMBEEngine::registerController(const std::string& deviceRef)
         connect(m_controllers.back().worker, SIGNAL(finished()), m_controllers.back().worker, SLOT(deleteLater()));
         connect(m_controllers.back().thread, SIGNAL(finished()), m_controllers.back().thread, SLOT(deleteLater()));
         connect(&m_controllers.back().worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), m_controllers.back().worker, SLOT(handleInputMessages()));
+        connect(m_controllers.back().worker, SIGNAL(framesEnqueued()), m_controllers.back().worker, SLOT(handleFrames()));
         std::this_thread::sleep_for(std::chrono::seconds(1));
         m_controllers.back().thread->start();
 
@@ -254,6 +255,7 @@ void AMBEEngine::releaseController(const std::string& deviceRef)
         if (it->device == deviceRef)
         {
             disconnect(&it->worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), it->worker, SLOT(handleInputMessages()));
+            disconnect(it->worker, SIGNAL(framesEnqueued()), it->worker, SLOT(handleFrames()));
             it->worker->stop();
             it->thread->wait(100);
             it->worker->m_inputMessageQueue.clear();
@@ -274,6 +276,7 @@ void AMBEEngine::releaseAll()
     while (it != m_controllers.end())
     {
         disconnect(&it->worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), it->worker, SLOT(handleInputMessages()));
+        disconnect(it->worker, SIGNAL(framesEnqueued()), it->worker, SLOT(handleFrames()));
         it->worker->stop();
         it->thread->wait(100);
         it->worker->m_inputMessageQueue.clear();
@@ -307,7 +310,7 @@ void AMBEEngine::pushMbeFrame(
 {
     std::vector<AMBEController>::iterator it = m_controllers.begin();
     std::vector<AMBEController>::iterator itAvail = m_controllers.end();
-    bool done = false;
+    unsigned int minChannels = 0, minQueueDepth = 0;
     QMutexLocker locker(&m_mutex);
 
     while (it != m_controllers.end())
@@ -315,29 +318,48 @@ void AMBEEngine::pushMbeFrame(
         if (it->worker->hasFifo(audioFifo))
         {
             it->worker->pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useLP, upsampling, audioFifo);
-            done = true;
+            return;
         }
-        else if (it->worker->isAvailable())
+
+        // new channels go to the device with the least channels then the shortest queue
+        unsigned int nbChannels, queueDepth;
+        it->worker->getLoad(nbChannels, queueDepth);
+
+        if ((itAvail == m_controllers.end())
+            || (nbChannels < minChannels)
+            || ((nbChannels == minChannels) && (queueDepth < minQueueDepth)))
         {
             itAvail = it;
+            minChannels = nbChannels;
+            minQueueDepth = queueDepth;
         }
 
         ++it;
     }
 
-    if (!done)
+    if (itAvail != m_controllers.end())
     {
-        if (itAvail != m_controllers.end())
-        {
-            int wNum = itAvail - m_controllers.begin();
+        int wNum = itAvail - m_controllers.begin();
 
-            qDebug("AMBEEngine::pushMbeFrame: push %p on empty queue %d", audioFifo, wNum);
-            itAvail->worker->pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useLP, upsampling, audioFifo);
-        }
-        else
-        {
-            qDebug("AMBEEngine::pushMbeFrame: no DV device available. MBE frame dropped");
-        }
+        qDebug("AMBEEngine::pushMbeFrame: push %p on queue %d with %u channels", audioFifo, wNum, minChannels);
+        itAvail->worker->pushMbeFrame(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useLP, upsampling, audioFifo);
+    }
+    else
+    {
+        qDebug("AMBEEngine::pushMbeFrame: no DV device available. MBE frame dropped");
+    }
+}
+
+void AMBEEngine::getMetrics(std::vector<DeviceMetrics>& metrics)
+{
+    QMutexLocker locker(&m_mutex);
+    metrics.clear();
+
+    for (std::vector<AMBEController>::iterator it = m_controllers.begin(); it != m_controllers.end(); ++it)
+    {
+        metrics.push_back(DeviceMetrics());
+        metrics.back().m_device = QString(it->device.c_str());
+        it->worker->getMetrics(metrics.back());
     }
 }
 
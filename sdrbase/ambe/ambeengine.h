@@ -33,10 +33,28 @@ class QThread;
 class AMBEWorker;
 class AudioFifo;
 
+/**
+ * Pool of AMBE devices decoding the MBE frames of the DSD demodulators. Each device can serve
+ * several channels: a new channel goes to the device with the least channels then the shortest
+ * queue so that channels only share a device when there are more channels than devices.
+ */
 class SDRBASE_API AMBEEngine : public QObject
 {
     Q_OBJECT
 public:
+    struct DeviceMetrics
+    {
+        QString m_device;
+        unsigned int m_nbChannels;   //!< channels currently assigned
+        unsigned int m_queueDepth;   //!< frames waiting for decode
+        quint64 m_decodedFrames;
+        quint64 m_droppedFrames;     //!< frames dropped on channel queue overflow
+        quint64 m_failedFrames;      //!< frames the device failed to decode
+        quint64 m_batches;
+        quint64 m_latencyTotalNs;    //!< sum of the times from push to decoded audio
+        quint64 m_latencyMaxNs;
+    };
+
     AMBEEngine();
     ~AMBEEngine();
 
@@ -57,6 +75,8 @@ public:
             int upsampling,
             AudioFifo *audioFifo);
 
+    void getMetrics(std::vector<DeviceMetrics>& metrics); //!< queue and latency figures of each device
+
     QByteArray serialize() const;
     bool deserialize(const QByteArray& data);
 
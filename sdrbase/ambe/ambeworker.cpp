@@ -20,39 +20,70 @@
 #include <chrono>
 #include <thread>
 
+#include <QMutexLocker>
+
 #include "audio/audiofifo.h"
 #include "ambeworker.h"
 
-MESSAGE_CLASS_DEFINITION(AMBEWorker::MsgMbeDecode, Message)
 MESSAGE_CLASS_DEFINITION(AMBEWorker::MsgTest, Message)
 
+const unsigned int AMBEWorker::m_maxChannelFrames = 25; // 500 ms of 20 ms frames
+const qint64 AMBEWorker::m_channelTimeoutNs = 1000000000LL;
+const int AMBEWorker::m_loopbackDecodeUs = 7000; // 320 bytes of audio packet at 460800 baud
+
+AMBEWorker::Channel::Channel(AudioFifo *audioFifo) :
+    m_audioFifo(audioFifo),
+    m_lastPushNs(0),
+    m_audioBufferFill(0),
+    m_upsamplerLastValue(0.0f),
+    m_upsampling(1),
+    m_volume(1.0f)
+{
+    m_audioBuffer.resize(8*SerialDV::MBE_AUDIO_BLOCK_SIZE); // room for one frame at maximum upsampling (6)
+    setVolumeFactors(this);
+}
+
 AMBEWorker::AMBEWorker() :
+    m_loopback(false),
     m_running(false),
     m_currentGainIn(0),
     m_currentGainOut(0),
-    m_upsamplerLastValue(0.0f),
-    m_phase(0),
-    m_upsampling(1),
-    m_volume(1.0f)
+    m_roundRobin(0),
+    m_queueDepth(0),
+    m_scheduled(false),
+    m_decodedFrames(0),
+    m_droppedFrames(0),
+    m_failedFrames(0),
+    m_batches(0),
+    m_latencyTotalNs(0),
+    m_latencyMaxNs(0)
 {
-    m_audioBuffer.resize(48000);
-    m_audioBufferFill = 0;
-    m_audioFifo = 0;
     std::fill(m_dvAudioSamples, m_dvAudioSamples+SerialDV::MBE_AUDIO_BLOCK_SIZE, 0);
-    setVolumeFactors();
 }
 
 AMBEWorker::~AMBEWorker()
-{}
+{
+    for (Channel *channel : m_channels) {
+        delete channel;
+    }
+}
 
 bool AMBEWorker::open(const std::string& deviceRef)
 {
+    if (deviceRef.compare(0, 8, "loopback") == 0)
+    {
+        m_loopback = true;
+        return true;
+    }
+
     return m_dvController.open(deviceRef);
 }
 
 void AMBEWorker::close()
 {
-    m_dvController.close();
+    if (!m_loopback) {
+        m_dvController.close();
+    }
 }
 
 void AMBEWorker::process()
@@ -77,77 +108,118 @@ void AMBEWorker::stop()
 void AMBEWorker::handleInputMessages()
 {
     Message* message;
-    m_audioBufferFill = 0;
-    AudioFifo *audioFifo = 0;
 
     while ((message = m_inputMessageQueue.pop()) != 0)
     {
-        if (MsgMbeDecode::match(*message))
+        if (MsgTest::match(*message)) {
+            qDebug("AMBEWorker::handleInputMessages: MsgTest");
+        }
+
+        delete message;
+    }
+}
+
+void AMBEWorker::handleFrames()
+{
+    while (true)
+    {
+        m_mutex.lock();
+        purgeIdleChannels(nowNs());
+        m_batch.clear();
+        unsigned int nbChannels = m_channels.size();
+
+        // one frame of each channel with pending frames starting with a different channel each time
+        for (unsigned int i = 0; i < nbChannels; i++)
         {
-            MsgMbeDecode *decodeMsg = (MsgMbeDecode *) message;
-            int dBVolume = (decodeMsg->getVolumeIndex() - 30) / 4;
-            float volume = pow(10.0, dBVolume / 10.0f);
-            int upsampling = decodeMsg->getUpsampling();
-            upsampling = upsampling > 6 ? 6 : upsampling < 1 ? 1 : upsampling;
+            Channel *channel = m_channels[(m_roundRobin + i) % nbChannels];
 
-            if ((volume != m_volume) || (upsampling != m_upsampling))
+            if (!channel->m_frames.empty())
             {
-                m_volume = volume;
-                m_upsampling = upsampling;
-                setVolumeFactors();
+                m_batch.push_back(BatchEntry{channel, channel->m_frames.front()});
+                channel->m_frames.pop_front();
             }
+        }
 
-            m_upsampleFilter.useHP(decodeMsg->getUseHP());
+        if (m_batch.empty())
+        {
+            m_scheduled = false;
+            m_mutex.unlock();
+            return;
+        }
 
-            if (m_dvController.decode(m_dvAudioSamples, decodeMsg->getMbeFrame(), decodeMsg->getMbeRate()))
-            {
-                if (upsampling > 1) {
-                    upsample(upsampling, m_dvAudioSamples, SerialDV::MBE_AUDIO_BLOCK_SIZE, decodeMsg->getChannels());
-                } else {
-                    noUpsample(m_dvAudioSamples, SerialDV::MBE_AUDIO_BLOCK_SIZE, decodeMsg->getChannels());
-                }
+        m_roundRobin = nbChannels == 0 ? 0 : (m_roundRobin + 1) % nbChannels;
+        m_queueDepth -= m_batch.size();
+        m_mutex.unlock();
 
-                audioFifo = decodeMsg->getAudioFifo();
+        // channels are only deleted in this thread so they remain valid without the lock
+        for (const BatchEntry& entry : m_batch) {
+            decodeFrame(entry.m_channel, entry.m_frame);
+        }
 
-                if (audioFifo && (m_audioBufferFill >= m_audioBuffer.size() - 960))
-                {
-                    uint res = audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+        m_batches.fetchAndAddRelaxed(1);
+    }
+}
 
-                    if (res != m_audioBufferFill) {
-                        qDebug("AMBEWorker::handleInputMessages: %u/%u audio samples written", res, m_audioBufferFill);
-                    }
+void AMBEWorker::decodeFrame(Channel *channel, const Frame& frame)
+{
+    int dBVolume = (frame.m_volumeIndex - 30) / 4;
+    float volume = pow(10.0, dBVolume / 10.0f);
+    int upsampling = frame.m_upsampling;
+    upsampling = upsampling > 6 ? 6 : upsampling < 1 ? 1 : upsampling;
 
-                    m_audioBufferFill = 0;
-                }
-            }
-            else
-            {
-                qDebug("AMBEWorker::handleInputMessages: MsgMbeDecode: decode failed");
-            }
-        }
+    if ((volume != channel->m_volume) || (upsampling != channel->m_upsampling))
+    {
+        channel->m_volume = volume;
+        channel->m_upsampling = upsampling;
+        setVolumeFactors(channel);
+    }
 
-        delete message;
+    channel->m_upsampleFilter.useHP(frame.m_useHP);
+
+    if (decode(m_dvAudioSamples, frame.m_mbeFrame, frame.m_mbeRate))
+    {
+        channel->m_audioBufferFill = 0;
+
+        if (upsampling > 1) {
+            upsample(channel, m_dvAudioSamples, SerialDV::MBE_AUDIO_BLOCK_SIZE, frame.m_channels, m_compressor);
+        } else {
+            noUpsample(channel, m_dvAudioSamples, SerialDV::MBE_AUDIO_BLOCK_SIZE, frame.m_channels);
+        }
 
-        if (m_inputMessageQueue.size() > 100)
+        if (channel->m_audioFifo)
         {
-            qDebug("AMBEWorker::handleInputMessages: MsgMbeDecode: too many messages in queue. Flushing...");
-            m_inputMessageQueue.clear();
-            break;
+            uint res = channel->m_audioFifo->write((const quint8*)&channel->m_audioBuffer[0], channel->m_audioBufferFill);
+
+            if (res != channel->m_audioBufferFill) {
+                qDebug("AMBEWorker::decodeFrame: %u/%u audio samples written", res, channel->m_audioBufferFill);
+            }
         }
-    }
 
-    if (audioFifo)
-    {
-        uint res = audioFifo->write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+        quint64 latencyNs = nowNs() - frame.m_timestampNs;
+        m_decodedFrames.fetchAndAddRelaxed(1);
+        m_latencyTotalNs.fetchAndAddRelaxed(latencyNs);
 
-        if (res != m_audioBufferFill) {
-            qDebug("AMBEWorker::handleInputMessages: %u/%u audio samples written", res, m_audioBufferFill);
+        if (latencyNs > m_latencyMaxNs.load()) { // single writer
+            m_latencyMaxNs.store(latencyNs);
         }
+    }
+    else
+    {
+        m_failedFrames.fetchAndAddRelaxed(1);
+        qDebug("AMBEWorker::decodeFrame: decode failed");
+    }
+}
 
-        m_audioBufferFill = 0;
+bool AMBEWorker::decode(short *audioSamples, const unsigned char *mbeFrame, SerialDV::DVRate mbeRate)
+{
+    if (m_loopback)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(m_loopbackDecodeUs));
+        std::fill(audioSamples, audioSamples + SerialDV::MBE_AUDIO_BLOCK_SIZE, 0);
+        return true;
     }
 
-    m_timestamp = QDateTime::currentDateTime();
+    return m_dvController.decode(audioSamples, mbeFrame, mbeRate);
 }
 
 void AMBEWorker::pushMbeFrame(const unsigned char *mbeFrame,
@@ -158,75 +230,160 @@ void AMBEWorker::pushMbeFrame(const unsigned char *mbeFrame,
         int upsampling,
         AudioFifo *audioFifo)
 {
-    m_audioFifo = audioFifo;
-    m_inputMessageQueue.push(MsgMbeDecode::create(mbeFrame, mbeRateIndex, mbeVolumeIndex, channels, useHP, upsampling, audioFifo));
+    QMutexLocker locker(&m_mutex);
+    Channel *channel = m_channelsByFifo.value(audioFifo, nullptr);
+
+    if (!channel)
+    {
+        channel = new Channel(audioFifo);
+        m_channels.push_back(channel);
+        m_channelsByFifo.insert(audioFifo, channel);
+        qDebug("AMBEWorker::pushMbeFrame: new channel %p (%lu channels)", audioFifo, m_channels.size());
+    }
+
+    if (channel->m_frames.size() >= m_maxChannelFrames) // drop the oldest frame of this channel only
+    {
+        channel->m_frames.pop_front();
+        m_queueDepth--;
+        m_droppedFrames.fetchAndAddRelaxed(1);
+    }
+
+    channel->m_frames.push_back(Frame());
+    Frame& frame = channel->m_frames.back();
+    frame.m_mbeRate = (SerialDV::DVRate) mbeRateIndex;
+    memcpy((void *) frame.m_mbeFrame, (const void *) mbeFrame, SerialDV::DVController::getNbMbeBytes(frame.m_mbeRate));
+    frame.m_volumeIndex = mbeVolumeIndex;
+    frame.m_channels = channels % 4;
+    frame.m_useHP = useHP;
+    frame.m_upsampling = upsampling;
+    frame.m_timestampNs = nowNs();
+    channel->m_lastPushNs = frame.m_timestampNs;
+    m_queueDepth++;
+
+    if (!m_scheduled)
+    {
+        m_scheduled = true;
+        emit framesEnqueued();
+    }
+}
+
+bool AMBEWorker::hasFifo(AudioFifo *audioFifo)
+{
+    QMutexLocker locker(&m_mutex);
+    Channel *channel = m_channelsByFifo.value(audioFifo, nullptr);
+    return channel && !isIdle(channel, nowNs());
 }
 
-bool AMBEWorker::isAvailable()
+void AMBEWorker::getLoad(unsigned int& nbChannels, unsigned int& queueDepth)
 {
-	if (m_audioFifo == 0) {
-		return true;
-	}
+    QMutexLocker locker(&m_mutex);
+    qint64 now = nowNs();
+    nbChannels = 0;
 
-	return m_timestamp.time().msecsTo(QDateTime::currentDateTime().time()) > 1000; // 1 second inactivity timeout
+    for (const Channel *channel : m_channels)
+    {
+        if (!isIdle(channel, now)) {
+            nbChannels++;
+        }
+    }
+
+    queueDepth = m_queueDepth;
 }
 
-bool AMBEWorker::hasFifo(AudioFifo *audioFifo)
+void AMBEWorker::getMetrics(AMBEEngine::DeviceMetrics& metrics)
+{
+    getLoad(metrics.m_nbChannels, metrics.m_queueDepth);
+    metrics.m_decodedFrames = m_decodedFrames.load();
+    metrics.m_droppedFrames = m_droppedFrames.load();
+    metrics.m_failedFrames = m_failedFrames.load();
+    metrics.m_batches = m_batches.load();
+    metrics.m_latencyTotalNs = m_latencyTotalNs.load();
+    metrics.m_latencyMaxNs = m_latencyMaxNs.load();
+}
+
+bool AMBEWorker::isIdle(const Channel *channel, qint64 nowNs) const
+{
+    return channel->m_frames.empty() && (nowNs - channel->m_lastPushNs > m_channelTimeoutNs);
+}
+
+void AMBEWorker::purgeIdleChannels(qint64 nowNs)
 {
-    return m_audioFifo == audioFifo;
+    std::vector<Channel*>::iterator it = m_channels.begin();
+
+    while (it != m_channels.end())
+    {
+        if (isIdle(*it, nowNs))
+        {
+            qDebug("AMBEWorker::purgeIdleChannels: release channel %p", (*it)->m_audioFifo);
+            m_channelsByFifo.remove((*it)->m_audioFifo);
+            delete *it;
+            it = m_channels.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
 }
 
-void AMBEWorker::upsample(int upsampling, short *in, int nbSamplesIn, unsigned char channels)
+qint64 AMBEWorker::nowNs()
 {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void AMBEWorker::upsample(Channel *channel, short *in, int nbSamplesIn, unsigned char channels, AudioCompressor& compressor)
+{
+    int upsampling = channel->m_upsampling;
+
     for (int i = 0; i < nbSamplesIn; i++)
     {
-        //float cur = m_upsampleFilter.usesHP() ? m_upsampleFilter.runHP((float) m_compressor.compress(in[i])) : (float) m_compressor.compress(in[i]);
-        float cur = m_upsampleFilter.usesHP() ? m_upsampleFilter.runHP((float) in[i]) : (float) in[i];
-        float prev = m_upsamplerLastValue;
+        //float cur = channel->m_upsampleFilter.usesHP() ? channel->m_upsampleFilter.runHP((float) compressor.compress(in[i])) : (float) compressor.compress(in[i]);
+        float cur = channel->m_upsampleFilter.usesHP() ? channel->m_upsampleFilter.runHP((float) in[i]) : (float) in[i];
+        float prev = channel->m_upsamplerLastValue;
         qint16 upsample;
 
         for (int j = 1; j <= upsampling; j++)
         {
-            upsample = (qint16) m_upsampleFilter.runLP(cur*m_upsamplingFactors[j] + prev*m_upsamplingFactors[upsampling-j]);
-            m_audioBuffer[m_audioBufferFill].l = channels & 1 ? m_compressor.compress(upsample) : 0;
-            m_audioBuffer[m_audioBufferFill].r = (channels>>1) & 1 ? m_compressor.compress(upsample) : 0;
+            upsample = (qint16) channel->m_upsampleFilter.runLP(cur*channel->m_upsamplingFactors[j] + prev*channel->m_upsamplingFactors[upsampling-j]);
+            channel->m_audioBuffer[channel->m_audioBufferFill].l = channels & 1 ? compressor.compress(upsample) : 0;
+            channel->m_audioBuffer[channel->m_audioBufferFill].r = (channels>>1) & 1 ? compressor.compress(upsample) : 0;
 
-            if (m_audioBufferFill < m_audioBuffer.size() - 1) {
-                ++m_audioBufferFill;
+            if (channel->m_audioBufferFill < channel->m_audioBuffer.size() - 1) {
+                ++channel->m_audioBufferFill;
             }
         }
 
-        m_upsamplerLastValue = cur;
+        channel->m_upsamplerLastValue = cur;
     }
 
-    if (m_audioBufferFill >= m_audioBuffer.size() - 1) {
+    if (channel->m_audioBufferFill >= channel->m_audioBuffer.size() - 1) {
         qDebug("AMBEWorker::upsample(%d): audio buffer is full check its size", upsampling);
     }
 }
 
-void AMBEWorker::noUpsample(short *in, int nbSamplesIn, unsigned char channels)
+void AMBEWorker::noUpsample(Channel *channel, short *in, int nbSamplesIn, unsigned char channels)
 {
     for (int i = 0; i < nbSamplesIn; i++)
     {
-        float cur = m_upsampleFilter.usesHP() ? m_upsampleFilter.runHP((float) in[i]) : (float) in[i];
-        m_audioBuffer[m_audioBufferFill].l = channels & 1 ? cur*m_upsamplingFactors[0] : 0;
-        m_audioBuffer[m_audioBufferFill].r = (channels>>1) & 1 ? cur*m_upsamplingFactors[0] : 0;
+        float cur = channel->m_upsampleFilter.usesHP() ? channel->m_upsampleFilter.runHP((float) in[i]) : (float) in[i];
+        channel->m_audioBuffer[channel->m_audioBufferFill].l = channels & 1 ? cur*channel->m_upsamplingFactors[0] : 0;
+        channel->m_audioBuffer[channel->m_audioBufferFill].r = (channels>>1) & 1 ? cur*channel->m_upsamplingFactors[0] : 0;
 
-        if (m_audioBufferFill < m_audioBuffer.size() - 1) {
-            ++m_audioBufferFill;
+        if (channel->m_audioBufferFill < channel->m_audioBuffer.size() - 1) {
+            ++channel->m_audioBufferFill;
         }
     }
 
-    if (m_audioBufferFill >= m_audioBuffer.size() - 1) {
+    if (channel->m_audioBufferFill >= channel->m_audioBuffer.size() - 1) {
         qDebug("AMBEWorker::noUpsample: audio buffer is full check its size");
     }
 }
 
-void AMBEWorker::setVolumeFactors()
+void AMBEWorker::setVolumeFactors(Channel *channel)
 {
-    m_upsamplingFactors[0] = m_volume;
+    channel->m_upsamplingFactors[0] = channel->m_volume;
 
-    for (int i = 1; i <= m_upsampling; i++) {
-        m_upsamplingFactors[i] = (i*m_volume) / (float) m_upsampling;
+    for (int i = 1; i <= channel->m_upsampling; i++) {
+        channel->m_upsamplingFactors[i] = (i*channel->m_volume) / (float) channel->m_upsampling;
     }
 }
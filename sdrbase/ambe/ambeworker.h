@@ -19,9 +19,14 @@
 #ifndef SDRBASE_AMBE_AMBEWORKER_H_
 #define SDRBASE_AMBE_AMBEWORKER_H_
 
+#include <vector>
+#include <deque>
+
 #include <QObject>
 #include <QDebug>
-#include <QDateTime>
+#include <QMutex>
+#include <QHash>
+#include <QAtomicInteger>
 
 #include "export.h"
 #include "dvcontroller.h"
@@ -31,9 +36,19 @@
 #include "dsp/filtermbe.h"
 #include "dsp/dsptypes.h"
 #include "audio/audiocompressor.h"
+#include "ambeengine.h"
 
 class AudioFifo;
 
+/**
+ * Decodes the MBE frames of one AMBE device. The device is shared by the channels (audio FIFOs)
+ * assigned to it by the AMBEEngine. Frames are queued per channel and decoded in batches of at
+ * most one frame per channel taken in turn so that a busy channel cannot starve the others.
+ * A channel is released after 1 second without frames.
+ *
+ * A device reference starting with "loopback" opens a stub that returns silence after the time
+ * a serial device takes to return an audio frame. It can be used to test the scheduling without hardware.
+ */
 class SDRBASE_API AMBEWorker : public QObject {
     Q_OBJECT
 public:
@@ -46,58 +61,6 @@ public:
         MsgTest() {}
     };
 
-    class MsgMbeDecode : public Message
-    {
-        MESSAGE_CLASS_DECLARATION
-    public:
-        const unsigned char *getMbeFrame() const { return m_mbeFrame; }
-        SerialDV::DVRate getMbeRate() const { return m_mbeRate; }
-        int getVolumeIndex() const { return m_volumeIndex; }
-        unsigned char getChannels() const { return m_channels % 4; }
-        bool getUseHP() const { return m_useHP; }
-        int getUpsampling() const { return m_upsampling; }
-        AudioFifo *getAudioFifo() { return m_audioFifo; }
-
-        static MsgMbeDecode* create(
-                const unsigned char *mbeFrame,
-                int mbeRateIndex,
-                int volumeIndex,
-                unsigned char channels,
-                bool useHP,
-                int upsampling,
-                AudioFifo *audioFifo)
-        {
-            return new MsgMbeDecode(mbeFrame, (SerialDV::DVRate) mbeRateIndex, volumeIndex, channels, useHP, upsampling, audioFifo);
-        }
-
-    private:
-        unsigned char m_mbeFrame[SerialDV::MBE_FRAME_MAX_LENGTH_BYTES];
-        SerialDV::DVRate m_mbeRate;
-        int m_volumeIndex;
-        unsigned char m_channels;
-        bool m_useHP;
-        int m_upsampling;
-        AudioFifo *m_audioFifo;
-
-        MsgMbeDecode(const unsigned char *mbeFrame,
-                SerialDV::DVRate mbeRate,
-                int volumeIndex,
-                unsigned char channels,
-                bool useHP,
-                int upsampling,
-                AudioFifo *audioFifo) :
-            Message(),
-            m_mbeRate(mbeRate),
-            m_volumeIndex(volumeIndex),
-            m_channels(channels),
-            m_useHP(useHP),
-            m_upsampling(upsampling),
-            m_audioFifo(audioFifo)
-        {
-            memcpy((void *) m_mbeFrame, (const void *) mbeFrame, SerialDV::DVController::getNbMbeBytes(m_mbeRate));
-        }
-    };
-
     AMBEWorker();
     ~AMBEWorker();
 
@@ -109,12 +72,13 @@ public:
             int upsampling,
             AudioFifo *audioFifo);
 
-    bool open(const std::string& deviceRef); //!< Either serial device or ip:port
+    bool open(const std::string& deviceRef); //!< Either serial device or ip:port or loopback stub
     void close();
     void process();
     void stop();
-    bool isAvailable();
     bool hasFifo(AudioFifo *audioFifo);
+    void getLoad(unsigned int& nbChannels, unsigned int& queueDepth);
+    void getMetrics(AMBEEngine::DeviceMetrics& metrics);
 
     void postTest()
     {
@@ -126,31 +90,81 @@ public:
 
 signals:
     void finished();
+    void framesEnqueued();
 
 public slots:
     void handleInputMessages();
+    void handleFrames();
 
 private:
-    void upsample(int upsampling, short *in, int nbSamplesIn, unsigned char channels);
-    void noUpsample(short *in, int nbSamplesIn, unsigned char channels);
-    void setVolumeFactors();
+    struct Frame
+    {
+        unsigned char m_mbeFrame[SerialDV::MBE_FRAME_MAX_LENGTH_BYTES];
+        SerialDV::DVRate m_mbeRate;
+        int m_volumeIndex;
+        unsigned char m_channels;
+        bool m_useHP;
+        int m_upsampling;
+        qint64 m_timestampNs; //!< push time
+    };
+
+    struct Channel
+    {
+        AudioFifo *m_audioFifo;
+        std::deque<Frame> m_frames;
+        qint64 m_lastPushNs;
+        AudioVector m_audioBuffer;
+        uint m_audioBufferFill;
+        float m_upsamplerLastValue;
+        MBEAudioInterpolatorFilter m_upsampleFilter;
+        int m_upsampling;
+        float m_volume;
+        float m_upsamplingFactors[7];
+
+        Channel(AudioFifo *audioFifo);
+    };
+
+    struct BatchEntry
+    {
+        Channel *m_channel;
+        Frame m_frame;
+    };
+
+    bool decode(short *audioSamples, const unsigned char *mbeFrame, SerialDV::DVRate mbeRate);
+    void decodeFrame(Channel *channel, const Frame& frame);
+    void purgeIdleChannels(qint64 nowNs);
+    bool isIdle(const Channel *channel, qint64 nowNs) const;
+    static qint64 nowNs();
+    static void upsample(Channel *channel, short *in, int nbSamplesIn, unsigned char channels, AudioCompressor& compressor);
+    static void noUpsample(Channel *channel, short *in, int nbSamplesIn, unsigned char channels);
+    static void setVolumeFactors(Channel *channel);
 
     SerialDV::DVController m_dvController;
-    AudioFifo *m_audioFifo;
-    QDateTime m_timestamp;
+    bool m_loopback;
     volatile bool m_running;
     int m_currentGainIn;
     int m_currentGainOut;
     short m_dvAudioSamples[SerialDV::MBE_AUDIO_BLOCK_SIZE];
-    AudioVector m_audioBuffer;
-    uint m_audioBufferFill;
-    float m_upsamplerLastValue;
-    float m_phase;
-    MBEAudioInterpolatorFilter m_upsampleFilter;
-    int m_upsampling;
-    float m_volume;
-    float m_upsamplingFactors[7];
     AudioCompressor m_compressor;
+
+    QMutex m_mutex;                    //!< protects the channels list and their frame queues
+    std::vector<Channel*> m_channels;
+    QHash<AudioFifo*, Channel*> m_channelsByFifo;
+    unsigned int m_roundRobin;         //!< first channel of the next batch
+    unsigned int m_queueDepth;
+    bool m_scheduled;                  //!< frames handling is pending in the worker thread
+    std::vector<BatchEntry> m_batch;
+
+    QAtomicInteger<quint64> m_decodedFrames;
+    QAtomicInteger<quint64> m_droppedFrames;
+    QAtomicInteger<quint64> m_failedFrames;
+    QAtomicInteger<quint64> m_batches;
+    QAtomicInteger<quint64> m_latencyTotalNs;
+    QAtomicInteger<quint64> m_latencyMaxNs;
+
+    static const unsigned int m_maxChannelFrames; //!< per channel queue limit
+    static const qint64 m_channelTimeoutNs;       //!< inactivity time after which a channel is released
+    static const int m_loopbackDecodeUs;          //!< loopback stub decode time
 };
 
 #endif // SDRBASE_AMBE_AMBEWORKER_H_
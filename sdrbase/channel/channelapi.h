@@ -27,6 +27,7 @@
 #include "export.h"
 
 class DeviceAPI;
+class ScopeVis;
 
 namespace SWGSDRangel
 {
@@ -44,6 +45,21 @@ public:
         StreamMIMO          //!< May expose any number of sink and/or source streams
     };
 
+    struct Metrics //!< Compact channel figures for bulk monitoring
+    {
+        double m_channelPowerDB; //!< Channel power (dB)
+        int m_squelch;           //!< -1: no squelch, 0: closed, 1: open
+        int m_channelSampleRate; //!< Channel sample rate (S/s)
+        int m_audioSampleRate;   //!< Audio sample rate (S/s) or 0 if there is no audio
+
+        Metrics() :
+            m_channelPowerDB(0.0),
+            m_squelch(-1),
+            m_channelSampleRate(0),
+            m_audioSampleRate(0)
+        {}
+    };
+
     ChannelAPI(const QString& name, StreamType streamType);
     virtual ~ChannelAPI() {}
     virtual void destroy() = 0;
@@ -107,6 +123,23 @@ public:
         errorMessage = "Not implemented"; return 501;
     }
 
+    /**
+     * Scope engine owned by the channel core if any. The web API uses it to stream the
+     * scope traces over a websocket also when there is no GUI.
+     */
+    virtual ScopeVis *getScopeVis() { return nullptr; }
+
+    /**
+     * Bulk metrics snapshot. Called from the web API thread so it must only read values
+     * already cached by the DSP thread and never take a lock nor reset accumulators.
+     * Returns false if the channel does not publish metrics.
+     */
+    virtual bool getMetrics(Metrics& metrics) const
+    {
+        (void) metrics;
+        return false;
+    }
+
     int getIndexInDeviceSet() const { return m_indexInDeviceSet; }
     void setIndexInDeviceSet(int indexInDeviceSet) { m_indexInDeviceSet = indexInDeviceSet; }
     int getDeviceSetIndex() const { return m_deviceSetIndex; }
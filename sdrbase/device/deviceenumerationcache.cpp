@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QDebug>
+
+#include "deviceenumerationcache.h"
+
+const quint32 DeviceEnumerationCache::m_magic = 0x53444543; // SDEC
+const quint32 DeviceEnumerationCache::m_version = 2;
+const qint64 DeviceEnumerationCache::m_maxAgeMs = 24*3600*1000LL;
+const qint64 DeviceEnumerationCache::m_minElapsedMs = 200;
+
+DeviceEnumerationCache::DeviceEnumerationCache()
+{
+    m_fileName = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/devices.cache";
+}
+
+DeviceEnumerationCache::~DeviceEnumerationCache()
+{}
+
+bool DeviceEnumerationCache::load(const QByteArray& fingerprint)
+{
+    m_entries.clear();
+    QFile file(m_fileName);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic, version;
+    QByteArray savedFingerprint;
+    stream >> magic >> version;
+
+    if ((magic != m_magic) || (version != m_version))
+    {
+        qDebug("DeviceEnumerationCache::load: %s: unknown format", qPrintable(m_fileName));
+        return false;
+    }
+
+    stream >> savedFingerprint;
+
+    if (savedFingerprint != fingerprint)
+    {
+        qDebug("DeviceEnumerationCache::load: %s: plugins or hardware changed", qPrintable(m_fileName));
+        return false;
+    }
+
+    qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    quint32 nbEntries;
+    stream >> nbEntries;
+
+    for (quint32 i = 0; (i < nbEntries) && (stream.status() == QDataStream::Ok); i++)
+    {
+        QString hardwareId;
+        Entry entry;
+        quint32 nbDevices;
+        stream >> hardwareId >> entry.m_elapsedMs >> entry.m_timestampMs >> nbDevices;
+
+        for (quint32 j = 0; (j < nbDevices) && (stream.status() == QDataStream::Ok); j++)
+        {
+            QString displayableName, deviceHardwareId, serial;
+            qint32 sequence, nbRxStreams, nbTxStreams;
+            stream >> displayableName >> deviceHardwareId >> serial >> sequence >> nbRxStreams >> nbTxStreams;
+            entry.m_originDevices.append(PluginInterface::OriginDevice(
+                displayableName, deviceHardwareId, serial, sequence, nbRxStreams, nbTxStreams));
+        }
+
+        if (nowMs - entry.m_timestampMs > m_maxAgeMs) {
+            qDebug("DeviceEnumerationCache::load: %s: expired", qPrintable(hardwareId));
+        } else {
+            m_entries.insert(hardwareId, entry);
+        }
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        qWarning("DeviceEnumerationCache::load: %s: truncated", qPrintable(m_fileName));
+        m_entries.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void DeviceEnumerationCache::save(const QByteArray& fingerprint) const
+{
+    QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+    QFile file(m_fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning("DeviceEnumerationCache::save: cannot write %s", qPrintable(m_fileName));
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream << m_magic << m_version << fingerprint << (quint32) m_entries.size();
+
+    for (QMap<QString, Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        stream << it.key() << it->m_elapsedMs << it->m_timestampMs << (quint32) it->m_originDevices.size();
+
+        for (const PluginInterface::OriginDevice& device : it->m_originDevices)
+        {
+            stream << device.displayableName << device.hardwareId << device.serial
+                << (qint32) device.sequence << (qint32) device.nbRxStreams << (qint32) device.nbTxStreams;
+        }
+    }
+}
+
+bool DeviceEnumerationCache::get(const QString& hardwareId, PluginInterface::OriginDevices& originDevices) const
+{
+    QMap<QString, Entry>::const_iterator it = m_entries.find(hardwareId);
+
+    if ((it == m_entries.end()) || (it->m_elapsedMs < m_minElapsedMs)) {
+        return false;
+    }
+
+    originDevices = it->m_originDevices;
+    return true;
+}
+
+void DeviceEnumerationCache::put(const QString& hardwareId, const PluginInterface::OriginDevices& originDevices, qint64 elapsedMs)
+{
+    Entry& entry = m_entries[hardwareId];
+    entry.m_originDevices = originDevices;
+    entry.m_elapsedMs = elapsedMs;
+    entry.m_timestampMs = QDateTime::currentMSecsSinceEpoch();
+}
+
+QByteArray DeviceEnumerationCache::getHardwareFingerprint()
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+#if defined(__linux__)
+    // bus and device numbers change whenever a device is plugged or unplugged
+    QDir usbDevices("/sys/bus/usb/devices");
+
+    for (const QString& device : usbDevices.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name))
+    {
+        for (const char *attribute : {"busnum", "devnum", "idVendor", "idProduct"})
+        {
+            QFile file(usbDevices.absoluteFilePath(device) + "/" + attribute);
+
+            if (file.open(QIODevice::ReadOnly)) {
+                hash.addData(file.readAll());
+            }
+        }
+    }
+#endif
+    return hash.result();
+}
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DEVICE_DEVICEENUMERATIONCACHE_H_
+#define SDRBASE_DEVICE_DEVICEENUMERATIONCACHE_H_
+
+#include <QMap>
+#include <QString>
+#include <QByteArray>
+
+#include "plugin/plugininterface.h"
+#include "export.h"
+
+/**
+ * On disk cache of the origin devices found by each hardware type at the previous start.
+ * Only the hardware types that were slow to enumerate are taken from the cache so the
+ * fast ones still reflect the devices actually present.
+ *
+ * The cache is discarded when the fingerprint given at load differs from the saved one
+ * (application version, plugin files and on Linux the USB devices topology). Each entry
+ * keeps the time of the enumeration it comes from and is dropped when older than a day
+ * so it is refreshed at least daily. Delete the file to force a full enumeration.
+ */
+class SDRBASE_API DeviceEnumerationCache
+{
+public:
+    DeviceEnumerationCache();
+    ~DeviceEnumerationCache();
+
+    bool load(const QByteArray& fingerprint); //!< false if the cache is missing or stale
+    void save(const QByteArray& fingerprint) const;
+    bool get(const QString& hardwareId, PluginInterface::OriginDevices& originDevices) const;
+    void put(const QString& hardwareId, const PluginInterface::OriginDevices& originDevices, qint64 elapsedMs);
+    const QString& getFileName() const { return m_fileName; }
+
+    static QByteArray getHardwareFingerprint();
+
+private:
+    struct Entry
+    {
+        PluginInterface::OriginDevices m_originDevices;
+        qint64 m_elapsedMs;   //!< duration of the last actual enumeration
+        qint64 m_timestampMs; //!< time of the last actual enumeration (ms since epoch)
+    };
+
+    QMap<QString, Entry> m_entries;
+    QString m_fileName;
+
+    static const quint32 m_magic;
+    static const quint32 m_version;
+    static const qint64 m_maxAgeMs;     //!< entries are discarded after this age
+    static const qint64 m_minElapsedMs; //!< enumerations faster than this are always redone
+};
+
+#endif // SDRBASE_DEVICE_DEVICEENUMERATIONCACHE_H_
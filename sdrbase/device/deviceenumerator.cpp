@@ -15,12 +15,84 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <QGlobalStatic>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QElapsedTimer>
+#include <QCryptographicHash>
 
 #include "plugin/pluginmanager.h"
+#include "device/deviceenumerationcache.h"
 
 #include "deviceenumerator.h"
 
+namespace {
+
+struct HardwareEnumeration
+{
+    QString m_hardwareId;
+    PluginInterface *m_plugin;
+    QStringList m_listedHwIds;
+    PluginInterface::OriginDevices m_originDevices;
+    qint64 m_elapsedMs;
+    bool m_cached;
+
+    HardwareEnumeration(const QString& hardwareId, PluginInterface *plugin) :
+        m_hardwareId(hardwareId),
+        m_plugin(plugin),
+        m_elapsedMs(0),
+        m_cached(false)
+    {}
+};
+
+// Enumerates one or more hardware types one after the other in a pool thread
+class HardwareEnumerationTask : public QRunnable
+{
+public:
+    void add(HardwareEnumeration *hardwareEnumeration) { m_hardwareEnumerations.push_back(hardwareEnumeration); }
+    bool isEmpty() const { return m_hardwareEnumerations.empty(); }
+
+    virtual void run()
+    {
+        for (HardwareEnumeration *hardwareEnumeration : m_hardwareEnumerations)
+        {
+            QElapsedTimer timer;
+            timer.start();
+            hardwareEnumeration->m_plugin->enumOriginDevices(hardwareEnumeration->m_listedHwIds, hardwareEnumeration->m_originDevices);
+            hardwareEnumeration->m_elapsedMs = timer.elapsed();
+        }
+    }
+
+private:
+    std::vector<HardwareEnumeration*> m_hardwareEnumerations;
+};
+
+// First plugin of each hardware type in registration order (Rx, Tx, MIMO)
+void addHardwareEnumerations(std::vector<HardwareEnumeration>& hardwareEnumerations, const PluginAPI::SamplingDeviceRegistrations& registrations)
+{
+    for (const PluginAPI::SamplingDeviceRegistration& registration : registrations)
+    {
+        std::vector<HardwareEnumeration>::const_iterator it = hardwareEnumerations.begin();
+
+        for (; it != hardwareEnumerations.end(); ++it)
+        {
+            if (it->m_hardwareId == registration.m_deviceHardwareId) {
+                break;
+            }
+        }
+
+        if (it == hardwareEnumerations.end()) {
+            hardwareEnumerations.push_back(HardwareEnumeration(registration.m_deviceHardwareId, registration.m_plugin));
+        }
+    }
+}
+
+}
+
+const int DeviceEnumerator::m_maxEnumerationThreads = 16;
+
 Q_GLOBAL_STATIC(DeviceEnumerator, deviceEnumerator)
 DeviceEnumerator *DeviceEnumerator::instance()
 {
@@ -181,6 +253,101 @@ bool DeviceEnumerator::isTxEnumerated(const QString& deviceHwId, int deviceSeque
     return false;
 }
 
+void DeviceEnumerator::enumerateOriginDevices(PluginManager *pluginManager, bool useCache)
+{
+    std::vector<HardwareEnumeration> hardwareEnumerations;
+    addHardwareEnumerations(hardwareEnumerations, pluginManager->getSourceDeviceRegistrations());
+    addHardwareEnumerations(hardwareEnumerations, pluginManager->getSinkDeviceRegistrations());
+    addHardwareEnumerations(hardwareEnumerations, pluginManager->getMIMODeviceRegistrations());
+
+    DeviceEnumerationCache cache;
+    QByteArray fingerprint;
+    bool cacheLoaded = false;
+
+    if (useCache)
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(pluginManager->getPluginsFingerprint());
+        hash.addData(DeviceEnumerationCache::getHardwareFingerprint());
+        fingerprint = hash.result();
+        cacheLoaded = cache.load(fingerprint);
+        qInfo("DeviceEnumerator::enumerateOriginDevices: cache %s %s",
+            cacheLoaded ? "loaded from" : "will be rebuilt in", qPrintable(cache.getFileName()));
+    }
+
+    // Most of the time is spent waiting on USB or network so every hardware type gets its thread
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(std::max(1, std::min((int) hardwareEnumerations.size(), m_maxEnumerationThreads)));
+    HardwareEnumerationTask *sequentialTask = new HardwareEnumerationTask();
+
+    for (HardwareEnumeration& hardwareEnumeration : hardwareEnumerations)
+    {
+        if (cacheLoaded
+            && hardwareEnumeration.m_plugin->isEnumerationCacheable()
+            && cache.get(hardwareEnumeration.m_hardwareId, hardwareEnumeration.m_originDevices))
+        {
+            hardwareEnumeration.m_cached = true;
+        }
+        else if (hardwareEnumeration.m_plugin->isEnumerationThreadSafe())
+        {
+            HardwareEnumerationTask *task = new HardwareEnumerationTask();
+            task->add(&hardwareEnumeration);
+            threadPool.start(task);
+        }
+        else
+        {
+            sequentialTask->add(&hardwareEnumeration);
+        }
+    }
+
+    if (sequentialTask->isEmpty()) {
+        delete sequentialTask;
+    } else {
+        threadPool.start(sequentialTask);
+    }
+
+    threadPool.waitForDone();
+
+    // Merge in registration order so that the device lists do not depend on thread scheduling
+    m_originDevices.clear();
+    m_originDevicesHwIds.clear();
+
+    for (const HardwareEnumeration& hardwareEnumeration : hardwareEnumerations)
+    {
+        if (hardwareEnumeration.m_cached)
+        {
+            qDebug("DeviceEnumerator::enumerateOriginDevices: %s: %d devices from cache",
+                qPrintable(hardwareEnumeration.m_hardwareId), hardwareEnumeration.m_originDevices.size());
+        }
+        else
+        {
+            qDebug("DeviceEnumerator::enumerateOriginDevices: %s: %d devices in %lld ms",
+                qPrintable(hardwareEnumeration.m_hardwareId), hardwareEnumeration.m_originDevices.size(), hardwareEnumeration.m_elapsedMs);
+
+            if (useCache && hardwareEnumeration.m_plugin->isEnumerationCacheable()) {
+                cache.put(hardwareEnumeration.m_hardwareId, hardwareEnumeration.m_originDevices, hardwareEnumeration.m_elapsedMs);
+            }
+        }
+
+        m_originDevices.append(hardwareEnumeration.m_originDevices);
+
+        for (const QString& hardwareId : hardwareEnumeration.m_listedHwIds)
+        {
+            if (!m_originDevicesHwIds.contains(hardwareId)) {
+                m_originDevicesHwIds.append(hardwareId);
+            }
+        }
+
+        if (!m_originDevicesHwIds.contains(hardwareEnumeration.m_hardwareId)) {
+            m_originDevicesHwIds.append(hardwareEnumeration.m_hardwareId);
+        }
+    }
+
+    if (useCache) {
+        cache.save(fingerprint);
+    }
+}
+
 void DeviceEnumerator::enumerateRxDevices(PluginManager *pluginManager)
 {
     m_rxEnumeration.clear();
@@ -34,6 +34,7 @@ public:
 
     static DeviceEnumerator *instance();
 
+    void enumerateOriginDevices(PluginManager *pluginManager, bool useCache); //!< all hardware types concurrently
     void enumerateRxDevices(PluginManager *pluginManager);
     void enumerateTxDevices(PluginManager *pluginManager);
     void enumerateMIMODevices(PluginManager *pluginManager);
@@ -84,6 +85,8 @@ private:
     PluginInterface::OriginDevices m_originDevices;
     QStringList m_originDevicesHwIds;
 
+    static const int m_maxEnumerationThreads;
+
     PluginInterface *getRxRegisteredPlugin(PluginManager *pluginManager, const QString& deviceHwId);
     PluginInterface *getTxRegisteredPlugin(PluginManager *pluginManager, const QString& deviceHwId);
     bool isRxEnumerated(const QString& deviceHwId, int deviceSequence);
@@ -0,0 +1,301 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <math.h>
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "dsp/atvlinekernels.h"
+
+namespace {
+
+#ifdef USE_SSE2
+// load four consecutive samples as [re0, re1, re2, re3] and [im0, im1, im2, im3]
+inline void load4(const Complex *in, __m128& re, __m128& im)
+{
+    __m128 a = _mm_loadu_ps((const float*) in);       // [re0, im0, re1, im1]
+    __m128 b = _mm_loadu_ps((const float*) (in + 2)); // [re2, im2, re3, im3]
+    re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+inline int firstBit(int mask)
+{
+    int i = 0;
+
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        i++;
+    }
+
+    return i;
+}
+#endif
+
+} // namespace
+
+void ATVLineKernels::magnitude(const Complex *in, float *magSq, float *mag, int n)
+{
+    int i = 0;
+
+#ifdef USE_SSE2
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 re, im;
+        load4(&in[i], re, im);
+        __m128 m2 = _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+        _mm_storeu_ps(&magSq[i], m2);
+        _mm_storeu_ps(&mag[i], _mm_sqrt_ps(m2));
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        magSq[i] = in[i].real()*in[i].real() + in[i].imag()*in[i].imag();
+        mag[i] = sqrt(magSq[i]);
+    }
+}
+
+void ATVLineKernels::normalize(const Complex *in, const float *mag, float *normI, float *normQ, int n)
+{
+    int i = 0;
+
+#ifdef USE_SSE2
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 re, im;
+        load4(&in[i], re, im);
+        __m128 m = _mm_loadu_ps(&mag[i]);
+        _mm_storeu_ps(&normI[i], _mm_div_ps(re, m));
+        _mm_storeu_ps(&normQ[i], _mm_div_ps(im, m));
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        normI[i] = in[i].real() / mag[i];
+        normQ[i] = in[i].imag() / mag[i];
+    }
+}
+
+void ATVLineKernels::discriminator1(const float *normI, const float *normQ, float *out, int n)
+{
+    int i = 0;
+
+#ifdef USE_SSE2
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 quarter = _mm_set1_ps(0.25f);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 dQ = _mm_sub_ps(_mm_loadu_ps(&normQ[i]), _mm_loadu_ps(&normQ[i-2]));
+        __m128 dI = _mm_sub_ps(_mm_loadu_ps(&normI[i]), _mm_loadu_ps(&normI[i-2]));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(&normI[i-1]), dQ), _mm_mul_ps(_mm_loadu_ps(&normQ[i-1]), dI));
+        _mm_storeu_ps(&out[i], _mm_mul_ps(_mm_add_ps(y, two), quarter));
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        float y = normI[i-1]*(normQ[i] - normQ[i-2]) - normQ[i-1]*(normI[i] - normI[i-2]);
+        out[i] = (y + 2.0f) / 4.0f;
+    }
+}
+
+void ATVLineKernels::discriminator2(const float *normI, const float *normQ, float *out, int n)
+{
+    int i = 0;
+
+#ifdef USE_SSE2
+    const __m128 sixteenth = _mm_set1_ps(1.0f / 16.0f);
+    const __m128 offset = _mm_set1_ps(2.125f);
+    const __m128 span = _mm_set1_ps(4.25f);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 fQ = _mm_add_ps(
+            _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&normQ[i-6]), _mm_loadu_ps(&normQ[i])), sixteenth),
+            _mm_sub_ps(_mm_loadu_ps(&normQ[i-2]), _mm_loadu_ps(&normQ[i-4])));
+        __m128 fI = _mm_add_ps(
+            _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&normI[i-6]), _mm_loadu_ps(&normI[i])), sixteenth),
+            _mm_sub_ps(_mm_loadu_ps(&normI[i-2]), _mm_loadu_ps(&normI[i-4])));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(&normI[i-3]), fQ), _mm_mul_ps(_mm_loadu_ps(&normQ[i-3]), fI));
+        _mm_storeu_ps(&out[i], _mm_div_ps(_mm_add_ps(y, offset), span));
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        float y = normI[i-3]*((normQ[i-6] - normQ[i])/16.0f + normQ[i-2] - normQ[i-4]);
+        y -= normQ[i-3]*((normI[i-6] - normI[i])/16.0f + normI[i-2] - normI[i-4]);
+        out[i] = (y + 2.125f) / 4.25f;
+    }
+}
+
+void ATVLineKernels::scale(const float *in, float *out, int n, float scale, float offset)
+{
+    int i = 0;
+
+#ifdef USE_SSE2
+    const __m128 mul = _mm_set1_ps(scale);
+    const __m128 ofs = _mm_set1_ps(offset);
+
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(&out[i], _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&in[i]), mul), ofs));
+    }
+#endif
+
+    for (; i < n; i++) {
+        out[i] = in[i] * scale + offset;
+    }
+}
+
+void ATVLineKernels::minMax(const float *in, int n, float& min, float& max)
+{
+    int i = 0;
+
+#ifdef USE_SSE2
+    if (n >= 4)
+    {
+        __m128 vmin = _mm_set1_ps(min);
+        __m128 vmax = _mm_set1_ps(max);
+
+        for (; i + 4 <= n; i += 4)
+        {
+            __m128 v = _mm_loadu_ps(&in[i]);
+            vmin = _mm_min_ps(vmin, v);
+            vmax = _mm_max_ps(vmax, v);
+        }
+
+        alignas(16) float lmin[4], lmax[4];
+        _mm_store_ps(lmin, vmin);
+        _mm_store_ps(lmax, vmax);
+
+        for (int k = 0; k < 4; k++)
+        {
+            min = lmin[k] < min ? lmin[k] : min;
+            max = lmax[k] > max ? lmax[k] : max;
+        }
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        min = in[i] < min ? in[i] : min;
+        max = in[i] > max ? in[i] : max;
+    }
+}
+
+void ATVLineKernels::toVideo(float *samples, int *video, int n, float scale, float offset, float levelBlack, float rangeCorrection)
+{
+    int i = 0;
+
+#ifdef USE_SSE2
+    const __m128 mul = _mm_set1_ps(scale);
+    const __m128 ofs = _mm_set1_ps(offset);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 black = _mm_set1_ps(levelBlack);
+    const __m128 range = _mm_set1_ps(rangeCorrection);
+    const __m128 white = _mm_set1_ps(255.0f);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 s = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&samples[i]), mul), ofs);
+        s = _mm_min_ps(_mm_max_ps(s, zero), one);
+        _mm_storeu_ps(&samples[i], s);
+        __m128 v = _mm_mul_ps(_mm_sub_ps(s, black), range);
+        v = _mm_min_ps(_mm_max_ps(v, zero), white); // clipping before truncation gives the same level
+        _mm_storeu_si128((__m128i*) &video[i], _mm_cvttps_epi32(v));
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        float s = samples[i] * scale + offset;
+        s = (s < 0.0f) ? 0.0f : (s > 1.0f) ? 1.0f : s;
+        samples[i] = s;
+        int v = (int) ((s - levelBlack) * rangeCorrection);
+        video[i] = (v < 0) ? 0 : (v > 255) ? 255 : v;
+    }
+}
+
+int ATVLineKernels::countBelow(const float *in, int n, float level)
+{
+    int i = 0;
+    int count = 0;
+
+#ifdef USE_SSE2
+    const __m128 lvl = _mm_set1_ps(level);
+    __m128i acc = _mm_setzero_si128();
+
+    for (; i + 4 <= n; i += 4) // comparison lanes are -1 when true
+    {
+        acc = _mm_sub_epi32(acc, _mm_castps_si128(_mm_cmplt_ps(_mm_loadu_ps(&in[i]), lvl)));
+    }
+
+    alignas(16) int lanes[4];
+    _mm_store_si128((__m128i*) lanes, acc);
+    count = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+    for (; i < n; i++) {
+        count += in[i] < level;
+    }
+
+    return count;
+}
+
+int ATVLineKernels::findFallingEdge(const float *in, int start, int n, float prev, float level)
+{
+    int i = start;
+
+    if ((i == 0) && (n > 0))
+    {
+        if ((prev >= level) && (in[0] < level)) {
+            return 0;
+        }
+
+        i++;
+    }
+
+#ifdef USE_SSE2
+    const __m128 lvl = _mm_set1_ps(level);
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 below = _mm_cmplt_ps(_mm_loadu_ps(&in[i]), lvl);
+        __m128 above = _mm_cmpge_ps(_mm_loadu_ps(&in[i-1]), lvl);
+        int mask = _mm_movemask_ps(_mm_and_ps(below, above));
+
+        if (mask) {
+            return i + firstBit(mask);
+        }
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        if ((in[i-1] >= level) && (in[i] < level)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
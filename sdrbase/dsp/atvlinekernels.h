@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_ATVLINEKERNELS_H_
+#define SDRBASE_DSP_ATVLINEKERNELS_H_
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Analog TV demodulation kernels working on a whole video line with SSE2 versions.
+ * They are the block counterparts of the per sample computations of the ATV demodulator
+ * so that a line can be demodulated, converted to gray levels and scanned for sync
+ * pulses in a few passes instead of one sample at a time.
+ */
+class SDRBASE_API ATVLineKernels
+{
+public:
+    /** magnitude squared and magnitude of each sample */
+    static void magnitude(const Complex *in, float *magSq, float *mag, int n);
+    /** in-phase and quadrature components of each sample divided by its magnitude */
+    static void normalize(const Complex *in, const float *mag, float *normI, float *normQ, int n);
+    /**
+     * FM discriminator #1: (I[k-1](Q[k] - Q[k-2]) - Q[k-1](I[k] - I[k-2]) + 2) / 4
+     * on normalized samples. normI and normQ must be preceded by 2 history samples.
+     */
+    static void discriminator1(const float *normI, const float *normQ, float *out, int n);
+    /**
+     * FM discriminator #2 (folded): (I[k-3]((Q[k-6] - Q[k])/16 + Q[k-2] - Q[k-4])
+     * - Q[k-3]((I[k-6] - I[k])/16 + I[k-2] - I[k-4]) + 2.125) / 4.25
+     * on normalized samples. normI and normQ must be preceded by 6 history samples.
+     */
+    static void discriminator2(const float *normI, const float *normQ, float *out, int n);
+    /** out = in * scale + offset */
+    static void scale(const float *in, float *out, int n, float scale, float offset);
+    /** minimum and maximum of the samples. min and max are updated not reset. */
+    static void minMax(const float *in, int n, float& min, float& max);
+    /**
+     * Video level s = sample * scale + offset clipped to [0, 1] stored back in samples
+     * and gray level (s - levelBlack) * rangeCorrection truncated and clipped to [0, 255].
+     */
+    static void toVideo(float *samples, int *video, int n, float scale, float offset, float levelBlack, float rangeCorrection);
+    /** number of samples below level */
+    static int countBelow(const float *in, int n, float level);
+    /**
+     * Index of the first sample from start that goes below level while the previous one is
+     * at or above level or -1 if none. prev is the sample preceding in[0].
+     */
+    static int findFallingEdge(const float *in, int start, int n, float prev, float level);
+};
+
+#endif // SDRBASE_DSP_ATVLINEKERNELS_H_
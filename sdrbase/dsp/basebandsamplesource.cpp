@@ -20,7 +20,8 @@
 #include "util/message.h"
 
 BasebandSampleSource::BasebandSampleSource() :
-    m_guiMessageQueue(nullptr)
+    m_guiMessageQueue(nullptr),
+    m_mixGain(1.0f)
 {
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
 }
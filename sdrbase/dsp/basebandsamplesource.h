@@ -41,10 +41,13 @@ public:
 	MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     virtual void setMessageQueueToGUI(MessageQueue *queue) { m_guiMessageQueue = queue; }
     MessageQueue *getMessageQueueToGUI() { return m_guiMessageQueue; }
+    void setMixGain(float gain) { m_mixGain = gain; } //!< Gain applied when mixed with other sources of the same stream
+    float getMixGain() const { return m_mixGain; }
 
 protected:
 	MessageQueue m_inputMessageQueue;     //!< Queue for asynchronous inbound communication
     MessageQueue *m_guiMessageQueue;      //!< Input message queue to the GUI
+    float m_mixGain;                      //!< Gain in the mix of sources of the same stream
 
 protected slots:
 	void handleInputMessages();
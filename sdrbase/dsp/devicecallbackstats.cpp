@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include "devicecallbackstats.h"
+
+DeviceCallbackStats::DeviceCallbackStats() :
+    m_callbacks(0),
+    m_totalNs(0),
+    m_maxNs(0),
+    m_lateCallbacks(0),
+    m_overruns(0)
+{}
+
+void DeviceCallbackStats::reset()
+{
+    m_callbacks.store(0);
+    m_totalNs.store(0);
+    m_maxNs.store(0);
+    m_lateCallbacks.store(0);
+    m_overruns.store(0);
+}
+
+void DeviceCallbackStats::record(qint64 durationNs, qint64 blockPeriodNs)
+{
+    // single writer: no need for read-modify-write loops
+    m_callbacks.fetchAndAddRelaxed(1);
+    m_totalNs.fetchAndAddRelaxed(durationNs);
+
+    if ((quint64) durationNs > m_maxNs.load()) {
+        m_maxNs.store(durationNs);
+    }
+
+    if ((blockPeriodNs > 0) && (durationNs > blockPeriodNs)) {
+        m_lateCallbacks.fetchAndAddRelaxed(1);
+    }
+}
@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_DEVICECALLBACKSTATS_H_
+#define SDRBASE_DSP_DEVICECALLBACKSTATS_H_
+
+#include <QAtomicInteger>
+
+#include "export.h"
+
+/**
+ * Timing of the sample callbacks of a device library (USB transfer completion) and count of the
+ * blocks lost because the processing could not keep up. Updated from the callback thread and read
+ * from any thread (web API metrics). A callback is late when it lasts longer than the time the
+ * device takes to deliver the block: the library then runs out of transfers and the device overruns.
+ */
+class SDRBASE_API DeviceCallbackStats
+{
+public:
+    DeviceCallbackStats();
+
+    void reset();
+    void record(qint64 durationNs, qint64 blockPeriodNs); //!< from the callback
+    void overrun() { m_overruns.fetchAndAddRelaxed(1); }   //!< a block was dropped
+
+    quint64 getCallbacks() const { return m_callbacks.load(); }
+    quint64 getTotalNs() const { return m_totalNs.load(); }
+    quint64 getMaxNs() const { return m_maxNs.load(); }
+    quint64 getLateCallbacks() const { return m_lateCallbacks.load(); }
+    quint64 getOverruns() const { return m_overruns.load(); }
+
+private:
+    QAtomicInteger<quint64> m_callbacks;
+    QAtomicInteger<quint64> m_totalNs;
+    QAtomicInteger<quint64> m_maxNs;
+    QAtomicInteger<quint64> m_lateCallbacks;
+    QAtomicInteger<quint64> m_overruns;
+};
+
+#endif // SDRBASE_DSP_DEVICECALLBACKSTATS_H_
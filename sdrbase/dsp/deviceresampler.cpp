@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDebug>
+
+#include "dsp/samplesinkfifo.h"
+#include "deviceresampler.h"
+
+const int DeviceResampler::m_phaseSteps = 128; // about -62 dB interpolation residual
+const int DeviceResampler::m_nbTaps = 72;
+
+DeviceResampler::DeviceResampler() :
+    m_changed(0),
+    m_pendingInputRate(0),
+    m_pendingOutputRate(0),
+    m_active(false),
+    m_distance(0.0f),
+    m_distanceStep(1.0f)
+{}
+
+DeviceResampler::~DeviceResampler()
+{}
+
+int DeviceResampler::getOutputRate(int inputRate, int outputRate)
+{
+    return outputRate > 0 ? clampOutputRate(inputRate, outputRate) : inputRate;
+}
+
+int DeviceResampler::clampOutputRate(int inputRate, int outputRate)
+{
+    if (outputRate <= 0) {
+        return 0;
+    }
+
+    if (inputRate <= 0) { // not known yet
+        return outputRate;
+    }
+
+    return std::max((inputRate + 1) / 2, std::min(2*inputRate - 1, outputRate));
+}
+
+void DeviceResampler::configure(int inputRate, int outputRate)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_pendingInputRate = inputRate;
+    m_pendingOutputRate = outputRate;
+    m_changed.storeRelease(1);
+}
+
+void DeviceResampler::apply()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_changed.storeRelease(0);
+    int outputRate = clampOutputRate(m_pendingInputRate, m_pendingOutputRate);
+
+    if ((m_pendingInputRate <= 0) || (outputRate <= 0) || (m_pendingInputRate == outputRate))
+    {
+        m_active = false;
+        qDebug("DeviceResampler::apply: bypass");
+        return;
+    }
+
+    if (outputRate != m_pendingOutputRate) {
+        qWarning("DeviceResampler::apply: %d S/s out of range clamped to %d S/s", m_pendingOutputRate, outputRate);
+    }
+
+    // filter at the lowest of the two rates
+    m_interpolator.create(m_phaseSteps, m_pendingInputRate, std::min(m_pendingInputRate, outputRate) / 2.2, m_nbTaps / (double) m_phaseSteps);
+    m_distanceStep = (Real) m_pendingInputRate / (Real) outputRate;
+    m_distance = 0.0f;
+    m_active = true;
+    qDebug("DeviceResampler::apply: %d S/s to %d S/s", m_pendingInputRate, outputRate);
+}
+
+void DeviceResampler::write(SampleSinkFifo *sampleFifo, SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+    if (m_changed.loadAcquire()) {
+        apply();
+    }
+
+    if (!m_active)
+    {
+        sampleFifo->write(begin, end);
+        return;
+    }
+
+    int nbIn = end - begin;
+
+    if (m_in.size() < (unsigned int) nbIn) {
+        m_in.resize(nbIn);
+    }
+
+    for (int i = 0; i < nbIn; ++i, ++begin) {
+        m_in[i] = Complex(begin->real(), begin->imag());
+    }
+
+    int nbOut = m_distanceStep >= 1.0f ?
+        m_interpolator.decimate(&m_distance, m_distanceStep, m_in.data(), nbIn, m_out) :
+        m_interpolator.interpolate(&m_distance, m_distanceStep, m_in.data(), nbIn, m_out);
+
+    if (m_samples.size() < (unsigned int) nbOut) {
+        m_samples.resize(nbOut);
+    }
+
+    for (int i = 0; i < nbOut; i++)
+    {
+        // the filter may overshoot slightly on full scale signals
+        Real re = std::max(-SDR_RX_SCALEF, std::min(SDR_RX_SCALEF - 1.0f, m_out[i].real()));
+        Real im = std::max(-SDR_RX_SCALEF, std::min(SDR_RX_SCALEF - 1.0f, m_out[i].imag()));
+        m_samples[i].setReal((FixReal) lrintf(re));
+        m_samples[i].setImag((FixReal) lrintf(im));
+    }
+
+    sampleFifo->write(m_samples.begin(), m_samples.begin() + nbOut);
+}
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_DEVICERESAMPLER_H_
+#define SDRBASE_DSP_DEVICERESAMPLER_H_
+
+#include <vector>
+
+#include <QMutex>
+#include <QAtomicInt>
+
+#include "dsp/dsptypes.h"
+#include "dsp/interpolator.h"
+#include "export.h"
+
+class SampleSinkFifo;
+
+/**
+ * Optional arbitrary rate resampler between the power of two decimation of a device source
+ * and its sample FIFO so that the baseband runs at a chosen rate (e.g. exactly 2.4 MS/s or a
+ * multiple of 48 kHz). It uses the polyphase Interpolator block methods. When not configured or
+ * configured with the decimated rate the samples are written as is.
+ *
+ * The filter has a fixed number of taps so the output to input ratio is limited to [0.5, 2).
+ * Larger rate changes are left to the power of two decimation. Output rates outside of this
+ * range are clamped (see clampOutputRate).
+ *
+ * configure() can be called from any thread. The new rates are picked up by the streaming
+ * thread at the next write().
+ */
+class SDRBASE_API DeviceResampler
+{
+public:
+    DeviceResampler();
+    ~DeviceResampler();
+
+    void configure(int inputRate, int outputRate); //!< outputRate 0 disables resampling
+    static int getOutputRate(int inputRate, int outputRate); //!< actual output rate of a configuration
+    static int clampOutputRate(int inputRate, int outputRate); //!< outputRate within the supported ratios or 0
+    void write(SampleSinkFifo *sampleFifo, SampleVector::const_iterator begin, SampleVector::const_iterator end);
+
+private:
+    QMutex m_mutex;
+    QAtomicInt m_changed;
+    int m_pendingInputRate;
+    int m_pendingOutputRate;
+    bool m_active;
+    Interpolator m_interpolator;
+    Real m_distance;
+    Real m_distanceStep;
+    std::vector<Complex> m_in;
+    std::vector<Complex> m_out;
+    SampleVector m_samples;
+
+    static const int m_phaseSteps; //!< phase resolution of the polyphase filter
+    static const int m_nbTaps;     //!< taps per output sample
+
+    void apply();
+};
+
+#endif // SDRBASE_DSP_DEVICERESAMPLER_H_
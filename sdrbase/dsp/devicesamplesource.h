@@ -27,6 +27,8 @@
 #include "util/messagequeue.h"
 #include "export.h"
 
+class DeviceCallbackStats;
+
 namespace SWGSDRangel
 {
     class SWGDeviceSettings;
@@ -133,6 +135,7 @@ public:
 	virtual void setMessageQueueToGUI(MessageQueue *queue) = 0; // pure virtual so that child classes must have to deal with this
 	MessageQueue *getMessageQueueToGUI() { return m_guiMessageQueue; }
     SampleSinkFifo* getSampleFifo() { return &m_sampleFifo; }
+    virtual const DeviceCallbackStats* getCallbackStats() const { return nullptr; } //!< for sources decimating in the device library callback
 
     static qint64 calculateDeviceCenterFrequency(
             quint64 centerFrequency,
@@ -25,6 +25,7 @@
 #include "downchannelizer.h"
 
 DownChannelizer::DownChannelizer(ChannelSampleSink* sampleSink) :
+    m_filterChainPending(false),
     m_filterChainSetMode(false),
 	m_sampleSink(sampleSink),
 	m_basebandSampleRate(0),
@@ -50,6 +51,10 @@ void DownChannelizer::feed(const SampleVector::const_iterator& begin, const Samp
 		return;
 	}
 
+	if (m_filterChainPending) {
+		buildFilterChain();
+	}
+
 	if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
 	{
 		m_sampleSink->feed(begin, end);
@@ -125,16 +130,19 @@ void DownChannelizer::applyChannelization()
         return;
 	}
 
-	freeFilterChain();
+	std::vector<FilterStage::Mode> previousStageModes;
+	previousStageModes.swap(m_stageModes);
 
 	m_channelFrequencyOffset = createFilterChain(
 		m_basebandSampleRate / -2, m_basebandSampleRate / 2,
 		m_requestedCenterFrequency - m_requestedOutputSampleRate / 2, m_requestedCenterFrequency + m_requestedOutputSampleRate / 2);
 
-	m_channelSampleRate = m_basebandSampleRate / (1 << m_filterStages.size());
+	m_channelSampleRate = m_basebandSampleRate / (1 << m_stageModes.size());
+	m_filterChainPending = m_filterChainPending || (m_stageModes != previousStageModes); // same chain: keep filters as they are
 
 	qDebug() << "DownChannelizer::applyChannelization done:"
-        << " nb stages:" << m_filterStages.size()
+        << " nb stages:" << m_stageModes.size()
+        << " rebuild:" << m_filterChainPending
         << " in (baseband):" << m_basebandSampleRate
 		<< " req:" << m_requestedOutputSampleRate
 		<< " out (channel):" << m_channelSampleRate
@@ -155,10 +163,10 @@ void DownChannelizer::applyDecimation()
     m_channelFrequencyOffset = m_basebandSampleRate * HBFilterChainConverter::convertToIndexes(m_log2Decim, m_filterChainHash, stageIndexes);
     m_requestedCenterFrequency = m_channelFrequencyOffset;
 
-    freeFilterChain();
-
+    m_stageModes.clear();
     m_channelFrequencyOffset = m_basebandSampleRate * setFilterChain(stageIndexes);
-    m_channelSampleRate = m_basebandSampleRate / (1 << m_filterStages.size());
+    m_channelSampleRate = m_basebandSampleRate / (1 << m_stageModes.size());
+    m_filterChainPending = true;
     m_requestedOutputSampleRate = m_channelSampleRate;
 
 	qDebug() << "DownChannelizer::applyDecimation:"
@@ -239,7 +247,7 @@ Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanSta
 	if(signalContainsChannel(sigStart, sigStart + sigBw / 2.0, chanStart, chanEnd))
     {
 		//qDebug("DownChannelizer::createFilterChain: -> take left half (rotate by +1/4 and decimate by 2)");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeLowerHalf));
+		m_stageModes.push_back(FilterStage::ModeLowerHalf);
 		return createFilterChain(sigStart, sigStart + sigBw / 2.0, chanStart, chanEnd);
 	}
 
@@ -247,7 +255,7 @@ Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanSta
 	if(signalContainsChannel(sigEnd - sigBw / 2.0f, sigEnd, chanStart, chanEnd))
     {
 		//qDebug("DownChannelizer::createFilterChain: -> take right half (rotate by -1/4 and decimate by 2)");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeUpperHalf));
+		m_stageModes.push_back(FilterStage::ModeUpperHalf);
 		return createFilterChain(sigEnd - sigBw / 2.0f, sigEnd, chanStart, chanEnd);
 	}
 
@@ -255,7 +263,7 @@ Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanSta
 	if(signalContainsChannel(sigStart + rot, sigEnd - rot, chanStart, chanEnd))
     {
 		//qDebug("DownChannelizer::createFilterChain: -> take center half (decimate by 2)");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeCenter));
+		m_stageModes.push_back(FilterStage::ModeCenter);
 		return createFilterChain(sigStart + rot, sigEnd - rot, chanStart, chanEnd);
 	}
 
@@ -277,18 +285,18 @@ double DownChannelizer::setFilterChain(const std::vector<unsigned int>& stageInd
     {
         if (*rit == 0)
         {
-            m_filterStages.push_back(new FilterStage(FilterStage::ModeLowerHalf));
+            m_stageModes.push_back(FilterStage::ModeLowerHalf);
             ofs -= ofs_stage;
             qDebug("DownChannelizer::setFilterChain: lower half: ofs: %f", ofs);
         }
         else if (*rit == 1)
         {
-            m_filterStages.push_back(new FilterStage(FilterStage::ModeCenter));
+            m_stageModes.push_back(FilterStage::ModeCenter);
             qDebug("DownChannelizer::setFilterChain: center: ofs: %f", ofs);
         }
         else if (*rit == 2)
         {
-            m_filterStages.push_back(new FilterStage(FilterStage::ModeUpperHalf));
+            m_stageModes.push_back(FilterStage::ModeUpperHalf);
             ofs += ofs_stage;
             qDebug("DownChannelizer::setFilterChain: upper half: ofs: %f", ofs);
         }
@@ -297,6 +305,17 @@ double DownChannelizer::setFilterChain(const std::vector<unsigned int>& stageInd
     return ofs;
 }
 
+void DownChannelizer::buildFilterChain()
+{
+	freeFilterChain();
+
+	for (std::vector<FilterStage::Mode>::const_iterator it = m_stageModes.begin(); it != m_stageModes.end(); ++it) {
+		m_filterStages.push_back(new FilterStage(*it));
+	}
+
+	m_filterChainPending = false;
+}
+
 void DownChannelizer::freeFilterChain()
 {
 	for(FilterStages::iterator it = m_filterStages.begin(); it != m_filterStages.end(); ++it)
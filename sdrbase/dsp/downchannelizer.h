@@ -74,6 +74,8 @@ protected:
 	};
 	typedef std::list<FilterStage*> FilterStages;
 	FilterStages m_filterStages;
+	std::vector<FilterStage::Mode> m_stageModes; //!< Target filter chain
+	bool m_filterChainPending; //!< Filter chain is rebuilt on next feed so several changes in a row cost one rebuild
     bool m_filterChainSetMode;
 	ChannelSampleSink* m_sampleSink; //!< Demodulator
     int m_basebandSampleRate;
@@ -90,6 +92,7 @@ protected:
 	bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
 	Real createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
     double setFilterChain(const std::vector<unsigned int>& stageIndexes);
+	void buildFilterChain();
 	void freeFilterChain();
 	void debugFilterChain();
 };
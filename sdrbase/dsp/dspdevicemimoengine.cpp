@@ -428,40 +428,27 @@ void DSPDeviceMIMOEngine::workSamplesSource(SampleVector& data, unsigned int iBe
                 begin
             );
         }
-        else if (m_basebandSampleSources[streamIndex].size() == 1)
+        else if ((m_basebandSampleSources[streamIndex].size() == 1)
+            && (m_basebandSampleSources[streamIndex].front()->getMixGain() == 1.0f))
         {
             BasebandSampleSource *sampleSource = m_basebandSampleSources[streamIndex].front();
             sampleSource->pull(begin, nbSamples);
         }
         else
         {
+            // sum of sources times their gain scaled by the number of sources
             m_sourceSampleBuffers[streamIndex].allocate(nbSamples);
+            SampleVector::iterator aBegin = m_sourceSampleBuffers[streamIndex].m_vector.begin();
             BasebandSampleSources::const_iterator srcIt = m_basebandSampleSources[streamIndex].begin();
-            BasebandSampleSource *sampleSource = *srcIt;
-            sampleSource->pull(begin, nbSamples);
-            ++srcIt;
-            m_sumIndex = 1;
+            m_sampleMixer.reset(nbSamples);
 
-            for (; srcIt != m_basebandSampleSources[streamIndex].end(); ++srcIt, m_sumIndex++)
+            for (; srcIt != m_basebandSampleSources[streamIndex].end(); ++srcIt)
             {
-                sampleSource = *srcIt;
-                SampleVector::iterator aBegin = m_sourceSampleBuffers[streamIndex].m_vector.begin();
-                sampleSource->pull(aBegin, nbSamples);
-                std::transform(
-                    aBegin,
-                    aBegin + nbSamples,
-                    begin,
-                    begin,
-                    [this](Sample& a, const Sample& b) -> Sample {
-                        int den = m_sumIndex + 1; // at each stage scale sum by n/n+1 and input by 1/n+1
-                        int nom = m_sumIndex;     // so that final sum is scaled by N (number of channels)
-                        return Sample{
-                            a.real()/den + nom*(b.real()/den),
-                            a.imag()/den + nom*(b.imag()/den)
-                        };
-                    }
-                );
+                (*srcIt)->pull(aBegin, nbSamples);
+                m_sampleMixer.add(aBegin, nbSamples, (*srcIt)->getMixGain());
             }
+
+            m_sampleMixer.output(begin, nbSamples, 1.0f / m_basebandSampleSources[streamIndex].size());
         }
     }
 
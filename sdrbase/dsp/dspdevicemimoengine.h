@@ -27,6 +27,7 @@
 #include "util/syncmessenger.h"
 #include "util/movingaverage.h"
 #include "util/incrementalvector.h"
+#include "dsp/samplemixer.h"
 #include "export.h"
 
 class DeviceSampleMIMO;
@@ -327,7 +328,7 @@ private:
 	std::vector<BasebandSampleSources> m_basebandSampleSources; //!< channel sample sources (per output stream)
     std::vector<IncrementalVector<Sample>> m_sourceSampleBuffers;
     std::vector<IncrementalVector<Sample>> m_sourceZeroBuffers;
-    unsigned int m_sumIndex;            //!< channel index when summing channels
+    SampleMixer m_sampleMixer;          //!< mixes channel sources of a stream
 
     typedef std::list<MIMOChannel*> MIMOChannels;
     MIMOChannels m_mimoChannels; //!< MIMO channels
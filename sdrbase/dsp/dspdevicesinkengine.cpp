@@ -197,40 +197,25 @@ void DSPDeviceSinkEngine::workSamples(SampleVector& data, unsigned int iBegin, u
             data.begin() + iBegin
         );
     }
-    else if (m_basebandSampleSources.size() == 1)
+    else if ((m_basebandSampleSources.size() == 1) && (m_basebandSampleSources.front()->getMixGain() == 1.0f))
     {
         BasebandSampleSource *source = m_basebandSampleSources.front();
         source->pull(begin, nbSamples);
     }
     else
     {
+        // sum of sources times their gain scaled by the number of sources
         m_sourceSampleBuffer.allocate(nbSamples);
         SampleVector::iterator sBegin = m_sourceSampleBuffer.m_vector.begin();
-        BasebandSampleSources::const_iterator srcIt = m_basebandSampleSources.begin();
-        BasebandSampleSource *source = *srcIt;
-        source->pull(begin, nbSamples);
-        srcIt++;
-        m_sumIndex = 1;
+        m_sampleMixer.reset(nbSamples);
 
-        for (; srcIt != m_basebandSampleSources.end(); ++srcIt, m_sumIndex++)
+        for (BasebandSampleSources::const_iterator srcIt = m_basebandSampleSources.begin(); srcIt != m_basebandSampleSources.end(); ++srcIt)
         {
-            source = *srcIt;
-            source->pull(sBegin, nbSamples);
-            std::transform(
-                sBegin,
-                sBegin + nbSamples,
-                data.begin() + iBegin,
-                data.begin() + iBegin,
-                [this](Sample& a, const Sample& b) -> Sample {
-                    int den = m_sumIndex + 1; // at each stage scale sum by n/n+1 and input by 1/n+1
-                    int nom = m_sumIndex;     // so that final sum is scaled by N (number of channels)
-                    return Sample{
-                        a.real()/den + nom*(b.real()/den),
-                        a.imag()/den + nom*(b.imag()/den)
-                    };
-                }
-            );
+            (*srcIt)->pull(sBegin, nbSamples);
+            m_sampleMixer.add(sBegin, nbSamples, (*srcIt)->getMixGain());
         }
+
+        m_sampleMixer.output(begin, nbSamples, 1.0f / m_basebandSampleSources.size());
     }
 
     // possibly feed data to spectrum sink
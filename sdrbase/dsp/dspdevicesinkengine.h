@@ -33,6 +33,7 @@
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
 #include "util/incrementalvector.h"
+#include "dsp/samplemixer.h"
 #include "export.h"
 
 class DeviceSampleSink;
@@ -103,7 +104,7 @@ private:
 
 	uint32_t m_sampleRate;
 	quint64 m_centerFrequency;
-    unsigned int m_sumIndex; //!< channel index when summing channels
+    SampleMixer m_sampleMixer; //!< mixes channel sources
 
 	void run();
 	void workSampleFifo(); //!< transfer samples from baseband sources to sink if in running state
@@ -84,16 +84,23 @@ int fftcorr::run(const cmplx& inA, const cmplx* inB, cmplx **out)
         return 0;
     }
 
+    correlate(inB != 0);
+    *out = dataP;
+    return flen2;
+}
+
+void fftcorr::correlate(bool cross)
+{
     m_window.apply(dataA, fftA->in());
     fftA->transform();
 
-    if (inB)
+    if (cross)
     {
         m_window.apply(dataB, fftB->in());
         fftB->transform();
     }
 
-    if (inB) {
+    if (cross) {
         std::transform(fftB->out(), fftB->out()+flen, dataBj, [](const cmplx& c) -> cmplx { return std::conj(c); });
     } else {
         std::transform(fftA->out(), fftA->out()+flen, dataBj, [](const cmplx& c) -> cmplx { return std::conj(c); });
@@ -107,14 +114,11 @@ int fftcorr::run(const cmplx& inA, const cmplx* inB, cmplx **out)
     std::fill(dataA, dataA+flen, 0);
     inptrA = 0;
 
-    if (inB)
+    if (cross)
     {
         std::fill(dataB, dataB+flen, 0);
         inptrB = 0;
     }
-
-    *out = dataP;
-    return flen2;
 }
 
 const fftcorr::cmplx& fftcorr::run(const cmplx& inA, const cmplx* inB)
@@ -127,3 +131,38 @@ const fftcorr::cmplx& fftcorr::run(const cmplx& inA, const cmplx* inB)
 
     return dataP[outptr++];
 }
+
+void fftcorr::run(const cmplx* inA, const cmplx* inB, unsigned int size, cmplx* out)
+{
+    while (size > 0)
+    {
+        unsigned int n = std::min(size, (unsigned int) (flen2 - inptrA));
+        std::copy(inA, inA+n, dataA+inptrA);
+        inptrA += n;
+
+        if (inB)
+        {
+            std::copy(inB, inB+n, dataB+inptrB);
+            inptrB += n;
+            inB += n;
+        }
+
+        if (inptrA < flen2)
+        {
+            std::copy(dataP+outptr, dataP+outptr+n, out);
+            outptr += n;
+        }
+        else
+        {
+            // the sample completing the block gets the first sample of the new result
+            std::copy(dataP+outptr, dataP+outptr+n-1, out);
+            correlate(inB != 0);
+            out[n-1] = dataP[0];
+            outptr = 1;
+        }
+
+        inA += n;
+        out += n;
+        size -= n;
+    }
+}
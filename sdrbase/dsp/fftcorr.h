@@ -36,9 +36,11 @@ public:
 
     int run(const cmplx& inA, const cmplx* inB, cmplx **out); //!< if inB = 0 then run auto-correlation
     const cmplx& run(const cmplx& inA, const cmplx* inB);
+    void run(const cmplx* inA, const cmplx* inB, unsigned int size, cmplx* out); //!< same output as the single sample run for a span of samples
 
 private:
     void init_fft();
+    void correlate(bool cross);
     int flen;  //!< FFT length
     int flen2; //!< half FFT length
     FFTEngine *fftA;
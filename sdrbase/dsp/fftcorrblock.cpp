@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+
+#include "dsp/dspengine.h"
+#include "dsp/fftfactory.h"
+#include "dsp/fftengine.h"
+#include "fftcorrblock.h"
+
+FFTCorrBlock::FFTCorrBlock(unsigned int log2BlockSize) :
+    m_blockSize(1<<log2BlockSize),
+    m_fftSize(2<<log2BlockSize),
+    m_referenceSize(0),
+    m_fft(nullptr),
+    m_invFFT(nullptr),
+    m_delayLineIndex(0),
+    m_inBlock(m_fftSize),
+    m_outBlock(m_blockSize),
+    m_fill(0)
+{
+    FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
+    m_fftSequence = fftFactory->getEngine(m_fftSize, false, &m_fft);
+    m_invFFTSequence = fftFactory->getEngine(m_fftSize, true, &m_invFFT);
+}
+
+FFTCorrBlock::~FFTCorrBlock()
+{
+    FFTFactory *fftFactory = DSPEngine::instance()->getFFTFactory();
+    fftFactory->releaseEngine(m_fftSize, false, m_fftSequence);
+    fftFactory->releaseEngine(m_fftSize, true, m_invFFTSequence);
+}
+
+void FFTCorrBlock::setReference(const cmplx *reference, unsigned int size)
+{
+    float energy = 0.0f;
+
+    for (unsigned int i = 0; i < size; i++) {
+        energy += std::norm(reference[i]);
+    }
+
+    m_referenceSize = energy > 0.0f ? size : 0;
+    unsigned int nbPartitions = (m_referenceSize + m_blockSize - 1) / m_blockSize;
+    m_partitions.assign(nbPartitions, std::vector<cmplx>(m_fftSize));
+    m_delayLine.assign(nbPartitions, std::vector<cmplx>(m_fftSize));
+    // unit energy reference and inverse FFT scaling
+    float scale = 1.0f / (energy * m_fftSize);
+
+    // correlation is the convolution with the time reversed conjugate of the reference
+    for (unsigned int p = 0; p < nbPartitions; p++)
+    {
+        cmplx *fftIn = m_fft->in();
+        std::fill(fftIn, fftIn + m_fftSize, cmplx{0, 0});
+
+        for (unsigned int i = 0; (i < m_blockSize) && (p*m_blockSize + i < m_referenceSize); i++) {
+            fftIn[i] = std::conj(reference[m_referenceSize - 1 - p*m_blockSize - i]) * scale;
+        }
+
+        m_fft->transform();
+        std::copy(m_fft->out(), m_fft->out() + m_fftSize, m_partitions[p].begin());
+    }
+
+    reset();
+}
+
+void FFTCorrBlock::reset()
+{
+    for (std::vector<cmplx>& spectrum : m_delayLine) {
+        std::fill(spectrum.begin(), spectrum.end(), cmplx{0, 0});
+    }
+
+    std::fill(m_inBlock.begin(), m_inBlock.end(), cmplx{0, 0});
+    std::fill(m_outBlock.begin(), m_outBlock.end(), cmplx{0, 0});
+    m_delayLineIndex = 0;
+    m_fill = 0;
+}
+
+void FFTCorrBlock::run(const cmplx *in, unsigned int size, cmplx *out)
+{
+    while (size > 0)
+    {
+        unsigned int n = std::min(size, m_blockSize - m_fill);
+        cmplx *current = &m_inBlock[m_blockSize + m_fill];
+        std::copy(in, in + n, current);
+        std::copy(&m_outBlock[m_fill], &m_outBlock[m_fill + n], out);
+        m_fill += n;
+        in += n;
+        out += n;
+        size -= n;
+
+        if (m_fill == m_blockSize)
+        {
+            processBlock();
+            m_fill = 0;
+        }
+    }
+}
+
+void FFTCorrBlock::processBlock()
+{
+    if (m_partitions.size() == 0)
+    {
+        std::fill(m_outBlock.begin(), m_outBlock.end(), cmplx{0, 0});
+        std::copy(m_inBlock.begin() + m_blockSize, m_inBlock.end(), m_inBlock.begin());
+        return;
+    }
+
+    unsigned int nbPartitions = m_partitions.size();
+    m_delayLineIndex = (m_delayLineIndex + 1) % nbPartitions;
+    std::copy(m_inBlock.begin(), m_inBlock.end(), m_fft->in());
+    m_fft->transform();
+    std::copy(m_fft->out(), m_fft->out() + m_fftSize, m_delayLine[m_delayLineIndex].begin());
+
+    // sum of the products of the past input block spectra with the partition spectra
+    cmplx *acc = m_invFFT->in();
+    std::fill(acc, acc + m_fftSize, cmplx{0, 0});
+
+    for (unsigned int p = 0; p < nbPartitions; p++)
+    {
+        const cmplx *x = m_delayLine[(m_delayLineIndex + nbPartitions - p) % nbPartitions].data();
+        const cmplx *h = m_partitions[p].data();
+
+        for (unsigned int k = 0; k < m_fftSize; k++) {
+            acc[k] += x[k] * h[k];
+        }
+    }
+
+    m_invFFT->transform();
+    // the second half is free of circular wrap around
+    std::copy(m_invFFT->out() + m_blockSize, m_invFFT->out() + m_fftSize, m_outBlock.begin());
+    std::copy(m_inBlock.begin() + m_blockSize, m_inBlock.end(), m_inBlock.begin());
+}
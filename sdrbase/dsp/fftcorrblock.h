@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_FFTCORRBLOCK_H_
+#define SDRBASE_DSP_FFTCORRBLOCK_H_
+
+#include <complex>
+#include <vector>
+
+#include "export.h"
+
+class FFTEngine;
+
+/**
+ * Block FFT cross correlation of a sample stream with a known reference sequence
+ * (e.g. a preamble). Samples are processed by whole spans. References longer than the
+ * block size are split in partitions of the block size and correlated with uniformly
+ * partitioned overlap-save so that the FFT size stays twice the block size whatever the
+ * reference length. The spectra of the reference partitions are computed once and the
+ * spectra of the past input blocks are kept in a frequency domain delay line so each
+ * block takes one forward and one inverse FFT. FFT engines are taken from the FFTFactory.
+ *
+ * The output has as many samples as the input. It is delayed by one block and the
+ * correlation peaks when the last sample of an occurrence of the reference comes in.
+ * The reference is normalized to unit energy so that a copy of the reference scaled by
+ * a peaks at a.
+ */
+class SDRBASE_API FFTCorrBlock
+{
+public:
+    typedef std::complex<float> cmplx;
+
+    FFTCorrBlock(unsigned int log2BlockSize);
+    ~FFTCorrBlock();
+
+    void setReference(const cmplx *reference, unsigned int size); //!< size 0 clears the reference
+    unsigned int getReferenceSize() const { return m_referenceSize; }
+    unsigned int getBlockSize() const { return m_blockSize; }
+    void reset(); //!< clear the input history
+    void run(const cmplx *in, unsigned int size, cmplx *out); //!< out can be in
+
+private:
+    unsigned int m_blockSize;
+    unsigned int m_fftSize;  //!< twice the block size
+    unsigned int m_referenceSize;
+    FFTEngine *m_fft;
+    FFTEngine *m_invFFT;
+    unsigned int m_fftSequence;
+    unsigned int m_invFFTSequence;
+    std::vector<std::vector<cmplx>> m_partitions; //!< spectra of the reference partitions
+    std::vector<std::vector<cmplx>> m_delayLine;  //!< spectra of the past input blocks
+    unsigned int m_delayLineIndex;                //!< most recent input block spectrum
+    std::vector<cmplx> m_inBlock;                 //!< previous and current input blocks
+    std::vector<cmplx> m_outBlock;                //!< correlation of the previous block
+    unsigned int m_fill;                          //!< samples in the current input block
+
+    void processBlock();
+};
+
+#endif // SDRBASE_DSP_FFTCORRBLOCK_H_
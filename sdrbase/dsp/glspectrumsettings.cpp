@@ -50,6 +50,7 @@ void GLSpectrumSettings::resetToDefaults()
 	m_averagingMode = AvgModeNone;
 	m_averagingIndex = 0;
 	m_linear = false;
+	m_deferredUpdate = false;
 }
 
 QByteArray GLSpectrumSettings::serialize() const
@@ -77,6 +78,7 @@ QByteArray GLSpectrumSettings::serialize() const
 	s.writeS32(19, (int) m_averagingMode);
 	s.writeS32(20, (qint32) getAveragingValue(m_averagingIndex, m_averagingMode));
 	s.writeBool(21, m_linear);
+	s.writeBool(22, m_deferredUpdate);
 
 	return s.final();
 }
@@ -119,6 +121,7 @@ bool GLSpectrumSettings::deserialize(const QByteArray& data)
 		m_averagingIndex = getAveragingIndex(tmp, m_averagingMode);
 	    m_averagingNb = getAveragingValue(m_averagingIndex, m_averagingMode);
 	    d.readBool(21, &m_linear, false);
+	    d.readBool(22, &m_deferredUpdate, false);
 
 		return true;
 	}
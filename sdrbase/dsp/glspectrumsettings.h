@@ -58,6 +58,7 @@ public:
 	int m_averagingIndex;
 	unsigned int m_averagingNb;
 	bool m_linear; //!< linear else logarithmic scale
+	bool m_deferredUpdate; //!< waterfall and histogram computed on the GUI thread instead of the DSP thread
 
     GLSpectrumSettings();
 	virtual ~GLSpectrumSettings();
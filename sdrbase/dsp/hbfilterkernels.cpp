@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <cstring>
+
+#include <QDebug>
+
+#include "util/cpufeatures.h"
+#include "hbfilterkernelsisa.h"
+#include "hbfilterkernels.h"
+
+namespace {
+
+void symmetricFIR32Generic(const int32_t *rowI, const int32_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int32_t *iAcc, int32_t *qAcc)
+{
+    int32_t i = 0;
+    int32_t q = 0;
+
+    for (int k = 0; k < nbCoeffs; k++)
+    {
+        i += ((int32_t) (rowI[tip - k] + rowI[tail + k])) * coeffs[k];
+        q += ((int32_t) (rowQ[tip - k] + rowQ[tail + k])) * coeffs[k];
+    }
+
+    *iAcc = i;
+    *qAcc = q;
+}
+
+void symmetricFIR64Generic(const int64_t *rowI, const int64_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int64_t *iAcc, int64_t *qAcc)
+{
+    int64_t i = 0;
+    int64_t q = 0;
+
+    for (int k = 0; k < nbCoeffs; k++)
+    {
+        i += ((int64_t) (rowI[tip - k] + rowI[tail + k])) * coeffs[k];
+        q += ((int64_t) (rowQ[tip - k] + rowQ[tail + k])) * coeffs[k];
+    }
+
+    *iAcc = i;
+    *qAcc = q;
+}
+
+void symmetricFIRFGeneric(const float *rowI, const float *rowQ, int tip, int tail, const float *coeffs, int nbCoeffs, float *iAcc, float *qAcc)
+{
+    float i = 0;
+    float q = 0;
+
+    for (int k = 0; k < nbCoeffs; k++)
+    {
+        i += (rowI[tip - k] + rowI[tail + k]) * coeffs[k];
+        q += (rowQ[tip - k] + rowQ[tail + k]) * coeffs[k];
+    }
+
+    *iAcc = i;
+    *qAcc = q;
+}
+
+} // namespace
+
+HBFilterKernels::SymmetricFIR32 HBFilterKernels::m_symmetricFIR32 = symmetricFIR32Generic;
+HBFilterKernels::SymmetricFIR64 HBFilterKernels::m_symmetricFIR64 = symmetricFIR64Generic;
+HBFilterKernels::SymmetricFIRF HBFilterKernels::m_symmetricFIRF = symmetricFIRFGeneric;
+HBFilterKernels::ISA HBFilterKernels::m_isa = HBFilterKernels::ISAGeneric;
+bool HBFilterKernels::m_initialized = HBFilterKernels::initialize(); // before any worker thread starts
+
+bool HBFilterKernels::initialize()
+{
+    std::vector<ISA> isas = getSupportedISAs();
+    ISA isa = isas.back(); // best
+    const char *forced = std::getenv("SDRANGEL_SIMD");
+
+    if (forced)
+    {
+        for (ISA supported : isas)
+        {
+            if (std::strcmp(forced, getISAName(supported)) == 0) {
+                isa = supported;
+            }
+        }
+    }
+
+    setISA(isa);
+    qDebug("HBFilterKernels::initialize: using %s kernels", getISAName(m_isa));
+    return true;
+}
+
+bool HBFilterKernels::isSupported(ISA isa)
+{
+    switch (isa)
+    {
+    case ISAGeneric:
+        return true;
+    case ISASSE41:
+        return HBFilterKernelsISA::hasSSE41() && CPUFeatures::hasSSE41();
+    case ISAAVX2:
+        return HBFilterKernelsISA::hasAVX2() && CPUFeatures::hasAVX2();
+    case ISAAVX512:
+        return HBFilterKernelsISA::hasAVX512() && CPUFeatures::hasAVX512F();
+    default:
+        return false;
+    }
+}
+
+std::vector<HBFilterKernels::ISA> HBFilterKernels::getSupportedISAs()
+{
+    std::vector<ISA> isas;
+    ISA all[] = {ISAGeneric, ISASSE41, ISAAVX2, ISAAVX512};
+
+    for (ISA isa : all)
+    {
+        if (isSupported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+
+    return isas;
+}
+
+bool HBFilterKernels::setISA(ISA isa)
+{
+    if (!isSupported(isa)) {
+        return false;
+    }
+
+    switch (isa)
+    {
+    case ISASSE41:
+        m_symmetricFIR32 = HBFilterKernelsISA::symmetricFIR32SSE41;
+        m_symmetricFIR64 = symmetricFIR64Generic; // two 64 bit lanes do not beat the scalar multiplies
+        m_symmetricFIRF = HBFilterKernelsISA::symmetricFIRFSSE41;
+        break;
+    case ISAAVX2:
+        m_symmetricFIR32 = HBFilterKernelsISA::symmetricFIR32AVX2;
+        m_symmetricFIR64 = HBFilterKernelsISA::symmetricFIR64AVX2;
+        m_symmetricFIRF = HBFilterKernelsISA::symmetricFIRFAVX2;
+        break;
+    case ISAAVX512:
+        m_symmetricFIR32 = HBFilterKernelsISA::symmetricFIR32AVX512;
+        m_symmetricFIR64 = HBFilterKernelsISA::symmetricFIR64AVX512;
+        m_symmetricFIRF = HBFilterKernelsISA::symmetricFIRFAVX512;
+        break;
+    case ISAGeneric:
+    default:
+        m_symmetricFIR32 = symmetricFIR32Generic;
+        m_symmetricFIR64 = symmetricFIR64Generic;
+        m_symmetricFIRF = symmetricFIRFGeneric;
+        break;
+    }
+
+    m_isa = isa;
+    return true;
+}
+
+const char *HBFilterKernels::getISAName(ISA isa)
+{
+    switch (isa)
+    {
+    case ISASSE41:
+        return "sse4.1";
+    case ISAAVX2:
+        return "avx2";
+    case ISAAVX512:
+        return "avx512";
+    case ISAGeneric:
+    default:
+        return "generic";
+    }
+}
@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_HBFILTERKERNELS_H_
+#define SDRBASE_DSP_HBFILTERKERNELS_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "export.h"
+
+/**
+ * Symmetric FIR sums of the half band filters used by the decimators (IntHalfbandFilterEO with
+ * 32 or 64 bit storage and IntHalfbandFilterEOF). Distribution builds only target a baseline
+ * instruction set so the kernels are compiled separately for each instruction set and the
+ * best one supported by the CPU is selected at startup. It can be forced with the
+ * SDRANGEL_SIMD environment variable (generic, sse4.1, avx2, avx512).
+ *
+ * Each kernel computes for I and Q rows: acc = sum over k of (row[tip - k] + row[tail + k]) * coeffs[k]
+ * The 64 bit kernel (24 bit Rx DSP) wraps around exactly like the scalar 64 bit arithmetic.
+ */
+class SDRBASE_API HBFilterKernels
+{
+public:
+    enum ISA
+    {
+        ISAGeneric,
+        ISASSE41,
+        ISAAVX2,
+        ISAAVX512
+    };
+
+    typedef void (*SymmetricFIR32)(const int32_t *rowI, const int32_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int32_t *iAcc, int32_t *qAcc);
+    typedef void (*SymmetricFIR64)(const int64_t *rowI, const int64_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int64_t *iAcc, int64_t *qAcc);
+    typedef void (*SymmetricFIRF)(const float *rowI, const float *rowQ, int tip, int tail, const float *coeffs, int nbCoeffs, float *iAcc, float *qAcc);
+
+    static SymmetricFIR32 m_symmetricFIR32; //!< kernel of the current instruction set
+    static SymmetricFIR64 m_symmetricFIR64; //!< kernel of the current instruction set
+    static SymmetricFIRF m_symmetricFIRF;   //!< kernel of the current instruction set
+
+    static bool setISA(ISA isa); //!< returns false and leaves the current one if not supported
+    static ISA getISA() { return m_isa; }
+    static bool isSupported(ISA isa);
+    static std::vector<ISA> getSupportedISAs();
+    static const char *getISAName(ISA isa);
+
+private:
+    static ISA m_isa;
+    static bool m_initialized;
+    static bool initialize();
+};
+
+#endif // SDRBASE_DSP_HBFILTERKERNELS_H_
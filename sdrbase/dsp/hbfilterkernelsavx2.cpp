@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with AVX2 enabled. Only used after checking the CPU and OS support it.
+
+#if defined(__AVX2__)
+#define HBFILTERKERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+#include "hbfilterkernelsisa.h"
+
+#ifdef HBFILTERKERNELS_AVX2
+
+namespace HBFilterKernelsISA
+{
+
+bool hasAVX2()
+{
+    return true;
+}
+
+// low 64 bits of the products of the 64 bit lanes of a by the sign extended coefficients in h.
+// hHi (high halves of h) is 0 or 0xFFFFFFFF so the low half of a times hHi is -a or 0 modulo 2^32.
+static inline __m256i mullo64(__m256i a, __m256i h, __m256i hHi)
+{
+    __m256i cross = _mm256_sub_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), h), _mm256_and_si256(a, hHi));
+    return _mm256_add_epi64(_mm256_mul_epu32(a, h), _mm256_slli_epi64(cross, 32));
+}
+
+void symmetricFIR32AVX2(const int32_t *rowI, const int32_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int32_t *iAcc, int32_t *qAcc)
+{
+    if (nbCoeffs < 8)
+    {
+        symmetricFIR32SSE41(rowI, rowQ, tip, tail, coeffs, nbCoeffs, iAcc, qAcc);
+        return;
+    }
+
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i reverseShift = _mm256_setr_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+    // The tip sample has just been stored: a wide load over it would stall on store forwarding
+    // so the first tip vector is made of the previous samples with the tip sample put in lane 0.
+    __m256i ti = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &rowI[tip - 8]), reverseShift);
+    __m256i tq = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &rowQ[tip - 8]), reverseShift);
+    ti = _mm256_blend_epi32(ti, _mm256_set1_epi32(rowI[tip]), 0x01);
+    tq = _mm256_blend_epi32(tq, _mm256_set1_epi32(rowQ[tip]), 0x01);
+    __m256i h = _mm256_loadu_si256((const __m256i*) coeffs);
+    __m256i accI = _mm256_mullo_epi32(_mm256_add_epi32(ti, _mm256_loadu_si256((const __m256i*) &rowI[tail])), h);
+    __m256i accQ = _mm256_mullo_epi32(_mm256_add_epi32(tq, _mm256_loadu_si256((const __m256i*) &rowQ[tail])), h);
+    int k = 8;
+
+    for (; k + 8 <= nbCoeffs; k += 8)
+    {
+        h = _mm256_loadu_si256((const __m256i*) &coeffs[k]);
+        ti = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &rowI[tip - k - 7]), reverse);
+        tq = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &rowQ[tip - k - 7]), reverse);
+        __m256i si = _mm256_loadu_si256((const __m256i*) &rowI[tail + k]);
+        __m256i sq = _mm256_loadu_si256((const __m256i*) &rowQ[tail + k]);
+        accI = _mm256_add_epi32(accI, _mm256_mullo_epi32(_mm256_add_epi32(ti, si), h));
+        accQ = _mm256_add_epi32(accQ, _mm256_mullo_epi32(_mm256_add_epi32(tq, sq), h));
+    }
+
+    __m128i accI4 = _mm_add_epi32(_mm256_castsi256_si128(accI), _mm256_extracti128_si256(accI, 1));
+    __m128i accQ4 = _mm_add_epi32(_mm256_castsi256_si128(accQ), _mm256_extracti128_si256(accQ, 1));
+
+    if (k < nbCoeffs) // remaining 4 (nbCoeffs is a multiple of 4)
+    {
+        __m128i h4 = _mm_loadu_si128((const __m128i*) &coeffs[k]);
+        __m128i ti4 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &rowI[tip - k - 3]), _MM_SHUFFLE(0,1,2,3));
+        __m128i tq4 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &rowQ[tip - k - 3]), _MM_SHUFFLE(0,1,2,3));
+        accI4 = _mm_add_epi32(accI4, _mm_mullo_epi32(_mm_add_epi32(ti4, _mm_loadu_si128((const __m128i*) &rowI[tail + k])), h4));
+        accQ4 = _mm_add_epi32(accQ4, _mm_mullo_epi32(_mm_add_epi32(tq4, _mm_loadu_si128((const __m128i*) &rowQ[tail + k])), h4));
+    }
+
+    __m128i iq = _mm_add_epi32(_mm_unpacklo_epi64(accI4, accQ4), _mm_unpackhi_epi64(accI4, accQ4));
+    iq = _mm_add_epi32(iq, _mm_shuffle_epi32(iq, _MM_SHUFFLE(2,3,0,1)));
+    *iAcc = _mm_cvtsi128_si32(iq);
+    *qAcc = _mm_extract_epi32(iq, 2);
+}
+
+void symmetricFIR64AVX2(const int64_t *rowI, const int64_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int64_t *iAcc, int64_t *qAcc)
+{
+    // first tip vector: see symmetricFIR32AVX2
+    __m256i ti = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i*) &rowI[tip - 4]), _MM_SHUFFLE(1,2,3,3));
+    __m256i tq = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i*) &rowQ[tip - 4]), _MM_SHUFFLE(1,2,3,3));
+    ti = _mm256_blend_epi32(ti, _mm256_set1_epi64x(rowI[tip]), 0x03);
+    tq = _mm256_blend_epi32(tq, _mm256_set1_epi64x(rowQ[tip]), 0x03);
+    __m256i h = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*) coeffs));
+    __m256i hHi = _mm256_srli_epi64(h, 32);
+    __m256i accI = mullo64(_mm256_add_epi64(ti, _mm256_loadu_si256((const __m256i*) &rowI[tail])), h, hHi);
+    __m256i accQ = mullo64(_mm256_add_epi64(tq, _mm256_loadu_si256((const __m256i*) &rowQ[tail])), h, hHi);
+
+    for (int k = 4; k < nbCoeffs; k += 4) // nbCoeffs is a multiple of 4
+    {
+        h = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*) &coeffs[k]));
+        hHi = _mm256_srli_epi64(h, 32);
+        ti = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i*) &rowI[tip - k - 3]), _MM_SHUFFLE(0,1,2,3));
+        tq = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i*) &rowQ[tip - k - 3]), _MM_SHUFFLE(0,1,2,3));
+        __m256i si = _mm256_loadu_si256((const __m256i*) &rowI[tail + k]);
+        __m256i sq = _mm256_loadu_si256((const __m256i*) &rowQ[tail + k]);
+        accI = _mm256_add_epi64(accI, mullo64(_mm256_add_epi64(ti, si), h, hHi));
+        accQ = _mm256_add_epi64(accQ, mullo64(_mm256_add_epi64(tq, sq), h, hHi));
+    }
+
+    __m128i accI2 = _mm_add_epi64(_mm256_castsi256_si128(accI), _mm256_extracti128_si256(accI, 1));
+    __m128i accQ2 = _mm_add_epi64(_mm256_castsi256_si128(accQ), _mm256_extracti128_si256(accQ, 1));
+    _mm_storel_epi64((__m128i*) iAcc, _mm_add_epi64(accI2, _mm_unpackhi_epi64(accI2, accI2)));
+    _mm_storel_epi64((__m128i*) qAcc, _mm_add_epi64(accQ2, _mm_unpackhi_epi64(accQ2, accQ2)));
+}
+
+void symmetricFIRFAVX2(const float *rowI, const float *rowQ, int tip, int tail, const float *coeffs, int nbCoeffs, float *iAcc, float *qAcc)
+{
+    if (nbCoeffs < 8)
+    {
+        symmetricFIRFSSE41(rowI, rowQ, tip, tail, coeffs, nbCoeffs, iAcc, qAcc);
+        return;
+    }
+
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256i reverseShift = _mm256_setr_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+    // first tip vector: see symmetricFIR32AVX2
+    __m256 ti = _mm256_permutevar8x32_ps(_mm256_loadu_ps(&rowI[tip - 8]), reverseShift);
+    __m256 tq = _mm256_permutevar8x32_ps(_mm256_loadu_ps(&rowQ[tip - 8]), reverseShift);
+    ti = _mm256_blend_ps(ti, _mm256_set1_ps(rowI[tip]), 0x01);
+    tq = _mm256_blend_ps(tq, _mm256_set1_ps(rowQ[tip]), 0x01);
+    __m256 h = _mm256_loadu_ps(coeffs);
+    __m256 accI = _mm256_mul_ps(_mm256_add_ps(ti, _mm256_loadu_ps(&rowI[tail])), h);
+    __m256 accQ = _mm256_mul_ps(_mm256_add_ps(tq, _mm256_loadu_ps(&rowQ[tail])), h);
+    int k = 8;
+
+    for (; k + 8 <= nbCoeffs; k += 8)
+    {
+        h = _mm256_loadu_ps(&coeffs[k]);
+        ti = _mm256_permutevar8x32_ps(_mm256_loadu_ps(&rowI[tip - k - 7]), reverse);
+        tq = _mm256_permutevar8x32_ps(_mm256_loadu_ps(&rowQ[tip - k - 7]), reverse);
+        accI = _mm256_add_ps(accI, _mm256_mul_ps(_mm256_add_ps(ti, _mm256_loadu_ps(&rowI[tail + k])), h));
+        accQ = _mm256_add_ps(accQ, _mm256_mul_ps(_mm256_add_ps(tq, _mm256_loadu_ps(&rowQ[tail + k])), h));
+    }
+
+    __m128 accI4 = _mm_add_ps(_mm256_castps256_ps128(accI), _mm256_extractf128_ps(accI, 1));
+    __m128 accQ4 = _mm_add_ps(_mm256_castps256_ps128(accQ), _mm256_extractf128_ps(accQ, 1));
+
+    if (k < nbCoeffs) // remaining 4 (nbCoeffs is a multiple of 4)
+    {
+        __m128 h4 = _mm_loadu_ps(&coeffs[k]);
+        __m128 ti4 = _mm_loadu_ps(&rowI[tip - k - 3]);
+        __m128 tq4 = _mm_loadu_ps(&rowQ[tip - k - 3]);
+        ti4 = _mm_shuffle_ps(ti4, ti4, _MM_SHUFFLE(0,1,2,3));
+        tq4 = _mm_shuffle_ps(tq4, tq4, _MM_SHUFFLE(0,1,2,3));
+        accI4 = _mm_add_ps(accI4, _mm_mul_ps(_mm_add_ps(ti4, _mm_loadu_ps(&rowI[tail + k])), h4));
+        accQ4 = _mm_add_ps(accQ4, _mm_mul_ps(_mm_add_ps(tq4, _mm_loadu_ps(&rowQ[tail + k])), h4));
+    }
+
+    __m128 iq = _mm_add_ps(_mm_movelh_ps(accI4, accQ4), _mm_movehl_ps(accQ4, accI4));
+    iq = _mm_add_ps(iq, _mm_shuffle_ps(iq, iq, _MM_SHUFFLE(2,3,0,1)));
+    *iAcc = _mm_cvtss_f32(iq);
+    *qAcc = _mm_cvtss_f32(_mm_movehl_ps(iq, iq));
+}
+
+} // namespace HBFilterKernelsISA
+
+#else
+
+namespace HBFilterKernelsISA
+{
+
+bool hasAVX2()
+{
+    return false;
+}
+
+void symmetricFIR32AVX2(const int32_t*, const int32_t*, int, int, const int32_t*, int, int32_t*, int32_t*)
+{}
+
+void symmetricFIR64AVX2(const int64_t*, const int64_t*, int, int, const int32_t*, int, int64_t*, int64_t*)
+{}
+
+void symmetricFIRFAVX2(const float*, const float*, int, int, const float*, int, float*, float*)
+{}
+
+} // namespace HBFilterKernelsISA
+
+#endif // HBFILTERKERNELS_AVX2
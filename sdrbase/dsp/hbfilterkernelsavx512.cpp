@@ -0,0 +1,213 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with AVX-512F enabled. Only used after checking the CPU and OS support it.
+
+#if defined(__AVX512F__)
+#define HBFILTERKERNELS_AVX512
+#include <immintrin.h>
+#endif
+
+#include "hbfilterkernelsisa.h"
+
+#ifdef HBFILTERKERNELS_AVX512
+
+namespace HBFilterKernelsISA
+{
+
+bool hasAVX512()
+{
+    return true;
+}
+
+// see mullo64 in hbfilterkernelsavx2.cpp (AVX-512DQ has a 64 bit multiply but is not required here)
+static inline __m512i mullo64(__m512i a, __m512i h, __m512i hHi)
+{
+    __m512i cross = _mm512_sub_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), h), _mm512_and_si512(a, hHi));
+    return _mm512_add_epi64(_mm512_mul_epu32(a, h), _mm512_slli_epi64(cross, 32));
+}
+
+void symmetricFIR32AVX512(const int32_t *rowI, const int32_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int32_t *iAcc, int32_t *qAcc)
+{
+    if (nbCoeffs < 16)
+    {
+        symmetricFIR32AVX2(rowI, rowQ, tip, tail, coeffs, nbCoeffs, iAcc, qAcc);
+        return;
+    }
+
+    const __m512i reverse = _mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m512i reverseShift = _mm512_setr_epi32(0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    // The tip sample has just been stored: a wide load over it would stall on store forwarding
+    // so the first tip vector is made of the previous samples with the tip sample put in lane 0.
+    __m512i ti = _mm512_permutexvar_epi32(reverseShift, _mm512_loadu_si512((const void*) &rowI[tip - 16]));
+    __m512i tq = _mm512_permutexvar_epi32(reverseShift, _mm512_loadu_si512((const void*) &rowQ[tip - 16]));
+    ti = _mm512_mask_mov_epi32(ti, 0x0001, _mm512_set1_epi32(rowI[tip]));
+    tq = _mm512_mask_mov_epi32(tq, 0x0001, _mm512_set1_epi32(rowQ[tip]));
+    __m512i h = _mm512_loadu_si512((const void*) coeffs);
+    __m512i accI = _mm512_mullo_epi32(_mm512_add_epi32(ti, _mm512_loadu_si512((const void*) &rowI[tail])), h);
+    __m512i accQ = _mm512_mullo_epi32(_mm512_add_epi32(tq, _mm512_loadu_si512((const void*) &rowQ[tail])), h);
+    int k = 16;
+
+    for (; k + 16 <= nbCoeffs; k += 16)
+    {
+        h = _mm512_loadu_si512((const void*) &coeffs[k]);
+        ti = _mm512_permutexvar_epi32(reverse, _mm512_loadu_si512((const void*) &rowI[tip - k - 15]));
+        tq = _mm512_permutexvar_epi32(reverse, _mm512_loadu_si512((const void*) &rowQ[tip - k - 15]));
+        __m512i si = _mm512_loadu_si512((const void*) &rowI[tail + k]);
+        __m512i sq = _mm512_loadu_si512((const void*) &rowQ[tail + k]);
+        accI = _mm512_add_epi32(accI, _mm512_mullo_epi32(_mm512_add_epi32(ti, si), h));
+        accQ = _mm512_add_epi32(accQ, _mm512_mullo_epi32(_mm512_add_epi32(tq, sq), h));
+    }
+
+    for (; k < nbCoeffs; k += 4) // remaining by 4 (nbCoeffs is a multiple of 4)
+    {
+        __mmask16 m = 0x000F;
+        h = _mm512_maskz_loadu_epi32(m, &coeffs[k]);
+        ti = _mm512_maskz_loadu_epi32(m, &rowI[tip - k - 3]);
+        tq = _mm512_maskz_loadu_epi32(m, &rowQ[tip - k - 3]);
+        ti = _mm512_maskz_shuffle_epi32(m, ti, _MM_PERM_ABCD);
+        tq = _mm512_maskz_shuffle_epi32(m, tq, _MM_PERM_ABCD);
+        __m512i si = _mm512_maskz_loadu_epi32(m, &rowI[tail + k]);
+        __m512i sq = _mm512_maskz_loadu_epi32(m, &rowQ[tail + k]);
+        accI = _mm512_add_epi32(accI, _mm512_mullo_epi32(_mm512_add_epi32(ti, si), h));
+        accQ = _mm512_add_epi32(accQ, _mm512_mullo_epi32(_mm512_add_epi32(tq, sq), h));
+    }
+
+    *iAcc = _mm512_reduce_add_epi32(accI);
+    *qAcc = _mm512_reduce_add_epi32(accQ);
+}
+
+void symmetricFIR64AVX512(const int64_t *rowI, const int64_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int64_t *iAcc, int64_t *qAcc)
+{
+    if (nbCoeffs < 8)
+    {
+        symmetricFIR64AVX2(rowI, rowQ, tip, tail, coeffs, nbCoeffs, iAcc, qAcc);
+        return;
+    }
+
+    const __m512i reverse = _mm512_setr_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m512i reverseShift = _mm512_setr_epi64(0, 7, 6, 5, 4, 3, 2, 1);
+    // first tip vector: see symmetricFIR32AVX512
+    __m512i ti = _mm512_permutexvar_epi64(reverseShift, _mm512_loadu_si512((const void*) &rowI[tip - 8]));
+    __m512i tq = _mm512_permutexvar_epi64(reverseShift, _mm512_loadu_si512((const void*) &rowQ[tip - 8]));
+    ti = _mm512_mask_mov_epi64(ti, 0x01, _mm512_set1_epi64(rowI[tip]));
+    tq = _mm512_mask_mov_epi64(tq, 0x01, _mm512_set1_epi64(rowQ[tip]));
+    __m512i h = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i*) coeffs));
+    __m512i hHi = _mm512_srli_epi64(h, 32);
+    __m512i accI = mullo64(_mm512_add_epi64(ti, _mm512_loadu_si512((const void*) &rowI[tail])), h, hHi);
+    __m512i accQ = mullo64(_mm512_add_epi64(tq, _mm512_loadu_si512((const void*) &rowQ[tail])), h, hHi);
+    int k = 8;
+
+    for (; k + 8 <= nbCoeffs; k += 8)
+    {
+        h = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i*) &coeffs[k]));
+        hHi = _mm512_srli_epi64(h, 32);
+        ti = _mm512_permutexvar_epi64(reverse, _mm512_loadu_si512((const void*) &rowI[tip - k - 7]));
+        tq = _mm512_permutexvar_epi64(reverse, _mm512_loadu_si512((const void*) &rowQ[tip - k - 7]));
+        __m512i si = _mm512_loadu_si512((const void*) &rowI[tail + k]);
+        __m512i sq = _mm512_loadu_si512((const void*) &rowQ[tail + k]);
+        accI = _mm512_add_epi64(accI, mullo64(_mm512_add_epi64(ti, si), h, hHi));
+        accQ = _mm512_add_epi64(accQ, mullo64(_mm512_add_epi64(tq, sq), h, hHi));
+    }
+
+    if (k < nbCoeffs) // remaining 4 (nbCoeffs is a multiple of 4)
+    {
+        const __m512i reverse4 = _mm512_setr_epi64(3, 2, 1, 0, 4, 5, 6, 7);
+        __mmask8 m = 0x0F;
+        h = _mm512_maskz_cvtepi32_epi64(m, _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*) &coeffs[k])));
+        hHi = _mm512_srli_epi64(h, 32);
+        ti = _mm512_maskz_permutexvar_epi64(m, reverse4, _mm512_maskz_loadu_epi64(m, &rowI[tip - k - 3]));
+        tq = _mm512_maskz_permutexvar_epi64(m, reverse4, _mm512_maskz_loadu_epi64(m, &rowQ[tip - k - 3]));
+        __m512i si = _mm512_maskz_loadu_epi64(m, &rowI[tail + k]);
+        __m512i sq = _mm512_maskz_loadu_epi64(m, &rowQ[tail + k]);
+        accI = _mm512_add_epi64(accI, mullo64(_mm512_add_epi64(ti, si), h, hHi));
+        accQ = _mm512_add_epi64(accQ, mullo64(_mm512_add_epi64(tq, sq), h, hHi));
+    }
+
+    *iAcc = _mm512_reduce_add_epi64(accI);
+    *qAcc = _mm512_reduce_add_epi64(accQ);
+}
+
+void symmetricFIRFAVX512(const float *rowI, const float *rowQ, int tip, int tail, const float *coeffs, int nbCoeffs, float *iAcc, float *qAcc)
+{
+    if (nbCoeffs < 16)
+    {
+        symmetricFIRFAVX2(rowI, rowQ, tip, tail, coeffs, nbCoeffs, iAcc, qAcc);
+        return;
+    }
+
+    const __m512i reverse = _mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    const __m512i reverseShift = _mm512_setr_epi32(0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    // first tip vector: see symmetricFIR32AVX512
+    __m512 ti = _mm512_permutexvar_ps(reverseShift, _mm512_loadu_ps(&rowI[tip - 16]));
+    __m512 tq = _mm512_permutexvar_ps(reverseShift, _mm512_loadu_ps(&rowQ[tip - 16]));
+    ti = _mm512_mask_mov_ps(ti, 0x0001, _mm512_set1_ps(rowI[tip]));
+    tq = _mm512_mask_mov_ps(tq, 0x0001, _mm512_set1_ps(rowQ[tip]));
+    __m512 h = _mm512_loadu_ps(coeffs);
+    __m512 accI = _mm512_mul_ps(_mm512_add_ps(ti, _mm512_loadu_ps(&rowI[tail])), h);
+    __m512 accQ = _mm512_mul_ps(_mm512_add_ps(tq, _mm512_loadu_ps(&rowQ[tail])), h);
+    int k = 16;
+
+    for (; k + 16 <= nbCoeffs; k += 16)
+    {
+        h = _mm512_loadu_ps(&coeffs[k]);
+        ti = _mm512_permutexvar_ps(reverse, _mm512_loadu_ps(&rowI[tip - k - 15]));
+        tq = _mm512_permutexvar_ps(reverse, _mm512_loadu_ps(&rowQ[tip - k - 15]));
+        accI = _mm512_add_ps(accI, _mm512_mul_ps(_mm512_add_ps(ti, _mm512_loadu_ps(&rowI[tail + k])), h));
+        accQ = _mm512_add_ps(accQ, _mm512_mul_ps(_mm512_add_ps(tq, _mm512_loadu_ps(&rowQ[tail + k])), h));
+    }
+
+    for (; k < nbCoeffs; k += 4) // remaining by 4 (nbCoeffs is a multiple of 4)
+    {
+        __mmask16 m = 0x000F;
+        h = _mm512_maskz_loadu_ps(m, &coeffs[k]);
+        ti = _mm512_maskz_loadu_ps(m, &rowI[tip - k - 3]);
+        tq = _mm512_maskz_loadu_ps(m, &rowQ[tip - k - 3]);
+        ti = _mm512_maskz_permute_ps(m, ti, _MM_SHUFFLE(0,1,2,3));
+        tq = _mm512_maskz_permute_ps(m, tq, _MM_SHUFFLE(0,1,2,3));
+        accI = _mm512_add_ps(accI, _mm512_mul_ps(_mm512_add_ps(ti, _mm512_maskz_loadu_ps(m, &rowI[tail + k])), h));
+        accQ = _mm512_add_ps(accQ, _mm512_mul_ps(_mm512_add_ps(tq, _mm512_maskz_loadu_ps(m, &rowQ[tail + k])), h));
+    }
+
+    *iAcc = _mm512_reduce_add_ps(accI);
+    *qAcc = _mm512_reduce_add_ps(accQ);
+}
+
+} // namespace HBFilterKernelsISA
+
+#else
+
+namespace HBFilterKernelsISA
+{
+
+bool hasAVX512()
+{
+    return false;
+}
+
+void symmetricFIR32AVX512(const int32_t*, const int32_t*, int, int, const int32_t*, int, int32_t*, int32_t*)
+{}
+
+void symmetricFIR64AVX512(const int64_t*, const int64_t*, int, int, const int32_t*, int, int64_t*, int64_t*)
+{}
+
+void symmetricFIRFAVX512(const float*, const float*, int, int, const float*, int, float*, float*)
+{}
+
+} // namespace HBFilterKernelsISA
+
+#endif // HBFILTERKERNELS_AVX512
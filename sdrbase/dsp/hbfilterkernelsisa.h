@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_HBFILTERKERNELSISA_H_
+#define SDRBASE_DSP_HBFILTERKERNELSISA_H_
+
+// Kernels compiled with instruction set specific flags. This header must not bring any
+// inline or template code in these translation units.
+
+#include <stdint.h>
+
+namespace HBFilterKernelsISA
+{
+    // each returns false when the instruction set was not available to the compiler
+    bool hasSSE41();
+    void symmetricFIR32SSE41(const int32_t *rowI, const int32_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int32_t *iAcc, int32_t *qAcc);
+    void symmetricFIRFSSE41(const float *rowI, const float *rowQ, int tip, int tail, const float *coeffs, int nbCoeffs, float *iAcc, float *qAcc);
+
+    bool hasAVX2();
+    void symmetricFIR32AVX2(const int32_t *rowI, const int32_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int32_t *iAcc, int32_t *qAcc);
+    void symmetricFIR64AVX2(const int64_t *rowI, const int64_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int64_t *iAcc, int64_t *qAcc);
+    void symmetricFIRFAVX2(const float *rowI, const float *rowQ, int tip, int tail, const float *coeffs, int nbCoeffs, float *iAcc, float *qAcc);
+
+    bool hasAVX512();
+    void symmetricFIR32AVX512(const int32_t *rowI, const int32_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int32_t *iAcc, int32_t *qAcc);
+    void symmetricFIR64AVX512(const int64_t *rowI, const int64_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int64_t *iAcc, int64_t *qAcc);
+    void symmetricFIRFAVX512(const float *rowI, const float *rowQ, int tip, int tail, const float *coeffs, int nbCoeffs, float *iAcc, float *qAcc);
+}
+
+#endif // SDRBASE_DSP_HBFILTERKERNELSISA_H_
@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with SSE 4.1 enabled. Only used after checking the CPU supports it.
+
+#if defined(__SSE4_1__) || defined(__AVX__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define HBFILTERKERNELS_SSE41
+#include <smmintrin.h>
+#endif
+
+#include "hbfilterkernelsisa.h"
+
+#ifdef HBFILTERKERNELS_SSE41
+
+namespace HBFilterKernelsISA
+{
+
+bool hasSSE41()
+{
+    return true;
+}
+
+void symmetricFIR32SSE41(const int32_t *rowI, const int32_t *rowQ, int tip, int tail, const int32_t *coeffs, int nbCoeffs, int32_t *iAcc, int32_t *qAcc)
+{
+    // The tip sample has just been stored: a wide load over it would stall on store forwarding
+    // so the first tip vector is made of the previous samples shifted in with the tip sample.
+    __m128i ti = _mm_alignr_epi8(_mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &rowI[tip - 4]), _MM_SHUFFLE(0,1,2,3)), _mm_set1_epi32(rowI[tip]), 12);
+    __m128i tq = _mm_alignr_epi8(_mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &rowQ[tip - 4]), _MM_SHUFFLE(0,1,2,3)), _mm_set1_epi32(rowQ[tip]), 12);
+    __m128i h = _mm_loadu_si128((const __m128i*) coeffs);
+    __m128i accI = _mm_mullo_epi32(_mm_add_epi32(ti, _mm_loadu_si128((const __m128i*) &rowI[tail])), h);
+    __m128i accQ = _mm_mullo_epi32(_mm_add_epi32(tq, _mm_loadu_si128((const __m128i*) &rowQ[tail])), h);
+
+    for (int k = 4; k < nbCoeffs; k += 4) // nbCoeffs is a multiple of 4
+    {
+        h = _mm_loadu_si128((const __m128i*) &coeffs[k]);
+        ti = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &rowI[tip - k - 3]), _MM_SHUFFLE(0,1,2,3));
+        tq = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &rowQ[tip - k - 3]), _MM_SHUFFLE(0,1,2,3));
+        __m128i si = _mm_loadu_si128((const __m128i*) &rowI[tail + k]);
+        __m128i sq = _mm_loadu_si128((const __m128i*) &rowQ[tail + k]);
+        accI = _mm_add_epi32(accI, _mm_mullo_epi32(_mm_add_epi32(ti, si), h));
+        accQ = _mm_add_epi32(accQ, _mm_mullo_epi32(_mm_add_epi32(tq, sq), h));
+    }
+
+    // horizontal sums: I in lanes 0,1 then Q in lanes 2,3
+    __m128i iq = _mm_add_epi32(_mm_unpacklo_epi64(accI, accQ), _mm_unpackhi_epi64(accI, accQ));
+    iq = _mm_add_epi32(iq, _mm_shuffle_epi32(iq, _MM_SHUFFLE(2,3,0,1)));
+    *iAcc = _mm_cvtsi128_si32(iq);
+    *qAcc = _mm_extract_epi32(iq, 2);
+}
+
+void symmetricFIRFSSE41(const float *rowI, const float *rowQ, int tip, int tail, const float *coeffs, int nbCoeffs, float *iAcc, float *qAcc)
+{
+    // first tip vector: see symmetricFIR32SSE41
+    __m128 ti = _mm_loadu_ps(&rowI[tip - 4]);
+    __m128 tq = _mm_loadu_ps(&rowQ[tip - 4]);
+    ti = _mm_castsi128_ps(_mm_alignr_epi8(_mm_castps_si128(_mm_shuffle_ps(ti, ti, _MM_SHUFFLE(0,1,2,3))), _mm_castps_si128(_mm_set1_ps(rowI[tip])), 12));
+    tq = _mm_castsi128_ps(_mm_alignr_epi8(_mm_castps_si128(_mm_shuffle_ps(tq, tq, _MM_SHUFFLE(0,1,2,3))), _mm_castps_si128(_mm_set1_ps(rowQ[tip])), 12));
+    __m128 h = _mm_loadu_ps(coeffs);
+    __m128 accI = _mm_mul_ps(_mm_add_ps(ti, _mm_loadu_ps(&rowI[tail])), h);
+    __m128 accQ = _mm_mul_ps(_mm_add_ps(tq, _mm_loadu_ps(&rowQ[tail])), h);
+
+    for (int k = 4; k < nbCoeffs; k += 4) // nbCoeffs is a multiple of 4
+    {
+        h = _mm_loadu_ps(&coeffs[k]);
+        ti = _mm_loadu_ps(&rowI[tip - k - 3]);
+        tq = _mm_loadu_ps(&rowQ[tip - k - 3]);
+        ti = _mm_shuffle_ps(ti, ti, _MM_SHUFFLE(0,1,2,3));
+        tq = _mm_shuffle_ps(tq, tq, _MM_SHUFFLE(0,1,2,3));
+        accI = _mm_add_ps(accI, _mm_mul_ps(_mm_add_ps(ti, _mm_loadu_ps(&rowI[tail + k])), h));
+        accQ = _mm_add_ps(accQ, _mm_mul_ps(_mm_add_ps(tq, _mm_loadu_ps(&rowQ[tail + k])), h));
+    }
+
+    __m128 iq = _mm_add_ps(_mm_movelh_ps(accI, accQ), _mm_movehl_ps(accQ, accI));
+    iq = _mm_add_ps(iq, _mm_shuffle_ps(iq, iq, _MM_SHUFFLE(2,3,0,1)));
+    *iAcc = _mm_cvtss_f32(iq);
+    *qAcc = _mm_cvtss_f32(_mm_movehl_ps(iq, iq));
+}
+
+} // namespace HBFilterKernelsISA
+
+#else
+
+namespace HBFilterKernelsISA
+{
+
+bool hasSSE41()
+{
+    return false;
+}
+
+void symmetricFIR32SSE41(const int32_t*, const int32_t*, int, int, const int32_t*, int, int32_t*, int32_t*)
+{}
+
+void symmetricFIRFSSE41(const float*, const float*, int, int, const float*, int, float*, float*)
+{}
+
+} // namespace HBFilterKernelsISA
+
+#endif // HBFILTERKERNELS_SSE41
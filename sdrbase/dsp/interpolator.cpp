@@ -1,6 +1,10 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include <vector>
+#include <algorithm>
+#ifdef USE_AVX
+#include <immintrin.h>
+#endif
 #include "dsp/interpolator.h"
 
 
@@ -72,9 +76,12 @@ Interpolator::Interpolator() :
 	m_alignedTaps(0),
 	m_taps2(0),
 	m_alignedTaps2(0),
+	m_blockTaps(0),
+	m_alignedBlockTaps(0),
     m_ptr(0),
 	m_phaseSteps(1),
-    m_nTaps(1)
+    m_nTaps(1),
+    m_nBlockTaps(4)
 {
 }
 
@@ -159,6 +166,29 @@ void Interpolator::create(int phaseSteps, double sampleRate, double cutoff, doub
 		m_alignedTaps2[2 * (i - 1) + 0] = polyphase[i];
 		m_alignedTaps2[2 * (i - 1) + 1] = polyphase[i];
 	}
+
+	// block taps: each phase filter is reversed so that it applies to samples in chronological order
+	// and is zero padded at the front to a multiple of 4 taps (8 floats) with 32 bytes alignment
+	m_nBlockTaps = (m_nTaps + 3) & ~3;
+	int nbBlockTaps = 2 * m_nBlockTaps * phaseSteps;
+	m_blockTaps = new float[nbBlockTaps + 8];
+
+	for (int i = 0; i < nbBlockTaps + 8; ++i) {
+	    m_blockTaps[i] = 0;
+	}
+
+	m_alignedBlockTaps = (float*)((((quint64)m_blockTaps) + 31) & ~31);
+
+	for (int phase = 0; phase < phaseSteps; phase++)
+	{
+		float *phaseTaps = &m_alignedBlockTaps[2 * m_nBlockTaps * phase];
+
+		for (int i = 0; i < m_nTaps; i++)
+		{
+			phaseTaps[2 * (m_nBlockTaps - 1 - i) + 0] = polyphase[phase * m_nTaps + i];
+			phaseTaps[2 * (m_nBlockTaps - 1 - i) + 1] = polyphase[phase * m_nTaps + i];
+		}
+	}
 }
 
 void Interpolator::free()
@@ -171,5 +201,148 @@ void Interpolator::free()
 		delete[] m_taps2;
 		m_taps2 = NULL;
 		m_alignedTaps2 = NULL;
+		delete[] m_blockTaps;
+		m_blockTaps = NULL;
+		m_alignedBlockTaps = NULL;
+	}
+}
+
+int Interpolator::decimate(Real *distance, Real distanceStep, const Complex *in, int nbIn, std::vector<Complex>& out)
+{
+	int nbOut = prepareBlock(distanceStep, in, nbIn, out);
+
+	for (int i = 0; i < nbIn; i++)
+	{
+		*distance -= 1.0;
+
+		if (*distance < 1.0)
+		{
+			// newest sample is in[i] at m_blockSamples[m_nBlockTaps + i]
+			doBlockInterpolate((int) floor(*distance * (Real) m_phaseSteps), &m_blockSamples[i + 1], &out[nbOut++]);
+			*distance += distanceStep;
+		}
 	}
+
+	finishBlock(nbIn);
+
+	return nbOut;
+}
+
+int Interpolator::interpolate(Real *distance, Real distanceStep, const Complex *in, int nbIn, std::vector<Complex>& out)
+{
+	int nbOut = prepareBlock(distanceStep, in, nbIn, out);
+	int i = 0;
+
+	while (i < nbIn)
+	{
+		if (*distance >= 1.0)
+		{
+			// consume in[i]. The per sample version computes an output here that callers discard.
+			*distance -= 1.0;
+			i++;
+		}
+		else
+		{
+			// newest sample is the last consumed one at m_blockSamples[m_nBlockTaps - 1 + i]
+			doBlockInterpolate((int) floor(*distance * (Real) m_phaseSteps), &m_blockSamples[i], &out[nbOut++]);
+			*distance += distanceStep;
+		}
+	}
+
+	finishBlock(nbIn);
+
+	return nbOut;
+}
+
+int Interpolator::prepareBlock(Real distanceStep, const Complex *in, int nbIn, std::vector<Complex>& out)
+{
+	unsigned int maxOut = (unsigned int) ((nbIn + 2) / distanceStep) + 2;
+
+	if (out.size() < maxOut) {
+		out.resize(maxOut);
+	}
+
+	if (m_blockSamples.size() < (unsigned int) (m_nBlockTaps + nbIn)) {
+		m_blockSamples.resize(m_nBlockTaps + nbIn);
+	}
+
+	// history from the ring buffer with the newest sample last. Samples older than m_nTaps only meet zero taps.
+	for (int age = 0; age < m_nBlockTaps; age++) {
+		m_blockSamples[m_nBlockTaps - 1 - age] = age < m_nTaps ? m_samples[(m_ptr + age) % m_nTaps] : Complex{0, 0};
+	}
+
+	std::copy(in, in + nbIn, m_blockSamples.begin() + m_nBlockTaps);
+
+	return 0;
+}
+
+void Interpolator::finishBlock(int nbIn)
+{
+	// store back the newest samples into the ring buffer so that per sample calls can follow
+	int newest = m_nBlockTaps - 1 + nbIn;
+	m_ptr = 0;
+
+	for (int age = 0; age < m_nTaps; age++) {
+		m_samples[age] = m_blockSamples[newest - age];
+	}
+}
+
+void Interpolator::doBlockInterpolate(int phase, const Complex *src, Complex* result) const
+{
+	if (phase < 0) {
+		phase = 0;
+	}
+
+	const float *s = (const float*) src;
+	const float *coeff = &m_alignedBlockTaps[2 * m_nBlockTaps * phase];
+
+#if defined(USE_AVX)
+	__m256 sum0 = _mm256_setzero_ps();
+	__m256 sum1 = _mm256_setzero_ps();
+	int todo = m_nBlockTaps / 4;
+	int i = 0;
+
+	for (; i < todo - 1; i += 2)
+	{
+		sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(s), _mm256_load_ps(coeff)));
+		sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_loadu_ps(s + 8), _mm256_load_ps(coeff + 8)));
+		s += 16;
+		coeff += 16;
+	}
+
+	if (i < todo) {
+		sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(s), _mm256_load_ps(coeff)));
+	}
+
+	sum0 = _mm256_add_ps(sum0, sum1);
+	__m128 sum = _mm_add_ps(_mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1));
+	// add upper half to lower half and store
+	_mm_storel_pi((__m64*)result, _mm_add_ps(sum, _mm_movehl_ps(sum, sum)));
+#elif defined(USE_SSE2)
+	__m128 sum = _mm_setzero_ps();
+	int todo = m_nBlockTaps / 2;
+
+	for (int i = 0; i < todo; i++)
+	{
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(s), _mm_load_ps(coeff)));
+		s += 4;
+		coeff += 4;
+	}
+
+	// add upper half to lower half and store
+	_mm_storel_pi((__m64*)result, _mm_add_ps(sum, _mm_movehl_ps(sum, sum)));
+#else
+	Real rAcc = 0;
+	Real iAcc = 0;
+
+	for (int i = 0; i < m_nBlockTaps; i++)
+	{
+		rAcc += coeff[0] * s[0];
+		iAcc += coeff[1] * s[1];
+		s += 2;
+		coeff += 2;
+	}
+
+	*result = Complex(rAcc, iAcc);
+#endif
 }
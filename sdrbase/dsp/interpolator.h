@@ -21,6 +21,7 @@
 #ifdef USE_SSE2
 #include <emmintrin.h>
 #endif
+#include <vector>
 #include "dsp/dsptypes.h"
 #include "export.h"
 #include <stdio.h>
@@ -89,15 +90,27 @@ public:
 		return true;
 	}
 
+	// Block versions of decimate() and interpolate(). All nbIn input samples are consumed and the
+	// output samples are written from the start of out which is enlarged if necessary.
+	// distanceStep is the ratio of input to output sample rates that callers of the per sample
+	// methods add to distance after each output sample. Returns the number of output samples.
+	// Both flavors can be mixed as the filter history is shared.
+	int decimate(Real *distance, Real distanceStep, const Complex *in, int nbIn, std::vector<Complex>& out);
+	int interpolate(Real *distance, Real distanceStep, const Complex *in, int nbIn, std::vector<Complex>& out);
+
 private:
 	float* m_taps;
 	float* m_alignedTaps;
 	float* m_taps2;
 	float* m_alignedTaps2;
+	float* m_blockTaps;
+	float* m_alignedBlockTaps;
 	std::vector<Complex> m_samples;
+	std::vector<Complex> m_blockSamples; //!< history followed by the current block in chronological order
 	int m_ptr;
 	int m_phaseSteps;
 	int m_nTaps;
+	int m_nBlockTaps; //!< m_nTaps rounded up to a multiple of 4 for the block dot products
 
 	static void createPolyphaseLowPass(
 	    std::vector<Real>& taps,
@@ -118,6 +131,10 @@ private:
 
 	void createTaps(int nTaps, double sampleRate, double cutoff, std::vector<Real>* taps);
 
+	int prepareBlock(Real distanceStep, const Complex *in, int nbIn, std::vector<Complex>& out);
+	void finishBlock(int nbIn);
+	void doBlockInterpolate(int phase, const Complex *src, Complex* result) const;
+
 	void advanceFilter(const Complex& next)
 	{
 		m_ptr--;
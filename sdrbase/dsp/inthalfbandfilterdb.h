@@ -662,6 +662,58 @@ public:
         *y3 = -x;
     }
 
+    /** Block versions of the optimized upsamplers by 2 above. Produce nbOut samples at sampleOut
+     *  consuming input samples at sampleIn as needed. Returns the number of input samples consumed
+     *  which is given beforehand by getInterpolateInputCount(nbOut). */
+    int workInterpolateCenterBlock(Sample* sampleIn, Sample *sampleOut, int nbOut)
+    {
+        Sample *in = sampleIn;
+
+        for (int i = 0; i < nbOut; i++)
+        {
+            if (workInterpolateCenter(in, &sampleOut[i])) {
+                in++;
+            }
+        }
+
+        return in - sampleIn;
+    }
+
+    int workInterpolateLowerHalfBlock(Sample* sampleIn, Sample *sampleOut, int nbOut)
+    {
+        Sample *in = sampleIn;
+
+        for (int i = 0; i < nbOut; i++)
+        {
+            if (workInterpolateLowerHalf(in, &sampleOut[i])) {
+                in++;
+            }
+        }
+
+        return in - sampleIn;
+    }
+
+    int workInterpolateUpperHalfBlock(Sample* sampleIn, Sample *sampleOut, int nbOut)
+    {
+        Sample *in = sampleIn;
+
+        for (int i = 0; i < nbOut; i++)
+        {
+            if (workInterpolateUpperHalf(in, &sampleOut[i])) {
+                in++;
+            }
+        }
+
+        return in - sampleIn;
+    }
+
+    /** Number of input samples the optimized upsamplers consume to produce nbOut samples.
+     *  A sample is consumed in every odd state. */
+    int getInterpolateInputCount(int nbOut) const
+    {
+        return (m_state + nbOut) / 2 - m_state / 2;
+    }
+
 protected:
 	AccuType m_samplesDB[2*(HBFIRFilterTraits<HBFilterOrder>::hbOrder - 1)][2]; // double buffer technique
 	int m_ptr;
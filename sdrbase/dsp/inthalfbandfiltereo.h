@@ -27,6 +27,7 @@
 #include <cstdlib>
 #include "dsp/dsptypes.h"
 #include "dsp/hbfiltertraits.h"
+#include "dsp/hbfilterkernels.h"
 
 template<typename EOStorageType, typename AccuType, uint32_t HBFilterOrder, bool IQorder>
 class IntHalfbandFilterEO {
@@ -837,6 +838,38 @@ protected:
         m_ptr = m_ptr + 1 < 2*m_size ? m_ptr + 1: 0;
     }
 
+    // 32 bit storage and accumulator: run time selected SIMD kernel
+    static void symmetricSum(const qint32 *rowI, const qint32 *rowQ, int a, int b, qint32& iAcc, qint32& qAcc)
+    {
+        qint32 iSum, qSum;
+        HBFilterKernels::m_symmetricFIR32(rowI, rowQ, a, b, HBFIRFilterTraits<HBFilterOrder>::hbCoeffs,
+            HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4, &iSum, &qSum);
+        iAcc += iSum;
+        qAcc += qSum;
+    }
+
+    // 64 bit storage and accumulator (24 bit Rx DSP): run time selected SIMD kernel
+    static void symmetricSum(const qint64 *rowI, const qint64 *rowQ, int a, int b, qint64& iAcc, qint64& qAcc)
+    {
+        int64_t iSum, qSum;
+        HBFilterKernels::m_symmetricFIR64(reinterpret_cast<const int64_t*>(rowI), reinterpret_cast<const int64_t*>(rowQ), a, b,
+            HBFIRFilterTraits<HBFilterOrder>::hbCoeffs, HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4, &iSum, &qSum);
+        iAcc += iSum;
+        qAcc += qSum;
+    }
+
+    template<typename StorageType, typename AccuTypeT>
+    static void symmetricSum(const StorageType *rowI, const StorageType *rowQ, int a, int b, AccuTypeT& iAcc, AccuTypeT& qAcc)
+    {
+        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
+        {
+            iAcc += ((EOStorageType)(rowI[a] + rowI[b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+            qAcc += ((EOStorageType)(rowQ[a] + rowQ[b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+            a -= 1;
+            b += 1;
+        }
+    }
+
     void doFIR(Sample* sample)
     {
         AccuType iAcc = 0;
@@ -845,21 +878,10 @@ protected:
         int a = m_ptr/2 + m_size; // tip pointer
         int b = m_ptr/2 + 1; // tail pointer
 
-        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
-        {
-            if ((m_ptr % 2) == 0)
-            {
-                iAcc += ((EOStorageType)(m_even[0][a] + m_even[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_even[1][a] + m_even[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-            else
-            {
-                iAcc += ((EOStorageType)(m_odd[0][a] + m_odd[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_odd[1][a] + m_odd[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-
-            a -= 1;
-            b += 1;
+        if ((m_ptr % 2) == 0) {
+            symmetricSum(m_even[0], m_even[1], a, b, iAcc, qAcc);
+        } else {
+            symmetricSum(m_odd[0], m_odd[1], a, b, iAcc, qAcc);
         }
 
         if ((m_ptr % 2) == 0)
@@ -885,21 +907,10 @@ protected:
         int a = m_ptr/2 + m_size; // tip pointer
         int b = m_ptr/2 + 1; // tail pointer
 
-        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
-        {
-            if ((m_ptr % 2) == 0)
-            {
-                iAcc += ((EOStorageType)(m_even[0][a] + m_even[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_even[1][a] + m_even[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-            else
-            {
-                iAcc += ((EOStorageType)(m_odd[0][a] + m_odd[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_odd[1][a] + m_odd[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-
-            a -= 1;
-            b += 1;
+        if ((m_ptr % 2) == 0) {
+            symmetricSum(m_even[0], m_even[1], a, b, iAcc, qAcc);
+        } else {
+            symmetricSum(m_odd[0], m_odd[1], a, b, iAcc, qAcc);
         }
 
         if ((m_ptr % 2) == 0)
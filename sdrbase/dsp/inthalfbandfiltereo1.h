@@ -29,6 +29,10 @@
 #include "dsp/hbfiltertraits.h"
 //#include "dsp/inthalfbandfiltereo1i.h"
 
+#if defined(USE_SSE4_1)
+#include <smmintrin.h>
+#endif
+
 template<uint32_t HBFilterOrder>
 class IntHalfbandFilterEO1 {
 public:
@@ -653,6 +657,58 @@ public:
         *y3 = -x;
     }
 
+    /** Block versions of the optimized upsamplers by 2 above. Produce nbOut samples at sampleOut
+     *  consuming input samples at sampleIn as needed. Returns the number of input samples consumed
+     *  which is given beforehand by getInterpolateInputCount(nbOut). */
+    int workInterpolateCenterBlock(Sample* sampleIn, Sample *sampleOut, int nbOut)
+    {
+        Sample *in = sampleIn;
+
+        for (int i = 0; i < nbOut; i++)
+        {
+            if (workInterpolateCenter(in, &sampleOut[i])) {
+                in++;
+            }
+        }
+
+        return in - sampleIn;
+    }
+
+    int workInterpolateLowerHalfBlock(Sample* sampleIn, Sample *sampleOut, int nbOut)
+    {
+        Sample *in = sampleIn;
+
+        for (int i = 0; i < nbOut; i++)
+        {
+            if (workInterpolateLowerHalf(in, &sampleOut[i])) {
+                in++;
+            }
+        }
+
+        return in - sampleIn;
+    }
+
+    int workInterpolateUpperHalfBlock(Sample* sampleIn, Sample *sampleOut, int nbOut)
+    {
+        Sample *in = sampleIn;
+
+        for (int i = 0; i < nbOut; i++)
+        {
+            if (workInterpolateUpperHalf(in, &sampleOut[i])) {
+                in++;
+            }
+        }
+
+        return in - sampleIn;
+    }
+
+    /** Number of input samples the optimized upsamplers consume to produce nbOut samples.
+     *  A sample is consumed in every odd state. */
+    int getInterpolateInputCount(int nbOut) const
+    {
+        return (m_state + nbOut) / 2 - m_state / 2;
+    }
+
 protected:
     int32_t m_even[2][HBFIRFilterTraits<HBFilterOrder>::hbOrder]; // double buffer technique
     int32_t m_odd[2][HBFIRFilterTraits<HBFilterOrder>::hbOrder]; // double buffer technique
@@ -790,20 +846,10 @@ protected:
 
     void doInterpolateFIR(Sample* sample)
     {
-        qint32 iAcc = 0;
-        qint32 qAcc = 0;
+        qint32 iAcc;
+        qint32 qAcc;
 
-        qint16 a = m_ptr;
-        qint16 b = m_ptr + (HBFIRFilterTraits<HBFilterOrder>::hbOrder / 2) - 1;
-
-        // go through samples in buffer
-        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
-        {
-            iAcc += (m_samples[a][0] + m_samples[b][0]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            qAcc += (m_samples[a][1] + m_samples[b][1]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            a++;
-            b--;
-        }
+        doInterpolateFIRAcc(iAcc, qAcc);
 
         sample->setReal(iAcc >> (HBFIRFilterTraits<HBFilterOrder>::hbShift -1));
         sample->setImag(qAcc >> (HBFIRFilterTraits<HBFilterOrder>::hbShift -1));
@@ -811,11 +857,46 @@ protected:
 
     void doInterpolateFIR(qint32 *x, qint32 *y)
     {
-        qint32 iAcc = 0;
-        qint32 qAcc = 0;
+        qint32 iAcc;
+        qint32 qAcc;
 
-        qint16 a = m_ptr;
-        qint16 b = m_ptr + (HBFIRFilterTraits<HBFilterOrder>::hbOrder / 2) - 1;
+        doInterpolateFIRAcc(iAcc, qAcc);
+
+        *x = iAcc >> (HBFIRFilterTraits<HBFilterOrder>::hbShift -1);
+        *y = qAcc >> (HBFIRFilterTraits<HBFilterOrder>::hbShift -1);
+    }
+
+    void doInterpolateFIRAcc(qint32& iAcc, qint32& qAcc)
+    {
+        int a = m_ptr;
+        int b = m_ptr + (HBFIRFilterTraits<HBFilterOrder>::hbOrder / 2) - 1;
+
+#if defined(USE_SSE4_1)
+        // I/Q of two consecutive samples per vector. Coefficients come by 4 (hbOrder is a multiple of 16)
+        const int32_t *h = HBFIRFilterTraits<HBFilterOrder>::hbCoeffs;
+        __m128i acc = _mm_setzero_si128();
+
+        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i += 4)
+        {
+            __m128i h4 = _mm_loadu_si128((const __m128i*) &h[i]);
+            __m128i sa = _mm_loadu_si128((const __m128i*) m_samples[a]);     // a, a+1
+            __m128i sb = _mm_loadu_si128((const __m128i*) m_samples[b - 1]); // b-1, b
+            sb = _mm_shuffle_epi32(sb, _MM_SHUFFLE(1,0,3,2));                 // b, b-1
+            acc = _mm_add_epi32(acc, _mm_mullo_epi32(_mm_add_epi32(sa, sb), _mm_unpacklo_epi32(h4, h4)));
+            sa = _mm_loadu_si128((const __m128i*) m_samples[a + 2]);         // a+2, a+3
+            sb = _mm_loadu_si128((const __m128i*) m_samples[b - 3]);         // b-3, b-2
+            sb = _mm_shuffle_epi32(sb, _MM_SHUFFLE(1,0,3,2));                 // b-2, b-3
+            acc = _mm_add_epi32(acc, _mm_mullo_epi32(_mm_add_epi32(sa, sb), _mm_unpackhi_epi32(h4, h4)));
+            a += 4;
+            b -= 4;
+        }
+
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1,0,3,2)));
+        iAcc = _mm_cvtsi128_si32(acc);
+        qAcc = _mm_extract_epi32(acc, 1);
+#else
+        iAcc = 0;
+        qAcc = 0;
 
         // go through samples in buffer
         for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
@@ -825,9 +906,7 @@ protected:
             a++;
             b--;
         }
-
-        *x = iAcc >> (HBFIRFilterTraits<HBFilterOrder>::hbShift -1);
-        *y = qAcc >> (HBFIRFilterTraits<HBFilterOrder>::hbShift -1);
+#endif
     }
 };
 
@@ -27,6 +27,7 @@
 #include <cstdlib>
 #include "dsp/dsptypes.h"
 #include "dsp/hbfiltertraits.h"
+#include "dsp/hbfilterkernels.h"
 #include "export.h"
 
 template<uint32_t HBFilterOrder, bool IQOrder>
@@ -171,6 +172,27 @@ protected:
         m_ptr = m_ptr + 1 < 2*m_size ? m_ptr + 1: 0;
     }
 
+    // float coefficients: run time selected SIMD kernel
+    static void symmetricSum(const float *rowI, const float *rowQ, int a, int b, const float *coeffs, float& iAcc, float& qAcc)
+    {
+        float iSum, qSum;
+        HBFilterKernels::m_symmetricFIRF(rowI, rowQ, a, b, coeffs, HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4, &iSum, &qSum);
+        iAcc += iSum;
+        qAcc += qSum;
+    }
+
+    template<typename CoeffType>
+    static void symmetricSum(const float *rowI, const float *rowQ, int a, int b, const CoeffType *coeffs, float& iAcc, float& qAcc)
+    {
+        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
+        {
+            iAcc += (rowI[a] + rowI[b]) * coeffs[i];
+            qAcc += (rowQ[a] + rowQ[b]) * coeffs[i];
+            a -= 1;
+            b += 1;
+        }
+    }
+
     void doFIR(float *x, float *y)
     {
         float iAcc = 0;
@@ -179,21 +201,10 @@ protected:
         int a = m_ptr/2 + m_size; // tip pointer
         int b = m_ptr/2 + 1; // tail pointer
 
-        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
-        {
-            if ((m_ptr % 2) == 0)
-            {
-                iAcc += (m_even[0][a] + m_even[0][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffsF[i];
-                qAcc += (m_even[1][a] + m_even[1][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffsF[i];
-            }
-            else
-            {
-                iAcc += (m_odd[0][a] + m_odd[0][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffsF[i];
-                qAcc += (m_odd[1][a] + m_odd[1][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffsF[i];
-            }
-
-            a -= 1;
-            b += 1;
+        if ((m_ptr % 2) == 0) {
+            symmetricSum(m_even[0], m_even[1], a, b, HBFIRFilterTraits<HBFilterOrder>::hbCoeffsF, iAcc, qAcc);
+        } else {
+            symmetricSum(m_odd[0], m_odd[1], a, b, HBFIRFilterTraits<HBFilterOrder>::hbCoeffsF, iAcc, qAcc);
         }
 
         if ((m_ptr % 2) == 0)
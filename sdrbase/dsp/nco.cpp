@@ -21,6 +21,7 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include "dsp/nco.h"
+#include "dsp/ncomixer.h"
 
 #undef M_PI
 #define M_PI		3.14159265358979323846
@@ -81,6 +82,24 @@ void NCO::nextIQMul(Real& i, Real& q)
     q = x*v + y*u;
 }
 
+void NCO::nextIQMul(const Sample *in, Complex *out, int nbSamples)
+{
+    NCOMixer::mix(in, out, nbSamples, m_phase, m_phaseIncrement, TableSize);
+    advancePhase(nbSamples);
+}
+
+void NCO::nextIQMul(const Complex *in, Complex *out, int nbSamples)
+{
+    NCOMixer::mix(in, out, nbSamples, m_phase, m_phaseIncrement, TableSize);
+    advancePhase(nbSamples);
+}
+
+void NCO::advancePhase(int nbSamples)
+{
+    qint64 phase = (m_phase + (qint64) nbSamples * m_phaseIncrement) % TableSize;
+    m_phase = phase < 0 ? phase + TableSize : phase;
+}
+
 float NCO::get()
 {
 	return m_table[m_phase];
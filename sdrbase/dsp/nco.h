@@ -31,6 +31,7 @@ private:
 	static bool m_tableInitialized;
 
 	static void initTable();
+	void advancePhase(int nbSamples); //!< Increment phase by nbSamples steps at once
 
 	int m_phaseIncrement;
 	int m_phase;
@@ -54,6 +55,8 @@ public:
 	Complex nextIQ();       //!< Return next complex sample
 	Complex nextQI();       //!< Return next complex sample (reversed)
 	void nextIQMul(Real& i, Real& q); //!< multiply I,Q separately with next sample
+	void nextIQMul(const Sample *in, Complex *out, int nbSamples);  //!< multiply block of samples with next nbSamples complex samples
+	void nextIQMul(const Complex *in, Complex *out, int nbSamples); //!< multiply block of samples with next nbSamples complex samples
 	Real get();             //!< Return current real sample (no phase increment)
 	Complex getIQ();        //!< Return current complex sample (no phase increment)
 	void getIQ(Complex& c); //!< Sets to the current complex sample (no phase increment)
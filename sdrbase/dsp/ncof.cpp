@@ -20,6 +20,7 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include "dsp/ncof.h"
+#include "dsp/ncomixer.h"
 
 #undef M_PI
 #define M_PI		3.14159265358979323846
@@ -80,6 +81,28 @@ Complex NCOF::nextQI()
 	return Complex(-m_table[(phase + TableSize / 4) % TableSize], m_table[phase]);
 }
 
+void NCOF::nextIQMul(const Sample *in, Complex *out, int nbSamples)
+{
+    NCOMixer::mix(in, out, nbSamples, m_phase, m_phaseIncrement, TableSize);
+    advancePhase(nbSamples);
+}
+
+void NCOF::nextIQMul(const Complex *in, Complex *out, int nbSamples)
+{
+    NCOMixer::mix(in, out, nbSamples, m_phase, m_phaseIncrement, TableSize);
+    advancePhase(nbSamples);
+}
+
+void NCOF::advancePhase(int nbSamples)
+{
+    double phase = fmod(m_phase + (double) nbSamples * m_phaseIncrement, (double) TableSize);
+    m_phase = phase < 0.0 ? phase + TableSize : phase;
+
+    if (m_phase >= m_tableSizeLimit) { // rounding to float
+        m_phase -= TableSize;
+    }
+}
+
 float NCOF::get()
 {
 	return m_table[(int) m_phase];
@@ -31,6 +31,7 @@ private:
 	static float m_tableSizeLimit;
 
 	static void initTable();
+	void advancePhase(int nbSamples); //!< Increment phase by nbSamples steps at once
 
 	Real m_phaseIncrement;
 	Real m_phase;
@@ -57,6 +58,8 @@ public:
 	Complex nextIQ();                   //!< Return next complex sample
 	Complex nextIQ(float imbalance);    //!< Return next complex sample with an imbalance factor on I
 	Complex nextQI();                   //!< Return next complex sample (reversed)
+	void nextIQMul(const Sample *in, Complex *out, int nbSamples);  //!< multiply block of samples with next nbSamples complex samples
+	void nextIQMul(const Complex *in, Complex *out, int nbSamples); //!< multiply block of samples with next nbSamples complex samples
 	Real get();                         //!< Return current real sample (no phase increment)
 	Complex getIQ();                    //!< Return current complex sample (no phase increment)
 	void getIQ(Complex& c);             //!< Sets to the current complex sample (no phase increment)
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "dsp/ncomixer.h"
+
+#undef M_PI
+#define M_PI		3.14159265358979323846
+
+namespace {
+
+#ifdef USE_SSE2
+// load two consecutive samples as [re0, im0, re1, im1]
+inline __m128 load2(const Complex *in)
+{
+    return _mm_loadu_ps((const float*) in);
+}
+
+inline __m128 load2(const Sample *in)
+{
+#if SDR_RX_SAMP_SZ == 16
+    __m128i s = _mm_loadl_epi64((const __m128i*) in);
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+#else
+    return _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) in));
+#endif
+}
+#endif
+
+inline Complex load1(const Complex *in)
+{
+    return *in;
+}
+
+inline Complex load1(const Sample *in)
+{
+    return Complex(in->real(), in->imag());
+}
+
+} // namespace
+
+void NCOMixer::mix(const Sample *in, Complex *out, int nbSamples, double phase, double phaseIncrement, int period)
+{
+    mixT(in, out, nbSamples, phase, phaseIncrement, period);
+}
+
+void NCOMixer::mix(const Complex *in, Complex *out, int nbSamples, double phase, double phaseIncrement, int period)
+{
+    mixT(in, out, nbSamples, phase, phaseIncrement, period);
+}
+
+template<typename T>
+void NCOMixer::mixT(const T *in, Complex *out, int nbSamples, double phase, double phaseIncrement, int period)
+{
+    const double radPerUnit = (2.0 * M_PI) / period;
+    const double dphi = phaseIncrement * radPerUnit;
+    int n = 0;
+
+    while (n < nbSamples)
+    {
+        int chunk = nbSamples - n < RenormPeriod ? nbSamples - n : (int) RenormPeriod;
+        // exact phase of the first sample of the chunk. Keep the accumulator small to preserve precision.
+        double phi0 = fmod(phase + (n + 1) * phaseIncrement, (double) period) * radPerUnit;
+        int k = 0;
+#ifdef USE_SSE2
+        // two samples per vector: rotator lanes hold [cr0, cr0, cr1, cr1] and [ci0, ci0, ci1, ci1]
+        __m128 cr = _mm_setr_ps(cos(phi0), cos(phi0), cos(phi0 + dphi), cos(phi0 + dphi));
+        __m128 ci = _mm_setr_ps(sin(phi0), sin(phi0), sin(phi0 + dphi), sin(phi0 + dphi));
+        const __m128 sr = _mm_set1_ps(cos(2.0 * dphi));
+        const __m128 si = _mm_set1_ps(sin(2.0 * dphi));
+        const __m128 sign = _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+
+        for (; k < chunk - 1; k += 2)
+        {
+            __m128 x = load2(&in[n + k]);
+            __m128 xs = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)); // [im0, re0, im1, re1]
+            __m128 y = _mm_add_ps(_mm_mul_ps(x, cr), _mm_mul_ps(_mm_mul_ps(xs, ci), sign));
+            _mm_storeu_ps((float*) &out[n + k], y);
+            __m128 crn = _mm_sub_ps(_mm_mul_ps(cr, sr), _mm_mul_ps(ci, si));
+            ci = _mm_add_ps(_mm_mul_ps(cr, si), _mm_mul_ps(ci, sr));
+            cr = crn;
+        }
+#endif
+        if (k < chunk)
+        {
+            // scalar rotator for the remainder or the whole chunk when SIMD is not available
+            Complex c(cos(phi0 + k * dphi), sin(phi0 + k * dphi));
+            const Complex s(cos(dphi), sin(dphi));
+
+            for (; k < chunk; k++)
+            {
+                out[n + k] = load1(&in[n + k]) * c;
+                c *= s;
+            }
+        }
+
+        n += chunk;
+    }
+}
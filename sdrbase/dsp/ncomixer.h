@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_NCOMIXER_H
+#define INCLUDE_NCOMIXER_H
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Block frequency shifter used by NCO and NCOF.
+ * Output is out[n] = in[n] * exp(j*2*pi*(phase + (n+1)*phaseIncrement)/period) which is what
+ * successive calls to nextIQ() return for a table of size period.
+ * Samples are rotated by a recursive complex rotator that is renormalized from the exact
+ * phase accumulator every RenormPeriod samples so that errors do not build up.
+ */
+class SDRBASE_API NCOMixer
+{
+public:
+    static void mix(const Sample *in, Complex *out, int nbSamples, double phase, double phaseIncrement, int period);
+    static void mix(const Complex *in, Complex *out, int nbSamples, double phase, double phaseIncrement, int period);
+
+private:
+    enum {
+        RenormPeriod = 128 //!< multiple of 2 (SIMD width in complex samples)
+    };
+
+    template<typename T>
+    static void mixT(const T *in, Complex *out, int nbSamples, double phase, double phaseIncrement, int period);
+};
+
+#endif // INCLUDE_NCOMIXER_H
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cstring>
+
+#include <QDebug>
+
+#include "dsp/devicecallbackstats.h"
+#include "rawblockpipeline.h"
+
+RawBlockPipeline::RawBlockPipeline(Processor *processor, int blockBytes, int nbBlocks, DeviceCallbackStats *stats, QObject *parent) :
+    QThread(parent),
+    m_processor(processor),
+    m_stats(stats),
+    m_blockBytes(blockBytes),
+    m_nbBlocks(nbBlocks),
+    m_blocks(blockBytes*nbBlocks),
+    m_lengths(nbBlocks),
+    m_writeIndex(0),
+    m_readIndex(0),
+    m_running(false)
+{}
+
+RawBlockPipeline::~RawBlockPipeline()
+{
+    stopWork();
+}
+
+void RawBlockPipeline::startWork()
+{
+    m_writeIndex.storeRelease(0);
+    m_readIndex.storeRelease(0);
+    m_filled.tryAcquire(m_filled.available());
+    m_running = true;
+    start(QThread::HighPriority);
+}
+
+void RawBlockPipeline::stopWork()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    m_running = false;
+    m_filled.release(); // wake up
+    wait();
+    qDebug("RawBlockPipeline::stopWork: %d blocks of %d bytes", m_nbBlocks, m_blockBytes);
+}
+
+bool RawBlockPipeline::push(const void *buf, qint32 len, int bytesPerUnit)
+{
+    int writeIndex = m_writeIndex.load();
+    int fill = (writeIndex - m_readIndex.loadAcquire() + 2*m_nbBlocks) % (2*m_nbBlocks); // indexes run over twice the ring size to tell full from empty
+    int bytes = len * bytesPerUnit;
+
+    if ((fill >= m_nbBlocks) || (bytes > m_blockBytes))
+    {
+        if (m_stats) {
+            m_stats->overrun();
+        }
+
+        return false;
+    }
+
+    int slot = writeIndex % m_nbBlocks;
+    std::memcpy(&m_blocks[slot*m_blockBytes], buf, bytes);
+    m_lengths[slot] = len;
+    m_writeIndex.storeRelease((writeIndex + 1) % (2*m_nbBlocks));
+    m_filled.release();
+    return true;
+}
+
+void RawBlockPipeline::run()
+{
+    while (true)
+    {
+        m_filled.acquire();
+
+        int readIndex = m_readIndex.load();
+
+        if (readIndex == m_writeIndex.loadAcquire()) // woken up with nothing to process: stop
+        {
+            if (!m_running) {
+                break;
+            } else {
+                continue;
+            }
+        }
+
+        int slot = readIndex % m_nbBlocks;
+        m_processor->processBlock(&m_blocks[slot*m_blockBytes], m_lengths[slot]);
+        m_readIndex.storeRelease((readIndex + 1) % (2*m_nbBlocks));
+    }
+}
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_RAWBLOCKPIPELINE_H_
+#define SDRBASE_DSP_RAWBLOCKPIPELINE_H_
+
+#include <vector>
+
+#include <QThread>
+#include <QAtomicInt>
+#include <QSemaphore>
+
+#include "export.h"
+
+class DeviceCallbackStats;
+
+/**
+ * Moves the conversion and decimation of raw device samples off the device library callback.
+ * The callback only copies the raw block into a preallocated single producer single consumer
+ * ring with push() and returns. A thread pops the blocks in order and hands them to the processor.
+ * Blocks are processed by a single thread because the decimators carry filter state from one
+ * block to the next. When the ring is full the block is dropped and counted as an overrun.
+ */
+class SDRBASE_API RawBlockPipeline : public QThread
+{
+    Q_OBJECT
+public:
+    class Processor
+    {
+    public:
+        virtual ~Processor() {}
+        virtual void processBlock(const quint8 *buf, qint32 len) = 0; //!< len as given to push()
+    };
+
+    RawBlockPipeline(Processor *processor, int blockBytes, int nbBlocks, DeviceCallbackStats *stats = nullptr, QObject *parent = nullptr);
+    ~RawBlockPipeline();
+
+    void startWork();
+    void stopWork();
+    bool push(const void *buf, qint32 len, int bytesPerUnit = 1); //!< from the callback. Returns false if the block was dropped.
+
+private:
+    Processor *m_processor;
+    DeviceCallbackStats *m_stats;
+    int m_blockBytes;
+    int m_nbBlocks;
+    std::vector<quint8> m_blocks;
+    std::vector<qint32> m_lengths;
+    QAtomicInt m_writeIndex; //!< only written by the producer
+    QAtomicInt m_readIndex;  //!< only written by the consumer
+    QSemaphore m_filled;     //!< wakes up the consumer
+    volatile bool m_running;
+
+    void run();
+};
+
+#endif // SDRBASE_DSP_RAWBLOCKPIPELINE_H_
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "dsp/samplemixer.h"
+
+namespace {
+    const float txMin = -(float) (1 << (SDR_TX_SAMP_SZ - 1));
+    const float txMax = (float) ((1 << (SDR_TX_SAMP_SZ - 1)) - 1);
+}
+
+void SampleMixer::reset(unsigned int nbSamples)
+{
+    if (m_accumulator.size() < 2*nbSamples) {
+        m_accumulator.resize(2*nbSamples);
+    }
+
+    std::fill(m_accumulator.begin(), m_accumulator.begin() + 2*nbSamples, 0.0f);
+}
+
+void SampleMixer::add(SampleVector::const_iterator begin, unsigned int nbSamples, float gain)
+{
+    const FixReal *in = (const FixReal*) &(*begin);
+    float *acc = m_accumulator.data();
+    unsigned int n = 2*nbSamples; // I/Q components
+    unsigned int i = 0;
+
+#ifdef USE_SSE2
+    __m128 g = _mm_set1_ps(gain);
+#if SDR_RX_SAMP_SZ == 16
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*) &in[i]);
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16); // sign extend
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+        _mm_storeu_ps(&acc[i], _mm_add_ps(_mm_loadu_ps(&acc[i]), _mm_mul_ps(_mm_cvtepi32_ps(lo), g)));
+        _mm_storeu_ps(&acc[i+4], _mm_add_ps(_mm_loadu_ps(&acc[i+4]), _mm_mul_ps(_mm_cvtepi32_ps(hi), g)));
+    }
+#else
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*) &in[i]);
+        _mm_storeu_ps(&acc[i], _mm_add_ps(_mm_loadu_ps(&acc[i]), _mm_mul_ps(_mm_cvtepi32_ps(x), g)));
+    }
+#endif
+#endif
+
+    for (; i < n; i++) {
+        acc[i] += in[i] * gain;
+    }
+}
+
+void SampleMixer::output(SampleVector::iterator begin, unsigned int nbSamples, float scale)
+{
+    FixReal *out = (FixReal*) &(*begin);
+    const float *acc = m_accumulator.data();
+    unsigned int n = 2*nbSamples; // I/Q components
+    unsigned int i = 0;
+
+#ifdef USE_SSE2
+    __m128 s = _mm_set1_ps(scale);
+    __m128 vmin = _mm_set1_ps(txMin);
+    __m128 vmax = _mm_set1_ps(txMax);
+
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i lo = _mm_cvtps_epi32(_mm_max_ps(vmin, _mm_min_ps(vmax, _mm_mul_ps(_mm_loadu_ps(&acc[i]), s))));
+        __m128i hi = _mm_cvtps_epi32(_mm_max_ps(vmin, _mm_min_ps(vmax, _mm_mul_ps(_mm_loadu_ps(&acc[i+4]), s))));
+#if SDR_RX_SAMP_SZ == 16
+        _mm_storeu_si128((__m128i*) &out[i], _mm_packs_epi32(lo, hi));
+#else
+        _mm_storeu_si128((__m128i*) &out[i], lo);
+        _mm_storeu_si128((__m128i*) &out[i+4], hi);
+#endif
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        float v = acc[i] * scale;
+        v = v < txMin ? txMin : v > txMax ? txMax : v;
+        out[i] = (FixReal) std::lrint(v); // same rounding as SIMD conversion
+    }
+}
@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_SAMPLEMIXER_H
+#define INCLUDE_SAMPLEMIXER_H
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Mixes blocks of Tx samples from several channel sources.
+ * Sources are accumulated with their gain in a float buffer and the sum is scaled and
+ * saturated to the Tx sample range once at the end.
+ */
+class SDRBASE_API SampleMixer
+{
+public:
+    void reset(unsigned int nbSamples); //!< start a new mix of nbSamples samples
+    void add(SampleVector::const_iterator begin, unsigned int nbSamples, float gain); //!< add nbSamples from begin times gain
+    void output(SampleVector::iterator begin, unsigned int nbSamples, float scale); //!< write mix times scale from begin
+
+private:
+    std::vector<float> m_accumulator; //!< I/Q interleaved
+};
+
+#endif // INCLUDE_SAMPLEMIXER_H
@@ -24,6 +24,7 @@ void SampleSinkFifo::create(unsigned int s)
 {
 	m_size = 0;
 	m_fill = 0;
+	m_fillSnapshot.store(0);
 	m_head = 0;
 	m_tail = 0;
 
@@ -35,13 +36,16 @@ void SampleSinkFifo::reset()
 {
 	m_suppressed = -1;
 	m_fill = 0;
+	m_fillSnapshot.store(0);
 	m_head = 0;
 	m_tail = 0;
 }
 
 SampleSinkFifo::SampleSinkFifo(QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_fillSnapshot(0),
+	m_droppedSamples(0)
 {
 	m_suppressed = -1;
 	m_size = 0;
@@ -52,7 +56,9 @@ SampleSinkFifo::SampleSinkFifo(QObject* parent) :
 
 SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_fillSnapshot(0),
+	m_droppedSamples(0)
 {
 	m_suppressed = -1;
 	create(size);
@@ -60,7 +66,9 @@ SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 
 SampleSinkFifo::SampleSinkFifo(const SampleSinkFifo& other) :
     QObject(other.parent()),
-    m_data(other.m_data)
+    m_data(other.m_data),
+    m_fillSnapshot(0),
+    m_droppedSamples(0)
 {
   	m_suppressed = -1;
 	m_size = m_data.size();
@@ -95,6 +103,8 @@ unsigned int SampleSinkFifo::write(const quint8* data, unsigned int count)
 
     if (total < count)
     {
+		m_droppedSamples.fetchAndAddRelaxed(count - total);
+
 		if (m_suppressed < 0)
         {
 			m_suppressed = 0;
@@ -129,6 +139,8 @@ unsigned int SampleSinkFifo::write(const quint8* data, unsigned int count)
 		remaining -= len;
 	}
 
+	m_fillSnapshot.store(m_fill);
+
 	if (m_fill > 0) {
 		emit dataReady();
     }
@@ -148,6 +160,8 @@ unsigned int SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVec
 
     if (total < count)
     {
+		m_droppedSamples.fetchAndAddRelaxed(count - total);
+
 		if (m_suppressed < 0)
         {
 			m_suppressed = 0;
@@ -182,6 +196,8 @@ unsigned int SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVec
 		remaining -= len;
 	}
 
+	m_fillSnapshot.store(m_fill);
+
 	if (m_fill > 0) {
 		emit dataReady();
     }
@@ -216,6 +232,8 @@ unsigned int SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::it
 		remaining -= len;
 	}
 
+	m_fillSnapshot.store(m_fill);
+
 	return total;
 }
 
@@ -279,6 +297,7 @@ unsigned int SampleSinkFifo::readCommit(unsigned int count)
 
     m_head = (m_head + count) % m_size;
 	m_fill -= count;
+	m_fillSnapshot.store(m_fill);
 
 	return count;
 }
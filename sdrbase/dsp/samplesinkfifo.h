@@ -22,6 +22,8 @@
 #include <QObject>
 #include <QMutex>
 #include <QElapsedTimer>
+#include <QAtomicInt>
+#include <QAtomicInteger>
 #include "dsp/dsptypes.h"
 #include "export.h"
 
@@ -39,6 +41,8 @@ private:
 	unsigned int m_fill;
 	unsigned int m_head;
 	unsigned int m_tail;
+	QAtomicInt m_fillSnapshot;                //!< Copy of m_fill readable without the mutex
+	QAtomicInteger<quint64> m_droppedSamples; //!< Cumulated number of samples dropped on overflow
 
 	void create(unsigned int s);
 
@@ -52,6 +56,8 @@ public:
     void reset();
 	inline unsigned int size() const { return m_size; }
 	inline unsigned int fill() { QMutexLocker mutexLocker(&m_mutex); unsigned int fill = m_fill; return fill; }
+	inline unsigned int getFillSnapshot() const { return m_fillSnapshot.load(); } //!< Lock free, may lag by one write or read
+	inline quint64 getDroppedSamples() const { return m_droppedSamples.load(); }   //!< Lock free
 
 	unsigned int write(const quint8* data, unsigned int count);
 	unsigned int write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
@@ -21,7 +21,7 @@
 
 #include "scopevis.h"
 #include "dsp/dspcommands.h"
-#include "gui/glscope.h"
+#include "dsp/glscopeinterface.h"
 
 MESSAGE_CLASS_DEFINITION(ScopeVis::MsgConfigureScopeVisNG, Message)
 MESSAGE_CLASS_DEFINITION(ScopeVis::MsgScopeVisNGAddTrigger, Message)
@@ -36,11 +36,13 @@ MESSAGE_CLASS_DEFINITION(ScopeVis::MsgScopeVisNGMoveTrace, Message)
 MESSAGE_CLASS_DEFINITION(ScopeVis::MsgScopeVisNGFocusOnTrace, Message)
 MESSAGE_CLASS_DEFINITION(ScopeVis::MsgScopeVisNGOneShot, Message)
 MESSAGE_CLASS_DEFINITION(ScopeVis::MsgScopeVisNGMemoryTrace, Message)
+MESSAGE_CLASS_DEFINITION(ScopeVis::MsgConfigureWSScopeOpenClose, Message)
+MESSAGE_CLASS_DEFINITION(ScopeVis::MsgConfigureWSScope, Message)
 
 const uint ScopeVis::m_traceChunkDefaultSize = 4800;
 
 
-ScopeVis::ScopeVis(GLScope* glScope) :
+ScopeVis::ScopeVis(GLScopeInterface* glScope) :
     m_glScope(glScope),
     m_preTriggerDelay(0),
     m_livePreTriggerDelay(0),
@@ -67,7 +69,11 @@ ScopeVis::ScopeVis(GLScope* glScope) :
 {
     setObjectName("ScopeVis");
     m_traceDiscreteMemory.resize(m_traceChunkDefaultSize); // arbitrary
-    m_glScope->setTraces(&m_traces.m_tracesData, &m_traces.m_traces[0]);
+
+    if (m_glScope) {
+        m_glScope->setTraces(&m_traces.m_tracesData, &m_traces.m_traces[0]);
+    }
+
     for (int i = 0; i < (int) Projector::nbProjectionTypes; i++) {
         m_projectorCache[i] = 0.0;
     }
@@ -80,6 +86,40 @@ ScopeVis::~ScopeVis()
     }
 }
 
+void ScopeVis::setGLScope(GLScopeInterface* glScope)
+{
+    QMutexLocker configLocker(&m_mutex);
+    m_glScope = glScope;
+
+    if (m_glScope)
+    {
+        m_glScope->setTraces(&m_traces.m_tracesData, &m_traces.m_traces[0]);
+        m_glScope->setSampleRate(m_sampleRate);
+        m_glScope->setTraceSize(m_traceSize);
+        m_glScope->setTriggerPre(m_preTriggerDelay);
+        m_glScope->setTimeBase(m_timeBase);
+        m_glScope->setTimeOfsProMill(m_timeOfsProMill);
+    }
+}
+
+void ScopeVis::openWSScope()
+{
+    MsgConfigureWSScopeOpenClose *cmd = new MsgConfigureWSScopeOpenClose(true);
+    getInputMessageQueue()->push(cmd);
+}
+
+void ScopeVis::closeWSScope()
+{
+    MsgConfigureWSScopeOpenClose *cmd = new MsgConfigureWSScopeOpenClose(false);
+    getInputMessageQueue()->push(cmd);
+}
+
+void ScopeVis::configureWSScope(const QString& address, uint16_t port)
+{
+    MsgConfigureWSScope* cmd = new MsgConfigureWSScope(address, port);
+    getInputMessageQueue()->push(cmd);
+}
+
 void ScopeVis::setLiveRate(int sampleRate)
 {
     m_liveSampleRate = sampleRate;
@@ -220,6 +260,10 @@ void ScopeVis::feed(const SampleVector::const_iterator& cbegin, const SampleVect
         return;
     }
 
+    if (!m_glScope && !m_wsScope.hasClients()) { // nobody is watching
+        return;
+    }
+
     if (!m_mutex.tryLock(0)) { // prevent conflicts with configuration process
         return;
     }
@@ -606,8 +650,13 @@ int ScopeVis::processTraces(const SampleVector::const_iterator& cbegin, const Sa
 
     float traceTime = ((float) m_traceSize) / m_sampleRate;
 
-    if (traceTime >= 1.0f) { // display continuously if trace time is 1 second or more
-        m_glScope->newTraces(m_traces.m_traces, m_traces.currentBufferIndex(), &m_traces.m_projectionTypes);
+    if (traceTime >= 1.0f) // display continuously if trace time is 1 second or more
+    {
+        if (m_glScope) {
+            m_glScope->newTraces(m_traces.m_traces, m_traces.currentBufferIndex(), &m_traces.m_projectionTypes);
+        }
+
+        newWSTraces();
     }
 
     if (m_nbSamples == 0) // finished
@@ -615,13 +664,15 @@ int ScopeVis::processTraces(const SampleVector::const_iterator& cbegin, const Sa
         // display only at trace end if trace time is less than 1 second
         if (traceTime < 1.0f)
         {
-            if (m_glScope->getProcessingTraceIndex().load() < 0) {
+            if (m_glScope && (m_glScope->getProcessingTraceIndex().load() < 0)) {
                 m_glScope->newTraces(m_traces.m_traces, m_traces.currentBufferIndex(), &m_traces.m_projectionTypes);
             }
+
+            newWSTraces();
         }
 
         // switch to next buffer only if it is not being processed by the scope
-        if (m_glScope->getProcessingTraceIndex().load() != (((int) m_traces.currentBufferIndex() + 1) % 2)) {
+        if (!m_glScope || (m_glScope->getProcessingTraceIndex().load() != (((int) m_traces.currentBufferIndex() + 1) % 2))) {
             m_traces.switchBuffer();
         }
 
@@ -633,6 +684,13 @@ int ScopeVis::processTraces(const SampleVector::const_iterator& cbegin, const Sa
     }
 }
 
+void ScopeVis::newWSTraces()
+{
+    if (m_wsScope.hasClients()) {
+        m_wsScope.newTraces(m_traces.m_traces[m_traces.currentBufferIndex()], m_traces.m_projectionTypes, m_traceSize, m_sampleRate);
+    }
+}
+
 void ScopeVis::start()
 {
 }
@@ -729,7 +787,10 @@ bool ScopeVis::handleMessage(const Message& message)
             if (triggerIndex == m_focusedTriggerIndex)
             {
                 computeDisplayTriggerLevels();
-                m_glScope->setFocusedTriggerData(m_triggerConditions[m_focusedTriggerIndex]->m_triggerData);
+                if (m_glScope) {
+                    m_glScope->setFocusedTriggerData(m_triggerConditions[m_focusedTriggerIndex]->m_triggerData);
+                }
+
                 updateGLScopeDisplay();
             }
         }
@@ -770,7 +831,10 @@ bool ScopeVis::handleMessage(const Message& message)
         m_triggerConditions[triggerIndex] = nextTrigger;
 
         computeDisplayTriggerLevels();
-        m_glScope->setFocusedTriggerData(m_triggerConditions[m_focusedTriggerIndex]->m_triggerData);
+        if (m_glScope) {
+            m_glScope->setFocusedTriggerData(m_triggerConditions[m_focusedTriggerIndex]->m_triggerData);
+        }
+
         updateGLScopeDisplay();
 
         return true;
@@ -785,7 +849,10 @@ bool ScopeVis::handleMessage(const Message& message)
         {
             m_focusedTriggerIndex = triggerIndex;
             computeDisplayTriggerLevels();
-            m_glScope->setFocusedTriggerData(m_triggerConditions[m_focusedTriggerIndex]->m_triggerData);
+            if (m_glScope) {
+                m_glScope->setFocusedTriggerData(m_triggerConditions[m_focusedTriggerIndex]->m_triggerData);
+            }
+
             updateGLScopeDisplay();
         }
 
@@ -850,7 +917,10 @@ bool ScopeVis::handleMessage(const Message& message)
         {
             m_focusedTraceIndex = traceIndex;
             computeDisplayTriggerLevels();
-            m_glScope->setFocusedTraceIndex(m_focusedTraceIndex);
+            if (m_glScope) {
+                m_glScope->setFocusedTraceIndex(m_focusedTraceIndex);
+            }
+
             updateGLScopeDisplay();
         }
 
@@ -896,6 +966,18 @@ bool ScopeVis::handleMessage(const Message& message)
         }
         return true;
     }
+    else if (MsgConfigureWSScopeOpenClose::match(message))
+    {
+        MsgConfigureWSScopeOpenClose& conf = (MsgConfigureWSScopeOpenClose&) message;
+        handleWSOpenClose(conf.getOpenClose());
+        return true;
+    }
+    else if (MsgConfigureWSScope::match(message))
+    {
+        MsgConfigureWSScope& conf = (MsgConfigureWSScope&) message;
+        handleConfigureWSScope(conf.getAddress(), conf.getPort());
+        return true;
+    }
     else
     {
         qDebug() << "ScopeVis::handleMessage" << message.getIdentifier() << " not handled";
@@ -1013,6 +1095,10 @@ void ScopeVis::computeDisplayTriggerLevels()
 
 void ScopeVis::updateGLScopeDisplay()
 {
+    if (!m_glScope) {
+        return;
+    }
+
     if (m_currentTraceMemoryIndex > 0) {
         m_glScope->setConfigChanged();
         processMemoryTrace();
@@ -1020,3 +1106,33 @@ void ScopeVis::updateGLScopeDisplay()
         m_glScope->updateDisplay();
     }
 }
+
+void ScopeVis::handleWSOpenClose(bool openClose)
+{
+    QMutexLocker configLocker(&m_mutex);
+
+    if (openClose) {
+        m_wsScope.openSocket();
+    } else {
+        m_wsScope.closeSocket();
+    }
+}
+
+void ScopeVis::handleConfigureWSScope(const QString& address, uint16_t port)
+{
+    QMutexLocker configLocker(&m_mutex);
+    bool wsScopeWasOpen = false;
+
+    if (m_wsScope.socketOpened())
+    {
+        m_wsScope.closeSocket();
+        wsScopeWasOpen = true;
+    }
+
+    m_wsScope.setListeningAddress(address);
+    m_wsScope.setPort(port);
+
+    if (wsScopeWasOpen) {
+        m_wsScope.openSocket();
+    }
+}
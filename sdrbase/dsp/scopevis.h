@@ -36,13 +36,14 @@
 #include "export.h"
 #include "util/message.h"
 #include "util/doublebuffer.h"
+#include "websockets/wsscope.h"
 
 #undef M_PI
 #define M_PI		3.14159265358979323846
 
-class GLScope;
+class GLScopeInterface;
 
-class SDRGUI_API ScopeVis : public BasebandSampleSink {
+class SDRBASE_API ScopeVis : public BasebandSampleSink {
 
 public:
     struct TraceData
@@ -152,9 +153,13 @@ public:
     static const uint32_t m_maxNbTraces = 10;
     static const uint32_t m_nbTraceMemories = 50;
 
-    ScopeVis(GLScope* glScope = 0);
+    ScopeVis(GLScopeInterface* glScope = nullptr);
     virtual ~ScopeVis();
 
+    void setGLScope(GLScopeInterface* glScope);
+    void openWSScope();
+    void closeWSScope();
+    void configureWSScope(const QString& address, uint16_t port);
     void setLiveRate(int sampleRate);
     void configure(uint32_t traceSize, uint32_t timeBase, uint32_t timeOfsProMill, uint32_t triggerPre, bool freeRun);
     void addTrace(const TraceData& traceData);
@@ -1129,7 +1134,43 @@ private:
         bool m_reset;
     };
 
-    GLScope* m_glScope;
+    class MsgConfigureWSScopeOpenClose : public Message
+    {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        MsgConfigureWSScopeOpenClose(bool openClose) :
+            Message(),
+            m_openClose(openClose)
+        {}
+
+        bool getOpenClose() const { return m_openClose; }
+
+    private:
+        bool m_openClose;
+    };
+
+    class MsgConfigureWSScope : public Message
+    {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        MsgConfigureWSScope(const QString& address, uint16_t port) :
+            Message(),
+            m_address(address),
+            m_port(port)
+        {}
+
+        const QString& getAddress() const { return m_address; }
+        uint16_t getPort() const { return m_port; }
+
+    private:
+        QString m_address;
+        uint16_t m_port;
+    };
+
+    GLScopeInterface* m_glScope;
+    WSScope m_wsScope;                             //!< Remote scope traces streaming
     uint32_t m_preTriggerDelay;                    //!< Pre-trigger delay in number of samples
     uint32_t m_livePreTriggerDelay;                //!< Pre-trigger delay in number of samples in live mode
     std::vector<TriggerCondition*> m_triggerConditions; //!< Chain of triggers
@@ -1208,6 +1249,14 @@ private:
      */
     void updateGLScopeDisplay();
 
+    /**
+     * Send the current traces to the websocket clients if any
+     */
+    void newWSTraces();
+
+    void handleWSOpenClose(bool openClose);
+    void handleConfigureWSScope(const QString& address, uint16_t port);
+
     /**
      * Set the actual sample rate
      */
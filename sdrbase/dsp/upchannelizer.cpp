@@ -99,16 +99,47 @@ void UpChannelizer::pull(SampleVector::iterator begin, unsigned int nbSamples)
     {
         m_sampleSource->pull(begin, nbSamples);
     }
-    else
+    else if (nbSamples > 0)
     {
-        std::for_each(
-            begin,
-            begin + nbSamples,
-            [this](Sample& s) {
-                pullOne(s);
-            }
-        );
+        if (m_stageBuffers.size() != log2Interp) {
+            m_stageBuffers.resize(log2Interp);
+        }
+
+        pullStage(0, &(*begin), nbSamples); // directly into the destination (FIFO) region
+    }
+}
+
+/**
+ * Produce a block of nbSamples samples at the output of stage stageIndex. The block of input samples
+ * it consumes is pulled from the next stage or from the source for the last stage. The same way as
+ * pullOne() each stage keeps the input sample it will consume next (m_stageSamples[stageIndex + 1]
+ * or m_sampleIn for the last stage) so that both methods can be mixed.
+ */
+void UpChannelizer::pullStage(unsigned int stageIndex, Sample *samples, unsigned int nbSamples)
+{
+    FilterStage *stage = m_filterStages[stageIndex];
+    bool lastStage = stageIndex == m_filterStages.size() - 1;
+    Sample& nextSample = lastStage ? m_sampleIn : m_stageSamples[stageIndex + 1];
+    SampleVector& stageBuffer = m_stageBuffers[stageIndex];
+    int nbIn = stage->getInputCount(nbSamples);
+
+    if (stageBuffer.size() < (unsigned int) nbIn + 1) {
+        stageBuffer.resize(nbIn + 1);
     }
+
+    stageBuffer[0] = nextSample;
+
+    if (nbIn > 0)
+    {
+        if (lastStage) {
+            m_sampleSource->pull(stageBuffer.begin() + 1, nbIn);
+        } else {
+            pullStage(stageIndex + 1, &stageBuffer[1], nbIn);
+        }
+    }
+
+    stage->workBlock(stageBuffer.data(), samples, nbSamples);
+    nextSample = stageBuffer[nbIn];
 }
 
 void UpChannelizer::prefetch(unsigned int nbSamples)
@@ -195,38 +226,46 @@ void UpChannelizer::applyInterpolation()
 #ifdef USE_SSE4_1
 UpChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>),
-    m_workFunction(0)
+    m_workFunction(0),
+    m_workBlockFunction(0)
 {
     switch(mode) {
         case ModeCenter:
             m_workFunction = &IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateCenter;
+            m_workBlockFunction = &IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateCenterBlock;
             break;
 
         case ModeLowerHalf:
             m_workFunction = &IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateLowerHalf;
+            m_workBlockFunction = &IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateLowerHalfBlock;
             break;
 
         case ModeUpperHalf:
             m_workFunction = &IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateUpperHalf;
+            m_workBlockFunction = &IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateUpperHalfBlock;
             break;
     }
 }
 #else
 UpChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>),
-    m_workFunction(0)
+    m_workFunction(0),
+    m_workBlockFunction(0)
 {
     switch(mode) {
         case ModeCenter:
             m_workFunction = &IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateCenter;
+            m_workBlockFunction = &IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateCenterBlock;
             break;
 
         case ModeLowerHalf:
             m_workFunction = &IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateLowerHalf;
+            m_workBlockFunction = &IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateLowerHalfBlock;
             break;
 
         case ModeUpperHalf:
             m_workFunction = &IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateUpperHalf;
+            m_workBlockFunction = &IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>::workInterpolateUpperHalfBlock;
             break;
     }
 }
@@ -353,6 +392,7 @@ void UpChannelizer::freeFilterChain()
         delete *it;
     m_filterStages.clear();
     m_stageSamples.clear();
+    m_stageBuffers.clear();
 }
 
 
@@ -60,12 +60,15 @@ protected:
 
 #ifdef USE_SSE4_1
         typedef bool (IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* sIn, Sample *sOut);
+        typedef int (IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>::*WorkBlockFunction)(Sample* sIn, Sample *sOut, int nbOut);
         IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>* m_filter;
 #else
         typedef bool (IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* sIn, Sample *sOut);
+        typedef int (IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>::*WorkBlockFunction)(Sample* sIn, Sample *sOut, int nbOut);
         IntHalfbandFilterDB<qint32, UPCHANNELIZER_HB_FILTER_ORDER>* m_filter;
 #endif
         WorkFunction m_workFunction;
+        WorkBlockFunction m_workBlockFunction;
 
         FilterStage(Mode mode);
         ~FilterStage();
@@ -73,12 +76,21 @@ protected:
         bool work(Sample* sampleIn, Sample *sampleOut) {
             return (m_filter->*m_workFunction)(sampleIn, sampleOut);
         }
+
+        int workBlock(Sample* samplesIn, Sample *samplesOut, int nbOut) {
+            return (m_filter->*m_workBlockFunction)(samplesIn, samplesOut, nbOut);
+        }
+
+        int getInputCount(int nbOut) const {
+            return m_filter->getInterpolateInputCount(nbOut);
+        }
     };
 
     typedef std::vector<FilterStage*> FilterStages;
     FilterStages m_filterStages;
     bool m_filterChainSetMode;
     std::vector<Sample> m_stageSamples;
+    std::vector<SampleVector> m_stageBuffers; //!< input blocks of each stage for block processing
     ChannelSampleSource* m_sampleSource; //!< Modulator
     int m_basebandSampleRate;
     int m_requestedInputSampleRate;
@@ -90,6 +102,7 @@ protected:
     SampleVector m_sampleBuffer;
     Sample m_sampleIn;
 
+    void pullStage(unsigned int stageIndex, Sample *samples, unsigned int nbSamples);
     void applyChannelization();
     void applyInterpolation();
     bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
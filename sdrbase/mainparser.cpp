@@ -31,15 +31,26 @@ MainParser::MainParser() :
         "Web API server port.",
         "port",
         "8091"),
+    m_wsReportsPortOption(QStringList() << "wsreports-port",
+        "Websocket reports server port.",
+        "port",
+        "8885"),
     m_fftwfWisdomOption(QStringList() << "w" << "fftwf-wisdom",
         "FFTW Wisdom file.",
         "file",
-        "")
+        ""),
+    m_enumerationCacheOption(QStringList() << "enum-cache",
+        "Reuse the results of slow device enumerations of the previous start until plugins or USB devices change."),
+    m_asyncLogOption(QStringList() << "async-log",
+        "Write log messages from a background thread. Messages may be dropped under pressure.")
 {
     m_serverAddress = "127.0.0.1";
     m_serverPort = 8091;
+    m_wsReportsPort = 8885;
     m_mimoSupport = false;
     m_fftwfWindowFileName = "";
+    m_enumerationCache = false;
+    m_asyncLog = false;
 
     m_parser.setApplicationDescription("Software Defined Radio application");
     m_parser.addHelpOption();
@@ -47,7 +58,10 @@ MainParser::MainParser() :
 
     m_parser.addOption(m_serverAddressOption);
     m_parser.addOption(m_serverPortOption);
+    m_parser.addOption(m_wsReportsPortOption);
     m_parser.addOption(m_fftwfWisdomOption);
+    m_parser.addOption(m_enumerationCacheOption);
+    m_parser.addOption(m_asyncLogOption);
 }
 
 MainParser::~MainParser()
@@ -88,10 +102,29 @@ void MainParser::parse(const QCoreApplication& app)
         qWarning() << "MainParser::parse: server port invalid. Defaulting to " << m_serverPort;
     }
 
+    // websocket reports server port
+
+    QString wsReportsPortStr = m_parser.value(m_wsReportsPortOption);
+    int wsReportsPort = wsReportsPortStr.toInt(&ok);
+
+    if (ok && (wsReportsPort > 1023) && (wsReportsPort < 65536)) {
+        m_wsReportsPort = wsReportsPort;
+    } else {
+        qWarning() << "MainParser::parse: websocket reports server port invalid. Defaulting to " << m_wsReportsPort;
+    }
+
     // FFTWF wisdom file
 
     m_fftwfWindowFileName = m_parser.value(m_fftwfWisdomOption);
 
+    // device enumeration cache
+
+    m_enumerationCache = m_parser.isSet(m_enumerationCacheOption);
+
+    // asynchronous logging
+
+    m_asyncLog = m_parser.isSet(m_asyncLogOption);
+
     // MIMO - from version
 
     QStringList versionParts = app.applicationVersion().split(".");
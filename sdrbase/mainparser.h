@@ -34,19 +34,28 @@ public:
 
     const QString& getServerAddress() const { return m_serverAddress; }
     uint16_t getServerPort() const { return m_serverPort; }
+    uint16_t getWSReportsPort() const { return m_wsReportsPort; }
     bool getMIMOSupport() const { return m_mimoSupport; }
     const QString& getFFTWFWisdomFileName() const { return m_fftwfWindowFileName; }
+    bool getEnumerationCache() const { return m_enumerationCache; }
+    bool getAsyncLog() const { return m_asyncLog; }
 
 private:
     QString  m_serverAddress;
     uint16_t m_serverPort;
+    uint16_t m_wsReportsPort;
     QString  m_fftwfWindowFileName;
     bool m_mimoSupport; //!< obtained from major version
+    bool m_enumerationCache;
+    bool m_asyncLog;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_serverAddressOption;
     QCommandLineOption m_serverPortOption;
+    QCommandLineOption m_wsReportsPortOption;
     QCommandLineOption m_fftwfWisdomOption;
+    QCommandLineOption m_enumerationCacheOption;
+    QCommandLineOption m_asyncLogOption;
 };
 
 
@@ -203,6 +203,19 @@ public:
         (void) originDevices;
     }
 
+    // false if the enumeration relies on a library shared with other plugins that is not thread safe.
+    // Such plugins are enumerated one after the other but still concurrently with the other plugins.
+    virtual bool isEnumerationThreadSafe() const {
+        return true;
+    }
+
+    // false if the enumeration builds a scan state the plugin relies on to open the devices later
+    // (e.g. a device library scan) or looks for devices over the network. The device enumeration
+    // cache is then never used and such hardware is enumerated at every start.
+    virtual bool isEnumerationCacheable() const {
+        return true;
+    }
+
     virtual SamplingDevice::SamplingDeviceType getSamplingDeviceType() const {
         return SamplingDevice::SamplingDeviceType::PhysicalDevice;
     }
@@ -17,6 +17,10 @@
 
 #include <QCoreApplication>
 #include <QPluginLoader>
+#include <QElapsedTimer>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QDateTime>
 #include <QDebug>
 
 #include <cstdio>
@@ -47,7 +51,8 @@ const QString PluginManager::m_fileOutputDeviceTypeID = "sdrangel.samplesink.fil
 
 PluginManager::PluginManager(QObject* parent) :
 	QObject(parent),
-    m_pluginAPI(this)
+    m_pluginAPI(this),
+    m_enumerationCache(false)
 {
 }
 
@@ -64,6 +69,8 @@ void PluginManager::loadPlugins(const QString& pluginsSubDir)
 
 void PluginManager::loadPluginsPart(const QString& pluginsSubDir)
 {
+    QElapsedTimer timer;
+    timer.start();
     QString applicationDirPath = QCoreApplication::instance()->applicationDirPath();
     QStringList PluginsPath;
 
@@ -91,6 +98,7 @@ void PluginManager::loadPluginsPart(const QString& pluginsSubDir)
 
         found = true;
         loadPluginsDir(d);
+        qInfo("PluginManager::loadPluginsPart: loaded %d plugins from %s in %lld ms", m_plugins.size(), qPrintable(dir), timer.elapsed());
         break;
     }
 
@@ -103,6 +111,8 @@ void PluginManager::loadPluginsPart(const QString& pluginsSubDir)
 
 void PluginManager::loadPluginsFinal()
 {
+    QElapsedTimer timer;
+    timer.start();
     std::sort(m_plugins.begin(), m_plugins.end());
 
     for (Plugins::const_iterator it = m_plugins.begin(); it != m_plugins.end(); ++it)
@@ -110,9 +120,14 @@ void PluginManager::loadPluginsFinal()
         it->pluginInterface->initPlugin(&m_pluginAPI);
     }
 
+    qint64 initMs = timer.restart();
+    DeviceEnumerator::instance()->enumerateOriginDevices(this, m_enumerationCache);
+    qint64 originMs = timer.restart();
     DeviceEnumerator::instance()->enumerateRxDevices(this);
     DeviceEnumerator::instance()->enumerateTxDevices(this);
     DeviceEnumerator::instance()->enumerateMIMODevices(this);
+    qInfo("PluginManager::loadPluginsFinal: init plugins %lld ms, enumerate hardware %lld ms, enumerate devices %lld ms",
+        initMs, originMs, timer.elapsed());
 }
 
 void PluginManager::loadPluginsNonDiscoverable(const DeviceUserArgs& deviceUserArgs)
@@ -192,6 +207,8 @@ void PluginManager::registerSampleMIMO(const QString& mimoName, PluginInterface*
 void PluginManager::loadPluginsDir(const QDir& dir)
 {
     QDir pluginsDir(dir);
+    QCryptographicHash fingerprint(QCryptographicHash::Sha1);
+    fingerprint.addData(QCoreApplication::applicationVersion().toUtf8());
 
     foreach (QString fileName, pluginsDir.entryList(QDir::Files))
     {
@@ -219,8 +236,14 @@ void PluginManager::loadPluginsDir(const QDir& dir)
 
             qInfo("PluginManager::loadPluginsDir: loaded plugin %s", qPrintable(fileName));
             m_plugins.append(Plugin(fileName, instance));
+            QFileInfo fileInfo(pluginsDir.absoluteFilePath(fileName));
+            fingerprint.addData(fileName.toUtf8());
+            fingerprint.addData(QByteArray::number(fileInfo.size()));
+            fingerprint.addData(QByteArray::number(fileInfo.lastModified().toMSecsSinceEpoch()));
        }
     }
+
+    m_pluginsFingerprint = fingerprint.result();
 }
 
 void PluginManager::listTxChannels(QList<QString>& list)
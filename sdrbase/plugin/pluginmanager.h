@@ -23,6 +23,7 @@
 #include <QDir>
 #include <QList>
 #include <QString>
+#include <QByteArray>
 
 #include "plugin/plugininterface.h"
 #include "plugin/pluginapi.h"
@@ -57,6 +58,8 @@ public:
 	~PluginManager();
 
 	PluginAPI *getPluginAPI() { return &m_pluginAPI; }
+	void setEnumerationCache(bool enumerationCache) { m_enumerationCache = enumerationCache; } //!< to be set before loading the plugins
+	const QByteArray& getPluginsFingerprint() const { return m_pluginsFingerprint; } //!< plugin files loaded
 	void loadPlugins(const QString& pluginsSubDir);
 	void loadPluginsPart(const QString& pluginsSubDir);
 	void loadPluginsFinal();
@@ -121,6 +124,8 @@ private:
 
 	PluginAPI m_pluginAPI;
 	Plugins m_plugins;
+	QByteArray m_pluginsFingerprint;
+	bool m_enumerationCache;
 
 	PluginAPI::ChannelRegistrations m_rxChannelRegistrations;           //!< Channel plugins register here
 	PluginAPI::ChannelRegistrations m_txChannelRegistrations;           //!< Channel plugins register here
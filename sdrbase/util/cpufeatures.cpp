@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+#include "cpufeatures.h"
+
+CPUFeatures::Flags::Flags() :
+    m_sse41(false),
+    m_avx2(false),
+    m_avx512f(false)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    m_sse41 = __builtin_cpu_supports("sse4.1");
+    m_avx2 = __builtin_cpu_supports("avx2");
+    m_avx512f = __builtin_cpu_supports("avx512f");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int regs[4];
+    __cpuid(regs, 0);
+    int maxLeaf = regs[0];
+
+    if (maxLeaf < 1) {
+        return;
+    }
+
+    __cpuid(regs, 1);
+    m_sse41 = (regs[2] & (1<<19)) != 0;
+    bool osxsave = (regs[2] & (1<<27)) != 0;
+
+    if (!osxsave || (maxLeaf < 7)) {
+        return;
+    }
+
+    unsigned long long xcr0 = _xgetbv(0);
+    bool osYmm = (xcr0 & 0x06) == 0x06;  // SSE and AVX state
+    bool osZmm = (xcr0 & 0xE6) == 0xE6;  // idem plus opmask and upper ZMM state
+    __cpuidex(regs, 7, 0);
+    m_avx2 = osYmm && ((regs[1] & (1<<5)) != 0);
+    m_avx512f = osZmm && ((regs[1] & (1<<16)) != 0);
+#endif
+}
+
+const CPUFeatures::Flags& CPUFeatures::getFlags()
+{
+    static const Flags flags;
+    return flags;
+}
+
+bool CPUFeatures::hasSSE41()
+{
+    return getFlags().m_sse41;
+}
+
+bool CPUFeatures::hasAVX2()
+{
+    return getFlags().m_avx2;
+}
+
+bool CPUFeatures::hasAVX512F()
+{
+    return getFlags().m_avx512f;
+}
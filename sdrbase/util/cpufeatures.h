@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_CPUFEATURES_H_
+#define SDRBASE_UTIL_CPUFEATURES_H_
+
+#include "export.h"
+
+/**
+ * Instruction set extensions of the CPU running the program as opposed to the USE_xxx
+ * definitions that tell what the program was compiled for. This is what kernels compiled
+ * for several instruction sets use to select the best one at run time.
+ * AVX extensions are only reported when the OS saves the wide registers.
+ */
+class SDRBASE_API CPUFeatures
+{
+public:
+    static bool hasSSE41();
+    static bool hasAVX2();
+    static bool hasAVX512F();
+
+private:
+    struct Flags
+    {
+        bool m_sse41;
+        bool m_avx2;
+        bool m_avx512f;
+        Flags();
+    };
+
+    static const Flags& getFlags();
+};
+
+#endif // SDRBASE_UTIL_CPUFEATURES_H_
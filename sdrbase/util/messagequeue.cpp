@@ -23,8 +23,9 @@
 
 MessageQueue::MessageQueue(QObject* parent) :
 	QObject(parent),
-	m_lock(QMutex::Recursive),
-	m_queue()
+	m_head(&m_stub),
+	m_tail(&m_stub),
+	m_size(0)
 {
 }
 
@@ -39,13 +40,21 @@ MessageQueue::~MessageQueue()
 	}
 }
 
+void MessageQueue::link(Message* message)
+{
+	message->m_next.store(nullptr);
+	Message* previous = m_head.fetchAndStoreOrdered(message);
+	// The queue is not connected between the exchange and this store. The consumer sees
+	// it as empty in between and gets the message on the next signal.
+	previous->m_next.storeRelease(message);
+}
+
 void MessageQueue::push(Message* message, bool emitSignal)
 {
 	if (message)
 	{
-		m_lock.lock();
-		m_queue.append(message);
-		m_lock.unlock();
+		m_size.fetchAndAddRelaxed(1);
+		link(message);
 	}
 
 	if (emitSignal)
@@ -56,30 +65,50 @@ void MessageQueue::push(Message* message, bool emitSignal)
 
 Message* MessageQueue::pop()
 {
-	QMutexLocker locker(&m_lock);
+	QMutexLocker locker(&m_popLock);
+	Message* tail = m_tail;
+	Message* next = tail->m_next.loadAcquire();
 
-	if (m_queue.isEmpty())
+	if (tail == &m_stub) // skip the stub
 	{
-		return 0;
+		if (!next) {
+			return 0;
+		}
+
+		m_tail = next;
+		tail = next;
+		next = next->m_next.loadAcquire();
 	}
-	else
+
+	if (!next) // tail is the last linked message
 	{
-		return m_queue.takeFirst();
+		if (tail != m_head.loadAcquire()) {
+			return 0; // a producer is linking after tail
+		}
+
+		link(&m_stub); // re-insert the stub so that tail can be detached
+		next = tail->m_next.loadAcquire();
+
+		if (!next) {
+			return 0; // another producer pushed in between and is still linking
+		}
 	}
+
+	m_tail = next;
+	m_size.fetchAndSubRelaxed(1);
+	return tail;
 }
 
 int MessageQueue::size()
 {
-	QMutexLocker locker(&m_lock);
-
-	return m_queue.size();
+	return m_size.loadAcquire();
 }
 
 void MessageQueue::clear()
 {
-	QMutexLocker locker(&m_lock);
+	Message* message;
 
-    while (!m_queue.isEmpty()) {
-        delete m_queue.takeFirst();
-    }
+	while ((message = pop()) != 0) {
+		delete message;
+	}
 }
@@ -20,12 +20,18 @@
 #define INCLUDE_MESSAGEQUEUE_H
 
 #include <QObject>
-#include <QQueue>
 #include <QMutex>
+#include <QAtomicPointer>
+#include <QAtomicInt>
 #include "export.h"
-
-class Message;
-
+#include "util/message.h"
+
+/**
+ * Multiple producers single consumer queue of messages. Messages are linked through their
+ * own m_next field (intrusive MPSC queue after D. Vyukov) so pushing is wait-free and does not
+ * allocate. Popping is meant to be done by the thread owning the queue. It is still serialized
+ * by a lock that producers never take so that occasional pops from other threads stay safe.
+ */
 class SDRBASE_API MessageQueue : public QObject {
 	Q_OBJECT
 
@@ -36,15 +42,20 @@ public:
 	void push(Message* message, bool emitSignal = true);  //!< Push message onto queue
 	Message* pop(); //!< Pop message from queue
 
-	int size(); //!< Returns queue size
+	int size(); //!< Returns queue size (approximate while producers are pushing)
 	void clear(); //!< Empty queue
 
 signals:
 	void messageEnqueued();
 
 private:
-	QMutex m_lock;
-	QQueue<Message*> m_queue;
+	QAtomicPointer<Message> m_head; //!< last pushed message (producers side)
+	Message* m_tail;                //!< next message to pop (consumer side)
+	Message m_stub;                 //!< keeps the queue never empty of nodes
+	QMutex m_popLock;
+	QAtomicInt m_size;
+
+	void link(Message* message);
 };
 
 #endif // INCLUDE_MESSAGEQUEUE_H
@@ -18,11 +18,13 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include "plugin/pluginmanager.h"
+#include "channel/channelapi.h"
 #include "channel/channelwebapiadapter.h"
 #include "channel/channelutils.h"
 #include "device/devicewebapiadapter.h"
 #include "device/deviceutils.h"
 #include "dsp/glspectrumsettings.h"
+#include "dsp/basebandsamplesource.h"
 #include "webapiadapterbase.h"
 
 WebAPIAdapterBase::WebAPIAdapterBase()
@@ -418,6 +420,33 @@ void WebAPIAdapterBase::webapiUpdateCommand(
     }
 }
 
+void WebAPIAdapterBase::webapiFormatChannelMixGain(
+        SWGSDRangel::SWGChannelSettings *apiChannelSettings,
+        ChannelAPI *channelAPI
+)
+{
+    BasebandSampleSource *source = dynamic_cast<BasebandSampleSource*>(channelAPI);
+
+    if (source) { // Tx channels only
+        apiChannelSettings->setMixGain(source->getMixGain());
+    }
+}
+
+void WebAPIAdapterBase::webapiUpdateChannelMixGain(
+        SWGSDRangel::SWGChannelSettings *apiChannelSettings,
+        const QStringList& channelSettingsKeys,
+        ChannelAPI *channelAPI
+)
+{
+    BasebandSampleSource *source = dynamic_cast<BasebandSampleSource*>(channelAPI);
+
+    if (source && channelSettingsKeys.contains("mixGain"))
+    {
+        float mixGain = apiChannelSettings->getMixGain();
+        source->setMixGain(mixGain < 0.0f ? 0.0f : mixGain > 10.0f ? 10.0f : mixGain);
+    }
+}
+
 ChannelWebAPIAdapter *WebAPIAdapterBase::WebAPIChannelAdapters::getChannelWebAPIAdapter(const QString& channelURI, const PluginManager *pluginManager)
 {
     QString registeredChannelURI = ChannelUtils::getRegisteredChannelURI(channelURI);
@@ -25,6 +25,7 @@
 #include "SWGPreferences.h"
 #include "SWGPreset.h"
 #include "SWGCommand.h"
+#include "SWGChannelSettings.h"
 #include "settings/preferences.h"
 #include "settings/preset.h"
 #include "settings/mainsettings.h"
@@ -32,6 +33,7 @@
 #include "webapiadapterinterface.h"
 
 class PluginManager;
+class ChannelAPI;
 class ChannelWebAPIAdapter;
 class DeviceWebAPIAdapter;
 
@@ -77,6 +79,15 @@ public:
         const WebAPIAdapterInterface::CommandKeys& commandKeys,
         Command& command
     );
+    static void webapiFormatChannelMixGain(
+        SWGSDRangel::SWGChannelSettings *apiChannelSettings,
+        ChannelAPI *channelAPI
+    );
+    static void webapiUpdateChannelMixGain(
+        SWGSDRangel::SWGChannelSettings *apiChannelSettings,
+        const QStringList& channelSettingsKeys,
+        ChannelAPI *channelAPI
+    );
 
 private:
     class WebAPIChannelAdapters
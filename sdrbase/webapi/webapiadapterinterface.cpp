@@ -41,21 +41,24 @@ QString WebAPIAdapterInterface::instancePresetURL = "/sdrangel/preset";
 QString WebAPIAdapterInterface::instancePresetFileURL = "/sdrangel/preset/file";
 QString WebAPIAdapterInterface::instanceDeviceSetsURL = "/sdrangel/devicesets";
 QString WebAPIAdapterInterface::instanceDeviceSetURL = "/sdrangel/deviceset";
+QString WebAPIAdapterInterface::instanceMetricsURL = "/sdrangel/metrics";
+QString WebAPIAdapterInterface::instanceSettingsBatchURL = "/sdrangel/settings/batch";
 
-std::regex WebAPIAdapterInterface::devicesetURLRe("^/sdrangel/deviceset/([0-9]{1,2})$");
-std::regex WebAPIAdapterInterface::devicesetFocusURLRe("^/sdrangel/deviceset/([0-9]{1,2})/focus$");
-std::regex WebAPIAdapterInterface::devicesetDeviceURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device$");
-std::regex WebAPIAdapterInterface::devicesetDeviceSettingsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/settings$");
-std::regex WebAPIAdapterInterface::devicesetDeviceRunURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/run$");
-std::regex WebAPIAdapterInterface::devicesetDeviceSubsystemRunURLRe("^/sdrangel/deviceset/([0-9]{1,2})/subdevice/([0-9]{1,2})/run$");
-std::regex WebAPIAdapterInterface::devicesetDeviceReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/report$");
-std::regex WebAPIAdapterInterface::devicesetDeviceActionsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/actions$");
-std::regex WebAPIAdapterInterface::devicesetChannelsReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channels/report$");
-std::regex WebAPIAdapterInterface::devicesetChannelURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel$");
-std::regex WebAPIAdapterInterface::devicesetChannelIndexURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})$");
-std::regex WebAPIAdapterInterface::devicesetChannelSettingsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})/settings$");
-std::regex WebAPIAdapterInterface::devicesetChannelReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})/report");
-std::regex WebAPIAdapterInterface::devicesetChannelActionsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})/actions");
+QString WebAPIAdapterInterface::devicesetURLRoute = "/sdrangel/deviceset/{int}";
+QString WebAPIAdapterInterface::devicesetFocusURLRoute = "/sdrangel/deviceset/{int}/focus";
+QString WebAPIAdapterInterface::devicesetDeviceURLRoute = "/sdrangel/deviceset/{int}/device";
+QString WebAPIAdapterInterface::devicesetDeviceSettingsURLRoute = "/sdrangel/deviceset/{int}/device/settings";
+QString WebAPIAdapterInterface::devicesetDeviceRunURLRoute = "/sdrangel/deviceset/{int}/device/run";
+QString WebAPIAdapterInterface::devicesetDeviceSubsystemRunURLRoute = "/sdrangel/deviceset/{int}/subdevice/{int}/run";
+QString WebAPIAdapterInterface::devicesetDeviceReportURLRoute = "/sdrangel/deviceset/{int}/device/report";
+QString WebAPIAdapterInterface::devicesetDeviceActionsURLRoute = "/sdrangel/deviceset/{int}/device/actions";
+QString WebAPIAdapterInterface::devicesetChannelsReportURLRoute = "/sdrangel/deviceset/{int}/channels/report";
+QString WebAPIAdapterInterface::devicesetChannelURLRoute = "/sdrangel/deviceset/{int}/channel";
+QString WebAPIAdapterInterface::devicesetChannelIndexURLRoute = "/sdrangel/deviceset/{int}/channel/{int}";
+QString WebAPIAdapterInterface::devicesetChannelSettingsURLRoute = "/sdrangel/deviceset/{int}/channel/{int}/settings";
+QString WebAPIAdapterInterface::devicesetChannelReportURLRoute = "/sdrangel/deviceset/{int}/channel/{int}/report";
+QString WebAPIAdapterInterface::devicesetChannelActionsURLRoute = "/sdrangel/deviceset/{int}/channel/{int}/actions";
+QString WebAPIAdapterInterface::devicesetChannelScopeServerURLRoute = "/sdrangel/deviceset/{int}/channel/{int}/scope/server";
 
 void WebAPIAdapterInterface::ConfigKeys::debug() const
 {
@@ -22,12 +22,13 @@
 
 #include <QString>
 #include <QStringList>
-#include <regex>
 
 #include "SWGErrorResponse.h"
 
 #include "export.h"
 
+class WebAPIMetrics;
+
 namespace SWGSDRangel
 {
     class SWGInstanceSummaryResponse;
@@ -61,6 +62,7 @@ namespace SWGSDRangel
     class SWGChannelSettings;
     class SWGChannelReport;
     class SWGChannelActions;
+    class SWGScopeServer;
     class SWGSuccessResponse;
 }
 
@@ -628,6 +630,20 @@ public:
     	return 501;
     }
 
+    /**
+     * Handler of /sdrangel/metrics (GET)
+     * collects the bulk metrics of all device sets and channels (default 501: not implemented)
+     */
+    virtual int instanceMetricsGet(
+            WebAPIMetrics& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) response;
+    	error.init();
+    	*error.getMessage() = QString("Function not implemented");
+    	return 501;
+    }
+
     /**
      * Handler of /sdrangel/deviceset (POST) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
      * returns the Http status code (default 501: not implemented)
@@ -1017,6 +1033,44 @@ public:
         return 501;
     }
 
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/channel/{channelIndex}/scope/server (PUT)
+     * configures and opens the websocket scope server of the channel (default 501: not implemented)
+     */
+    virtual int devicesetChannelScopeServerPut(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGScopeServer& query,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) channelIndex;
+        (void) query;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/channel/{channelIndex}/scope/server (DELETE)
+     * closes the websocket scope server of the channel (default 501: not implemented)
+     */
+    virtual int devicesetChannelScopeServerDelete(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) channelIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     static QString instanceSummaryURL;
     static QString instanceConfigURL;
     static QString instanceDevicesURL;
@@ -1039,20 +1093,23 @@ public:
     static QString instancePresetFileURL;
     static QString instanceDeviceSetsURL;
     static QString instanceDeviceSetURL;
-    static std::regex devicesetURLRe;
-    static std::regex devicesetFocusURLRe;
-    static std::regex devicesetDeviceURLRe;
-    static std::regex devicesetDeviceSettingsURLRe;
-    static std::regex devicesetDeviceRunURLRe;
-    static std::regex devicesetDeviceSubsystemRunURLRe;
-    static std::regex devicesetDeviceReportURLRe;
-    static std::regex devicesetDeviceActionsURLRe;
-    static std::regex devicesetChannelURLRe;
-    static std::regex devicesetChannelIndexURLRe;
-    static std::regex devicesetChannelSettingsURLRe;
-    static std::regex devicesetChannelReportURLRe;
-    static std::regex devicesetChannelActionsURLRe;
-    static std::regex devicesetChannelsReportURLRe;
+    static QString instanceMetricsURL;
+    static QString instanceSettingsBatchURL;
+    static QString devicesetURLRoute;
+    static QString devicesetFocusURLRoute;
+    static QString devicesetDeviceURLRoute;
+    static QString devicesetDeviceSettingsURLRoute;
+    static QString devicesetDeviceRunURLRoute;
+    static QString devicesetDeviceSubsystemRunURLRoute;
+    static QString devicesetDeviceReportURLRoute;
+    static QString devicesetDeviceActionsURLRoute;
+    static QString devicesetChannelURLRoute;
+    static QString devicesetChannelIndexURLRoute;
+    static QString devicesetChannelSettingsURLRoute;
+    static QString devicesetChannelReportURLRoute;
+    static QString devicesetChannelActionsURLRoute;
+    static QString devicesetChannelScopeServerURLRoute;
+    static QString devicesetChannelsReportURLRoute;
 };
 
 
@@ -0,0 +1,452 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Swagger server bulk metrics                                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include "device/deviceapi.h"
+#include "dsp/devicesamplesource.h"
+#include "dsp/devicesamplesink.h"
+#include "dsp/devicesamplemimo.h"
+#include "dsp/samplesinkfifo.h"
+#include "dsp/devicecallbackstats.h"
+
+#include "webapimetrics.h"
+
+WebAPIMetrics::WebAPIMetrics()
+{}
+
+WebAPIMetrics::~WebAPIMetrics()
+{}
+
+void WebAPIMetrics::addDeviceSet(int deviceSetIndex, DeviceAPI *deviceAPI)
+{
+    m_deviceSets.push_back(DeviceSetEntry());
+    DeviceSetEntry& entry = m_deviceSets.back();
+    entry.m_index = deviceSetIndex;
+    entry.m_hardwareId = deviceAPI->getHardwareId();
+    entry.m_running = deviceAPI->state() == DeviceAPI::StRunning;
+    entry.m_sampleRate = 0;
+    entry.m_centerFrequency = 0;
+    entry.m_hasFifo = false;
+    entry.m_fifoSize = 0;
+    entry.m_fifoFill = 0;
+    entry.m_fifoDropped = 0;
+    entry.m_hasCallbackStats = false;
+    entry.m_callbacks = 0;
+    entry.m_callbackTotalNs = 0;
+    entry.m_callbackMaxNs = 0;
+    entry.m_callbacksLate = 0;
+    entry.m_callbackOverruns = 0;
+
+    if (deviceAPI->getSampleSource())
+    {
+        DeviceSampleSource *source = deviceAPI->getSampleSource();
+        SampleSinkFifo *fifo = source->getSampleFifo();
+        entry.m_direction = "rx";
+        entry.m_sampleRate = source->getSampleRate();
+        entry.m_centerFrequency = source->getCenterFrequency();
+        entry.m_hasFifo = true;
+        entry.m_fifoSize = fifo->size();
+        entry.m_fifoFill = fifo->getFillSnapshot();
+        entry.m_fifoDropped = fifo->getDroppedSamples();
+        const DeviceCallbackStats *callbackStats = source->getCallbackStats();
+
+        if (callbackStats)
+        {
+            entry.m_hasCallbackStats = true;
+            entry.m_callbacks = callbackStats->getCallbacks();
+            entry.m_callbackTotalNs = callbackStats->getTotalNs();
+            entry.m_callbackMaxNs = callbackStats->getMaxNs();
+            entry.m_callbacksLate = callbackStats->getLateCallbacks();
+            entry.m_callbackOverruns = callbackStats->getOverruns();
+        }
+
+        for (int i = 0; i < deviceAPI->getNbSinkChannels(); i++) {
+            addChannel(entry, i, deviceAPI->getChanelSinkAPIAt(i));
+        }
+    }
+    else if (deviceAPI->getSampleSink())
+    {
+        DeviceSampleSink *sink = deviceAPI->getSampleSink();
+        entry.m_direction = "tx";
+        entry.m_sampleRate = sink->getSampleRate();
+        entry.m_centerFrequency = sink->getCenterFrequency();
+
+        for (int i = 0; i < deviceAPI->getNbSourceChannels(); i++) {
+            addChannel(entry, i, deviceAPI->getChanelSourceAPIAt(i));
+        }
+    }
+    else if (deviceAPI->getSampleMIMO())
+    {
+        DeviceSampleMIMO *mimo = deviceAPI->getSampleMIMO();
+        entry.m_direction = "mimo";
+        entry.m_sampleRate = mimo->getMIMOSampleRate();
+        entry.m_centerFrequency = mimo->getMIMOCenterFrequency();
+
+        for (int i = 0; i < deviceAPI->getNbMIMOChannels(); i++) {
+            addChannel(entry, i, deviceAPI->getMIMOChannelAPIAt(i));
+        }
+    }
+    else
+    {
+        entry.m_direction = "none";
+    }
+}
+
+void WebAPIMetrics::addAMBEEngine(AMBEEngine *ambeEngine)
+{
+    ambeEngine->getMetrics(m_ambeDevices);
+}
+
+void WebAPIMetrics::addChannel(DeviceSetEntry& deviceSetEntry, int channelIndex, ChannelAPI *channelAPI)
+{
+    if (!channelAPI) {
+        return;
+    }
+
+    deviceSetEntry.m_channels.push_back(ChannelEntry());
+    ChannelEntry& entry = deviceSetEntry.m_channels.back();
+    entry.m_index = channelIndex;
+    channelAPI->getIdentifier(entry.m_id);
+    entry.m_frequencyOffset = channelAPI->getCenterFrequency();
+    entry.m_hasMetrics = channelAPI->getMetrics(entry.m_metrics);
+}
+
+void WebAPIMetrics::serializeJson(QByteArray& bytes) const
+{
+    // 64 bit counters go as doubles which is exact up to 2^53
+    QJsonArray deviceSetsArray;
+
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        QJsonObject deviceSetObject;
+        deviceSetObject["index"] = deviceSet.m_index;
+        deviceSetObject["direction"] = QString(deviceSet.m_direction);
+        deviceSetObject["hwType"] = deviceSet.m_hardwareId;
+        deviceSetObject["running"] = deviceSet.m_running ? 1 : 0;
+        deviceSetObject["sampleRate"] = deviceSet.m_sampleRate;
+        deviceSetObject["centerFrequency"] = (double) deviceSet.m_centerFrequency;
+
+        if (deviceSet.m_hasFifo)
+        {
+            deviceSetObject["fifoSize"] = (double) deviceSet.m_fifoSize;
+            deviceSetObject["fifoFill"] = (double) deviceSet.m_fifoFill;
+            deviceSetObject["fifoDropped"] = (double) deviceSet.m_fifoDropped;
+        }
+
+        if (deviceSet.m_hasCallbackStats)
+        {
+            deviceSetObject["callbacks"] = (double) deviceSet.m_callbacks;
+            deviceSetObject["callbackTotalNs"] = (double) deviceSet.m_callbackTotalNs;
+            deviceSetObject["callbackMaxNs"] = (double) deviceSet.m_callbackMaxNs;
+            deviceSetObject["callbacksLate"] = (double) deviceSet.m_callbacksLate;
+            deviceSetObject["callbackOverruns"] = (double) deviceSet.m_callbackOverruns;
+        }
+
+        QJsonArray channelsArray;
+
+        for (const ChannelEntry& channel : deviceSet.m_channels)
+        {
+            QJsonObject channelObject;
+            channelObject["index"] = channel.m_index;
+            channelObject["id"] = channel.m_id;
+            channelObject["deltaFrequency"] = (double) channel.m_frequencyOffset;
+
+            if (channel.m_hasMetrics)
+            {
+                channelObject["powerDB"] = std::round(channel.m_metrics.m_channelPowerDB * 10.0) / 10.0;
+
+                if (channel.m_metrics.m_squelch >= 0) {
+                    channelObject["squelch"] = channel.m_metrics.m_squelch;
+                }
+
+                channelObject["channelSampleRate"] = channel.m_metrics.m_channelSampleRate;
+
+                if (channel.m_metrics.m_audioSampleRate > 0) {
+                    channelObject["audioSampleRate"] = channel.m_metrics.m_audioSampleRate;
+                }
+            }
+
+            channelsArray.append(channelObject);
+        }
+
+        deviceSetObject["channels"] = channelsArray;
+        deviceSetsArray.append(deviceSetObject);
+    }
+
+    QJsonArray ambeDevicesArray;
+
+    for (const AMBEEngine::DeviceMetrics& ambeDevice : m_ambeDevices)
+    {
+        QJsonObject ambeDeviceObject;
+        ambeDeviceObject["device"] = ambeDevice.m_device;
+        ambeDeviceObject["channels"] = (double) ambeDevice.m_nbChannels;
+        ambeDeviceObject["queueDepth"] = (double) ambeDevice.m_queueDepth;
+        ambeDeviceObject["decodedFrames"] = (double) ambeDevice.m_decodedFrames;
+        ambeDeviceObject["droppedFrames"] = (double) ambeDevice.m_droppedFrames;
+        ambeDeviceObject["failedFrames"] = (double) ambeDevice.m_failedFrames;
+        ambeDeviceObject["batches"] = (double) ambeDevice.m_batches;
+        ambeDeviceObject["latencyTotalNs"] = (double) ambeDevice.m_latencyTotalNs;
+        ambeDeviceObject["latencyMaxNs"] = (double) ambeDevice.m_latencyMaxNs;
+        ambeDevicesArray.append(ambeDeviceObject);
+    }
+
+    QJsonObject metricsObject;
+    metricsObject["deviceSets"] = deviceSetsArray;
+    metricsObject["ambeDevices"] = ambeDevicesArray;
+    bytes = QJsonDocument(metricsObject).toJson(QJsonDocument::Compact);
+}
+
+void WebAPIMetrics::serializePrometheus(QByteArray& bytes) const
+{
+    bytes.reserve(1024 + m_deviceSets.size()*2048);
+
+    prometheusHeader(bytes, "sdrangel_device_running", "gauge", "1 if the device engine is running");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets) {
+        prometheusDeviceLabels(bytes, "sdrangel_device_running", deviceSet);
+        bytes.append(deviceSet.m_running ? "1\n" : "0\n");
+    }
+
+    prometheusHeader(bytes, "sdrangel_device_sample_rate", "gauge", "Device sample rate (S/s)");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets) {
+        prometheusDeviceLabels(bytes, "sdrangel_device_sample_rate", deviceSet);
+        bytes.append(QByteArray::number(deviceSet.m_sampleRate)).append('\n');
+    }
+
+    prometheusHeader(bytes, "sdrangel_device_center_frequency_hz", "gauge", "Device center frequency (Hz)");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets) {
+        prometheusDeviceLabels(bytes, "sdrangel_device_center_frequency_hz", deviceSet);
+        bytes.append(QByteArray::number(deviceSet.m_centerFrequency)).append('\n');
+    }
+
+    prometheusHeader(bytes, "sdrangel_device_fifo_size", "gauge", "Device sample FIFO size (samples)");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        if (deviceSet.m_hasFifo) {
+            prometheusDeviceLabels(bytes, "sdrangel_device_fifo_size", deviceSet);
+            bytes.append(QByteArray::number(deviceSet.m_fifoSize)).append('\n');
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_device_fifo_fill", "gauge", "Device sample FIFO fill (samples)");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        if (deviceSet.m_hasFifo) {
+            prometheusDeviceLabels(bytes, "sdrangel_device_fifo_fill", deviceSet);
+            bytes.append(QByteArray::number(deviceSet.m_fifoFill)).append('\n');
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_device_fifo_dropped_samples_total", "counter", "Samples dropped on device sample FIFO overflow");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        if (deviceSet.m_hasFifo) {
+            prometheusDeviceLabels(bytes, "sdrangel_device_fifo_dropped_samples_total", deviceSet);
+            bytes.append(QByteArray::number(deviceSet.m_fifoDropped)).append('\n');
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_device_callbacks_total", "counter", "Device library sample callbacks");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        if (deviceSet.m_hasCallbackStats) {
+            prometheusDeviceLabels(bytes, "sdrangel_device_callbacks_total", deviceSet);
+            bytes.append(QByteArray::number(deviceSet.m_callbacks)).append('\n');
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_device_callback_seconds_total", "counter", "Time spent in device library sample callbacks (s)");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        if (deviceSet.m_hasCallbackStats) {
+            prometheusDeviceLabels(bytes, "sdrangel_device_callback_seconds_total", deviceSet);
+            bytes.append(QByteArray::number(deviceSet.m_callbackTotalNs / 1e9, 'g', 9)).append('\n');
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_device_callback_max_seconds", "gauge", "Longest device library sample callback (s)");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        if (deviceSet.m_hasCallbackStats) {
+            prometheusDeviceLabels(bytes, "sdrangel_device_callback_max_seconds", deviceSet);
+            bytes.append(QByteArray::number(deviceSet.m_callbackMaxNs / 1e9, 'g', 6)).append('\n');
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_device_callbacks_late_total", "counter", "Device library sample callbacks lasting longer than their block of samples");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        if (deviceSet.m_hasCallbackStats) {
+            prometheusDeviceLabels(bytes, "sdrangel_device_callbacks_late_total", deviceSet);
+            bytes.append(QByteArray::number(deviceSet.m_callbacksLate)).append('\n');
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_device_callback_overruns_total", "counter", "Raw sample blocks dropped by the decimation pipeline");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        if (deviceSet.m_hasCallbackStats) {
+            prometheusDeviceLabels(bytes, "sdrangel_device_callback_overruns_total", deviceSet);
+            bytes.append(QByteArray::number(deviceSet.m_callbackOverruns)).append('\n');
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_channel_frequency_offset_hz", "gauge", "Channel offset from device center frequency (Hz)");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        for (const ChannelEntry& channel : deviceSet.m_channels) {
+            prometheusChannelLabels(bytes, "sdrangel_channel_frequency_offset_hz", deviceSet, channel);
+            bytes.append(QByteArray::number(channel.m_frequencyOffset)).append('\n');
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_channel_power_db", "gauge", "Channel power (dB)");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        for (const ChannelEntry& channel : deviceSet.m_channels)
+        {
+            if (channel.m_hasMetrics) {
+                prometheusChannelLabels(bytes, "sdrangel_channel_power_db", deviceSet, channel);
+                bytes.append(QByteArray::number(channel.m_metrics.m_channelPowerDB, 'f', 1)).append('\n');
+            }
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_channel_squelch_open", "gauge", "1 if the channel squelch is open");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        for (const ChannelEntry& channel : deviceSet.m_channels)
+        {
+            if (channel.m_hasMetrics && (channel.m_metrics.m_squelch >= 0)) {
+                prometheusChannelLabels(bytes, "sdrangel_channel_squelch_open", deviceSet, channel);
+                bytes.append(QByteArray::number(channel.m_metrics.m_squelch)).append('\n');
+            }
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_channel_sample_rate", "gauge", "Channel sample rate (S/s)");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        for (const ChannelEntry& channel : deviceSet.m_channels)
+        {
+            if (channel.m_hasMetrics) {
+                prometheusChannelLabels(bytes, "sdrangel_channel_sample_rate", deviceSet, channel);
+                bytes.append(QByteArray::number(channel.m_metrics.m_channelSampleRate)).append('\n');
+            }
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_channel_audio_sample_rate", "gauge", "Channel audio sample rate (S/s)");
+    for (const DeviceSetEntry& deviceSet : m_deviceSets)
+    {
+        for (const ChannelEntry& channel : deviceSet.m_channels)
+        {
+            if (channel.m_hasMetrics && (channel.m_metrics.m_audioSampleRate > 0)) {
+                prometheusChannelLabels(bytes, "sdrangel_channel_audio_sample_rate", deviceSet, channel);
+                bytes.append(QByteArray::number(channel.m_metrics.m_audioSampleRate)).append('\n');
+            }
+        }
+    }
+
+    prometheusHeader(bytes, "sdrangel_ambe_channels", "gauge", "Channels served by the AMBE device");
+    for (const AMBEEngine::DeviceMetrics& ambeDevice : m_ambeDevices) {
+        prometheusAMBELabels(bytes, "sdrangel_ambe_channels", ambeDevice);
+        bytes.append(QByteArray::number(ambeDevice.m_nbChannels)).append('\n');
+    }
+
+    prometheusHeader(bytes, "sdrangel_ambe_queue_depth", "gauge", "MBE frames waiting for the AMBE device");
+    for (const AMBEEngine::DeviceMetrics& ambeDevice : m_ambeDevices) {
+        prometheusAMBELabels(bytes, "sdrangel_ambe_queue_depth", ambeDevice);
+        bytes.append(QByteArray::number(ambeDevice.m_queueDepth)).append('\n');
+    }
+
+    prometheusHeader(bytes, "sdrangel_ambe_decoded_frames_total", "counter", "MBE frames decoded by the AMBE device");
+    for (const AMBEEngine::DeviceMetrics& ambeDevice : m_ambeDevices) {
+        prometheusAMBELabels(bytes, "sdrangel_ambe_decoded_frames_total", ambeDevice);
+        bytes.append(QByteArray::number(ambeDevice.m_decodedFrames)).append('\n');
+    }
+
+    prometheusHeader(bytes, "sdrangel_ambe_dropped_frames_total", "counter", "MBE frames dropped on channel queue overflow");
+    for (const AMBEEngine::DeviceMetrics& ambeDevice : m_ambeDevices) {
+        prometheusAMBELabels(bytes, "sdrangel_ambe_dropped_frames_total", ambeDevice);
+        bytes.append(QByteArray::number(ambeDevice.m_droppedFrames)).append('\n');
+    }
+
+    prometheusHeader(bytes, "sdrangel_ambe_failed_frames_total", "counter", "MBE frames the AMBE device failed to decode");
+    for (const AMBEEngine::DeviceMetrics& ambeDevice : m_ambeDevices) {
+        prometheusAMBELabels(bytes, "sdrangel_ambe_failed_frames_total", ambeDevice);
+        bytes.append(QByteArray::number(ambeDevice.m_failedFrames)).append('\n');
+    }
+
+    prometheusHeader(bytes, "sdrangel_ambe_decode_latency_seconds_total", "counter", "Sum of the times from MBE frame push to decoded audio (s)");
+    for (const AMBEEngine::DeviceMetrics& ambeDevice : m_ambeDevices) {
+        prometheusAMBELabels(bytes, "sdrangel_ambe_decode_latency_seconds_total", ambeDevice);
+        bytes.append(QByteArray::number(ambeDevice.m_latencyTotalNs / 1e9, 'g', 9)).append('\n');
+    }
+
+    prometheusHeader(bytes, "sdrangel_ambe_decode_latency_max_seconds", "gauge", "Longest time from MBE frame push to decoded audio (s)");
+    for (const AMBEEngine::DeviceMetrics& ambeDevice : m_ambeDevices) {
+        prometheusAMBELabels(bytes, "sdrangel_ambe_decode_latency_max_seconds", ambeDevice);
+        bytes.append(QByteArray::number(ambeDevice.m_latencyMaxNs / 1e9, 'g', 6)).append('\n');
+    }
+}
+
+void WebAPIMetrics::prometheusHeader(QByteArray& bytes, const char *name, const char *type, const char *help)
+{
+    bytes.append("# HELP ").append(name).append(' ').append(help).append('\n');
+    bytes.append("# TYPE ").append(name).append(' ').append(type).append('\n');
+}
+
+QByteArray WebAPIMetrics::prometheusLabelValue(const QString& value)
+{
+    QByteArray escaped = value.toUtf8();
+    escaped.replace('\\', "\\\\");
+    escaped.replace('"', "\\\"");
+    escaped.replace('\n', "\\n");
+    return escaped;
+}
+
+void WebAPIMetrics::prometheusDeviceLabels(QByteArray& bytes, const char *name, const DeviceSetEntry& deviceSet)
+{
+    bytes.append(name);
+    bytes.append("{deviceset=\"").append(QByteArray::number(deviceSet.m_index));
+    bytes.append("\",direction=\"").append(deviceSet.m_direction);
+    bytes.append("\",hwtype=\"").append(prometheusLabelValue(deviceSet.m_hardwareId));
+    bytes.append("\"} ");
+}
+
+void WebAPIMetrics::prometheusAMBELabels(QByteArray& bytes, const char *name, const AMBEEngine::DeviceMetrics& ambeDevice)
+{
+    bytes.append(name);
+    bytes.append("{device=\"").append(prometheusLabelValue(ambeDevice.m_device));
+    bytes.append("\"} ");
+}
+
+void WebAPIMetrics::prometheusChannelLabels(QByteArray& bytes, const char *name, const DeviceSetEntry& deviceSet, const ChannelEntry& channel)
+{
+    bytes.append(name);
+    bytes.append("{deviceset=\"").append(QByteArray::number(deviceSet.m_index));
+    bytes.append("\",channel=\"").append(QByteArray::number(channel.m_index));
+    bytes.append("\",id=\"").append(prometheusLabelValue(channel.m_id));
+    bytes.append("\"} ");
+}
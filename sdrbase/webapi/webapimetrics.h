@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Swagger server bulk metrics                                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBAPI_WEBAPIMETRICS_H_
+#define SDRBASE_WEBAPI_WEBAPIMETRICS_H_
+
+#include <vector>
+
+#include <QByteArray>
+#include <QString>
+
+#include "channel/channelapi.h"
+#include "ambe/ambeengine.h"
+#include "export.h"
+
+class DeviceAPI;
+
+/**
+ * Metrics of all device sets, channels and AMBE devices collected in one pass for the /sdrangel/metrics
+ * endpoint. Collection only reads values cached by the DSP threads (no message round trip,
+ * no swagger object, no accumulator reset) so it can be scraped at any rate.
+ * The result is serialized either as compact JSON or as Prometheus text exposition format.
+ */
+class SDRBASE_API WebAPIMetrics
+{
+public:
+    WebAPIMetrics();
+    ~WebAPIMetrics();
+
+    void addDeviceSet(int deviceSetIndex, DeviceAPI *deviceAPI);
+    void addAMBEEngine(AMBEEngine *ambeEngine);
+    void serializeJson(QByteArray& bytes) const;
+    void serializePrometheus(QByteArray& bytes) const;
+
+    struct ChannelEntry
+    {
+        int m_index;
+        QString m_id;
+        qint64 m_frequencyOffset;
+        bool m_hasMetrics;
+        ChannelAPI::Metrics m_metrics;
+    };
+
+    struct DeviceSetEntry
+    {
+        int m_index;
+        const char *m_direction; //!< "rx", "tx" or "mimo"
+        QString m_hardwareId;
+        bool m_running;
+        int m_sampleRate;
+        quint64 m_centerFrequency;
+        bool m_hasFifo;          //!< FIFO figures are only available for Rx devices
+        unsigned int m_fifoSize;
+        unsigned int m_fifoFill;
+        quint64 m_fifoDropped;
+        bool m_hasCallbackStats; //!< see DeviceCallbackStats
+        quint64 m_callbacks;
+        quint64 m_callbackTotalNs;
+        quint64 m_callbackMaxNs;
+        quint64 m_callbacksLate;
+        quint64 m_callbackOverruns;
+        std::vector<ChannelEntry> m_channels;
+    };
+
+    const std::vector<DeviceSetEntry>& getDeviceSets() const { return m_deviceSets; }
+    const std::vector<AMBEEngine::DeviceMetrics>& getAMBEDevices() const { return m_ambeDevices; }
+
+private:
+    std::vector<DeviceSetEntry> m_deviceSets;
+    std::vector<AMBEEngine::DeviceMetrics> m_ambeDevices;
+
+    void addChannel(DeviceSetEntry& deviceSetEntry, int channelIndex, ChannelAPI *channelAPI);
+    static QByteArray prometheusLabelValue(const QString& value); //!< escaped for use between double quotes
+    static void prometheusHeader(QByteArray& bytes, const char *name, const char *type, const char *help);
+    static void prometheusDeviceLabels(QByteArray& bytes, const char *name, const DeviceSetEntry& deviceSet);
+    static void prometheusAMBELabels(QByteArray& bytes, const char *name, const AMBEEngine::DeviceMetrics& ambeDevice);
+    static void prometheusChannelLabels(QByteArray& bytes, const char *name, const DeviceSetEntry& deviceSet, const ChannelEntry& channel);
+};
+
+#endif // SDRBASE_WEBAPI_WEBAPIMETRICS_H_
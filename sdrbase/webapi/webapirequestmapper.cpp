@@ -17,14 +17,17 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#include <QDirIterator>
+#include <memory>
+
 #include <QJsonDocument>
 #include <QJsonArray>
-
-#include <boost/lexical_cast.hpp>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QPair>
 
 #include "httpdocrootsettings.h"
 #include "webapirequestmapper.h"
+#include "webapimetrics.h"
 #include "SWGInstanceSummaryResponse.h"
 #include "SWGInstanceConfigResponse.h"
 #include "SWGInstanceDevicesResponse.h"
@@ -49,6 +52,7 @@
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelActions.h"
+#include "SWGScopeServer.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
 
@@ -236,6 +240,46 @@ WebAPIRequestMapper::WebAPIRequestMapper(QObject* parent) :
     qtwebapp::HttpDocrootSettings docrootSettings;
     docrootSettings.path = ":/webapi";
     m_staticFileController = new qtwebapp::StaticFileController(docrootSettings, parent);
+
+    m_router.addRoute(WebAPIAdapterInterface::instanceSummaryURL, RouteInstanceSummary);
+    m_router.addRoute(WebAPIAdapterInterface::instanceConfigURL, RouteInstanceConfig);
+    m_router.addRoute(WebAPIAdapterInterface::instanceDevicesURL, RouteInstanceDevices);
+    m_router.addRoute(WebAPIAdapterInterface::instanceChannelsURL, RouteInstanceChannels);
+    m_router.addRoute(WebAPIAdapterInterface::instanceLoggingURL, RouteInstanceLogging);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAudioURL, RouteInstanceAudio);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAudioInputParametersURL, RouteInstanceAudioInputParameters);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAudioOutputParametersURL, RouteInstanceAudioOutputParameters);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAudioInputCleanupURL, RouteInstanceAudioInputCleanup);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAudioOutputCleanupURL, RouteInstanceAudioOutputCleanup);
+    m_router.addRoute(WebAPIAdapterInterface::instanceLocationURL, RouteInstanceLocation);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAMBESerialURL, RouteInstanceAMBESerial);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAMBEDevicesURL, RouteInstanceAMBEDevices);
+    m_router.addRoute(WebAPIAdapterInterface::instanceLimeRFESerialURL, RouteInstanceLimeRFESerial);
+    m_router.addRoute(WebAPIAdapterInterface::instanceLimeRFEConfigURL, RouteInstanceLimeRFEConfig);
+    m_router.addRoute(WebAPIAdapterInterface::instanceLimeRFERunURL, RouteInstanceLimeRFERun);
+    m_router.addRoute(WebAPIAdapterInterface::instanceLimeRFEPowerURL, RouteInstanceLimeRFEPower);
+    m_router.addRoute(WebAPIAdapterInterface::instancePresetsURL, RouteInstancePresets);
+    m_router.addRoute(WebAPIAdapterInterface::instancePresetURL, RouteInstancePreset);
+    m_router.addRoute(WebAPIAdapterInterface::instancePresetFileURL, RouteInstancePresetFile);
+    m_router.addRoute(WebAPIAdapterInterface::instanceDeviceSetsURL, RouteInstanceDeviceSets);
+    m_router.addRoute(WebAPIAdapterInterface::instanceDeviceSetURL, RouteInstanceDeviceSet);
+    m_router.addRoute(WebAPIAdapterInterface::instanceMetricsURL, RouteInstanceMetrics);
+    m_router.addRoute(WebAPIAdapterInterface::instanceSettingsBatchURL, RouteInstanceSettingsBatch);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetURLRoute, RouteDeviceset);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetFocusURLRoute, RouteDevicesetFocus);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetDeviceURLRoute, RouteDevicesetDevice);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetDeviceSettingsURLRoute, RouteDevicesetDeviceSettings);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetDeviceRunURLRoute, RouteDevicesetDeviceRun);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetDeviceSubsystemRunURLRoute, RouteDevicesetDeviceSubsystemRun);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetDeviceReportURLRoute, RouteDevicesetDeviceReport);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetDeviceActionsURLRoute, RouteDevicesetDeviceActions);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetChannelsReportURLRoute, RouteDevicesetChannelsReport);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetChannelURLRoute, RouteDevicesetChannel);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetChannelIndexURLRoute, RouteDevicesetChannelIndex);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetChannelSettingsURLRoute, RouteDevicesetChannelSettings);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetChannelReportURLRoute, RouteDevicesetChannelReport);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetChannelActionsURLRoute, RouteDevicesetChannelActions);
+    m_router.addRoute(WebAPIAdapterInterface::devicesetChannelScopeServerURLRoute, RouteDevicesetChannelScopeServer);
 }
 
 WebAPIRequestMapper::~WebAPIRequestMapper()
@@ -274,95 +318,138 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
             return;
         }
 
-        if (path == WebAPIAdapterInterface::instanceSummaryURL) {
+        WebAPIRouter::Match match;
+
+        if (!m_router.match(path, match))
+        {
+            m_staticFileController->service(request, response); // serve static documentation pages
+            return;
+        }
+
+        const int *params = match.m_params;
+
+        switch (match.m_routeId)
+        {
+        case RouteInstanceSummary:
             instanceSummaryService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceConfigURL) {
+            break;
+        case RouteInstanceConfig:
             instanceConfigService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDevicesURL) {
+            break;
+        case RouteInstanceDevices:
             instanceDevicesService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceChannelsURL) {
+            break;
+        case RouteInstanceChannels:
             instanceChannelsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLoggingURL) {
+            break;
+        case RouteInstanceLogging:
             instanceLoggingService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioURL) {
+            break;
+        case RouteInstanceAudio:
             instanceAudioService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioInputParametersURL) {
+            break;
+        case RouteInstanceAudioInputParameters:
             instanceAudioInputParametersService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioOutputParametersURL) {
+            break;
+        case RouteInstanceAudioOutputParameters:
             instanceAudioOutputParametersService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioInputCleanupURL) {
+            break;
+        case RouteInstanceAudioInputCleanup:
             instanceAudioInputCleanupService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioOutputCleanupURL) {
+            break;
+        case RouteInstanceAudioOutputCleanup:
             instanceAudioOutputCleanupService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLocationURL) {
+            break;
+        case RouteInstanceLocation:
             instanceLocationService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAMBESerialURL) {
+            break;
+        case RouteInstanceAMBESerial:
             instanceAMBESerialService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAMBEDevicesURL) {
+            break;
+        case RouteInstanceAMBEDevices:
             instanceAMBEDevicesService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLimeRFESerialURL) {
+            break;
+        case RouteInstanceLimeRFESerial:
             instanceLimeRFESerialService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLimeRFEConfigURL) {
+            break;
+        case RouteInstanceLimeRFEConfig:
             instanceLimeRFEConfigService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLimeRFERunURL) {
+            break;
+        case RouteInstanceLimeRFERun:
             instanceLimeRFERunService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLimeRFEPowerURL) {
+            break;
+        case RouteInstanceLimeRFEPower:
             instanceLimeRFEPowerService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetsURL) {
+            break;
+        case RouteInstancePresets:
             instancePresetsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetURL) {
+            break;
+        case RouteInstancePreset:
             instancePresetService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetFileURL) {
+            break;
+        case RouteInstancePresetFile:
             instancePresetFileService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDeviceSetsURL) {
+            break;
+        case RouteInstanceDeviceSets:
             instanceDeviceSetsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDeviceSetURL) {
+            break;
+        case RouteInstanceDeviceSet:
             instanceDeviceSetService(request, response);
-        }
-        else
-        {
-            std::smatch desc_match;
-            std::string pathStr(path.constData(), path.length());
-
-            if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetURLRe)) {
-                devicesetService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceURLRe)) {
-                devicesetDeviceService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetFocusURLRe)) {
-                devicesetFocusService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceSettingsURLRe)) {
-                devicesetDeviceSettingsService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceRunURLRe)) {
-                devicesetDeviceRunService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceSubsystemRunURLRe)) {
-                devicesetDeviceSubsystemRunService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceReportURLRe)) {
-                devicesetDeviceReportService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceActionsURLRe)) {
-                devicesetDeviceActionsService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelsReportURLRe)) {
-                devicesetChannelsReportService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelURLRe)) {
-                devicesetChannelService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelIndexURLRe)) {
-                devicesetChannelIndexService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelSettingsURLRe)) {
-                devicesetChannelSettingsService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelReportURLRe)) {
-                devicesetChannelReportService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelActionsURLRe)) {
-                devicesetChannelActionsService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            }
-            else // serve static documentation pages
-            {
-                m_staticFileController->service(request, response);
-            }
-
-//            QDirIterator it(":", QDirIterator::Subdirectories);
-//            while (it.hasNext()) {
-//                qDebug() << "WebAPIRequestMapper::service: " << it.next();
-//            }
-
+            break;
+        case RouteInstanceMetrics:
+            instanceMetricsService(request, response);
+            break;
+        case RouteInstanceSettingsBatch:
+            instanceSettingsBatchService(request, response);
+            break;
+        case RouteDeviceset:
+            devicesetService(params[0], request, response);
+            break;
+        case RouteDevicesetFocus:
+            devicesetFocusService(params[0], request, response);
+            break;
+        case RouteDevicesetDevice:
+            devicesetDeviceService(params[0], request, response);
+            break;
+        case RouteDevicesetDeviceSettings:
+            devicesetDeviceSettingsService(params[0], request, response);
+            break;
+        case RouteDevicesetDeviceRun:
+            devicesetDeviceRunService(params[0], request, response);
+            break;
+        case RouteDevicesetDeviceSubsystemRun:
+            devicesetDeviceSubsystemRunService(params[0], params[1], request, response);
+            break;
+        case RouteDevicesetDeviceReport:
+            devicesetDeviceReportService(params[0], request, response);
+            break;
+        case RouteDevicesetDeviceActions:
+            devicesetDeviceActionsService(params[0], request, response);
+            break;
+        case RouteDevicesetChannelsReport:
+            devicesetChannelsReportService(params[0], request, response);
+            break;
+        case RouteDevicesetChannel:
+            devicesetChannelService(params[0], request, response);
+            break;
+        case RouteDevicesetChannelIndex:
+            devicesetChannelIndexService(params[0], params[1], request, response);
+            break;
+        case RouteDevicesetChannelSettings:
+            devicesetChannelSettingsService(params[0], params[1], request, response);
+            break;
+        case RouteDevicesetChannelReport:
+            devicesetChannelReportService(params[0], params[1], request, response);
+            break;
+        case RouteDevicesetChannelActions:
+            devicesetChannelActionsService(params[0], params[1], request, response);
+            break;
+        case RouteDevicesetChannelScopeServer:
+            devicesetChannelScopeServerService(params[0], params[1], request, response);
+            break;
+        default:
+            m_staticFileController->service(request, response);
+            break;
         }
     }
 }
@@ -1509,6 +1596,256 @@ void WebAPIRequestMapper::instanceDeviceSetsService(qtwebapp::HttpRequest& reque
     }
 }
 
+void WebAPIRequestMapper::instanceMetricsService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    // Prometheus text format on request or when the scraper asks for it
+    bool prometheus = (request.getParameter("format") == "prometheus")
+        || request.getHeader("Accept").contains("text/plain")
+        || request.getHeader("Accept").contains("openmetrics");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "GET")
+    {
+        WebAPIMetrics metrics;
+        int status = m_adapter->instanceMetricsGet(metrics, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2)
+        {
+            QByteArray bytes;
+
+            if (prometheus)
+            {
+                response.setHeader("Content-Type", "text/plain; version=0.0.4");
+                metrics.serializePrometheus(bytes);
+            }
+            else
+            {
+                response.setHeader("Content-Type", "application/json");
+                metrics.serializeJson(bytes);
+            }
+
+            response.write(bytes);
+        }
+        else
+        {
+            response.setHeader("Content-Type", "application/json");
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else
+    {
+        response.setHeader("Content-Type", "application/json");
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::instanceSettingsBatchService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if ((request.getMethod() != "PUT") && (request.getMethod() != "PATCH"))
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+        return;
+    }
+
+    QElapsedTimer latencyTimer;
+    latencyTimer.start();
+    QString jsonStr = request.getBody();
+    QJsonObject jsonObject;
+
+    if (!parseJsonBody(jsonStr, jsonObject, response)) {
+        return;
+    }
+
+    // Merge the changes targeting the same device or channel so that each one is applied once.
+    // Maps are ordered by device set index then channel index so changes are grouped per device set
+    // (one DSP engine and its channels basebands) and the device change comes before its channels.
+    QMap<int, QJsonObject> deviceChanges;
+    QMap<QPair<int, int>, QJsonObject> channelChanges;
+    QJsonArray devicesArray = jsonObject["devices"].toArray();
+    QJsonArray channelsArray = jsonObject["channels"].toArray();
+
+    for (const QJsonValue& value : devicesArray)
+    {
+        QJsonObject item = value.toObject();
+        int deviceSetIndex = item["deviceSetIndex"].toInt(-1);
+        mergeJsonObject(deviceChanges[deviceSetIndex], item["settings"].toObject());
+    }
+
+    for (const QJsonValue& value : channelsArray)
+    {
+        QJsonObject item = value.toObject();
+        QPair<int, int> target(item["deviceSetIndex"].toInt(-1), item["channelIndex"].toInt(-1));
+        mergeJsonObject(channelChanges[target], item["settings"].toObject());
+    }
+
+    // Validate everything before applying anything
+    struct DeviceChange {
+        int m_deviceSetIndex;
+        SWGSDRangel::SWGDeviceSettings m_settings;
+        QStringList m_keys;
+    };
+    struct ChannelChange {
+        int m_deviceSetIndex;
+        int m_channelIndex;
+        SWGSDRangel::SWGChannelSettings m_settings;
+        QStringList m_keys;
+    };
+    std::vector<std::unique_ptr<DeviceChange>> devices; // SWG classes are not copyable
+    std::vector<std::unique_ptr<ChannelChange>> channels;
+
+    for (QMap<int, QJsonObject>::iterator it = deviceChanges.begin(); it != deviceChanges.end(); ++it)
+    {
+        devices.emplace_back(new DeviceChange());
+        DeviceChange *change = devices.back().get();
+        change->m_deviceSetIndex = it.key();
+        resetDeviceSettings(change->m_settings);
+
+        if ((it.key() < 0) || !validateDeviceSettings(change->m_settings, it.value(), change->m_keys))
+        {
+            batchError(response, 400, QString("Invalid JSON request for device set %1: nothing applied").arg(it.key()));
+            return;
+        }
+    }
+
+    for (QMap<QPair<int, int>, QJsonObject>::iterator it = channelChanges.begin(); it != channelChanges.end(); ++it)
+    {
+        channels.emplace_back(new ChannelChange());
+        ChannelChange *change = channels.back().get();
+        change->m_deviceSetIndex = it.key().first;
+        change->m_channelIndex = it.key().second;
+        resetChannelSettings(change->m_settings);
+
+        if ((it.key().first < 0) || (it.key().second < 0) || !validateChannelSettings(change->m_settings, it.value(), change->m_keys))
+        {
+            batchError(response, 400, QString("Invalid JSON request for channel %1:%2: nothing applied").arg(it.key().first).arg(it.key().second));
+            return;
+        }
+    }
+
+    // Resolve every target with the same checks as the adapter will do on apply
+    // so that a missing device set or channel or a type mismatch does not leave a partly applied batch
+    for (const std::unique_ptr<DeviceChange>& change : devices)
+    {
+        SWGSDRangel::SWGDeviceSettings current;
+        resetDeviceSettings(current);
+        int status = m_adapter->devicesetDeviceSettingsGet(change->m_deviceSetIndex, current, errorResponse);
+
+        if (status/100 != 2)
+        {
+            batchError(response, status, QString("Device set %1: %2: nothing applied")
+                .arg(change->m_deviceSetIndex).arg(*errorResponse.getMessage()));
+            return;
+        }
+
+        if ((*current.getDeviceHwType() != *change->m_settings.getDeviceHwType())
+         || (current.getDirection() != change->m_settings.getDirection()))
+        {
+            batchError(response, 404, QString("Device set %1: device is %2 direction %3: nothing applied")
+                .arg(change->m_deviceSetIndex).arg(*current.getDeviceHwType()).arg(current.getDirection()));
+            return;
+        }
+    }
+
+    for (const std::unique_ptr<ChannelChange>& change : channels)
+    {
+        SWGSDRangel::SWGChannelSettings current;
+        resetChannelSettings(current);
+        int status = m_adapter->devicesetChannelSettingsGet(change->m_deviceSetIndex, change->m_channelIndex, current, errorResponse);
+
+        if (status/100 != 2)
+        {
+            batchError(response, status, QString("Channel %1:%2: %3: nothing applied")
+                .arg(change->m_deviceSetIndex).arg(change->m_channelIndex).arg(*errorResponse.getMessage()));
+            return;
+        }
+
+        if (*current.getChannelType() != *change->m_settings.getChannelType())
+        {
+            batchError(response, 404, QString("Channel %1:%2: channel is %3: nothing applied")
+                .arg(change->m_deviceSetIndex).arg(change->m_channelIndex).arg(*current.getChannelType()));
+            return;
+        }
+    }
+
+    bool force = (request.getMethod() == "PUT"); // force settings on PUT
+    int batchStatus = 200;
+    QJsonArray devicesResult;
+    QJsonArray channelsResult;
+    std::vector<std::unique_ptr<DeviceChange>>::iterator deviceIt = devices.begin();
+    std::vector<std::unique_ptr<ChannelChange>>::iterator channelIt = channels.begin();
+    QElapsedTimer applyTimer;
+    applyTimer.start();
+
+    while ((deviceIt != devices.end()) || (channelIt != channels.end()))
+    {
+        QJsonObject result;
+        int status;
+
+        if ((deviceIt != devices.end()) && ((channelIt == channels.end()) || ((*deviceIt)->m_deviceSetIndex <= (*channelIt)->m_deviceSetIndex)))
+        {
+            DeviceChange *change = (deviceIt++)->get();
+            status = m_adapter->devicesetDeviceSettingsPutPatch(
+                change->m_deviceSetIndex, force, change->m_keys, change->m_settings, errorResponse);
+            result["deviceSetIndex"] = change->m_deviceSetIndex;
+            result["status"] = status;
+
+            if (status/100 != 2) {
+                result["message"] = *errorResponse.getMessage();
+            }
+
+            devicesResult.append(result);
+        }
+        else
+        {
+            ChannelChange *change = (channelIt++)->get();
+            status = m_adapter->devicesetChannelSettingsPutPatch(
+                change->m_deviceSetIndex, change->m_channelIndex, force, change->m_keys, change->m_settings, errorResponse);
+            result["deviceSetIndex"] = change->m_deviceSetIndex;
+            result["channelIndex"] = change->m_channelIndex;
+            result["status"] = status;
+
+            if (status/100 != 2) {
+                result["message"] = *errorResponse.getMessage();
+            }
+
+            channelsResult.append(result);
+        }
+
+        if ((status/100 != 2) && (status > batchStatus)) {
+            batchStatus = status;
+        }
+    }
+
+    QJsonObject batchResult;
+    batchResult["applyLatencyUs"] = (double) (applyTimer.nsecsElapsed() / 1000);
+    batchResult["totalLatencyUs"] = (double) (latencyTimer.nsecsElapsed() / 1000);
+    batchResult["devices"] = devicesResult;
+    batchResult["channels"] = channelsResult;
+    response.setStatus(batchStatus);
+    response.write(QJsonDocument(batchResult).toJson(QJsonDocument::Compact));
+}
+
+void WebAPIRequestMapper::batchError(qtwebapp::HttpResponse& response, int status, const QString& message)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setStatus(status, "Batch rejected");
+    errorResponse.init();
+    *errorResponse.getMessage() = message;
+    response.write(errorResponse.asJson().toUtf8());
+}
+
 void WebAPIRequestMapper::instanceDeviceSetService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
@@ -1560,7 +1897,7 @@ void WebAPIRequestMapper::instanceDeviceSetService(qtwebapp::HttpRequest& reques
     }
 }
 
-void WebAPIRequestMapper::devicesetService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
@@ -1568,24 +1905,13 @@ void WebAPIRequestMapper::devicesetService(const std::string& indexStr, qtwebapp
 
     if (request.getMethod() == "GET")
     {
-        try
-        {
-            SWGSDRangel::SWGDeviceSet normalResponse;
-            int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-            int status = m_adapter->devicesetGet(deviceSetIndex, normalResponse, errorResponse);
-            response.setStatus(status);
+        SWGSDRangel::SWGDeviceSet normalResponse;
+        int status = m_adapter->devicesetGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        catch (const boost::bad_lexical_cast &e)
-        {
-            errorResponse.init();
-            *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-            response.setStatus(400,"Invalid data");
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
@@ -1598,327 +1924,267 @@ void WebAPIRequestMapper::devicesetService(const std::string& indexStr, qtwebapp
     }
 }
 
-void WebAPIRequestMapper::devicesetFocusService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetFocusService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "PATCH")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-
-        if (request.getMethod() == "PATCH")
-        {
-            SWGSDRangel::SWGSuccessResponse normalResponse;
-            int status = m_adapter->devicesetFocusPatch(deviceSetIndex, normalResponse, errorResponse);
+        SWGSDRangel::SWGSuccessResponse normalResponse;
+        int status = m_adapter->devicesetFocusPatch(deviceSetIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else
-        {
-            response.setStatus(405,"Invalid HTTP method");
-            errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "PUT")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if (request.getMethod() == "PUT")
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
+            SWGSDRangel::SWGDeviceListItem query;
+            SWGSDRangel::SWGDeviceListItem normalResponse;
 
-            if (parseJsonBody(jsonStr, jsonObject, response))
+            if (validateDeviceListItem(query, jsonObject))
             {
-                SWGSDRangel::SWGDeviceListItem query;
-                SWGSDRangel::SWGDeviceListItem normalResponse;
-
-                if (validateDeviceListItem(query, jsonObject))
-                {
-                    int status = m_adapter->devicesetDevicePut(deviceSetIndex, query, normalResponse, errorResponse);
-                    response.setStatus(status);
+                int status = m_adapter->devicesetDevicePut(deviceSetIndex, query, normalResponse, errorResponse);
+                response.setStatus(status);
 
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Missing device identification");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Missing device identification";
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
                     response.write(errorResponse.asJson().toUtf8());
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Missing device identification");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
+                *errorResponse.getMessage() = "Missing device identification";
                 response.write(errorResponse.asJson().toUtf8());
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceSettingsService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceSettingsService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
+            SWGSDRangel::SWGDeviceSettings normalResponse;
+            resetDeviceSettings(normalResponse);
+            QStringList deviceSettingsKeys;
 
-            if (parseJsonBody(jsonStr, jsonObject, response))
+            if (validateDeviceSettings(normalResponse, jsonObject, deviceSettingsKeys))
             {
-                SWGSDRangel::SWGDeviceSettings normalResponse;
-                resetDeviceSettings(normalResponse);
-                QStringList deviceSettingsKeys;
-
-                if (validateDeviceSettings(normalResponse, jsonObject, deviceSettingsKeys))
-                {
-                    int status = m_adapter->devicesetDeviceSettingsPutPatch(
-                            deviceSetIndex,
-                            (request.getMethod() == "PUT"), // force settings on PUT
-                            deviceSettingsKeys,
-                            normalResponse,
-                            errorResponse);
-                    response.setStatus(status);
+                int status = m_adapter->devicesetDeviceSettingsPutPatch(
+                        deviceSetIndex,
+                        (request.getMethod() == "PUT"), // force settings on PUT
+                        deviceSettingsKeys,
+                        normalResponse,
+                        errorResponse);
+                response.setStatus(status);
 
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Invalid JSON request");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Invalid JSON request";
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
                     response.write(errorResponse.asJson().toUtf8());
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else if (request.getMethod() == "GET")
-        {
-            SWGSDRangel::SWGDeviceSettings normalResponse;
-            resetDeviceSettings(normalResponse);
-            int status = m_adapter->devicesetDeviceSettingsGet(deviceSetIndex, normalResponse, errorResponse);
-            response.setStatus(status);
-
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
+                *errorResponse.getMessage() = "Invalid JSON request";
                 response.write(errorResponse.asJson().toUtf8());
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGDeviceSettings normalResponse;
+        resetDeviceSettings(normalResponse);
+        int status = m_adapter->devicesetDeviceSettingsGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceRunService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceRunService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "GET")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceRunGet(deviceSetIndex, normalResponse, errorResponse);
 
-        if (request.getMethod() == "GET")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceRunGet(deviceSetIndex, normalResponse, errorResponse);
-
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
         }
-        else if (request.getMethod() == "POST")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceRunPost(deviceSetIndex, normalResponse, errorResponse);
+    }
+    else if (request.getMethod() == "POST")
+    {
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceRunPost(deviceSetIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
         }
-        else if (request.getMethod() == "DELETE")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceRunDelete(deviceSetIndex, normalResponse, errorResponse);
+    }
+    else if (request.getMethod() == "DELETE")
+    {
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceRunDelete(deviceSetIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else
-        {
-            response.setStatus(405,"Invalid HTTP method");
-            errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceSubsystemRunService(const std::string& indexStr, const std::string& subsystemIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceSubsystemRunService(int deviceSetIndex, int subsystemIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
-    {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-        int subsystemIndex = boost::lexical_cast<int>(subsystemIndexStr);
 
-        if (request.getMethod() == "GET")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceSubsystemRunGet(deviceSetIndex, subsystemIndex, normalResponse, errorResponse);
+    if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceSubsystemRunGet(deviceSetIndex, subsystemIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
         }
-        else if (request.getMethod() == "POST")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceSubsystemRunPost(deviceSetIndex, subsystemIndex, normalResponse, errorResponse);
+    }
+    else if (request.getMethod() == "POST")
+    {
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceSubsystemRunPost(deviceSetIndex, subsystemIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
         }
-        else if (request.getMethod() == "DELETE")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceSubsystemRunDelete(deviceSetIndex, subsystemIndex, normalResponse, errorResponse);
+    }
+    else if (request.getMethod() == "DELETE")
+    {
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceSubsystemRunDelete(deviceSetIndex, subsystemIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else
-        {
-            response.setStatus(405,"Invalid HTTP method");
-            errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceReportService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
@@ -1926,25 +2192,14 @@ void WebAPIRequestMapper::devicesetDeviceReportService(const std::string& indexS
 
     if (request.getMethod() == "GET")
     {
-        try
-        {
-            SWGSDRangel::SWGDeviceReport normalResponse;
-            resetDeviceReport(normalResponse);
-            int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-            int status = m_adapter->devicesetDeviceReportGet(deviceSetIndex, normalResponse, errorResponse);
-            response.setStatus(status);
+        SWGSDRangel::SWGDeviceReport normalResponse;
+        resetDeviceReport(normalResponse);
+        int status = m_adapter->devicesetDeviceReportGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        catch (const boost::bad_lexical_cast &e)
-        {
-            errorResponse.init();
-            *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-            response.setStatus(400,"Invalid data");
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
@@ -1957,78 +2212,66 @@ void WebAPIRequestMapper::devicesetDeviceReportService(const std::string& indexS
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceActionsService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceActionsService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "POST")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if (request.getMethod() == "POST")
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
+            SWGSDRangel::SWGDeviceActions query;
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            resetDeviceActions(query);
+            QStringList deviceActionsKeys;
 
-            if (parseJsonBody(jsonStr, jsonObject, response))
+            if (validateDeviceActions(query, jsonObject, deviceActionsKeys))
             {
-                SWGSDRangel::SWGDeviceActions query;
-                SWGSDRangel::SWGSuccessResponse normalResponse;
-                resetDeviceActions(query);
-                QStringList deviceActionsKeys;
-
-                if (validateDeviceActions(query, jsonObject, deviceActionsKeys))
-                {
-                    int status = m_adapter->devicesetDeviceActionsPost(
-                        deviceSetIndex,
-                        deviceActionsKeys,
-                        query,
-                        normalResponse,
-                        errorResponse);
-                    response.setStatus(status);
+                int status = m_adapter->devicesetDeviceActionsPost(
+                    deviceSetIndex,
+                    deviceActionsKeys,
+                    query,
+                    normalResponse,
+                    errorResponse);
+                response.setStatus(status);
 
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Invalid JSON request");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Invalid JSON request";
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
                     response.write(errorResponse.asJson().toUtf8());
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
+                *errorResponse.getMessage() = "Invalid JSON request";
                 response.write(errorResponse.asJson().toUtf8());
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch(const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
-void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetChannelsReportService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
@@ -2036,24 +2279,13 @@ void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& inde
 
     if (request.getMethod() == "GET")
     {
-        try
-        {
-            SWGSDRangel::SWGChannelsDetail normalResponse;
-            int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-            int status = m_adapter->devicesetChannelsReportGet(deviceSetIndex, normalResponse, errorResponse);
-            response.setStatus(status);
+        SWGSDRangel::SWGChannelsDetail normalResponse;
+        int status = m_adapter->devicesetChannelsReportGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        catch (const boost::bad_lexical_cast &e)
-        {
-            errorResponse.init();
-            *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-            response.setStatus(400,"Invalid data");
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
@@ -2067,7 +2299,7 @@ void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& inde
 }
 
 void WebAPIRequestMapper::devicesetChannelService(
-        const std::string& deviceSetIndexStr,
+        int deviceSetIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -2075,77 +2307,65 @@ void WebAPIRequestMapper::devicesetChannelService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "POST")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if (request.getMethod() == "POST")
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
-
-            if (parseJsonBody(jsonStr, jsonObject, response))
-            {
-                SWGSDRangel::SWGChannelSettings query;
-                SWGSDRangel::SWGSuccessResponse normalResponse;
-                resetChannelSettings(query);
+            SWGSDRangel::SWGChannelSettings query;
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            resetChannelSettings(query);
 
-                if (jsonObject.contains("direction")) {
-                    query.setDirection(jsonObject["direction"].toInt());
-                } else {
-                    query.setDirection(0); // assume Rx
-                }
+            if (jsonObject.contains("direction")) {
+                query.setDirection(jsonObject["direction"].toInt());
+            } else {
+                query.setDirection(0); // assume Rx
+            }
 
-                if (jsonObject.contains("channelType") && jsonObject["channelType"].isString())
-                {
-                    query.setChannelType(new QString(jsonObject["channelType"].toString()));
+            if (jsonObject.contains("channelType") && jsonObject["channelType"].isString())
+            {
+                query.setChannelType(new QString(jsonObject["channelType"].toString()));
 
-                    int status = m_adapter->devicesetChannelPost(deviceSetIndex, query, normalResponse, errorResponse);
+                int status = m_adapter->devicesetChannelPost(deviceSetIndex, query, normalResponse, errorResponse);
 
-                    response.setStatus(status);
+                response.setStatus(status);
 
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Invalid JSON request");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Invalid JSON request";
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
                     response.write(errorResponse.asJson().toUtf8());
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
+                *errorResponse.getMessage() = "Invalid JSON request";
                 response.write(errorResponse.asJson().toUtf8());
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
 void WebAPIRequestMapper::devicesetChannelIndexService(
-        const std::string& deviceSetIndexStr,
-        const std::string& channelIndexStr,
+        int deviceSetIndex,
+        int channelIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -2153,44 +2373,32 @@ void WebAPIRequestMapper::devicesetChannelIndexService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
-    {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
-        int channelIndex = boost::lexical_cast<int>(channelIndexStr);
 
-        if (request.getMethod() == "DELETE")
-        {
-            SWGSDRangel::SWGSuccessResponse normalResponse;
-            int status = m_adapter->devicesetChannelDelete(deviceSetIndex, channelIndex, normalResponse, errorResponse);
+    if (request.getMethod() == "DELETE")
+    {
+        SWGSDRangel::SWGSuccessResponse normalResponse;
+        int status = m_adapter->devicesetChannelDelete(deviceSetIndex, channelIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else
-        {
-            response.setStatus(405,"Invalid HTTP method");
-            errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
 void WebAPIRequestMapper::devicesetChannelSettingsService(
-        const std::string& deviceSetIndexStr,
-        const std::string& channelIndexStr,
+        int deviceSetIndex,
+        int channelIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -2198,88 +2406,76 @@ void WebAPIRequestMapper::devicesetChannelSettingsService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+
+    if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGChannelSettings normalResponse;
+        resetChannelSettings(normalResponse);
+        int status = m_adapter->devicesetChannelSettingsGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
-        int channelIndex = boost::lexical_cast<int>(channelIndexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if (request.getMethod() == "GET")
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
             SWGSDRangel::SWGChannelSettings normalResponse;
             resetChannelSettings(normalResponse);
-            int status = m_adapter->devicesetChannelSettingsGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
-            response.setStatus(status);
-
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
-        {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
+            QStringList channelSettingsKeys;
 
-            if (parseJsonBody(jsonStr, jsonObject, response))
+            if (validateChannelSettings(normalResponse, jsonObject, channelSettingsKeys))
             {
-                SWGSDRangel::SWGChannelSettings normalResponse;
-                resetChannelSettings(normalResponse);
-                QStringList channelSettingsKeys;
-
-                if (validateChannelSettings(normalResponse, jsonObject, channelSettingsKeys))
-                {
-                    int status = m_adapter->devicesetChannelSettingsPutPatch(
-                            deviceSetIndex,
-                            channelIndex,
-                            (request.getMethod() == "PUT"), // force settings on PUT
-                            channelSettingsKeys,
-                            normalResponse,
-                            errorResponse);
-                    response.setStatus(status);
+                int status = m_adapter->devicesetChannelSettingsPutPatch(
+                        deviceSetIndex,
+                        channelIndex,
+                        (request.getMethod() == "PUT"), // force settings on PUT
+                        channelSettingsKeys,
+                        normalResponse,
+                        errorResponse);
+                response.setStatus(status);
 
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Invalid JSON request");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Invalid JSON request";
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
                     response.write(errorResponse.asJson().toUtf8());
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
+                *errorResponse.getMessage() = "Invalid JSON request";
                 response.write(errorResponse.asJson().toUtf8());
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
 void WebAPIRequestMapper::devicesetChannelReportService(
-        const std::string& deviceSetIndexStr,
-        const std::string& channelIndexStr,
+        int deviceSetIndex,
+        int channelIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -2287,44 +2483,97 @@ void WebAPIRequestMapper::devicesetChannelReportService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+
+    if (request.getMethod() == "GET")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
-        int channelIndex = boost::lexical_cast<int>(channelIndexStr);
+        SWGSDRangel::SWGChannelReport normalResponse;
+        resetChannelReport(normalResponse);
+        int status = m_adapter->devicesetChannelReportGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
+        response.setStatus(status);
 
-        if (request.getMethod() == "GET")
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::devicesetChannelActionsService(
+        int deviceSetIndex,
+        int channelIndex,
+        qtwebapp::HttpRequest& request,
+        qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+
+    if (request.getMethod() == "POST")
+    {
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
+
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            SWGSDRangel::SWGChannelReport normalResponse;
-            resetChannelReport(normalResponse);
-            int status = m_adapter->devicesetChannelReportGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
-            response.setStatus(status);
+            SWGSDRangel::SWGChannelActions query;
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            resetChannelActions(query);
+            QStringList channelActionsKeys;
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
+            if (validateChannelActions(query, jsonObject, channelActionsKeys))
+            {
+                int status = m_adapter->devicesetChannelActionsPost(
+                    deviceSetIndex,
+                    channelIndex,
+                    channelActionsKeys,
+                    query,
+                    normalResponse,
+                    errorResponse);
+                response.setStatus(status);
+
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
+                    response.write(errorResponse.asJson().toUtf8());
+                }
+            }
+            else
+            {
+                response.setStatus(400,"Invalid JSON request");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Invalid JSON request";
                 response.write(errorResponse.asJson().toUtf8());
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
-void WebAPIRequestMapper::devicesetChannelActionsService(
-        const std::string& deviceSetIndexStr,
-        const std::string& channelIndexStr,
+void WebAPIRequestMapper::devicesetChannelScopeServerService(
+        int deviceSetIndex,
+        int channelIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -2332,73 +2581,81 @@ void WebAPIRequestMapper::devicesetChannelActionsService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "PUT")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
-        int channelIndex = boost::lexical_cast<int>(channelIndexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if (request.getMethod() == "POST")
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
+            SWGSDRangel::SWGScopeServer query;
+            SWGSDRangel::SWGSuccessResponse normalResponse;
 
-            if (parseJsonBody(jsonStr, jsonObject, response))
+            if (validateScopeServer(query, jsonObject))
             {
-                SWGSDRangel::SWGChannelActions query;
-                SWGSDRangel::SWGSuccessResponse normalResponse;
-                resetChannelActions(query);
-                QStringList channelActionsKeys;
-
-                if (validateChannelActions(query, jsonObject, channelActionsKeys))
-                {
-                    int status = m_adapter->devicesetChannelActionsPost(
-                        deviceSetIndex,
-                        channelIndex,
-                        channelActionsKeys,
-                        query,
-                        normalResponse,
-                        errorResponse);
-                    response.setStatus(status);
+                int status = m_adapter->devicesetChannelScopeServerPut(deviceSetIndex, channelIndex, query, normalResponse, errorResponse);
+                response.setStatus(status);
 
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Invalid JSON request");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Invalid JSON request";
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
                     response.write(errorResponse.asJson().toUtf8());
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
+                *errorResponse.getMessage() = "Invalid JSON request";
                 response.write(errorResponse.asJson().toUtf8());
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
+            *errorResponse.getMessage() = "Invalid JSON format";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else if (request.getMethod() == "DELETE")
+    {
+        SWGSDRangel::SWGSuccessResponse normalResponse;
+        int status = m_adapter->devicesetChannelScopeServerDelete(deviceSetIndex, channelIndex, normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
             response.write(errorResponse.asJson().toUtf8());
         }
     }
-    catch(const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
+        *errorResponse.getMessage() = "Invalid HTTP method";
         response.write(errorResponse.asJson().toUtf8());
     }
 }
 
+void WebAPIRequestMapper::mergeJsonObject(QJsonObject& into, const QJsonObject& from)
+{
+    for (QJsonObject::const_iterator it = from.begin(); it != from.end(); ++it)
+    {
+        if (it.value().isObject() && into.value(it.key()).isObject())
+        {
+            QJsonObject merged = into.value(it.key()).toObject();
+            mergeJsonObject(merged, it.value().toObject());
+            into[it.key()] = merged;
+        }
+        else
+        {
+            into[it.key()] = it.value(); // later change wins
+        }
+    }
+}
+
 bool WebAPIRequestMapper::parseJsonBody(QString& jsonStr, QJsonObject& jsonObject, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
@@ -2447,6 +2704,18 @@ bool WebAPIRequestMapper::validatePresetTransfer(SWGSDRangel::SWGPresetTransfer&
     return validatePresetIdentifer(*presetIdentifier);
 }
 
+bool WebAPIRequestMapper::validateScopeServer(SWGSDRangel::SWGScopeServer& scopeServer, QJsonObject& jsonObject)
+{
+    if (!jsonObject.contains("listeningAddress") || !jsonObject.contains("port")) {
+        return false;
+    }
+
+    scopeServer.fromJsonObject(jsonObject);
+    int port = scopeServer.getPort();
+
+    return (port > 0) && (port < 65536);
+}
+
 bool WebAPIRequestMapper::validatePresetIdentifer(SWGSDRangel::SWGPresetIdentifier& presetIdentifier)
 {
     return (presetIdentifier.getGroupName() && presetIdentifier.getName() && presetIdentifier.getType());
@@ -2638,11 +2907,21 @@ bool WebAPIRequestMapper::validateChannelSettings(
 
     QString *channelType = channelSettings.getChannelType();
 
-    if (m_channelTypeToSettingsKey.contains(*channelType)) {
-        return getChannelSettings(m_channelTypeToSettingsKey[*channelType], &channelSettings, jsonObject, channelSettingsKeys);
-    } else {
+    if (!m_channelTypeToSettingsKey.contains(*channelType)) {
+        return false;
+    }
+
+    if (!getChannelSettings(m_channelTypeToSettingsKey[*channelType], &channelSettings, jsonObject, channelSettingsKeys)) {
         return false;
     }
+
+    if (jsonObject.contains("mixGain")) // Tx channels gain in the mix of sources
+    {
+        channelSettings.setMixGain(jsonObject["mixGain"].toDouble());
+        channelSettingsKeys.append("mixGain");
+    }
+
+    return true;
 }
 
 bool WebAPIRequestMapper::validateChannelActions(
@@ -27,6 +27,7 @@
 #include "httpresponse.h"
 #include "staticfilecontroller.h"
 #include "webapiadapterinterface.h"
+#include "webapirouter.h"
 
 #include "export.h"
 
@@ -46,10 +47,55 @@ public:
     ~WebAPIRequestMapper();
     void service(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void setAdapter(WebAPIAdapterInterface *adapter) { m_adapter = adapter; }
+    const WebAPIRouter& getRouter() const { return m_router; }
+
+    enum Route
+    {
+        RouteInstanceSummary,
+        RouteInstanceConfig,
+        RouteInstanceDevices,
+        RouteInstanceChannels,
+        RouteInstanceLogging,
+        RouteInstanceAudio,
+        RouteInstanceAudioInputParameters,
+        RouteInstanceAudioOutputParameters,
+        RouteInstanceAudioInputCleanup,
+        RouteInstanceAudioOutputCleanup,
+        RouteInstanceLocation,
+        RouteInstanceAMBESerial,
+        RouteInstanceAMBEDevices,
+        RouteInstanceLimeRFESerial,
+        RouteInstanceLimeRFEConfig,
+        RouteInstanceLimeRFERun,
+        RouteInstanceLimeRFEPower,
+        RouteInstancePresets,
+        RouteInstancePreset,
+        RouteInstancePresetFile,
+        RouteInstanceDeviceSets,
+        RouteInstanceDeviceSet,
+        RouteInstanceMetrics,
+        RouteInstanceSettingsBatch,
+        RouteDeviceset,
+        RouteDevicesetFocus,
+        RouteDevicesetDevice,
+        RouteDevicesetDeviceSettings,
+        RouteDevicesetDeviceRun,
+        RouteDevicesetDeviceSubsystemRun,
+        RouteDevicesetDeviceReport,
+        RouteDevicesetDeviceActions,
+        RouteDevicesetChannelsReport,
+        RouteDevicesetChannel,
+        RouteDevicesetChannelIndex,
+        RouteDevicesetChannelSettings,
+        RouteDevicesetChannelReport,
+        RouteDevicesetChannelActions,
+        RouteDevicesetChannelScopeServer
+    };
 
 private:
     WebAPIAdapterInterface *m_adapter;
     qtwebapp::StaticFileController *m_staticFileController;
+    WebAPIRouter m_router; //!< Compiled once at construction
 
     void instanceSummaryService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceConfigService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
@@ -73,22 +119,25 @@ private:
     void instancePresetService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instancePresetFileService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceDeviceSetsService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void instanceMetricsService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void instanceSettingsBatchService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
     void instanceDeviceSetService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
 
-    void devicesetService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetFocusService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetDeviceService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetDeviceSettingsService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetDeviceRunService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetDeviceSubsystemRunService(const std::string& indexStr, const std::string& subsystemIndexStr,qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetDeviceReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetDeviceActionsService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetChannelsReportService(const std::string& deviceSetIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetChannelService(const std::string& deviceSetIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetChannelIndexService(const std::string& deviceSetIndexStr, const std::string& channelIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetChannelSettingsService(const std::string& deviceSetIndexStr, const std::string& channelIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetChannelReportService(const std::string& deviceSetIndexStr, const std::string& channelIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
-    void devicesetChannelActionsService(const std::string& deviceSetIndexStr, const std::string& channelIndexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetFocusService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetDeviceService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetDeviceSettingsService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetDeviceRunService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetDeviceSubsystemRunService(int deviceSetIndex, int subsystemIndex,qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetDeviceReportService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetDeviceActionsService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelsReportService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelIndexService(int deviceSetIndex, int channelIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelSettingsService(int deviceSetIndex, int channelIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelReportService(int deviceSetIndex, int channelIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelActionsService(int deviceSetIndex, int channelIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetChannelScopeServerService(int deviceSetIndex, int channelIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
 
     bool validatePresetTransfer(SWGSDRangel::SWGPresetTransfer& presetTransfer);
     bool validatePresetIdentifer(SWGSDRangel::SWGPresetIdentifier& presetIdentifier);
@@ -98,6 +147,7 @@ private:
     bool validateDeviceActions(SWGSDRangel::SWGDeviceActions& deviceActions, QJsonObject& jsonObject, QStringList& deviceActionsKeys);
     bool validateChannelSettings(SWGSDRangel::SWGChannelSettings& channelSettings, QJsonObject& jsonObject, QStringList& channelSettingsKeys);
     bool validateChannelActions(SWGSDRangel::SWGChannelActions& channelActions, QJsonObject& jsonObject, QStringList& channelActionsKeys);
+    bool validateScopeServer(SWGSDRangel::SWGScopeServer& scopeServer, QJsonObject& jsonObject);
     bool validateAudioInputDevice(SWGSDRangel::SWGAudioInputDevice& audioInputDevice, QJsonObject& jsonObject, QStringList& audioInputDeviceKeys);
     bool validateAudioOutputDevice(SWGSDRangel::SWGAudioOutputDevice& audioOutputDevice, QJsonObject& jsonObject, QStringList& audioOutputDeviceKeys);
     bool validateAMBEDevices(SWGSDRangel::SWGAMBEDevices& ambeDevices, QJsonObject& jsonObject);
@@ -161,6 +211,8 @@ private:
             QStringList& keyList);
 
     bool parseJsonBody(QString& jsonStr, QJsonObject& jsonObject, qtwebapp::HttpResponse& response);
+    static void mergeJsonObject(QJsonObject& into, const QJsonObject& from);
+    static void batchError(qtwebapp::HttpResponse& response, int status, const QString& message); //!< Batch rejected before anything is applied
 
     void resetDeviceSettings(SWGSDRangel::SWGDeviceSettings& deviceSettings);
     void resetDeviceReport(SWGSDRangel::SWGDeviceReport& deviceReport);
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Swagger server path router                                                    //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QStringList>
+#include <QDebug>
+
+#include "webapirouter.h"
+
+WebAPIRouter::WebAPIRouter() :
+    m_nodes(1)
+{}
+
+WebAPIRouter::~WebAPIRouter()
+{}
+
+void WebAPIRouter::addRoute(const QString& pattern, int routeId)
+{
+    QStringList segments = pattern.split('/');
+    int nodeIndex = 0;
+    int nbParams = 0;
+
+    if (!segments.isEmpty() && segments.front().isEmpty()) { // leading slash
+        segments.pop_front();
+    }
+
+    for (const QString& segment : segments)
+    {
+        int childIndex;
+
+        if (segment == "{int}")
+        {
+            childIndex = m_nodes[nodeIndex].m_intChild;
+
+            if (childIndex < 0)
+            {
+                childIndex = m_nodes.size();
+                m_nodes.push_back(Node());
+                m_nodes[nodeIndex].m_intChild = childIndex;
+            }
+
+            nbParams++;
+        }
+        else
+        {
+            QByteArray key = segment.toUtf8();
+            childIndex = m_nodes[nodeIndex].m_literals.value(key, -1);
+
+            if (childIndex < 0)
+            {
+                childIndex = m_nodes.size();
+                m_nodes.push_back(Node());
+                m_nodes[nodeIndex].m_literals.insert(key, childIndex);
+            }
+        }
+
+        nodeIndex = childIndex;
+    }
+
+    if (nbParams > m_maxParams) {
+        qWarning("WebAPIRouter::addRoute: too many parameters in %s", qPrintable(pattern));
+    } else if (m_nodes[nodeIndex].m_routeId >= 0) {
+        qWarning("WebAPIRouter::addRoute: duplicate route %s", qPrintable(pattern));
+    } else {
+        m_nodes[nodeIndex].m_routeId = routeId;
+    }
+}
+
+bool WebAPIRouter::match(const QByteArray& path, Match& match) const
+{
+    const char *p = path.constData();
+    const char *end = p + path.size();
+    int nodeIndex = 0;
+    match.m_nbParams = 0;
+
+    if ((p == end) || (*p != '/')) {
+        return false;
+    }
+
+    while (p < end)
+    {
+        const char *segBegin = ++p; // skip slash
+        while ((p < end) && (*p != '/')) {
+            p++;
+        }
+
+        const Node& node = m_nodes[nodeIndex];
+        int childIndex = node.m_literals.value(QByteArray::fromRawData(segBegin, p - segBegin), -1);
+
+        if (childIndex < 0)
+        {
+            int value;
+
+            if ((node.m_intChild < 0) || (match.m_nbParams == m_maxParams) || !parseInt(segBegin, p, value)) {
+                return false;
+            }
+
+            match.m_params[match.m_nbParams++] = value;
+            childIndex = node.m_intChild;
+        }
+
+        nodeIndex = childIndex;
+    }
+
+    match.m_routeId = m_nodes[nodeIndex].m_routeId;
+    return match.m_routeId >= 0;
+}
+
+bool WebAPIRouter::parseInt(const char *begin, const char *end, int& value)
+{
+    if ((end - begin < 1) || (end - begin > 2)) {
+        return false;
+    }
+
+    value = 0;
+
+    for (; begin < end; ++begin)
+    {
+        if ((*begin < '0') || (*begin > '9')) {
+            return false;
+        }
+
+        value = value*10 + (*begin - '0');
+    }
+
+    return true;
+}
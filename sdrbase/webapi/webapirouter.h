@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Swagger server path router                                                    //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBAPI_WEBAPIROUTER_H_
+#define SDRBASE_WEBAPI_WEBAPIROUTER_H_
+
+#include <vector>
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+#include "export.h"
+
+/**
+ * Path segment trie built once with the route patterns. A pattern is a path made of
+ * literal segments and {int} segments e.g. /sdrangel/deviceset/{int}/channel/{int}/settings.
+ * An {int} segment matches 1 or 2 decimal digits and its value is returned as a typed
+ * parameter. Literal segments take precedence over {int} segments.
+ */
+class SDRBASE_API WebAPIRouter
+{
+public:
+    static const int m_maxParams = 2;
+
+    struct Match
+    {
+        int m_routeId;
+        int m_nbParams;
+        int m_params[m_maxParams];
+
+        Match() :
+            m_routeId(-1),
+            m_nbParams(0)
+        {}
+    };
+
+    WebAPIRouter();
+    ~WebAPIRouter();
+
+    void addRoute(const QString& pattern, int routeId);
+    bool match(const QByteArray& path, Match& match) const; //!< returns false if no route matches the whole path
+
+private:
+    struct Node
+    {
+        QHash<QByteArray, int> m_literals; //!< Literal segment to child node index
+        int m_intChild;                    //!< Index of the {int} child node or -1
+        int m_routeId;                     //!< Route ending at this node or -1
+
+        Node() :
+            m_intChild(-1),
+            m_routeId(-1)
+        {}
+    };
+
+    std::vector<Node> m_nodes; //!< Node 0 is the root
+
+    static bool parseInt(const char *begin, const char *end, int& value);
+};
+
+#endif // SDRBASE_WEBAPI_WEBAPIROUTER_H_
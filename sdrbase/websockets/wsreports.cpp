@@ -0,0 +1,344 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <vector>
+
+#include <QtWebSockets>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QDebug>
+
+#include "webapi/webapiadapterinterface.h"
+#include "webapi/webapimetrics.h"
+
+#include "wsreports.h"
+
+const int WSReports::m_tickMs = 50;
+const int WSReports::m_minIntervalMs = 50;
+const int WSReports::m_maxIntervalMs = 60000;
+
+WSReports::WSReports(WebAPIAdapterInterface *adapter, QObject *parent) :
+    QObject(parent),
+    m_adapter(adapter),
+    m_listeningAddress(QHostAddress::LocalHost),
+    m_port(8885),
+    m_webSocketServer(nullptr)
+{
+    m_clock.start();
+    connect(&m_timer, &QTimer::timeout, this, &WSReports::tick);
+}
+
+WSReports::~WSReports()
+{
+    closeSocket();
+}
+
+void WSReports::openSocket()
+{
+    m_webSocketServer = new QWebSocketServer(
+        QStringLiteral("Reports Server"),
+        QWebSocketServer::NonSecureMode,
+        this);
+
+    if (m_webSocketServer->listen(m_listeningAddress, m_port))
+    {
+        qDebug() << "WSReports::openSocket: reports server listening at " << m_listeningAddress.toString() << " on port " << m_port;
+        connect(m_webSocketServer, &QWebSocketServer::newConnection, this, &WSReports::onNewConnection);
+    }
+    else
+    {
+        qInfo("WSReports::openSocket: cannot start reports server at %s on port %u", qPrintable(m_listeningAddress.toString()), m_port);
+    }
+}
+
+void WSReports::closeSocket()
+{
+    m_timer.stop();
+
+    for (QWebSocket *pClient : m_subscribers.keys())
+    {
+        disconnect(pClient, &QWebSocket::disconnected, this, &WSReports::socketDisconnected);
+        pClient->close();
+        pClient->deleteLater();
+    }
+
+    m_subscribers.clear();
+
+    if (m_webSocketServer)
+    {
+        delete m_webSocketServer;
+        m_webSocketServer = nullptr;
+    }
+}
+
+bool WSReports::socketOpened()
+{
+    return m_webSocketServer && m_webSocketServer->isListening();
+}
+
+QString WSReports::getWebSocketIdentifier(QWebSocket *peer)
+{
+    return QStringLiteral("%1:%2").arg(peer->peerAddress().toString(), QString::number(peer->peerPort()));
+}
+
+void WSReports::onNewConnection()
+{
+    auto pSocket = m_webSocketServer->nextPendingConnection();
+    qDebug() << " WSReports::onNewConnection: " << getWebSocketIdentifier(pSocket) << " connected";
+    pSocket->setParent(this);
+
+    connect(pSocket, &QWebSocket::textMessageReceived, this, &WSReports::processClientMessage);
+    connect(pSocket, &QWebSocket::disconnected, this, &WSReports::socketDisconnected);
+
+    m_subscribers.insert(pSocket, Subscriber());
+
+    if (!m_timer.isActive()) {
+        m_timer.start(m_tickMs);
+    }
+}
+
+void WSReports::processClientMessage(const QString &message)
+{
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+
+    if (!pClient || !m_subscribers.contains(pClient)) {
+        return;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8(), &error);
+
+    if (!doc.isObject())
+    {
+        qDebug() << "WSReports::processClientMessage: invalid subscription: " << message;
+        return;
+    }
+
+    QJsonObject object = doc.object();
+    Subscriber& subscriber = m_subscribers[pClient];
+    int intervalMs = object.value("intervalMs").toInt(subscriber.m_intervalMs);
+    subscriber.m_deviceSetIndex = object.value("deviceSet").toInt(-1);
+    subscriber.m_channelIndex = object.value("channel").toInt(-1);
+    subscriber.m_intervalMs = intervalMs < m_minIntervalMs ? m_minIntervalMs : intervalMs > m_maxIntervalMs ? m_maxIntervalMs : intervalMs;
+    subscriber.m_nextDueMs = 0;
+    subscriber.m_lastSent.clear(); // next message is a full update
+    qDebug() << "WSReports::processClientMessage:" << getWebSocketIdentifier(pClient)
+        << "deviceSet:" << subscriber.m_deviceSetIndex
+        << "channel:" << subscriber.m_channelIndex
+        << "intervalMs:" << subscriber.m_intervalMs;
+}
+
+void WSReports::socketDisconnected()
+{
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+
+    if (pClient)
+    {
+        qDebug() << getWebSocketIdentifier(pClient) << " disconnected";
+        m_subscribers.remove(pClient);
+        pClient->deleteLater();
+
+        if (m_subscribers.isEmpty()) {
+            m_timer.stop();
+        }
+    }
+}
+
+void WSReports::tick()
+{
+    qint64 nowMs = m_clock.elapsed();
+    bool due = false;
+
+    for (const Subscriber& subscriber : m_subscribers)
+    {
+        if (nowMs >= subscriber.m_nextDueMs)
+        {
+            due = true;
+            break;
+        }
+    }
+
+    if (!due) {
+        return;
+    }
+
+    // Collect once for all the subscribers that are due
+    WebAPIMetrics metrics;
+    SWGSDRangel::SWGErrorResponse errorResponse;
+
+    if (m_adapter->instanceMetricsGet(metrics, errorResponse) / 100 != 2) {
+        return;
+    }
+
+    QHash<quint32, quint64> values;
+    flatten(metrics, values);
+    QByteArray payload;
+
+    for (QHash<QWebSocket*, Subscriber>::iterator it = m_subscribers.begin(); it != m_subscribers.end(); ++it)
+    {
+        Subscriber& subscriber = it.value();
+
+        if (nowMs < subscriber.m_nextDueMs) {
+            continue;
+        }
+
+        subscriber.m_nextDueMs = nowMs + subscriber.m_intervalMs;
+        buildPayload(payload, subscriber, values);
+
+        if (!payload.isEmpty()) {
+            it.key()->sendBinaryMessage(payload);
+        }
+    }
+}
+
+void WSReports::flatten(const WebAPIMetrics& metrics, QHash<quint32, quint64>& values)
+{
+    for (const WebAPIMetrics::DeviceSetEntry& deviceSet : metrics.getDeviceSets())
+    {
+        int ds = deviceSet.m_index;
+        values.insert(makeKey(ds, 255, FieldDeviceRunning), deviceSet.m_running ? 1 : 0);
+        values.insert(makeKey(ds, 255, FieldDeviceSampleRate), (quint32) deviceSet.m_sampleRate);
+        values.insert(makeKey(ds, 255, FieldDeviceCenterFrequency), deviceSet.m_centerFrequency);
+
+        if (deviceSet.m_hasFifo)
+        {
+            values.insert(makeKey(ds, 255, FieldDeviceFifoFill), deviceSet.m_fifoFill);
+            values.insert(makeKey(ds, 255, FieldDeviceFifoDropped), deviceSet.m_fifoDropped);
+        }
+
+        if (deviceSet.m_hasCallbackStats)
+        {
+            values.insert(makeKey(ds, 255, FieldDeviceCallbacksLate), deviceSet.m_callbacksLate);
+            values.insert(makeKey(ds, 255, FieldDeviceCallbackOverruns), deviceSet.m_callbackOverruns);
+        }
+
+        for (const WebAPIMetrics::ChannelEntry& channel : deviceSet.m_channels)
+        {
+            int ch = channel.m_index;
+            values.insert(makeKey(ds, ch, FieldChannelFrequencyOffset), (quint64) channel.m_frequencyOffset);
+
+            if (channel.m_hasMetrics)
+            {
+                float powerDB = channel.m_metrics.m_channelPowerDB;
+                quint32 powerBits;
+                std::memcpy(&powerBits, &powerDB, sizeof(float));
+                values.insert(makeKey(ds, ch, FieldChannelPowerDB), powerBits);
+                values.insert(makeKey(ds, ch, FieldChannelSampleRate), (quint32) channel.m_metrics.m_channelSampleRate);
+
+                if (channel.m_metrics.m_squelch >= 0) {
+                    values.insert(makeKey(ds, ch, FieldChannelSquelch), (quint32) channel.m_metrics.m_squelch);
+                }
+
+                if (channel.m_metrics.m_audioSampleRate > 0) {
+                    values.insert(makeKey(ds, ch, FieldChannelAudioSampleRate), (quint32) channel.m_metrics.m_audioSampleRate);
+                }
+            }
+        }
+    }
+}
+
+bool WSReports::selected(const Subscriber& subscriber, quint32 key)
+{
+    int ds = key >> 16;
+    int ch = (key >> 8) & 0xFF;
+
+    if ((subscriber.m_deviceSetIndex >= 0) && (ds != subscriber.m_deviceSetIndex)) {
+        return false;
+    }
+
+    return (ch == 255) || (subscriber.m_channelIndex < 0) || (ch == subscriber.m_channelIndex);
+}
+
+void WSReports::buildPayload(QByteArray& bytes, Subscriber& subscriber, const QHash<quint32, quint64>& values)
+{
+    std::vector<quint32> updates;
+    std::vector<quint32> removals;
+    bytes.clear();
+
+    for (QHash<quint32, quint64>::const_iterator it = values.begin(); it != values.end(); ++it)
+    {
+        if (!selected(subscriber, it.key())) {
+            continue;
+        }
+
+        QHash<quint32, quint64>::iterator last = subscriber.m_lastSent.find(it.key());
+
+        if (last == subscriber.m_lastSent.end()) {
+            subscriber.m_lastSent.insert(it.key(), it.value());
+        } else if (last.value() != it.value()) {
+            last.value() = it.value();
+        } else {
+            continue;
+        }
+
+        updates.push_back(it.key());
+    }
+
+    for (QHash<quint32, quint64>::iterator it = subscriber.m_lastSent.begin(); it != subscriber.m_lastSent.end();)
+    {
+        if (values.contains(it.key()))
+        {
+            ++it;
+        }
+        else
+        {
+            removals.push_back(it.key());
+            it = subscriber.m_lastSent.erase(it);
+        }
+    }
+
+    if (updates.empty() && removals.empty()) { // nothing changed: nothing sent
+        return;
+    }
+
+    quint32 sequence = subscriber.m_sequence++;
+    qint64 timestampMs = QDateTime::currentMSecsSinceEpoch();
+    quint16 nbUpdates = updates.size();
+    quint16 nbRemovals = removals.size();
+
+    bytes.reserve(sizeof(quint32) + sizeof(qint64) + 2*sizeof(quint16) + nbUpdates*11 + nbRemovals*3);
+    bytes.append((const char*) &sequence, sizeof(quint32));
+    bytes.append((const char*) &timestampMs, sizeof(qint64));
+    bytes.append((const char*) &nbUpdates, sizeof(quint16));
+    bytes.append((const char*) &nbRemovals, sizeof(quint16));
+
+    for (quint32 key : updates)
+    {
+        char address[3] = {(char) (key >> 16), (char) (key >> 8), (char) key};
+        bytes.append(address, 3);
+        quint64 value = values.value(key);
+
+        if (isWideField(key & 0xFF))
+        {
+            bytes.append((const char*) &value, sizeof(quint64));
+        }
+        else
+        {
+            quint32 narrowValue = value;
+            bytes.append((const char*) &narrowValue, sizeof(quint32));
+        }
+    }
+
+    for (quint32 key : removals)
+    {
+        char address[3] = {(char) (key >> 16), (char) (key >> 8), (char) key};
+        bytes.append(address, 3);
+    }
+}
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBSOCKETS_WSREPORTS_H_
+#define SDRBASE_WEBSOCKETS_WSREPORTS_H_
+
+#include <QObject>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHostAddress>
+
+#include "export.h"
+
+class QWebSocketServer;
+class QWebSocket;
+class WebAPIAdapterInterface;
+class WebAPIMetrics;
+
+/**
+ * Websocket server pushing device and channel report deltas to subscribers instead of
+ * having them poll the report endpoints. It listens on the web API address, port 8885 by
+ * default (--wsreports-port option). Figures are collected once per tick from the
+ * web API adapter metrics (see WebAPIMetrics) and shared by all subscribers that are due.
+ * Each subscriber only receives the values that changed since its previous message so
+ * intermediate updates are coalesced into one message per subscriber interval.
+ *
+ * A client subscribes by sending a text message:
+ * {"deviceSet": -1, "channel": -1, "intervalMs": 500}
+ * where -1 means all device sets or all channels. The device figures of the selected device
+ * sets are always included. Subscribing again replaces the subscription and the next message
+ * is a full update. New clients are subscribed to everything every second.
+ *
+ * Each binary message is made of a header:
+ * - sequence (uint32): message counter for this subscriber
+ * - timestampMs (int64): milliseconds since epoch
+ * - nbUpdates (uint16): number of updated values
+ * - nbRemovals (uint16): number of removed values
+ * then nbUpdates times deviceSet (uint8), channel (uint8, 255 for the device), field (uint8)
+ * followed by the value whose type depends on the field (see Field),
+ * then nbRemovals times deviceSet (uint8), channel (uint8), field (uint8).
+ */
+class SDRBASE_API WSReports : public QObject
+{
+    Q_OBJECT
+public:
+    enum Field
+    {
+        FieldDeviceRunning = 0,         //!< int32
+        FieldDeviceSampleRate = 1,      //!< int32
+        FieldDeviceCenterFrequency = 2, //!< int64
+        FieldDeviceFifoFill = 3,        //!< int32
+        FieldDeviceFifoDropped = 4,     //!< int64
+        FieldDeviceCallbacksLate = 5,   //!< int64
+        FieldDeviceCallbackOverruns = 6, //!< int64
+        FieldChannelFrequencyOffset = 16, //!< int64
+        FieldChannelPowerDB = 17,         //!< float32
+        FieldChannelSquelch = 18,         //!< int32
+        FieldChannelSampleRate = 19,      //!< int32
+        FieldChannelAudioSampleRate = 20  //!< int32
+    };
+
+    explicit WSReports(WebAPIAdapterInterface *adapter, QObject *parent = nullptr);
+    ~WSReports() override;
+
+    void openSocket();
+    void closeSocket();
+    bool socketOpened();
+    void setListeningAddress(const QString& address) { m_listeningAddress.setAddress(address); }
+    void setPort(quint16 port) { m_port = port; }
+
+private slots:
+    void onNewConnection();
+    void processClientMessage(const QString &message);
+    void socketDisconnected();
+    void tick();
+
+private:
+    struct Subscriber
+    {
+        int m_deviceSetIndex;  //!< -1 for all
+        int m_channelIndex;    //!< -1 for all
+        int m_intervalMs;
+        qint64 m_nextDueMs;
+        quint32 m_sequence;
+        QHash<quint32, quint64> m_lastSent; //!< Last values sent by key (see makeKey)
+
+        Subscriber() :
+            m_deviceSetIndex(-1),
+            m_channelIndex(-1),
+            m_intervalMs(1000),
+            m_nextDueMs(0),
+            m_sequence(0)
+        {}
+    };
+
+    WebAPIAdapterInterface *m_adapter;
+    QHostAddress m_listeningAddress;
+    quint16 m_port;
+    QWebSocketServer* m_webSocketServer;
+    QHash<QWebSocket*, Subscriber> m_subscribers;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+
+    static const int m_tickMs;
+    static const int m_minIntervalMs;
+    static const int m_maxIntervalMs;
+
+    static QString getWebSocketIdentifier(QWebSocket *peer);
+    static quint32 makeKey(int deviceSetIndex, int channelIndex, int field) {
+        return (deviceSetIndex << 16) | ((channelIndex & 0xFF) << 8) | field;
+    }
+    static bool isWideField(int field) {
+        return (field == FieldDeviceCenterFrequency) || (field == FieldDeviceFifoDropped)
+            || (field == FieldDeviceCallbacksLate) || (field == FieldDeviceCallbackOverruns)
+            || (field == FieldChannelFrequencyOffset);
+    }
+    static void flatten(const WebAPIMetrics& metrics, QHash<quint32, quint64>& values);
+    static bool selected(const Subscriber& subscriber, quint32 key);
+    static void buildPayload(QByteArray& bytes, Subscriber& subscriber, const QHash<quint32, quint64>& values);
+};
+
+#endif // SDRBASE_WEBSOCKETS_WSREPORTS_H_
@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QtWebSockets>
+#include <QHostAddress>
+#include <QDebug>
+
+#include "wsscope.h"
+
+WSScope::WSScope(QObject *parent) :
+    QObject(parent),
+    m_listeningAddress(QHostAddress::LocalHost),
+    m_port(8886),
+    m_maxPoints(1000),
+    m_webSocketServer(nullptr),
+    m_nbClients(0)
+{
+    m_timer.start();
+}
+
+WSScope::~WSScope()
+{
+    closeSocket();
+}
+
+void WSScope::openSocket()
+{
+    m_webSocketServer = new QWebSocketServer(
+        QStringLiteral("Scope Server"),
+        QWebSocketServer::NonSecureMode,
+        this);
+
+    if (m_webSocketServer->listen(m_listeningAddress, m_port))
+    {
+        qDebug() << "WSScope::openSocket: scope server listening at " << m_listeningAddress.toString() << " on port " << m_port;
+        connect(m_webSocketServer, &QWebSocketServer::newConnection, this, &WSScope::onNewConnection);
+    }
+    else
+    {
+        qInfo("WSScope::openSocket: cannot start scope server at %s on port %u", qPrintable(m_listeningAddress.toString()), m_port);
+    }
+}
+
+void WSScope::closeSocket()
+{
+    m_nbClients.store(0); // stops trace computation right away
+
+    for (QWebSocket *pClient : qAsConst(m_clients))
+    {
+        disconnect(pClient, &QWebSocket::disconnected, this, &WSScope::socketDisconnected);
+        pClient->close();
+        pClient->deleteLater();
+    }
+
+    m_clients.clear();
+
+    if (m_webSocketServer)
+    {
+        delete m_webSocketServer;
+        m_webSocketServer = nullptr;
+    }
+}
+
+bool WSScope::socketOpened()
+{
+    return m_webSocketServer && m_webSocketServer->isListening();
+}
+
+QString WSScope::getWebSocketIdentifier(QWebSocket *peer)
+{
+    return QStringLiteral("%1:%2").arg(peer->peerAddress().toString(), QString::number(peer->peerPort()));
+}
+
+void WSScope::onNewConnection()
+{
+    auto pSocket = m_webSocketServer->nextPendingConnection();
+    qDebug() << " WSScope::onNewConnection: " << getWebSocketIdentifier(pSocket) << " connected";
+    pSocket->setParent(this);
+
+    connect(pSocket, &QWebSocket::textMessageReceived, this, &WSScope::processClientMessage);
+    connect(pSocket, &QWebSocket::disconnected, this, &WSScope::socketDisconnected);
+
+    m_clients << pSocket;
+    m_nbClients.store(m_clients.size());
+}
+
+void WSScope::processClientMessage(const QString &message)
+{
+     qDebug() << "WSScope::processClientMessage: " << message;
+}
+
+void WSScope::socketDisconnected()
+{
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+
+    if (pClient)
+    {
+        qDebug() << getWebSocketIdentifier(pClient) << " disconnected";
+        m_clients.removeAll(pClient);
+        m_nbClients.store(m_clients.size());
+        pClient->deleteLater();
+    }
+}
+
+void WSScope::newTraces(
+    const std::vector<float *>& traces,
+    const std::vector<Projector::ProjectionType>& projectionTypes,
+    int traceSize,
+    int sampleRate
+)
+{
+    if (m_timer.elapsed() < 200) { // Max 5 frames per second
+        return;
+    }
+
+    qint64 elapsed = m_timer.restart();
+    QByteArray payload;
+
+    buildPayload(
+        payload,
+        traces,
+        projectionTypes,
+        traceSize,
+        elapsed,
+        sampleRate
+    );
+
+    for (QWebSocket *pClient : qAsConst(m_clients)) {
+        pClient->sendBinaryMessage(payload);
+    }
+}
+
+void WSScope::buildPayload(
+    QByteArray& bytes,
+    const std::vector<float *>& traces,
+    const std::vector<Projector::ProjectionType>& projectionTypes,
+    int traceSize,
+    int64_t traceTimeMs,
+    int sampleRate
+)
+{
+    int decimation = (traceSize + m_maxPoints - 1) / m_maxPoints;
+    decimation = decimation < 1 ? 1 : decimation;
+    int nbPoints = traceSize / decimation;
+    int nbTraces = traces.size();
+    std::vector<float> points(nbPoints);
+
+    bytes.reserve(5*sizeof(int) + sizeof(int64_t) + nbTraces*(sizeof(int) + nbPoints*sizeof(float)));
+    QBuffer buffer(&bytes);
+    buffer.open(QIODevice::WriteOnly);
+    buffer.write((char*) &traceSize, sizeof(int));
+    buffer.write((char*) &decimation, sizeof(int));
+    buffer.write((char*) &nbPoints, sizeof(int));
+    buffer.write((char*) &traceTimeMs, sizeof(int64_t));
+    buffer.write((char*) &sampleRate, sizeof(int));
+    buffer.write((char*) &nbTraces, sizeof(int));
+
+    for (int i = 0; i < nbTraces; i++)
+    {
+        int projectionType = (int) projectionTypes[i];
+        const float *trace = traces[i];
+
+        for (int j = 0; j < nbPoints; j++) {
+            points[j] = trace[2*j*decimation + 1]; // traces are interleaved (x, y) pairs
+        }
+
+        buffer.write((char*) &projectionType, sizeof(int));
+        buffer.write((char*) points.data(), nbPoints*sizeof(float));
+    }
+
+    buffer.close();
+}
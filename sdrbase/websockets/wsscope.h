@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBSOCKETS_WSSCOPE_H_
+#define SDRBASE_WEBSOCKETS_WSSCOPE_H_
+
+#include <vector>
+
+#include <QObject>
+#include <QList>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QAtomicInt>
+
+#include "dsp/projector.h"
+
+#include "export.h"
+
+class QWebSocketServer;
+class QWebSocket;
+
+/**
+ * Binary websocket server of scope traces. Each message is made of a header:
+ * - traceSize (int32): number of samples in a trace
+ * - decimation (int32): one point is sent every decimation samples
+ * - nbPoints (int32): number of points per trace
+ * - traceTimeMs (int64): time elapsed since the previous message
+ * - sampleRate (int32): trace sample rate in S/s
+ * - nbTraces (int32): number of traces that follow
+ * then for each trace its projection type (int32) followed by nbPoints Y values (float32)
+ * in the display -1.0 to 1.0 scale.
+ */
+class SDRBASE_API WSScope : public QObject
+{
+    Q_OBJECT
+public:
+    explicit WSScope(QObject *parent = nullptr);
+    ~WSScope() override;
+
+    void openSocket();
+    void closeSocket();
+    bool socketOpened();
+    bool hasClients() const { return m_nbClients.load() > 0; } //!< May be called from the DSP thread
+    void setListeningAddress(const QString& address) { m_listeningAddress.setAddress(address); }
+    void setPort(quint16 port) { m_port = port; }
+    void setMaxPoints(int maxPoints) { m_maxPoints = maxPoints < 1 ? 1 : maxPoints; }
+    void newTraces(
+        const std::vector<float *>& traces,
+        const std::vector<Projector::ProjectionType>& projectionTypes,
+        int traceSize,
+        int sampleRate
+    );
+
+private slots:
+    void onNewConnection();
+    void processClientMessage(const QString &message);
+    void socketDisconnected();
+
+private:
+    QHostAddress m_listeningAddress;
+    quint16 m_port;
+    int m_maxPoints;
+    QWebSocketServer* m_webSocketServer;
+    QList<QWebSocket*> m_clients;
+    QAtomicInt m_nbClients;
+    QElapsedTimer m_timer;
+
+    static QString getWebSocketIdentifier(QWebSocket *peer);
+    void buildPayload(
+        QByteArray& bytes,
+        const std::vector<float *>& traces,
+        const std::vector<Projector::ProjectionType>& projectionTypes,
+        int traceSize,
+        int64_t traceTimeMs,
+        int sampleRate
+    );
+};
+
+#endif // SDRBASE_WEBSOCKETS_WSSCOPE_H_
@@ -15,8 +15,12 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <cmath>
+
 #include <QtWebSockets>
 #include <QHostAddress>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QDebug>
 
 #include "wsspectrum.h"
@@ -81,12 +85,36 @@ void WSSpectrum::onNewConnection()
     connect(pSocket, &QWebSocket::textMessageReceived, this, &WSSpectrum::processClientMessage);
     connect(pSocket, &QWebSocket::disconnected, this, &WSSpectrum::socketDisconnected);
 
-    m_clients << pSocket;
+    m_clients.insert(pSocket, ClientFormat());
 }
 
 void WSSpectrum::processClientMessage(const QString &message)
 {
-     qDebug() << "WSSpectrum::processClientMessage: " << message;
+    qDebug() << "WSSpectrum::processClientMessage: " << message;
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8());
+
+    if (!pClient || !m_clients.contains(pClient) || !doc.isObject()) {
+        return;
+    }
+
+    QJsonObject object = doc.object();
+    ClientFormat& format = m_clients[pClient];
+    QString encoding = object.value("encoding").toString("float32");
+    int nbBins = object.value("bins").toInt(0);
+
+    if (encoding == "quantized16") {
+        format.m_encoding = EncodingQuantized16;
+    } else if (encoding == "quantized8") {
+        format.m_encoding = EncodingQuantized8;
+    } else if (encoding == "delta8") {
+        format.m_encoding = EncodingDelta8;
+    } else {
+        format.m_encoding = EncodingFloat32;
+    }
+
+    format.m_nbBins = nbBins < 0 ? 0 : nbBins > (1<<20) ? (1<<20) : nbBins;
+    format.m_needsKeyFrame = true;
 }
 
 void WSSpectrum::socketDisconnected()
@@ -96,7 +124,7 @@ void WSSpectrum::socketDisconnected()
 
     if (pClient)
     {
-        m_clients.removeAll(pClient);
+        m_clients.remove(pClient);
         pClient->deleteLater();
     }
 }
@@ -116,24 +144,77 @@ void WSSpectrum::newSpectrum(
     }
 
     qint64 elapsed = m_timer.restart();
-    QWebSocket *pSender = qobject_cast<QWebSocket *>(sender());
-    QByteArray payload;
-
-    buildPayload(
-        payload,
-        spectrum,
-        fftSize,
-        elapsed,
-        refLevel,
-        powerRange,
-        centerFrequency,
-        bandwidth,
-        linear
-    );
-    //qDebug() << "WSSpectrum::newSpectrum: " << payload.size() << " bytes in " << elapsed << " ms";
-
-    for (QWebSocket *pClient : qAsConst(m_clients)) {
-        pClient->sendBinaryMessage(payload);
+    m_payloads.clear();
+
+    for (QHash<quint32, DeltaState>::iterator it = m_deltaStates.begin(); it != m_deltaStates.end(); ++it) {
+        it.value().m_used = false;
+    }
+
+    for (QHash<QWebSocket*, ClientFormat>::iterator it = m_clients.begin(); it != m_clients.end(); ++it)
+    {
+        ClientFormat& format = it.value();
+        bool keyFrame = false;
+
+        if (format.m_encoding == EncodingDelta8)
+        {
+            const DeltaState& state = m_deltaStates[getFormatKey(format, false)];
+            keyFrame = format.m_needsKeyFrame || ((int) state.m_previous.size() != getNbValues(fftSize, format.m_nbBins));
+            format.m_needsKeyFrame = false;
+        }
+
+        quint32 formatKey = getFormatKey(format, keyFrame);
+        QHash<quint32, QByteArray>::iterator payloadIt = m_payloads.find(formatKey);
+
+        if (payloadIt == m_payloads.end()) // first client with this format in this frame
+        {
+            payloadIt = m_payloads.insert(formatKey, QByteArray());
+
+            if ((format.m_encoding == EncodingFloat32) && (getNbValues(fftSize, format.m_nbBins) == fftSize))
+            {
+                buildPayload(
+                    payloadIt.value(),
+                    spectrum,
+                    fftSize,
+                    elapsed,
+                    refLevel,
+                    powerRange,
+                    centerFrequency,
+                    bandwidth,
+                    linear
+                );
+            }
+            else
+            {
+                buildEncodedPayload(
+                    payloadIt.value(),
+                    format,
+                    keyFrame,
+                    spectrum,
+                    fftSize,
+                    elapsed,
+                    refLevel,
+                    powerRange,
+                    centerFrequency,
+                    bandwidth,
+                    linear
+                );
+            }
+        }
+
+        it.key()->sendBinaryMessage(payloadIt.value());
+    }
+
+    for (QHash<quint32, DeltaState>::iterator it = m_deltaStates.begin(); it != m_deltaStates.end();)
+    {
+        if (it.value().m_used)
+        {
+            it.value().m_previous.swap(it.value().m_current);
+            ++it;
+        }
+        else
+        {
+            it = m_deltaStates.erase(it); // no more clients with this format
+        }
     }
 }
 
@@ -162,3 +243,138 @@ void WSSpectrum::buildPayload(
     buffer.write((char*) spectrum.data(), fftSize*sizeof(Real));
     buffer.close();
 }
+
+void WSSpectrum::buildEncodedPayload(
+    QByteArray& bytes,
+    const ClientFormat& format,
+    bool keyFrame,
+    const std::vector<Real>& spectrum,
+    int fftSize,
+    int64_t fftTimeMs,
+    float refLevel,
+    float powerRange,
+    uint64_t centerFrequency,
+    int bandwidth,
+    bool linear
+)
+{
+    int nbValues = getNbValues(fftSize, format.m_nbBins);
+    int encoding = (int) format.m_encoding;
+    int flags = (nbValues != fftSize ? 1 : 0) | (keyFrame ? 2 : 0);
+    int linearInt = linear ? 1 : 0;
+
+    if (nbValues != fftSize) {
+        decimate(spectrum, fftSize, format.m_nbBins);
+    } else {
+        m_values.assign(spectrum.begin(), spectrum.begin() + fftSize);
+    }
+
+    bytes.reserve(48 + nbValues*sizeof(float));
+    bytes.append((const char*) &fftSize, sizeof(int));
+    bytes.append((const char*) &fftTimeMs, sizeof(int64_t));
+    bytes.append((const char*) &refLevel, sizeof(float));
+    bytes.append((const char*) &powerRange, sizeof(float));
+    bytes.append((const char*) &centerFrequency, sizeof(uint64_t));
+    bytes.append((const char*) &bandwidth, sizeof(int));
+    bytes.append((const char*) &linearInt, sizeof(int));
+    bytes.append((const char*) &encoding, sizeof(int));
+    bytes.append((const char*) &nbValues, sizeof(int));
+    bytes.append((const char*) &flags, sizeof(int));
+
+    if (format.m_encoding == EncodingFloat32)
+    {
+        bytes.append((const char*) m_values.data(), nbValues*sizeof(Real));
+    }
+    else if (format.m_encoding == EncodingQuantized16)
+    {
+        quantize(refLevel, powerRange, 1<<16);
+        bytes.append((const char*) m_quantized.data(), nbValues*sizeof(quint16));
+    }
+    else if (format.m_encoding == EncodingQuantized8)
+    {
+        quantize(refLevel, powerRange, 1<<8);
+
+        for (int i = 0; i < nbValues; i++) {
+            bytes.append((char) m_quantized[i]);
+        }
+    }
+    else // EncodingDelta8
+    {
+        quantize(refLevel, powerRange, 1<<8);
+        DeltaState& state = m_deltaStates[getFormatKey(format, false)];
+        state.m_current.resize(nbValues);
+        state.m_used = true;
+
+        for (int i = 0; i < nbValues; i++) {
+            state.m_current[i] = m_quantized[i];
+        }
+
+        if (keyFrame)
+        {
+            bytes.append((const char*) state.m_current.data(), nbValues);
+        }
+        else
+        {
+            int i = 0;
+
+            while (i < nbValues)
+            {
+                quint8 delta = state.m_current[i] - state.m_previous[i];
+
+                if (delta == 0) // run of unchanged values
+                {
+                    int run = 1;
+
+                    while ((i + run < nbValues) && (run < 255) && (state.m_current[i + run] == state.m_previous[i + run])) {
+                        run++;
+                    }
+
+                    bytes.append((char) 0);
+                    bytes.append((char) run);
+                    i += run;
+                }
+                else
+                {
+                    bytes.append((char) delta);
+                    i++;
+                }
+            }
+        }
+    }
+}
+
+void WSSpectrum::decimate(const std::vector<Real>& spectrum, int fftSize, int nbBins)
+{
+    m_values.resize(2*nbBins);
+
+    for (int i = 0; i < nbBins; i++)
+    {
+        int start = (int) (((int64_t) i * fftSize) / nbBins);
+        int end = (int) (((int64_t) (i + 1) * fftSize) / nbBins);
+        Real minValue = spectrum[start];
+        Real maxValue = spectrum[start];
+
+        for (int j = start + 1; j < end; j++)
+        {
+            minValue = spectrum[j] < minValue ? spectrum[j] : minValue;
+            maxValue = spectrum[j] > maxValue ? spectrum[j] : maxValue;
+        }
+
+        m_values[2*i] = minValue;
+        m_values[2*i + 1] = maxValue;
+    }
+}
+
+void WSSpectrum::quantize(float refLevel, float powerRange, int nbLevels)
+{
+    float low = refLevel - powerRange;
+    float scale = powerRange > 0.0f ? (nbLevels - 1) / powerRange : 0.0f;
+    float top = nbLevels - 1;
+    m_quantized.resize(m_values.size());
+
+    for (unsigned int i = 0; i < m_values.size(); i++)
+    {
+        float q = std::round((m_values[i] - low) * scale);
+        m_quantized[i] = q < 0.0f ? 0 : q > top ? (quint16) top : (quint16) q;
+    }
+}
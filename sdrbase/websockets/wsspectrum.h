@@ -21,7 +21,7 @@
 #include <vector>
 
 #include <QObject>
-#include <QList>
+#include <QHash>
 #include <QElapsedTimer>
 #include <QHostAddress>
 
@@ -32,10 +32,31 @@
 class QWebSocketServer;
 class QWebSocket;
 
+/**
+ * Binary websocket server of spectrum frames. Clients may negotiate the frame encoding
+ * by sending a text message: {"encoding": "float32", "bins": 0} where encoding is one of:
+ * - float32: the spectrum values as 32 bit floats (default, original format if bins is 0)
+ * - quantized16 or quantized8: values quantized on 16 or 8 bits in the [refLevel - powerRange, refLevel] range
+ * - delta8: 8 bit quantized values as a difference with the previous frame, zero runs being run length encoded
+ *   as a 0 byte followed by the run length. Frames are differences unless the keyframe flag is set.
+ * and bins is the number of display bins (0 for all). When bins is lower than the FFT size the
+ * minimum and maximum of the FFT bins falling in each display bin are sent.
+ * Apart from the original float32 format the header is followed by encoding (int32), number
+ * of values (int32) and flags (int32) with bit 0 set for min/max pairs and bit 1 for a keyframe.
+ * Each payload is built once per frame and per negotiated format and shared by its clients.
+ */
 class SDRBASE_API WSSpectrum : public QObject
 {
     Q_OBJECT
 public:
+    enum Encoding
+    {
+        EncodingFloat32,
+        EncodingQuantized16,
+        EncodingQuantized8,
+        EncodingDelta8
+    };
+
     explicit WSSpectrum(QObject *parent = nullptr);
     ~WSSpectrum() override;
 
@@ -60,13 +81,44 @@ private slots:
     void socketDisconnected();
 
 private:
+    struct ClientFormat
+    {
+        Encoding m_encoding;
+        int m_nbBins;          //!< 0 for all FFT bins
+        bool m_needsKeyFrame;  //!< delta encoding: next frame must be a keyframe
+
+        ClientFormat() :
+            m_encoding(EncodingFloat32),
+            m_nbBins(0),
+            m_needsKeyFrame(true)
+        {}
+    };
+
+    struct DeltaState
+    {
+        std::vector<quint8> m_previous; //!< 8 bit quantized values of the previous frame
+        std::vector<quint8> m_current;  //!< 8 bit quantized values of the current frame
+        bool m_used;                    //!< Format used in the current frame
+
+        DeltaState() :
+            m_used(false)
+        {}
+    };
+
     QHostAddress m_listeningAddress;
     quint16 m_port;
     QWebSocketServer* m_webSocketServer;
-    QList<QWebSocket*> m_clients;
+    QHash<QWebSocket*, ClientFormat> m_clients;
+    QHash<quint32, DeltaState> m_deltaStates;   //!< By format key
+    QHash<quint32, QByteArray> m_payloads;      //!< Payloads of the current frame by format key
+    std::vector<Real> m_values;
+    std::vector<quint16> m_quantized;
     QElapsedTimer m_timer;
 
     static QString getWebSocketIdentifier(QWebSocket *peer);
+    static quint32 getFormatKey(const ClientFormat& format, bool keyFrame) {
+        return (format.m_nbBins << 3) | (keyFrame ? 4 : 0) | format.m_encoding;
+    }
     void buildPayload(
         QByteArray& bytes,
         const std::vector<Real>& spectrum,
@@ -78,6 +130,24 @@ private:
         int bandwidth,
         bool linear
     );
+    void buildEncodedPayload(
+        QByteArray& bytes,
+        const ClientFormat& format,
+        bool keyFrame,
+        const std::vector<Real>& spectrum,
+        int fftSize,
+        int64_t fftTimeMs,
+        float refLevel,
+        float powerRange,
+        uint64_t centerFrequency,
+        int bandwidth,
+        bool linear
+    );
+    static int getNbValues(int fftSize, int nbBins) {
+        return (nbBins > 0) && (nbBins < fftSize) ? 2*nbBins : fftSize;
+    }
+    void decimate(const std::vector<Real>& spectrum, int fftSize, int nbBins);
+    void quantize(float refLevel, float powerRange, int nbLevels);
 };
 
 #endif // SDRBASE_WEBSOCKETS_WSSPECTRUM_H_
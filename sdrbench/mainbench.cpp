@@ -17,10 +17,29 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <deque>
+#include <memory>
+
 #include <QDebug>
 #include <QElapsedTimer>
+#include <QThread>
+#include <QMutex>
+#include <QQueue>
 
 #include "ambe/ambeengine.h"
+#include "audio/audiofifo.h"
+#include "dsp/interpolator.h"
+#include "dsp/hbfilterkernels.h"
+#include "dsp/samplemixer.h"
+#include "webapi/webapirequestmapper.h"
+#include "util/message.h"
+#include "util/messagequeue.h"
+#include "leansdr/framework.h"
+#include "leansdr/dvb.h"
+#include "leansdr/sdr.h"
+#include "atvdemodsink.h"
 
 #include "mainbench.h"
 
@@ -31,7 +50,8 @@ MainBench::MainBench(qtwebapp::LoggerWithFile *logger, const ParserBench& parser
     m_logger(logger),
     m_parser(parser),
     m_uniform_distribution_f(-1.0, 1.0),
-    m_uniform_distribution_s16(-2048, 2047)
+    m_uniform_distribution_s16(-2048, 2047),
+    m_result(0)
 {
     qDebug() << "MainBench::MainBench: start";
     m_instance = this;
@@ -50,20 +70,27 @@ void MainBench::run()
         << " repet: " << m_parser.getRepetition()
         << " log2f: " << m_parser.getLog2Factor();
 
-    if (m_parser.getTestType() == ParserBench::TestDecimatorsII) {
-        testDecimateII();
-    } else if (m_parser.getTestType() == ParserBench::TestDecimatorsInfII) {
-        testDecimateII(ParserBench::TestDecimatorsInfII);
-    } else if (m_parser.getTestType() == ParserBench::TestDecimatorsSupII) {
-        testDecimateII(ParserBench::TestDecimatorsSupII);
-    } else if (m_parser.getTestType() == ParserBench::TestDecimatorsIF) {
-        testDecimateIF();
-    } else if (m_parser.getTestType() == ParserBench::TestDecimatorsFI) {
-        testDecimateFI();
-    } else if (m_parser.getTestType() == ParserBench::TestDecimatorsFF) {
-        testDecimateFF();
+    if ((m_parser.getTestType() == ParserBench::TestDecimatorsII)
+     || (m_parser.getTestType() == ParserBench::TestDecimatorsInfII)
+     || (m_parser.getTestType() == ParserBench::TestDecimatorsSupII)
+     || (m_parser.getTestType() == ParserBench::TestDecimatorsIF)
+     || (m_parser.getTestType() == ParserBench::TestDecimatorsFI)
+     || (m_parser.getTestType() == ParserBench::TestDecimatorsFF)) {
+        testDecimators(m_parser.getTestType());
     } else if (m_parser.getTestType() == ParserBench::TestAMBE) {
         testAMBE();
+    } else if (m_parser.getTestType() == ParserBench::TestInterpolator) {
+        testInterpolator();
+    } else if (m_parser.getTestType() == ParserBench::TestWebAPIRouter) {
+        testWebAPIRouter();
+    } else if (m_parser.getTestType() == ParserBench::TestMessageQueue) {
+        testMessageQueue();
+    } else if (m_parser.getTestType() == ParserBench::TestATVDemod) {
+        m_result = testATVDemod();
+    } else if (m_parser.getTestType() == ParserBench::TestDATVPipeline) {
+        testDATVPipeline();
+    } else if (m_parser.getTestType() == ParserBench::TestSampleMixer) {
+        testSampleMixer();
     } else {
         qDebug() << "MainBench::run: unknown test type: " << m_parser.getTestType();
     }
@@ -71,6 +98,46 @@ void MainBench::run()
     emit finished();
 }
 
+void MainBench::testDecimators(ParserBench::TestType testType)
+{
+    // Run the test once for each instruction set the half band filter kernels support on this CPU
+    HBFilterKernels::ISA bestISA = HBFilterKernels::getISA();
+    std::vector<HBFilterKernels::ISA> isas = HBFilterKernels::getSupportedISAs();
+
+    for (HBFilterKernels::ISA isa : isas)
+    {
+        HBFilterKernels::setISA(isa);
+
+        switch (testType)
+        {
+        case ParserBench::TestDecimatorsInfII:
+        case ParserBench::TestDecimatorsSupII:
+            testDecimateII(testType);
+            break;
+        case ParserBench::TestDecimatorsIF:
+            testDecimateIF();
+            break;
+        case ParserBench::TestDecimatorsFI:
+            testDecimateFI();
+            break;
+        case ParserBench::TestDecimatorsFF:
+            testDecimateFF();
+            break;
+        case ParserBench::TestDecimatorsII:
+        default:
+            testDecimateII();
+            break;
+        }
+    }
+
+    HBFilterKernels::setISA(bestISA);
+}
+
+QString MainBench::isaPrefix(const QString& prefix)
+{
+    return QString("%1 [%2]").arg(prefix).arg(HBFilterKernels::getISAName(HBFilterKernels::getISA()));
+}
+
 void MainBench::testDecimateII(ParserBench::TestType testType)
 {
     QElapsedTimer timer;
@@ -108,7 +175,8 @@ void MainBench::testDecimateII(ParserBench::TestType testType)
         }
     }
 
-    printResults("MainBench::testDecimateII", nsecs);
+    // the 24 bit Rx DSP build (default) runs the 64 bit half band filter kernels
+    printResults(isaPrefix(QString("MainBench::testDecimateII %1 bit").arg(SDR_RX_SAMP_SZ)), nsecs);
 
     qDebug() << "MainBench::testDecimateII: cleanup test data";
     delete[] buf;
@@ -135,7 +203,7 @@ void MainBench::testDecimateIF()
         nsecs += timer.nsecsElapsed();
     }
 
-    printResults("MainBench::testDecimateIF", nsecs);
+    printResults(isaPrefix("MainBench::testDecimateIF"), nsecs);
 
     qDebug() << "MainBench::testDecimateIF: cleanup test data";
     delete[] buf;
@@ -162,7 +230,7 @@ void MainBench::testDecimateFI()
         nsecs += timer.nsecsElapsed();
     }
 
-    printResults("MainBench::testDecimateFI", nsecs);
+    printResults(isaPrefix("MainBench::testDecimateFI"), nsecs);
 
     qDebug() << "MainBench::testDecimateFI: cleanup test data";
     delete[] buf;
@@ -189,7 +257,7 @@ void MainBench::testDecimateFF()
         nsecs += timer.nsecsElapsed();
     }
 
-    printResults("MainBench::testDecimateFF", nsecs);
+    printResults(isaPrefix("MainBench::testDecimateFF"), nsecs);
 
     qDebug() << "MainBench::testDecimateFF: cleanup test data";
     delete[] buf;
@@ -205,6 +273,678 @@ void MainBench::testAMBE()
     for (std::vector<QString>::const_iterator it = ambeDevices.begin(); it != ambeDevices.end(); ++it) {
         qDebug("MainBench::testAMBE: detected AMBE device %s", qPrintable(*it));
     }
+
+    // scheduling of 2^log2 channels on 2 loopback devices at the real time pace of 20 ms frames
+    unsigned int nbChannels = 1 << m_parser.getLog2Factor();
+    unsigned int nbRounds = 50 * m_parser.getRepetition();
+    unsigned char mbeFrame[32] = {0}; // larger than any MBE frame
+    std::vector<AudioFifo*> audioFifos;
+    ambeEngine.registerController("loopback0");
+    ambeEngine.registerController("loopback1");
+
+    for (unsigned int i = 0; i < nbChannels; i++) {
+        audioFifos.push_back(new AudioFifo(48000));
+    }
+
+    qDebug("MainBench::testAMBE: %u channels on 2 loopback devices for %u frames", nbChannels, nbRounds);
+
+    for (unsigned int round = 0; round < nbRounds; round++)
+    {
+        for (AudioFifo *audioFifo : audioFifos) {
+            ambeEngine.pushMbeFrame(mbeFrame, 0, 30, 3, false, 1, audioFifo);
+        }
+
+        QThread::msleep(20);
+    }
+
+    QThread::msleep(600); // let the queues drain
+    std::vector<AMBEEngine::DeviceMetrics> metrics;
+    ambeEngine.getMetrics(metrics);
+
+    for (const AMBEEngine::DeviceMetrics& deviceMetrics : metrics)
+    {
+        QDebug info = qInfo();
+        info.noquote();
+        info << tr("MainBench::testAMBE: %1: channels: %2 decoded: %3 dropped: %4 batches: %5 latency avg: %6 ms max: %7 ms")
+            .arg(deviceMetrics.m_device)
+            .arg(deviceMetrics.m_nbChannels)
+            .arg(deviceMetrics.m_decodedFrames)
+            .arg(deviceMetrics.m_droppedFrames)
+            .arg(deviceMetrics.m_batches)
+            .arg(deviceMetrics.m_decodedFrames == 0 ? 0.0 : deviceMetrics.m_latencyTotalNs / (deviceMetrics.m_decodedFrames * 1e6), 0, 'f', 1)
+            .arg(deviceMetrics.m_latencyMaxNs / 1e6, 0, 'f', 1);
+    }
+
+    ambeEngine.releaseAll();
+
+    for (AudioFifo *audioFifo : audioFifos) {
+        delete audioFifo;
+    }
+}
+
+void MainBench::testInterpolator()
+{
+    QElapsedTimer timer;
+    qint64 nsecsSample = 0;
+    qint64 nsecsBlock = 0;
+    const int blockSize = 4096;
+    // channel to audio like ratio with a fractional part
+    Real distance = (1<<m_parser.getLog2Factor()) * 1.1f;
+
+    qDebug() << "MainBench::testInterpolator: create test data";
+
+    std::vector<Complex> buf(m_parser.getNbSamples());
+    std::vector<Complex> out;
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+
+    for (auto& c : buf) {
+        c = Complex(my_rand(), my_rand());
+    }
+
+    Interpolator interpolatorSample;
+    Interpolator interpolatorBlock;
+    interpolatorSample.create(16, 48000 * distance, 48000 / 2.2);
+    interpolatorBlock.create(16, 48000 * distance, 48000 / 2.2);
+    Real distanceRemainSample = 0;
+    Real distanceRemainBlock = 0;
+    Complex ci;
+    Real acc = 0; // consume outputs
+
+    qDebug() << "MainBench::testInterpolator: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (const auto& c : buf)
+        {
+            if (interpolatorSample.decimate(&distanceRemainSample, c, &ci))
+            {
+                acc += ci.real();
+                distanceRemainSample += distance;
+            }
+        }
+
+        nsecsSample += timer.nsecsElapsed();
+        timer.start();
+
+        for (unsigned int pos = 0; pos < buf.size(); pos += blockSize)
+        {
+            int nbIn = std::min(blockSize, (int) (buf.size() - pos));
+            int nbOut = interpolatorBlock.decimate(&distanceRemainBlock, distance, &buf[pos], nbIn, out);
+
+            for (int j = 0; j < nbOut; j++) {
+                acc += out[j].real();
+            }
+        }
+
+        nsecsBlock += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testInterpolator: sample", nsecsSample);
+    printResults("MainBench::testInterpolator: block", nsecsBlock);
+    qDebug() << "MainBench::testInterpolator: checksum:" << acc;
+}
+
+void MainBench::testWebAPIRouter()
+{
+    QElapsedTimer timer;
+    const QByteArray paths[] = {
+        "/sdrangel",
+        "/sdrangel/audio/output/parameters",
+        "/sdrangel/deviceset/0",
+        "/sdrangel/deviceset/1/device/settings",
+        "/sdrangel/deviceset/1/device/report",
+        "/sdrangel/deviceset/1/subdevice/0/run",
+        "/sdrangel/deviceset/1/channels/report",
+        "/sdrangel/deviceset/1/channel/12/settings",
+        "/sdrangel/deviceset/1/channel/12/report",
+        "/index.html" // static documentation (no route)
+    };
+
+    qDebug() << "MainBench::testWebAPIRouter: create mapper";
+    WebAPIRequestMapper mapper;
+    const WebAPIRouter& router = mapper.getRouter();
+    int acc = 0; // consume results
+
+    qDebug() << "MainBench::testWebAPIRouter: run test";
+
+    for (const QByteArray& path : paths)
+    {
+        qint64 nsecs = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            timer.start();
+
+            for (uint32_t j = 0; j < m_parser.getNbSamples(); j++)
+            {
+                WebAPIRouter::Match match;
+                router.match(path, match);
+                acc += match.m_routeId;
+            }
+
+            nsecs += timer.nsecsElapsed();
+        }
+
+        double nsPerDispatch = nsecs / ((double) m_parser.getNbSamples() * m_parser.getRepetition());
+        QDebug info = qInfo();
+        info.noquote();
+        info << tr("MainBench::testWebAPIRouter: %1: %2 ns per dispatch").arg(QString(path)).arg(nsPerDispatch, 0, 'f', 1);
+    }
+
+    qDebug() << "MainBench::testWebAPIRouter: checksum:" << acc;
+}
+
+namespace {
+
+// typical report message size
+class MsgBench : public Message {
+public:
+    MsgBench(int producer, unsigned int sequence) : m_producer(producer), m_sequence(sequence) {}
+    int m_producer;
+    unsigned int m_sequence;
+    qint64 m_payload[4];
+};
+
+// MessageQueue as it was before the lock-free implementation
+class MutexMessageQueue {
+public:
+    void push(Message *message, bool) { QMutexLocker locker(&m_lock); m_queue.append(message); }
+    Message *pop() { QMutexLocker locker(&m_lock); return m_queue.isEmpty() ? nullptr : m_queue.takeFirst(); }
+    int size() { QMutexLocker locker(&m_lock); return m_queue.size(); }
+private:
+    QMutex m_lock;
+    QQueue<Message*> m_queue;
+};
+
+template<typename QueueType>
+class BenchProducer : public QThread {
+public:
+    BenchProducer(QueueType& queue, int producer, unsigned int nbMessages) :
+        m_queue(queue), m_producer(producer), m_nbMessages(nbMessages) {}
+protected:
+    void run() override
+    {
+        for (unsigned int i = 0; i < m_nbMessages; i++)
+        {
+            while (m_queue.size() > 4096) { // keep a realistic number of messages in flight
+                QThread::yieldCurrentThread();
+            }
+
+            m_queue.push(new MsgBench(m_producer, i), false);
+        }
+    }
+private:
+    QueueType& m_queue;
+    int m_producer;
+    unsigned int m_nbMessages;
+};
+
+// returns ns per message
+template<typename QueueType>
+double runMessageQueue(int nbProducers, unsigned int nbMessages)
+{
+    QueueType queue;
+    std::vector<BenchProducer<QueueType>*> producers;
+    std::vector<unsigned int> expected(nbProducers, 0);
+    unsigned int perProducer = nbMessages / nbProducers;
+    unsigned int received = 0;
+    bool ordered = true;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int p = 0; p < nbProducers; p++)
+    {
+        producers.push_back(new BenchProducer<QueueType>(queue, p, perProducer));
+        producers.back()->start();
+    }
+
+    while (received < perProducer * nbProducers)
+    {
+        Message *message = queue.pop();
+
+        if (!message) {
+            continue;
+        }
+
+        MsgBench *msg = static_cast<MsgBench*>(message);
+        ordered = ordered && (msg->m_sequence == expected[msg->m_producer]);
+        expected[msg->m_producer] = msg->m_sequence + 1;
+        received++;
+        delete message;
+    }
+
+    qint64 nsecs = timer.nsecsElapsed();
+
+    for (auto producer : producers)
+    {
+        producer->wait();
+        delete producer;
+    }
+
+    if (!ordered) {
+        qWarning("runMessageQueue: messages of a producer were received out of order");
+    }
+
+    return nsecs / (double) received;
+}
+
+} // namespace
+
+void MainBench::testMessageQueue()
+{
+    unsigned int nbMessages = m_parser.getNbSamples();
+    int nbProducersList[] = {1, 2, 4, QThread::idealThreadCount()};
+
+    qDebug() << "MainBench::testMessageQueue: run test";
+
+    for (int nbProducers : nbProducersList)
+    {
+        double nsLockFree = 0, nsMutex = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            nsLockFree += runMessageQueue<MessageQueue>(nbProducers, nbMessages);
+            nsMutex += runMessageQueue<MutexMessageQueue>(nbProducers, nbMessages);
+        }
+
+        QDebug info = qInfo();
+        info.noquote();
+        info << tr("MainBench::testMessageQueue: %1 producers: lock-free: %2 ns/msg mutex: %3 ns/msg")
+            .arg(nbProducers)
+            .arg(nsLockFree / m_parser.getRepetition(), 0, 'f', 1)
+            .arg(nsMutex / m_parser.getRepetition(), 0, 'f', 1);
+    }
+}
+
+namespace {
+
+// Analog TV screen of the benchmark that keeps the completed frames for comparison
+class BenchTVScreen : public TVScreenAnalogBuffers
+{
+public:
+    struct Frame
+    {
+        std::vector<int> m_image;
+        std::vector<int> m_lineShifts;
+    };
+
+    BenchTVScreen() :
+        m_frontBuffer(std::make_shared<TVScreenAnalogBuffer>(5, 1)),
+        m_backBuffer(std::make_shared<TVScreenAnalogBuffer>(5, 1))
+    {}
+
+    std::shared_ptr<TVScreenAnalogBuffer> getBackBuffer() override { return m_backBuffer; }
+
+    std::shared_ptr<TVScreenAnalogBuffer> swapBuffers() override
+    {
+        std::swap(m_frontBuffer, m_backBuffer);
+        const int *image = m_frontBuffer->getImageData();
+        const int *lineShifts = m_frontBuffer->getLineShiftData();
+        m_frames.push_back(Frame());
+        m_frames.back().m_image.assign(image, image + m_frontBuffer->getWidth() * m_frontBuffer->getHeight());
+        m_frames.back().m_lineShifts.assign(lineShifts, lineShifts + m_frontBuffer->getHeight());
+        return m_backBuffer;
+    }
+
+    void resizeTVScreen(int intCols, int intRows) override
+    {
+        int colsAdj = intCols + 4;
+
+        if ((m_frontBuffer->getWidth() != colsAdj) || (m_frontBuffer->getHeight() != intRows))
+        {
+            m_frontBuffer = std::make_shared<TVScreenAnalogBuffer>(colsAdj, intRows);
+            m_backBuffer = std::make_shared<TVScreenAnalogBuffer>(colsAdj, intRows);
+        }
+    }
+
+    std::deque<Frame> m_frames;
+
+private:
+    std::shared_ptr<TVScreenAnalogBuffer> m_frontBuffer;
+    std::shared_ptr<TVScreenAnalogBuffer> m_backBuffer;
+};
+
+// largest absolute difference between two vectors of the same size
+int maxDifference(const std::vector<int>& a, const std::vector<int>& b)
+{
+    int maxDiff = 0;
+
+    for (unsigned int i = 0; i < a.size(); i++) {
+        maxDiff = std::max(maxDiff, std::abs(a[i] - b[i]));
+    }
+
+    return maxDiff;
+}
+
+}
+
+int MainBench::testATVDemod()
+{
+    const int sampleRate = 8000000;
+    const int nbLinesList[] = {625, 525}; // PAL, NTSC like
+    const int fpsList[] = {25, 30};
+    const ATVDemodSettings::ATVStd atvStdList[] = {ATVDemodSettings::ATVStdPAL625, ATVDemodSettings::ATVStdPAL525};
+    const char *standardNames[] = {"PAL", "NTSC"};
+    const int chunkSize = 1000; // not a multiple of the line length so that lines span several calls
+    int result = 0;
+
+    for (int k = 0; k < 2; k++)
+    {
+        QElapsedTimer timer;
+        qint64 nsecsSample = 0;
+        qint64 nsecsLine = 0;
+        int samplesPerLine = sampleRate / (nbLinesList[k] * fpsList[k]);
+
+        qDebug() << "MainBench::testATVDemod: create test data" << standardNames[k];
+
+        std::vector<Complex> buf((m_parser.getNbSamples() / samplesPerLine) * samplesPerLine); // whole lines
+        generateATV(buf, sampleRate, nbLinesList[k], fpsList[k]);
+        SampleVector samples(buf.size());
+
+        for (unsigned int i = 0; i < buf.size(); i++) {
+            samples[i] = Sample((FixReal) buf[i].real(), (FixReal) buf[i].imag());
+        }
+
+        // the same FM1 demodulator sample by sample (reference) and line by line
+        ATVDemodSettings settings;
+        settings.m_atvModulation = ATVDemodSettings::ATV_FM1;
+        settings.m_fmDeviation = 0.5f;
+        settings.m_nbLines = nbLinesList[k];
+        settings.m_fps = fpsList[k];
+        settings.m_atvStd = atvStdList[k];
+        settings.m_hSync = true;
+        settings.m_vSync = true;
+        BenchTVScreen sampleScreen, lineScreen;
+        ATVDemodSink sampleSink, lineSink;
+        sampleSink.setTVScreen(&sampleScreen);
+        lineSink.setTVScreen(&lineScreen);
+        settings.m_lineProcessing = false;
+        sampleSink.applySettings(settings, true);
+        sampleSink.applyChannelSettings(sampleRate, 0, true);
+        settings.m_lineProcessing = true;
+        lineSink.applySettings(settings, true);
+        lineSink.applyChannelSettings(sampleRate, 0, true);
+
+        int nbFrames = 0;
+        int maxImageDiff = 0;
+        int maxLineShiftDiff = 0;
+
+        qDebug() << "MainBench::testATVDemod: run test" << standardNames[k];
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            for (unsigned int pos = 0; pos < samples.size(); pos += chunkSize)
+            {
+                SampleVector::const_iterator begin = samples.begin() + pos;
+                SampleVector::const_iterator end = samples.begin() + std::min((unsigned int) samples.size(), pos + chunkSize);
+
+                timer.start();
+                sampleSink.feed(begin, end);
+                nsecsSample += timer.nsecsElapsed();
+                timer.start();
+                lineSink.feed(begin, end);
+                nsecsLine += timer.nsecsElapsed();
+
+                // compare the frames completed by both
+                while (!sampleScreen.m_frames.empty() && !lineScreen.m_frames.empty())
+                {
+                    const BenchTVScreen::Frame& sampleFrame = sampleScreen.m_frames.front();
+                    const BenchTVScreen::Frame& lineFrame = lineScreen.m_frames.front();
+
+                    if ((sampleFrame.m_image.size() != lineFrame.m_image.size())
+                     || (sampleFrame.m_lineShifts.size() != lineFrame.m_lineShifts.size()))
+                    {
+                        maxImageDiff = 256;
+                    }
+                    else
+                    {
+                        maxImageDiff = std::max(maxImageDiff, maxDifference(sampleFrame.m_image, lineFrame.m_image));
+                        maxLineShiftDiff = std::max(maxLineShiftDiff, maxDifference(sampleFrame.m_lineShifts, lineFrame.m_lineShifts));
+                    }
+
+                    sampleScreen.m_frames.pop_front();
+                    lineScreen.m_frames.pop_front();
+                    nbFrames++;
+                }
+            }
+        }
+
+        // the line path scales the video with a multiply-add where the sample path divides
+        // so a gray level or a line shift may be one off from float rounding
+        bool ok = sampleScreen.m_frames.empty() && lineScreen.m_frames.empty()
+            && (maxImageDiff <= 1) && (maxLineShiftDiff <= 1)
+            && (sampleSink.getHSyncCount() == lineSink.getHSyncCount())
+            && (sampleSink.getVSyncCount() == lineSink.getVSyncCount());
+
+        printResults(QString("MainBench::testATVDemod: %1 sample").arg(standardNames[k]), nsecsSample);
+        printResults(QString("MainBench::testATVDemod: %1 line").arg(standardNames[k]), nsecsLine);
+        QDebug info = qInfo();
+        info.noquote();
+        info << tr("MainBench::testATVDemod: %1 frames: %2 (%3 %4 left) max difference image: %5 line shift: %6 hsync: %7 %8 vsync: %9 %10: %11")
+            .arg(standardNames[k])
+            .arg(nbFrames)
+            .arg(sampleScreen.m_frames.size())
+            .arg(lineScreen.m_frames.size())
+            .arg(maxImageDiff)
+            .arg(maxLineShiftDiff)
+            .arg(sampleSink.getHSyncCount())
+            .arg(lineSink.getHSyncCount())
+            .arg(sampleSink.getVSyncCount())
+            .arg(lineSink.getVSyncCount())
+            .arg(ok ? "OK" : "FAIL");
+
+        if (!ok) {
+            result = 1;
+        }
+    }
+
+    return result;
+}
+
+void MainBench::generateATV(std::vector<Complex>& buf, int sampleRate, int nbLines, int fps)
+{
+    // FM modulated bar chart with the timings and levels of ATVModSource
+    const float blackLevel = 0.3f;
+    const float spanLevel = 0.7f;
+    const float fmExcursion = 0.5f;
+    const int nbBars = 6;
+    int pointsPerLine = sampleRate / (nbLines * fps);
+    int pointsPerSync = (4.7f / 64.0f) * pointsPerLine;
+    int pointsPerBP = (5.8f / 64.0f) * pointsPerLine;
+    int pointsPerFP = (1.5f / 64.0f) * pointsPerLine;
+    int pointsPerVSync = ((32.0f - 4.7f) / 64.0f) * pointsPerLine;
+    int pointsPerImgLine = pointsPerLine - pointsPerSync - pointsPerBP - pointsPerFP;
+    int pointsPerHBar = std::max(1, pointsPerImgLine / nbBars);
+    float phase = 0.0f;
+
+    for (unsigned int i = 0; i < buf.size(); i++)
+    {
+        int lineNumber = (i / pointsPerLine) % nbLines;
+        int horizontalCount = i % pointsPerLine;
+        int fieldLine = lineNumber < nbLines / 2 ? lineNumber : lineNumber - nbLines / 2;
+        float t;
+
+        if (fieldLine < 3) { // field synchronization: broad pulses on both half lines
+            t = (horizontalCount % (pointsPerLine / 2)) < pointsPerVSync ? 0.0f : blackLevel;
+        } else if (horizontalCount < pointsPerSync) { // sync pulse (ultra-black)
+            t = 0.0f;
+        } else if (horizontalCount < pointsPerSync + pointsPerBP) { // back porch
+            t = blackLevel;
+        } else if (horizontalCount < pointsPerSync + pointsPerBP + pointsPerImgLine) { // horizontal bars
+            int bar = std::min((horizontalCount - pointsPerSync - pointsPerBP) / pointsPerHBar, nbBars - 1);
+            t = bar * (spanLevel / (nbBars - 1)) + blackLevel;
+        } else { // front porch
+            t = blackLevel;
+        }
+
+        phase += (t - 0.5f) * fmExcursion * M_PI;
+        phase = phase > 2.0f * M_PI ? phase - 2.0f * M_PI : phase < 0 ? phase + 2.0f * M_PI : phase;
+        buf[i] = Complex(cos(phase), sin(phase)) * (SDR_RX_SCALEF * 0.9f);
+    }
+}
+
+void MainBench::testDATVPipeline()
+{
+    // DVB-S QPSK FEC 1/2: 204 bytes RS packets give 1632 symbols
+    // the interleaver holds back the last 11 packets
+    int nbPackets = m_parser.getNbSamples() / (leansdr::SIZE_RSPACKET * 8) + 11;
+    std::vector<leansdr::eucl_ss> symbols;
+    std::vector<leansdr::tspacket> serialPackets;
+    std::vector<leansdr::tspacket> pipelinedPackets;
+    qint64 nsecsSerial = 0;
+    qint64 nsecsPipelined = 0;
+    bool identical = true;
+
+    qDebug() << "MainBench::testDATVPipeline: create test data";
+
+    encodeDATV(nbPackets, symbols);
+
+    qDebug() << "MainBench::testDATVPipeline: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        serialPackets.clear();
+        pipelinedPackets.clear();
+        nsecsSerial += decodeDATV(symbols, false, serialPackets);
+        nsecsPipelined += decodeDATV(symbols, true, pipelinedPackets);
+        identical = identical && (serialPackets.size() == pipelinedPackets.size());
+
+        for (unsigned int j = 0; identical && (j < serialPackets.size()); j++) {
+            identical = std::equal(serialPackets[j].data, serialPackets[j].data + leansdr::tspacket::SIZE, pipelinedPackets[j].data);
+        }
+    }
+
+    printResults("MainBench::testDATVPipeline: serial", nsecsSerial);
+    printResults("MainBench::testDATVPipeline: pipelined", nsecsPipelined);
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testDATVPipeline: sent: %1 decoded serial: %2 pipelined: %3 frames: %4")
+        .arg(nbPackets)
+        .arg(serialPackets.size())
+        .arg(pipelinedPackets.size())
+        .arg(serialPackets.size() == 0 ? "none decoded" : identical ? "identical" : "DIFFERENT");
+}
+
+void MainBench::encodeDATV(int nbPackets, std::vector<leansdr::eucl_ss>& symbols)
+{
+    // random TS packets through the DVB-S transmit chain to noiseless hard symbols
+    leansdr::scheduler scheduler;
+    leansdr::pipebuf<leansdr::tspacket> tsPackets(&scheduler, "TS packets", nbPackets);
+    leansdr::pipebuf<leansdr::tspacket> randTsPackets(&scheduler, "rand TS packets", nbPackets);
+    leansdr::pipebuf<leansdr::rspacket<leansdr::u8>> rsPackets(&scheduler, "RS-enc packets", nbPackets);
+    leansdr::pipebuf<leansdr::u8> bytes(&scheduler, "bytes", nbPackets * leansdr::SIZE_RSPACKET);
+    leansdr::pipebuf<leansdr::u8> hardSymbols(&scheduler, "hard symbols", nbPackets * leansdr::SIZE_RSPACKET * 8);
+    leansdr::randomizer randomizer(&scheduler, tsPackets, randTsPackets);
+    leansdr::rs_encoder rsEncoder(&scheduler, randTsPackets, rsPackets);
+    leansdr::interleaver interleaver(&scheduler, rsPackets, bytes);
+    leansdr::dvb_convol convol(&scheduler, bytes, hardSymbols, leansdr::FEC12, 2);
+    leansdr::pipewriter<leansdr::tspacket> tsWriter(tsPackets);
+    leansdr::pipereader<leansdr::u8> hardReader(hardSymbols);
+    std::uniform_int_distribution<int> byteDistribution(0, 255);
+
+    for (int i = 0; i < nbPackets; i++)
+    {
+        leansdr::tspacket *packet = tsWriter.wr();
+        packet->data[0] = leansdr::MPEG_SYNC;
+
+        for (int j = 1; j < leansdr::tspacket::SIZE; j++) {
+            packet->data[j] = byteDistribution(m_generator);
+        }
+
+        tsWriter.written(1);
+    }
+
+    scheduler.run();
+    int nbSymbols = hardReader.readable();
+    symbols.resize(nbSymbols);
+
+    for (int i = 0; i < nbSymbols; i++)
+    {
+        symbols[i].nearest = hardReader.rd()[i] & 3;
+        leansdr::softsymb_harden(&symbols[i]);
+        symbols[i].discr2 = 1;
+    }
+
+    hardReader.read(nbSymbols);
+}
+
+qint64 MainBench::decodeDATV(const std::vector<leansdr::eucl_ss>& symbols, bool pipelined, std::vector<leansdr::tspacket>& packets)
+{
+    // DVB-S decoding stages of DATVDemodSink with the same buffer sizes and pinning
+    QElapsedTimer timer;
+    timer.start();
+    const int bufFactor = 4;
+    leansdr::scheduler scheduler(pipelined ? 1 : 0);
+    leansdr::pipebuf<leansdr::eucl_ss> softSymbols(&scheduler, "PSK soft-symbols", 1024 * bufFactor);
+    leansdr::pipebuf<leansdr::u8> bytes(&scheduler, "bytes", 2048 * bufFactor);
+    leansdr::pipebuf<leansdr::u8> mpegBytes(&scheduler, "mpegbytes", 2448 * bufFactor);
+    leansdr::pipebuf<leansdr::rspacket<leansdr::u8>> rsPackets(&scheduler, "RS-enc packets", bufFactor);
+    leansdr::pipebuf<leansdr::tspacket> randTsPackets(&scheduler, "rand TS packets", bufFactor);
+    leansdr::pipebuf<leansdr::tspacket> tsPackets(&scheduler, "TS packets", bufFactor);
+    leansdr::deconvol_sync_simple *deconv = leansdr::make_deconvol_sync_simple(&scheduler, softSymbols, bytes, leansdr::FEC12);
+    leansdr::mpeg_sync<leansdr::u8, 0> syncMpeg(&scheduler, bytes, mpegBytes, deconv);
+    leansdr::deinterleaver<leansdr::u8> deinterleaver(&scheduler, mpegBytes, rsPackets);
+    leansdr::rs_decoder<leansdr::u8, 0> rsDecoder(&scheduler, rsPackets, randTsPackets);
+    leansdr::derandomizer derandomizer(&scheduler, randTsPackets, tsPackets);
+    leansdr::pipewriter<leansdr::eucl_ss> symbolWriter(softSymbols);
+    leansdr::pipereader<leansdr::tspacket> tsReader(tsPackets);
+
+    if (pipelined)
+    {
+        scheduler.pin(deconv, 1);
+        scheduler.pin(&syncMpeg, 1);
+        scheduler.pin(&deinterleaver, 1);
+        scheduler.pin(&rsDecoder, 1);
+        scheduler.pin(&derandomizer, 1);
+    }
+
+    unsigned int pos = 0;
+    int idle = 0;
+
+    // feed the symbols and collect the packets until the decoding stages are idle
+    while (idle < (pipelined ? 100 : 1))
+    {
+        long nbWrite = std::min((long) (symbols.size() - pos), symbolWriter.writable());
+
+        if (nbWrite > 0)
+        {
+            std::copy(symbols.begin() + pos, symbols.begin() + pos + nbWrite, symbolWriter.wr());
+            symbolWriter.written(nbWrite);
+            pos += nbWrite;
+        }
+
+        if (pipelined) {
+            scheduler.step();
+        } else {
+            scheduler.run();
+        }
+
+        long nbRead = tsReader.readable();
+        packets.insert(packets.end(), tsReader.rd(), tsReader.rd() + nbRead);
+        tsReader.read(nbRead);
+
+        if ((nbWrite > 0) || (nbRead > 0))
+        {
+            idle = 0;
+        }
+        else
+        {
+            if (pos == symbols.size()) {
+                idle++;
+            }
+
+            if (pipelined) {
+                QThread::usleep(100);
+            }
+        }
+    }
+
+    scheduler.shutdown();
+    delete deconv;
+
+    return timer.nsecsElapsed();
 }
 
 void MainBench::decimateII(const qint16* buf, int len)
@@ -399,6 +1139,67 @@ void MainBench::decimateFF(const float *buf, int len)
     }
 }
 
+void MainBench::testSampleMixer()
+{
+    // two Tx sources with different gains mixed as in the sink engine
+    const float gainA = 0.25f;
+    const float gainB = 2.0f;
+    const float scale = 0.5f; // 1 / number of sources
+    const float txMin = -(float) (1 << (SDR_TX_SAMP_SZ - 1));
+    const float txMax = (float) ((1 << (SDR_TX_SAMP_SZ - 1)) - 1);
+    unsigned int nbSamples = m_parser.getNbSamples();
+    SampleVector sourceA(nbSamples);
+    SampleVector sourceB(nbSamples);
+    SampleVector mix(nbSamples);
+    SampleMixer sampleMixer;
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    long maxError = 0;
+
+    qDebug() << "MainBench::testSampleMixer: create test data";
+
+    // full range so that some sums saturate
+    std::uniform_int_distribution<int> distribution(-(1 << (SDR_TX_SAMP_SZ - 1)), (1 << (SDR_TX_SAMP_SZ - 1)) - 1);
+
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        sourceA[i] = Sample(distribution(m_generator), distribution(m_generator));
+        sourceB[i] = Sample(distribution(m_generator), distribution(m_generator));
+    }
+
+    qDebug() << "MainBench::testSampleMixer: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+        sampleMixer.reset(nbSamples);
+        sampleMixer.add(sourceA.begin(), nbSamples, gainA);
+        sampleMixer.add(sourceB.begin(), nbSamples, gainB);
+        sampleMixer.output(mix.begin(), nbSamples, scale);
+        nsecs += timer.nsecsElapsed();
+    }
+
+    // weighted sum computed in double as the reference, 1 LSB allowed for float rounding
+    for (unsigned int i = 0; i < nbSamples; i++)
+    {
+        double re = ((double) sourceA[i].m_real * gainA + (double) sourceB[i].m_real * gainB) * scale;
+        double im = ((double) sourceA[i].m_imag * gainA + (double) sourceB[i].m_imag * gainB) * scale;
+        re = re < txMin ? txMin : re > txMax ? txMax : re;
+        im = im < txMin ? txMin : im > txMax ? txMax : im;
+        maxError = std::max(maxError, std::labs(std::lrint(re) - (long) mix[i].m_real));
+        maxError = std::max(maxError, std::labs(std::lrint(im) - (long) mix[i].m_imag));
+    }
+
+    printResults("MainBench::testSampleMixer", nsecs);
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testSampleMixer: gains: %1 %2 max error: %3 LSB: %4")
+        .arg(gainA)
+        .arg(gainB)
+        .arg(maxError)
+        .arg(maxError > 1 ? "FAIL" : "OK");
+}
+
 void MainBench::printResults(const QString& prefix, qint64 nsecs)
 {
     double ratekSs = (m_parser.getNbSamples()*m_parser.getRepetition() / (double) nsecs) * 1e6;
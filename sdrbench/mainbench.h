@@ -34,6 +34,11 @@ namespace qtwebapp {
     class LoggerWithFile;
 }
 
+namespace leansdr {
+    struct eucl_ss;
+    struct tspacket;
+}
+
 class MainBench: public QObject {
     Q_OBJECT
 
@@ -41,6 +46,8 @@ public:
     explicit MainBench(qtwebapp::LoggerWithFile *logger, const ParserBench& parser, QObject *parent = 0);
     ~MainBench();
 
+    int getResult() const { return m_result; } //!< non zero if the test failed
+
 public slots:
     void run();
 
@@ -48,11 +55,18 @@ signals:
     void finished();
 
 private:
+    void testDecimators(ParserBench::TestType testType);
     void testDecimateII(ParserBench::TestType testType = ParserBench::TestDecimatorsII);
     void testDecimateIF();
     void testDecimateFI();
     void testDecimateFF();
     void testAMBE();
+    void testInterpolator();
+    void testWebAPIRouter();
+    void testMessageQueue();
+    int testATVDemod();
+    void testDATVPipeline();
+    void testSampleMixer();
     void decimateII(const qint16 *buf, int len);
     void decimateInfII(const qint16 *buf, int len);
     void decimateSupII(const qint16 *buf, int len);
@@ -60,6 +74,10 @@ private:
     void decimateFI(const float *buf, int len);
     void decimateFF(const float *buf, int len);
     void printResults(const QString& prefix, qint64 nsecs);
+    static QString isaPrefix(const QString& prefix);
+    static void generateATV(std::vector<Complex>& buf, int sampleRate, int nbLines, int fps);
+    void encodeDATV(int nbPackets, std::vector<leansdr::eucl_ss>& symbols);
+    static qint64 decodeDATV(const std::vector<leansdr::eucl_ss>& symbols, bool pipelined, std::vector<leansdr::tspacket>& packets);
 
     static MainBench *m_instance;
     qtwebapp::LoggerWithFile *m_logger;
@@ -67,6 +85,7 @@ private:
     std::mt19937 m_generator;
     std::uniform_real_distribution<float> m_uniform_distribution_f;
     std::uniform_int_distribution<qint16> m_uniform_distribution_s16;
+    int m_result;
 
 	Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12, true> m_decimatorsII;
 	DecimatorsIF<qint16, 12, true> m_decimatorsIF;
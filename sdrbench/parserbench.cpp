@@ -24,7 +24,7 @@
 
 ParserBench::ParserBench() :
     m_testOption(QStringList() << "t" << "test",
-        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe",
+        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe, interpolator, webapirouter, messagequeue, atvdemod, datvpipeline, samplemixer",
         "test",
         "decimateii"),
     m_nbSamplesOption(QStringList() << "n" << "nb-samples",
@@ -127,6 +127,18 @@ ParserBench::TestType ParserBench::getTestType() const
         return TestDecimatorsSupII;
     } else if (m_testStr == "ambe") {
         return TestAMBE;
+    } else if (m_testStr == "interpolator") {
+        return TestInterpolator;
+    } else if (m_testStr == "webapirouter") {
+        return TestWebAPIRouter;
+    } else if (m_testStr == "messagequeue") {
+        return TestMessageQueue;
+    } else if (m_testStr == "atvdemod") {
+        return TestATVDemod;
+    } else if (m_testStr == "datvpipeline") {
+        return TestDATVPipeline;
+    } else if (m_testStr == "samplemixer") {
+        return TestSampleMixer;
     } else {
         return TestDecimatorsII;
     }
@@ -33,7 +33,13 @@ public:
         TestDecimatorsFF,
         TestDecimatorsInfII,
         TestDecimatorsSupII,
-        TestAMBE
+        TestAMBE,
+        TestInterpolator,
+        TestWebAPIRouter,
+        TestMessageQueue,
+        TestATVDemod,
+        TestDATVPipeline,
+        TestSampleMixer
     } TestType;
 
     ParserBench();
@@ -16,16 +16,13 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#if 0 //def USE_SSE2
-#include <emmintrin.h>
-#endif
-
 #include <QMouseEvent>
 #include <QOpenGLShaderProgram>
 #include <QOpenGLFunctions>
 #include <QPainter>
 #include <QFontDatabase>
 #include "gui/glspectrum.h"
+#include "gui/glspectrumkernels.h"
 #include "util/messagequeue.h"
 
 #include <QDebug>
@@ -54,6 +51,9 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
 	m_displayMaxHold(false),
 	m_currentSpectrum(0),
 	m_displayCurrent(false),
+	m_deferredUpdate(false),
+	m_backFftSize(0),
+	m_backPending(false),
     m_leftMargin(0),
     m_rightMargin(0),
     m_topMargin(0),
@@ -399,8 +399,22 @@ void GLSpectrum::removeChannelMarker(ChannelMarker* channelMarker)
 
 void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int fftSize)
 {
+	if (m_deferredUpdate)
+	{
+		// only copy the frame on the DSP thread. The GUI thread processes the latest one on its next tick.
+		QMutexLocker backLocker(&m_backMutex);
+		m_backSpectrum.assign(spectrum.begin(), spectrum.begin() + fftSize);
+		m_backFftSize = fftSize;
+		m_backPending = true;
+		return;
+	}
+
 	QMutexLocker mutexLocker(&m_mutex);
+	processSpectrum(spectrum, fftSize);
+}
 
+void GLSpectrum::processSpectrum(const std::vector<Real>& spectrum, int fftSize)
+{
 	m_displayChanged = true;
 
 	if (m_changesPending)
@@ -425,135 +439,26 @@ void GLSpectrum::updateWaterfall(const std::vector<Real>& spectrum)
 	if (m_waterfallBufferPos < m_waterfallBuffer->height())
     {
 		quint32* pix = (quint32*)m_waterfallBuffer->scanLine(m_waterfallBufferPos);
-
-		for (int i = 0; i < m_fftSize; i++)
-        {
-			int v = (int)((spectrum[i] - m_referenceLevel) * 2.4 * 100.0 / m_powerRange + 240.0);
-
-            if (v > 239) {
-				v = 239;
-            } else if (v < 0) {
-				v = 0;
-            }
-
-			*pix++ = m_waterfallPalette[(int)v];
-		}
-
+		GLSpectrumKernels::mapToPalette(spectrum.data(), m_fftSize, m_referenceLevel, m_powerRange, m_waterfallPalette, pix);
 		m_waterfallBufferPos++;
 	}
 }
 
 void GLSpectrum::updateHistogram(const std::vector<Real>& spectrum)
 {
-	quint8* b = m_histogram;
-	int fftMulSize = 100 * m_fftSize;
-
 	if ((m_displayHistogram || m_displayMaxHold) && (m_decay != 0))
 	{
 		m_decayDivisorCount--;
 
 		if ((m_decay > 1) || (m_decayDivisorCount <= 0))
 		{
-			for (int i = 0; i < fftMulSize; i++)
-			{
-				if (*b > m_decay) {
-					*b = *b - m_decay;
-				} else {
-				    *b = 0;
-				}
-
-				b++;
-			}
-
+			GLSpectrumKernels::decayHistogram(m_histogram, 100 * m_fftSize, m_decay);
 			m_decayDivisorCount = m_decayDivisor;
 		}
 	}
 
 	m_currentSpectrum = &spectrum; // Store spectrum for current spectrum line display
-
-#if 0 //def USE_SSE2
-    if(m_decay >= 0) { // normal
-        const __m128 refl = {m_referenceLevel, m_referenceLevel, m_referenceLevel, m_referenceLevel};
-        const __m128 power = {m_powerRange, m_powerRange, m_powerRange, m_powerRange};
-        const __m128 mul = {100.0f, 100.0f, 100.0f, 100.0f};
-
-        for(int i = 0; i < m_fftSize; i += 4) {
-            __m128 abc = _mm_loadu_ps (&spectrum[i]);
-            abc = _mm_sub_ps(abc, refl);
-            abc = _mm_mul_ps(abc, mul);
-            abc = _mm_div_ps(abc, power);
-            abc =  _mm_add_ps(abc, mul);
-            __m128i result = _mm_cvtps_epi32(abc);
-
-            for(int j = 0; j < 4; j++) {
-                int v = ((int*)&result)[j];
-                if((v >= 0) && (v <= 99)) {
-                    b = m_histogram + (i + j) * 100 + v;
-                    if(*b < 220)
-                        *b += m_histogramStroke; // was 4
-                    else if(*b < 239)
-                        *b += 1;
-                }
-            }
-        }
-    } else { // draw double pixels
-        int add = -m_decay * 4;
-        const __m128 refl = {m_referenceLevel, m_referenceLevel, m_referenceLevel, m_referenceLevel};
-        const __m128 power = {m_powerRange, m_powerRange, m_powerRange, m_powerRange};
-        const __m128 mul = {100.0f, 100.0f, 100.0f, 100.0f};
-
-        for(int i = 0; i < m_fftSize; i += 4) {
-            __m128 abc = _mm_loadu_ps (&spectrum[i]);
-            abc = _mm_sub_ps(abc, refl);
-            abc = _mm_mul_ps(abc, mul);
-            abc = _mm_div_ps(abc, power);
-            abc =  _mm_add_ps(abc, mul);
-            __m128i result = _mm_cvtps_epi32(abc);
-
-            for(int j = 0; j < 4; j++) {
-                int v = ((int*)&result)[j];
-                if((v >= 1) && (v <= 98)) {
-                    b = m_histogram + (i + j) * 100 + v;
-                    if(b[-1] < 220)
-                        b[-1] += add;
-                    else if(b[-1] < 239)
-                        b[-1] += 1;
-                    if(b[0] < 220)
-                        b[0] += add;
-                    else if(b[0] < 239)
-                        b[0] += 1;
-                    if(b[1] < 220)
-                        b[1] += add;
-                    else if(b[1] < 239)
-                        b[1] += 1;
-                } else if((v >= 0) && (v <= 99)) {
-                    b = m_histogram + (i + j) * 100 + v;
-                    if(*b < 220)
-                        *b += add;
-                    else if(*b < 239)
-                        *b += 1;
-                }
-            }
-        }
-    }
-#else
-    for (int i = 0; i < m_fftSize; i++)
-    {
-        int v = (int)((spectrum[i] - m_referenceLevel) * 100.0 / m_powerRange + 100.0);
-
-        if ((v >= 0) && (v <= 99))
-        {
-            b = m_histogram + i * 100 + v;
-
-            // capping to 239 as palette values are [0..239]
-            if (*b + m_histogramStroke <= 239) {
-                *b += m_histogramStroke; // was 4
-            } else {
-                *b = 239;
-            }
-        }
-    }
-#endif
+	GLSpectrumKernels::strokeHistogram(spectrum.data(), m_fftSize, m_referenceLevel, m_powerRange, m_histogramStroke, m_histogram);
 }
 
 void GLSpectrum::initializeGL()
@@ -2242,6 +2147,10 @@ void GLSpectrum::leaveEvent(QEvent* event)
 
 void GLSpectrum::tick()
 {
+	if (m_deferredUpdate) {
+		processDeferredSpectrum();
+	}
+
 	if (m_displayChanged)
     {
 		m_displayChanged = false;
@@ -2249,6 +2158,35 @@ void GLSpectrum::tick()
 	}
 }
 
+void GLSpectrum::processDeferredSpectrum()
+{
+	int fftSize;
+
+	{
+		QMutexLocker backLocker(&m_backMutex);
+
+		if (!m_backPending) {
+			return;
+		}
+
+		m_backSpectrum.swap(m_frontSpectrum); // latest frame wins: at most one waterfall line per refresh
+		fftSize = m_backFftSize;
+		m_backPending = false;
+	}
+
+	QMutexLocker mutexLocker(&m_mutex);
+	processSpectrum(m_frontSpectrum, fftSize);
+}
+
+void GLSpectrum::setDeferredUpdate(bool deferredUpdate)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	QMutexLocker backLocker(&m_backMutex);
+	m_deferredUpdate = deferredUpdate;
+	m_backPending = false;
+	m_currentSpectrum = nullptr; // may point to a buffer of the other mode
+}
+
 void GLSpectrum::channelMarkerChanged()
 {
     QMutexLocker mutexLocker(&m_mutex);
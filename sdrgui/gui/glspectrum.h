@@ -96,6 +96,7 @@ public:
 	void setDisplayGridIntensity(int intensity);
 	void setDisplayTraceIntensity(int intensity);
 	void setLinear(bool linear);
+	void setDeferredUpdate(bool deferredUpdate);
 	qint32 getSampleRate() const { return m_sampleRate; }
 
 	void addChannelMarker(ChannelMarker* channelMarker);
@@ -259,6 +260,13 @@ private:
 	const std::vector<Real> *m_currentSpectrum;
 	bool m_displayCurrent;
 
+	bool m_deferredUpdate; //!< Waterfall and histogram are updated on the GUI thread from the latest spectrum frame
+	QMutex m_backMutex;    //!< Protects the back frame only so that the DSP thread never waits on painting
+	std::vector<Real> m_backSpectrum;
+	std::vector<Real> m_frontSpectrum;
+	int m_backFftSize;
+	bool m_backPending;
+
 	Real m_waterfallShare;
 
     int m_leftMargin;
@@ -320,6 +328,8 @@ private:
 
 	static const int m_waterfallBufferHeight = 256;
 
+	void processSpectrum(const std::vector<Real>& spectrum, int fftSize);
+	void processDeferredSpectrum();
 	void updateWaterfall(const std::vector<Real>& spectrum);
 	void updateHistogram(const std::vector<Real>& spectrum);
 
@@ -111,6 +111,7 @@ void GLSpectrumGUI::displaySettings()
 	ui->current->setChecked(m_settings.m_displayCurrent);
 	ui->histogram->setChecked(m_settings.m_displayHistogram);
 	ui->invert->setChecked(m_settings.m_invert);
+	ui->deferredUpdate->setChecked(m_settings.m_deferredUpdate);
 	ui->grid->setChecked(m_settings.m_displayGrid);
 	ui->gridIntensity->setSliderPosition(m_settings.m_displayGridIntensity);
 
@@ -170,6 +171,7 @@ void GLSpectrumGUI::applySettings()
         m_glSpectrum->setDecayDivisor(m_settings.m_decayDivisor);
         m_glSpectrum->setHistoStroke(m_settings.m_histogramStroke);
         m_glSpectrum->setInvertedWaterfall(m_settings.m_invert);
+        m_glSpectrum->setDeferredUpdate(m_settings.m_deferredUpdate);
         m_glSpectrum->setDisplayGrid(m_settings.m_displayGrid);
         m_glSpectrum->setDisplayGridIntensity(m_settings.m_displayGridIntensity);
         m_glSpectrum->setDisplayTraceIntensity(m_settings.m_displayTraceIntensity);
@@ -312,6 +314,12 @@ void GLSpectrumGUI::on_invert_toggled(bool checked)
     applySettings();
 }
 
+void GLSpectrumGUI::on_deferredUpdate_toggled(bool checked)
+{
+	m_settings.m_deferredUpdate = checked;
+    applySettings();
+}
+
 void GLSpectrumGUI::on_grid_toggled(bool checked)
 {
 	m_settings.m_displayGrid = checked;
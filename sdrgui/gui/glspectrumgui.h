@@ -99,6 +99,7 @@ private slots:
 	void on_maxHold_toggled(bool checked);
 	void on_current_toggled(bool checked);
 	void on_invert_toggled(bool checked);
+	void on_deferredUpdate_toggled(bool checked);
 	void on_grid_toggled(bool checked);
 	void on_clearSpectrum_clicked(bool checked);
     void on_freeze_toggled(bool checked);
@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "glspectrumkernels.h"
+
+void GLSpectrumKernels::mapToPalette(
+    const Real *spectrum,
+    int size,
+    float referenceLevel,
+    float powerRange,
+    const quint32 *palette,
+    quint32 *pixels
+)
+{
+    const float scale = 240.0f / powerRange;
+    int i = 0;
+
+#ifdef USE_SSE2
+    const __m128 ref = _mm_set1_ps(referenceLevel);
+    const __m128 mul = _mm_set1_ps(scale);
+    const __m128 ofs = _mm_set1_ps(240.0f);
+    const __m128 low = _mm_setzero_ps();
+    const __m128 high = _mm_set1_ps(239.0f);
+    alignas(16) int idx[4];
+
+    for (; i + 4 <= size; i += 4)
+    {
+        __m128 v = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&spectrum[i]), ref), mul), ofs);
+        v = _mm_min_ps(_mm_max_ps(v, low), high); // clipping before truncation gives the same index
+        _mm_store_si128((__m128i*) idx, _mm_cvttps_epi32(v));
+        pixels[i]   = palette[idx[0]];
+        pixels[i+1] = palette[idx[1]];
+        pixels[i+2] = palette[idx[2]];
+        pixels[i+3] = palette[idx[3]];
+    }
+#endif
+
+    for (; i < size; i++)
+    {
+        int v = (int) ((spectrum[i] - referenceLevel) * scale + 240.0f);
+        pixels[i] = palette[v > 239 ? 239 : v < 0 ? 0 : v];
+    }
+}
+
+void GLSpectrumKernels::decayHistogram(quint8 *histogram, int size, int decay)
+{
+    quint8 d = decay < 0 ? 0 : decay > 255 ? 255 : decay;
+    int i = 0;
+
+#ifdef USE_SSE2
+    const __m128i dv = _mm_set1_epi8((char) d);
+
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i h = _mm_loadu_si128((const __m128i*) &histogram[i]);
+        _mm_storeu_si128((__m128i*) &histogram[i], _mm_subs_epu8(h, dv));
+    }
+#endif
+
+    for (; i < size; i++) {
+        histogram[i] = histogram[i] > d ? histogram[i] - d : 0;
+    }
+}
+
+void GLSpectrumKernels::strokeHistogram(
+    const Real *spectrum,
+    int size,
+    float referenceLevel,
+    float powerRange,
+    int stroke,
+    quint8 *histogram
+)
+{
+    const float scale = 100.0f / powerRange;
+    int i = 0;
+
+#ifdef USE_SSE2
+    const __m128 ref = _mm_set1_ps(referenceLevel);
+    const __m128 mul = _mm_set1_ps(scale);
+    const __m128 ofs = _mm_set1_ps(100.0f);
+    alignas(16) int rows[4];
+
+    for (; i + 4 <= size; i += 4)
+    {
+        __m128 v = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&spectrum[i]), ref), mul), ofs);
+        _mm_store_si128((__m128i*) rows, _mm_cvttps_epi32(v)); // out of range gives 0x80000000 which is rejected below
+
+        for (int j = 0; j < 4; j++)
+        {
+            if ((rows[j] >= 0) && (rows[j] <= 99))
+            {
+                quint8 *b = histogram + (i + j) * 100 + rows[j];
+                *b = *b + stroke <= 239 ? *b + stroke : 239; // capping to 239 as palette values are [0..239]
+            }
+        }
+    }
+#endif
+
+    for (; i < size; i++)
+    {
+        int v = (int) ((spectrum[i] - referenceLevel) * scale + 100.0f);
+
+        if ((v >= 0) && (v <= 99))
+        {
+            quint8 *b = histogram + i * 100 + v;
+            *b = *b + stroke <= 239 ? *b + stroke : 239;
+        }
+    }
+}
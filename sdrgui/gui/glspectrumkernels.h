@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRGUI_GUI_GLSPECTRUMKERNELS_H_
+#define SDRGUI_GUI_GLSPECTRUMKERNELS_H_
+
+#include <QtGlobal>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Per frame waterfall and histogram computations of GLSpectrum with SSE2 versions.
+ * The level to index conversions use truncation like the original scalar code.
+ */
+class SDRGUI_API GLSpectrumKernels
+{
+public:
+    /** waterfall line: palette color of each bin with index (s - ref)*240/range + 240 clipped to [0, 239] */
+    static void mapToPalette(
+        const Real *spectrum,
+        int size,
+        float referenceLevel,
+        float powerRange,
+        const quint32 *palette,
+        quint32 *pixels
+    );
+    /** phosphor decay: every cell minus decay saturated to 0 */
+    static void decayHistogram(quint8 *histogram, int size, int decay);
+    /** phosphor stroke: add stroke (capped to 239) to the cell of each bin at row (s - ref)*100/range + 100 */
+    static void strokeHistogram(
+        const Real *spectrum,
+        int size,
+        float referenceLevel,
+        float powerRange,
+        int stroke,
+        quint8 *histogram
+    );
+};
+
+#endif // SDRGUI_GUI_GLSPECTRUMKERNELS_H_
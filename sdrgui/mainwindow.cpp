@@ -29,6 +29,7 @@
 #include <QKeyEvent>
 #include <QResource>
 #include <QFontDatabase>
+#include <QElapsedTimer>
 
 #include <plugin/plugininstancegui.h>
 #include <plugin/plugininstancegui.h>
@@ -68,6 +69,7 @@
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
 #include "webapi/webapiadaptergui.h"
+#include "websockets/wsreports.h"
 #include "commands/command.h"
 
 #include "mainwindow.h"
@@ -110,7 +112,10 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 	m_sampleFileName(std::string("./test.sdriq")),
 	m_logger(logger)
 {
+    m_logger->setAsynchronous(parser.getAsyncLog());
 	qDebug() << "MainWindow::MainWindow: start";
+    QElapsedTimer startupTimer;
+    startupTimer.start();
 
     m_instance = this;
 
@@ -201,6 +206,7 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
     qDebug() << "MainWindow::MainWindow: load plugins...";
 
     m_pluginManager = new PluginManager(this);
+    m_pluginManager->setEnumerationCache(parser.getEnumerationCache());
     m_pluginManager->loadPlugins(QString("plugins"));
     m_pluginManager->loadPluginsNonDiscoverable(m_settings.getDeviceUserArgs());
 
@@ -241,6 +247,10 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 	m_apiPort = parser.getServerPort();
 	m_apiServer = new WebAPIServer(m_apiHost, m_apiPort, m_requestMapper);
 	m_apiServer->start();
+	m_wsReports = new WSReports(m_apiAdapter);
+	m_wsReports->setListeningAddress(m_apiHost);
+	m_wsReports->setPort(parser.getWSReportsPort());
+	m_wsReports->openSocket();
 
 	m_commandKeyReceiver = new CommandKeyReceiver();
 	m_commandKeyReceiver->setRelease(true);
@@ -261,11 +271,12 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 
     delete splash;
 
-    qDebug() << "MainWindow::MainWindow: end";
+    qInfo("MainWindow::MainWindow: end in %lld ms", startupTimer.elapsed());
 }
 
 MainWindow::~MainWindow()
 {
+    delete m_wsReports;
     m_apiServer->stop();
     delete m_apiServer;
     delete m_requestMapper;
@@ -37,7 +37,9 @@
 #include "plugin/pluginapi.h"
 #include "plugin/pluginmanager.h"
 #include "channel/channelapi.h"
+#include "dsp/scopevis.h"
 #include "webapi/webapiadapterbase.h"
+#include "webapi/webapimetrics.h"
 #include "util/serialutil.h"
 
 #include "SWGInstanceSummaryResponse.h"
@@ -64,6 +66,7 @@
 #include "SWGChannelReport.h"
 #include "SWGChannelActions.h"
 #include "SWGSuccessResponse.h"
+#include "SWGScopeServer.h"
 #include "SWGErrorResponse.h"
 #include "SWGDeviceState.h"
 #include "SWGLimeRFEDevices.h"
@@ -1332,6 +1335,22 @@ int WebAPIAdapterGUI::instanceDeviceSetsGet(
     return 200;
 }
 
+int WebAPIAdapterGUI::instanceMetricsGet(
+        WebAPIMetrics& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    int nbDeviceSets = m_mainWindow.m_deviceUIs.size();
+
+    for (int i = 0; i < nbDeviceSets; i++) {
+        response.addDeviceSet(i, m_mainWindow.m_deviceUIs[i]->m_deviceAPI);
+    }
+
+    response.addAMBEEngine(m_mainWindow.m_dspEngine->getAMBEEngine());
+
+    return 200;
+}
+
 int WebAPIAdapterGUI::instanceDeviceSetPost(
         int direction,
         SWGSDRangel::SWGSuccessResponse& response,
@@ -2214,7 +2233,9 @@ int WebAPIAdapterGUI::devicesetChannelSettingsGet(
                 response.setChannelType(new QString());
                 channelAPI->getIdentifier(*response.getChannelType());
                 response.setDirection(0);
-                return channelAPI->webapiSettingsGet(response, *error.getMessage());
+                int httpRC = channelAPI->webapiSettingsGet(response, *error.getMessage());
+                WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                return httpRC;
             }
         }
         else if (deviceSet->m_deviceSinkEngine) // Single Tx
@@ -2231,7 +2252,9 @@ int WebAPIAdapterGUI::devicesetChannelSettingsGet(
                 response.setChannelType(new QString());
                 channelAPI->getIdentifier(*response.getChannelType());
                 response.setDirection(1);
-                return channelAPI->webapiSettingsGet(response, *error.getMessage());
+                int httpRC = channelAPI->webapiSettingsGet(response, *error.getMessage());
+                WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                return httpRC;
             }
         }
         else if (deviceSet->m_deviceMIMOEngine) // MIMO
@@ -2266,7 +2289,9 @@ int WebAPIAdapterGUI::devicesetChannelSettingsGet(
             {
                 response.setChannelType(new QString());
                 channelAPI->getIdentifier(*response.getChannelType());
-                return channelAPI->webapiSettingsGet(response, *error.getMessage());
+                int httpRC = channelAPI->webapiSettingsGet(response, *error.getMessage());
+                WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                return httpRC;
             }
             else
             {
@@ -2387,6 +2412,52 @@ int WebAPIAdapterGUI::devicesetChannelReportGet(
     }
 }
 
+int WebAPIAdapterGUI::devicesetChannelScopeServerPut(
+        int deviceSetIndex,
+        int channelIndex,
+        SWGSDRangel::SWGScopeServer& query,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+    ScopeVis *scopeVis;
+    int status = getChannelScopeVis(deviceSetIndex, channelIndex, &scopeVis, *error.getMessage());
+
+    if (status/100 == 2)
+    {
+        scopeVis->configureWSScope(*query.getListeningAddress(), query.getPort());
+        scopeVis->openWSScope();
+        response.init();
+        *response.getMessage() = QString("Message to open scope server on %1:%2 was submitted successfully")
+            .arg(*query.getListeningAddress())
+            .arg(query.getPort());
+        status = 202;
+    }
+
+    return status;
+}
+
+int WebAPIAdapterGUI::devicesetChannelScopeServerDelete(
+        int deviceSetIndex,
+        int channelIndex,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+    ScopeVis *scopeVis;
+    int status = getChannelScopeVis(deviceSetIndex, channelIndex, &scopeVis, *error.getMessage());
+
+    if (status/100 == 2)
+    {
+        scopeVis->closeWSScope();
+        response.init();
+        *response.getMessage() = QString("Message to close scope server was submitted successfully");
+        status = 202;
+    }
+
+    return status;
+}
+
 int WebAPIAdapterGUI::devicesetChannelActionsPost(
         int deviceSetIndex,
         int channelIndex,
@@ -2572,7 +2643,10 @@ int WebAPIAdapterGUI::devicesetChannelSettingsPutPatch(
 
                 if (channelType == *response.getChannelType())
                 {
-                    return channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiUpdateChannelMixGain(&response, channelSettingsKeys, channelAPI);
+                    int httpRC = channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                    return httpRC;
                 }
                 else
                 {
@@ -2600,7 +2674,10 @@ int WebAPIAdapterGUI::devicesetChannelSettingsPutPatch(
 
                 if (channelType == *response.getChannelType())
                 {
-                    return channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiUpdateChannelMixGain(&response, channelSettingsKeys, channelAPI);
+                    int httpRC = channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                    return httpRC;
                 }
                 else
                 {
@@ -2647,7 +2724,10 @@ int WebAPIAdapterGUI::devicesetChannelSettingsPutPatch(
 
                 if (channelType == *response.getChannelType())
                 {
-                    return channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiUpdateChannelMixGain(&response, channelSettingsKeys, channelAPI);
+                    int httpRC = channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                    return httpRC;
                 }
                 else
                 {
@@ -2677,6 +2757,70 @@ int WebAPIAdapterGUI::devicesetChannelSettingsPutPatch(
     }
 }
 
+int WebAPIAdapterGUI::getChannelScopeVis(int deviceSetIndex, int channelIndex, ScopeVis **scopeVis, QString& errorMessage)
+{
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        errorMessage = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+
+    if (channelIndex < 0)
+    {
+        errorMessage = QString("There is no channel with index %1").arg(channelIndex);
+        return 404;
+    }
+
+    DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+    ChannelAPI *channelAPI = nullptr;
+
+    if (deviceSet->m_deviceSourceEngine) // Single Rx
+    {
+        channelAPI = deviceSet->m_deviceAPI->getChanelSinkAPIAt(channelIndex);
+    }
+    else if (deviceSet->m_deviceSinkEngine) // Single Tx
+    {
+        channelAPI = deviceSet->m_deviceAPI->getChanelSourceAPIAt(channelIndex);
+    }
+    else if (deviceSet->m_deviceMIMOEngine) // MIMO
+    {
+        int nbSinkChannels = deviceSet->m_deviceAPI->getNbSinkChannels();
+        int nbSourceChannels = deviceSet->m_deviceAPI->getNbSourceChannels();
+        int nbMIMOChannels = deviceSet->m_deviceAPI->getNbMIMOChannels();
+
+        if (channelIndex < nbSinkChannels) {
+            channelAPI = deviceSet->m_deviceAPI->getChanelSinkAPIAt(channelIndex);
+        } else if (channelIndex < nbSinkChannels + nbSourceChannels) {
+            channelAPI = deviceSet->m_deviceAPI->getChanelSourceAPIAt(channelIndex - nbSinkChannels);
+        } else if (channelIndex < nbSinkChannels + nbSourceChannels + nbMIMOChannels) {
+            channelAPI = deviceSet->m_deviceAPI->getMIMOChannelAPIAt(channelIndex - nbSinkChannels - nbSourceChannels);
+        }
+    }
+    else
+    {
+        errorMessage = QString("DeviceSet error");
+        return 500;
+    }
+
+    if (channelAPI == nullptr)
+    {
+        errorMessage = QString("There is no channel with index %1").arg(channelIndex);
+        return 404;
+    }
+
+    *scopeVis = channelAPI->getScopeVis();
+
+    if (*scopeVis == nullptr)
+    {
+        QString channelType;
+        channelAPI->getIdentifier(channelType);
+        errorMessage = QString("Channel %1 at index %2 has no scope").arg(channelType).arg(channelIndex);
+        return 404;
+    }
+
+    return 200;
+}
+
 void WebAPIAdapterGUI::getDeviceSetList(SWGSDRangel::SWGDeviceSetList* deviceSetList)
 {
     deviceSetList->init();
@@ -26,6 +26,7 @@
 #include "export.h"
 
 class MainWindow;
+class ScopeVis;
 
 class SDRGUI_API WebAPIAdapterGUI: public WebAPIAdapterInterface
 {
@@ -193,6 +194,10 @@ public:
             SWGSDRangel::SWGDeviceSetList& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int instanceMetricsGet(
+            WebAPIMetrics& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int instanceDeviceSetPost(
             int direction,
             SWGSDRangel::SWGSuccessResponse& response,
@@ -320,12 +325,26 @@ public:
             SWGSDRangel::SWGChannelReport& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int devicesetChannelScopeServerPut(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGScopeServer& query,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetChannelScopeServerDelete(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
 private:
     MainWindow& m_mainWindow;
 
     void getDeviceSetList(SWGSDRangel::SWGDeviceSetList* deviceSetList);
     void getDeviceSet(SWGSDRangel::SWGDeviceSet *deviceSet, const DeviceUISet* deviceUISet, int deviceUISetIndex);
     void getChannelsDetail(SWGSDRangel::SWGChannelsDetail *channelsDetail, const DeviceUISet* deviceUISet);
+    int getChannelScopeVis(int deviceSetIndex, int channelIndex, ScopeVis **scopeVis, QString& errorMessage);
     static QtMsgType getMsgTypeFromString(const QString& msgTypeString);
     static void getMsgTypeString(const QtMsgType& msgType, QString& level);
 };
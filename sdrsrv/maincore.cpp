@@ -20,6 +20,7 @@
 #include <QDebug>
 #include <QSysInfo>
 #include <QResource>
+#include <QElapsedTimer>
 
 #include "dsp/dspengine.h"
 #include "dsp/dspdevicesourceengine.h"
@@ -33,6 +34,7 @@
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
 #include "webapi/webapiadaptersrv.h"
+#include "websockets/wsreports.h"
 
 #include "maincore.h"
 
@@ -57,7 +59,10 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_lastEngineState(DSPDeviceSourceEngine::StNotStarted),
     m_logger(logger)
 {
+    m_logger->setAsynchronous(parser.getAsyncLog());
     qDebug() << "MainCore::MainCore: start";
+    QElapsedTimer startupTimer;
+    startupTimer.start();
 
     m_instance = this;
     m_settings.setAudioDeviceManager(m_dspEngine->getAudioDeviceManager());
@@ -68,7 +73,9 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
 
     qDebug() << "MainCore::MainCore: load plugins...";
     m_pluginManager = new PluginManager(this);
+    m_pluginManager->setEnumerationCache(parser.getEnumerationCache());
     m_pluginManager->loadPlugins(QString("pluginssrv"));
+    qInfo("MainCore::MainCore: plugins ready at %lld ms", startupTimer.elapsed());
 
     connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleMessages()), Qt::QueuedConnection);
     m_masterTimer.start(50);
@@ -84,6 +91,11 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_requestMapper->setAdapter(m_apiAdapter);
     m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper);
     m_apiServer->start();
+    qInfo("MainCore::MainCore: web API started at %lld ms", startupTimer.elapsed());
+    m_wsReports = new WSReports(m_apiAdapter);
+    m_wsReports->setListeningAddress(parser.getServerAddress());
+    m_wsReports->setPort(parser.getWSReportsPort());
+    m_wsReports->openSocket();
 
     m_dspEngine->setMIMOSupport(parser.getMIMOSupport());
 
@@ -92,6 +104,8 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
 
 MainCore::~MainCore()
 {
+    delete m_wsReports;
+
     while (m_deviceSets.size() > 0) {
         removeLastDevice();
     }
@@ -42,6 +42,7 @@
 #include "SWGChannelReport.h"
 #include "SWGChannelActions.h"
 #include "SWGSuccessResponse.h"
+#include "SWGScopeServer.h"
 #include "SWGErrorResponse.h"
 #include "SWGDeviceState.h"
 #include "SWGDeviceReport.h"
@@ -62,10 +63,12 @@
 #include "dsp/dspdevicemimoengine.h"
 #include "dsp/dspengine.h"
 #include "channel/channelapi.h"
+#include "dsp/scopevis.h"
 #include "plugin/pluginapi.h"
 #include "plugin/pluginmanager.h"
 #include "util/serialutil.h"
 #include "webapi/webapiadapterbase.h"
+#include "webapi/webapimetrics.h"
 #include "webapiadaptersrv.h"
 
 #ifdef HAS_LIMERFEUSB
@@ -1440,6 +1443,22 @@ int WebAPIAdapterSrv::instanceDeviceSetsGet(
     return 200;
 }
 
+int WebAPIAdapterSrv::instanceMetricsGet(
+        WebAPIMetrics& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    int nbDeviceSets = m_mainCore.m_deviceSets.size();
+
+    for (int i = 0; i < nbDeviceSets; i++) {
+        response.addDeviceSet(i, m_mainCore.m_deviceSets[i]->m_deviceAPI);
+    }
+
+    response.addAMBEEngine(m_mainCore.m_dspEngine->getAMBEEngine());
+
+    return 200;
+}
+
 int WebAPIAdapterSrv::instanceDeviceSetPost(
         int direction,
         SWGSDRangel::SWGSuccessResponse& response,
@@ -2317,7 +2336,9 @@ int WebAPIAdapterSrv::devicesetChannelSettingsGet(
                 response.setChannelType(new QString());
                 channelAPI->getIdentifier(*response.getChannelType());
                 response.setDirection(0);
-                return channelAPI->webapiSettingsGet(response, *error.getMessage());
+                int httpRC = channelAPI->webapiSettingsGet(response, *error.getMessage());
+                WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                return httpRC;
             }
         }
         else if (deviceSet->m_deviceSinkEngine) // Single Tx
@@ -2334,7 +2355,9 @@ int WebAPIAdapterSrv::devicesetChannelSettingsGet(
                 response.setChannelType(new QString());
                 channelAPI->getIdentifier(*response.getChannelType());
                 response.setDirection(1);
-                return channelAPI->webapiSettingsGet(response, *error.getMessage());
+                int httpRC = channelAPI->webapiSettingsGet(response, *error.getMessage());
+                WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                return httpRC;
             }
         }
         else if (deviceSet->m_deviceMIMOEngine) // MIMO
@@ -2369,7 +2392,9 @@ int WebAPIAdapterSrv::devicesetChannelSettingsGet(
             {
                 response.setChannelType(new QString());
                 channelAPI->getIdentifier(*response.getChannelType());
-                return channelAPI->webapiSettingsGet(response, *error.getMessage());
+                int httpRC = channelAPI->webapiSettingsGet(response, *error.getMessage());
+                WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                return httpRC;
             }
             else
             {
@@ -2489,6 +2514,52 @@ int WebAPIAdapterSrv::devicesetChannelReportGet(
     }
 }
 
+int WebAPIAdapterSrv::devicesetChannelScopeServerPut(
+        int deviceSetIndex,
+        int channelIndex,
+        SWGSDRangel::SWGScopeServer& query,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+    ScopeVis *scopeVis;
+    int status = getChannelScopeVis(deviceSetIndex, channelIndex, &scopeVis, *error.getMessage());
+
+    if (status/100 == 2)
+    {
+        scopeVis->configureWSScope(*query.getListeningAddress(), query.getPort());
+        scopeVis->openWSScope();
+        response.init();
+        *response.getMessage() = QString("Message to open scope server on %1:%2 was submitted successfully")
+            .arg(*query.getListeningAddress())
+            .arg(query.getPort());
+        status = 202;
+    }
+
+    return status;
+}
+
+int WebAPIAdapterSrv::devicesetChannelScopeServerDelete(
+        int deviceSetIndex,
+        int channelIndex,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+    ScopeVis *scopeVis;
+    int status = getChannelScopeVis(deviceSetIndex, channelIndex, &scopeVis, *error.getMessage());
+
+    if (status/100 == 2)
+    {
+        scopeVis->closeWSScope();
+        response.init();
+        *response.getMessage() = QString("Message to close scope server was submitted successfully");
+        status = 202;
+    }
+
+    return status;
+}
+
 int WebAPIAdapterSrv::devicesetChannelActionsPost(
         int deviceSetIndex,
         int channelIndex,
@@ -2674,7 +2745,10 @@ int WebAPIAdapterSrv::devicesetChannelSettingsPutPatch(
 
                 if (channelType == *response.getChannelType())
                 {
-                    return channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiUpdateChannelMixGain(&response, channelSettingsKeys, channelAPI);
+                    int httpRC = channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                    return httpRC;
                 }
                 else
                 {
@@ -2702,7 +2776,10 @@ int WebAPIAdapterSrv::devicesetChannelSettingsPutPatch(
 
                 if (channelType == *response.getChannelType())
                 {
-                    return channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiUpdateChannelMixGain(&response, channelSettingsKeys, channelAPI);
+                    int httpRC = channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                    return httpRC;
                 }
                 else
                 {
@@ -2749,7 +2826,10 @@ int WebAPIAdapterSrv::devicesetChannelSettingsPutPatch(
 
                 if (channelType == *response.getChannelType())
                 {
-                    return channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiUpdateChannelMixGain(&response, channelSettingsKeys, channelAPI);
+                    int httpRC = channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    WebAPIAdapterBase::webapiFormatChannelMixGain(&response, channelAPI);
+                    return httpRC;
                 }
                 else
                 {
@@ -2779,6 +2859,70 @@ int WebAPIAdapterSrv::devicesetChannelSettingsPutPatch(
     }
 }
 
+int WebAPIAdapterSrv::getChannelScopeVis(int deviceSetIndex, int channelIndex, ScopeVis **scopeVis, QString& errorMessage)
+{
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_mainCore.m_deviceSets.size()))
+    {
+        errorMessage = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+
+    if (channelIndex < 0)
+    {
+        errorMessage = QString("There is no channel with index %1").arg(channelIndex);
+        return 404;
+    }
+
+    DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+    ChannelAPI *channelAPI = nullptr;
+
+    if (deviceSet->m_deviceSourceEngine) // Single Rx
+    {
+        channelAPI = deviceSet->m_deviceAPI->getChanelSinkAPIAt(channelIndex);
+    }
+    else if (deviceSet->m_deviceSinkEngine) // Single Tx
+    {
+        channelAPI = deviceSet->m_deviceAPI->getChanelSourceAPIAt(channelIndex);
+    }
+    else if (deviceSet->m_deviceMIMOEngine) // MIMO
+    {
+        int nbSinkChannels = deviceSet->m_deviceAPI->getNbSinkChannels();
+        int nbSourceChannels = deviceSet->m_deviceAPI->getNbSourceChannels();
+        int nbMIMOChannels = deviceSet->m_deviceAPI->getNbMIMOChannels();
+
+        if (channelIndex < nbSinkChannels) {
+            channelAPI = deviceSet->m_deviceAPI->getChanelSinkAPIAt(channelIndex);
+        } else if (channelIndex < nbSinkChannels + nbSourceChannels) {
+            channelAPI = deviceSet->m_deviceAPI->getChanelSourceAPIAt(channelIndex - nbSinkChannels);
+        } else if (channelIndex < nbSinkChannels + nbSourceChannels + nbMIMOChannels) {
+            channelAPI = deviceSet->m_deviceAPI->getMIMOChannelAPIAt(channelIndex - nbSinkChannels - nbSourceChannels);
+        }
+    }
+    else
+    {
+        errorMessage = QString("DeviceSet error");
+        return 500;
+    }
+
+    if (channelAPI == nullptr)
+    {
+        errorMessage = QString("There is no channel with index %1").arg(channelIndex);
+        return 404;
+    }
+
+    *scopeVis = channelAPI->getScopeVis();
+
+    if (*scopeVis == nullptr)
+    {
+        QString channelType;
+        channelAPI->getIdentifier(channelType);
+        errorMessage = QString("Channel %1 at index %2 has no scope").arg(channelType).arg(channelIndex);
+        return 404;
+    }
+
+    return 200;
+}
+
 void WebAPIAdapterSrv::getDeviceSetList(SWGSDRangel::SWGDeviceSetList* deviceSetList)
 {
     deviceSetList->init();
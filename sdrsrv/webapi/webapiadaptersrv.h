@@ -26,6 +26,7 @@
 
 class MainCore;
 class DeviceSet;
+class ScopeVis;
 
 class WebAPIAdapterSrv: public WebAPIAdapterInterface
 {
@@ -203,6 +204,10 @@ public:
             SWGSDRangel::SWGDeviceSetList& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int instanceMetricsGet(
+            WebAPIMetrics& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int instanceDeviceSetPost(
             int direction,
             SWGSDRangel::SWGSuccessResponse& response,
@@ -330,12 +335,26 @@ public:
             SWGSDRangel::SWGChannelReport& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int devicesetChannelScopeServerPut(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGScopeServer& query,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetChannelScopeServerDelete(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
 private:
     MainCore& m_mainCore;
 
     void getDeviceSetList(SWGSDRangel::SWGDeviceSetList* deviceSetList);
     void getDeviceSet(SWGSDRangel::SWGDeviceSet *swgDeviceSet, const DeviceSet* deviceSet, int deviceUISetIndex);
     void getChannelsDetail(SWGSDRangel::SWGChannelsDetail *channelsDetail, const DeviceSet* deviceSet);
+    int getChannelScopeVis(int deviceSetIndex, int channelIndex, ScopeVis **scopeVis, QString& errorMessage);
     static QtMsgType getMsgTypeFromString(const QString& msgTypeString);
     static void getMsgTypeString(const QtMsgType& msgType, QString& level);
 };
@@ -80,6 +80,8 @@ SWGATVDemodSettings::SWGATVDemodSettings() {
     m_bln_v_sync_isSet = false;
     bln_invert_video = 0;
     m_bln_invert_video_isSet = false;
+    bln_line_processing = 0;
+    m_bln_line_processing_isSet = false;
     int_video_tab_index = 0;
     m_int_video_tab_index_isSet = false;
     int_tv_sample_rate = 0;
@@ -154,6 +156,8 @@ SWGATVDemodSettings::init() {
     m_bln_v_sync_isSet = false;
     bln_invert_video = 0;
     m_bln_invert_video_isSet = false;
+    bln_line_processing = 0;
+    m_bln_line_processing_isSet = false;
     int_video_tab_index = 0;
     m_int_video_tab_index_isSet = false;
     int_tv_sample_rate = 0;
@@ -274,6 +278,8 @@ SWGATVDemodSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&bln_invert_video, pJson["blnInvertVideo"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&bln_line_processing, pJson["blnLineProcessing"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&int_video_tab_index, pJson["intVideoTabIndex"], "qint32", "");
     
     ::SWGSDRangel::setValue(&int_tv_sample_rate, pJson["intTVSampleRate"], "qint32", "");
@@ -382,6 +388,9 @@ SWGATVDemodSettings::asJsonObject() {
     if(m_bln_invert_video_isSet){
         obj->insert("blnInvertVideo", QJsonValue(bln_invert_video));
     }
+    if(m_bln_line_processing_isSet){
+        obj->insert("blnLineProcessing", QJsonValue(bln_line_processing));
+    }
     if(m_int_video_tab_index_isSet){
         obj->insert("intVideoTabIndex", QJsonValue(int_video_tab_index));
     }
@@ -667,6 +676,16 @@ SWGATVDemodSettings::setBlnInvertVideo(qint32 bln_invert_video) {
     this->m_bln_invert_video_isSet = true;
 }
 
+qint32
+SWGATVDemodSettings::getBlnLineProcessing() {
+    return bln_line_processing;
+}
+void
+SWGATVDemodSettings::setBlnLineProcessing(qint32 bln_line_processing) {
+    this->bln_line_processing = bln_line_processing;
+    this->m_bln_line_processing_isSet = true;
+}
+
 qint32
 SWGATVDemodSettings::getIntVideoTabIndex() {
     return int_video_tab_index;
@@ -820,6 +839,9 @@ SWGATVDemodSettings::isSet(){
         if(m_bln_invert_video_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_bln_line_processing_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_int_video_tab_index_isSet){
             isObjectUpdated = true; break;
         }
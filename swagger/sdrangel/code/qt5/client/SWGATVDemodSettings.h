@@ -120,6 +120,9 @@ public:
     qint32 getBlnInvertVideo();
     void setBlnInvertVideo(qint32 bln_invert_video);
 
+    qint32 getBlnLineProcessing();
+    void setBlnLineProcessing(qint32 bln_line_processing);
+
     qint32 getIntVideoTabIndex();
     void setIntVideoTabIndex(qint32 int_video_tab_index);
 
@@ -223,6 +226,9 @@ private:
     qint32 bln_invert_video;
     bool m_bln_invert_video_isSet;
 
+    qint32 bln_line_processing;
+    bool m_bln_line_processing_isSet;
+
     qint32 int_video_tab_index;
     bool m_int_video_tab_index_isSet;
 
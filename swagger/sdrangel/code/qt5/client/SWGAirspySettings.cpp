@@ -60,6 +60,10 @@ SWGAirspySettings::SWGAirspySettings() {
     m_transverter_delta_frequency_isSet = false;
     iq_order = 0;
     m_iq_order_isSet = false;
+    resample_rate = 0;
+    m_resample_rate_isSet = false;
+    pipelined = 0;
+    m_pipelined_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = nullptr;
@@ -108,6 +112,10 @@ SWGAirspySettings::init() {
     m_transverter_delta_frequency_isSet = false;
     iq_order = 0;
     m_iq_order_isSet = false;
+    resample_rate = 0;
+    m_resample_rate_isSet = false;
+    pipelined = 0;
+    m_pipelined_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = new QString("");
@@ -187,6 +195,10 @@ SWGAirspySettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&iq_order, pJson["iqOrder"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&resample_rate, pJson["resampleRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&pipelined, pJson["pipelined"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&use_reverse_api, pJson["useReverseAPI"], "qint32", "");
     
     ::SWGSDRangel::setValue(&reverse_api_address, pJson["reverseAPIAddress"], "QString", "QString");
@@ -259,6 +271,12 @@ SWGAirspySettings::asJsonObject() {
     if(m_iq_order_isSet){
         obj->insert("iqOrder", QJsonValue(iq_order));
     }
+    if(m_resample_rate_isSet){
+        obj->insert("resampleRate", QJsonValue(resample_rate));
+    }
+    if(m_pipelined_isSet){
+        obj->insert("pipelined", QJsonValue(pipelined));
+    }
     if(m_use_reverse_api_isSet){
         obj->insert("useReverseAPI", QJsonValue(use_reverse_api));
     }
@@ -435,6 +453,26 @@ SWGAirspySettings::setIqOrder(qint32 iq_order) {
     this->m_iq_order_isSet = true;
 }
 
+qint32
+SWGAirspySettings::getResampleRate() {
+    return resample_rate;
+}
+void
+SWGAirspySettings::setResampleRate(qint32 resample_rate) {
+    this->resample_rate = resample_rate;
+    this->m_resample_rate_isSet = true;
+}
+
+qint32
+SWGAirspySettings::getPipelined() {
+    return pipelined;
+}
+void
+SWGAirspySettings::setPipelined(qint32 pipelined) {
+    this->pipelined = pipelined;
+    this->m_pipelined_isSet = true;
+}
+
 qint32
 SWGAirspySettings::getUseReverseApi() {
     return use_reverse_api;
@@ -528,6 +566,12 @@ SWGAirspySettings::isSet(){
         if(m_iq_order_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_resample_rate_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_pipelined_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_use_reverse_api_isSet){
             isObjectUpdated = true; break;
         }
@@ -90,6 +90,12 @@ public:
     qint32 getIqOrder();
     void setIqOrder(qint32 iq_order);
 
+    qint32 getResampleRate();
+    void setResampleRate(qint32 resample_rate);
+
+    qint32 getPipelined();
+    void setPipelined(qint32 pipelined);
+
     qint32 getUseReverseApi();
     void setUseReverseApi(qint32 use_reverse_api);
 
@@ -154,6 +160,12 @@ private:
     qint32 iq_order;
     bool m_iq_order_isSet;
 
+    qint32 resample_rate;
+    bool m_resample_rate_isSet;
+
+    qint32 pipelined;
+    bool m_pipelined_isSet;
+
     qint32 use_reverse_api;
     bool m_use_reverse_api_isSet;
 
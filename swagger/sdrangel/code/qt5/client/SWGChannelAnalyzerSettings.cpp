@@ -58,6 +58,8 @@ SWGChannelAnalyzerSettings::SWGChannelAnalyzerSettings() {
     m_rgb_color_isSet = false;
     title = nullptr;
     m_title_isSet = false;
+    corr_reference_file_name = nullptr;
+    m_corr_reference_file_name_isSet = false;
     spectrum_config = nullptr;
     m_spectrum_config_isSet = false;
     scope_config = nullptr;
@@ -100,6 +102,8 @@ SWGChannelAnalyzerSettings::init() {
     m_rgb_color_isSet = false;
     title = new QString("");
     m_title_isSet = false;
+    corr_reference_file_name = new QString("");
+    m_corr_reference_file_name_isSet = false;
     spectrum_config = new SWGGLSpectrum();
     m_spectrum_config_isSet = false;
     scope_config = new SWGGLScope();
@@ -125,6 +129,9 @@ SWGChannelAnalyzerSettings::cleanup() {
     if(title != nullptr) { 
         delete title;
     }
+    if(corr_reference_file_name != nullptr) { 
+        delete corr_reference_file_name;
+    }
     if(spectrum_config != nullptr) { 
         delete spectrum_config;
     }
@@ -174,6 +181,8 @@ SWGChannelAnalyzerSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&title, pJson["title"], "QString", "QString");
     
+    ::SWGSDRangel::setValue(&corr_reference_file_name, pJson["corrReferenceFileName"], "QString", "QString");
+    
     ::SWGSDRangel::setValue(&spectrum_config, pJson["spectrumConfig"], "SWGGLSpectrum", "SWGGLSpectrum");
     
     ::SWGSDRangel::setValue(&scope_config, pJson["scopeConfig"], "SWGGLScope", "SWGGLScope");
@@ -239,6 +248,9 @@ SWGChannelAnalyzerSettings::asJsonObject() {
     if(title != nullptr && *title != QString("")){
         toJsonValue(QString("title"), title, obj, QString("QString"));
     }
+    if(corr_reference_file_name != nullptr && *corr_reference_file_name != QString("")){
+        toJsonValue(QString("corrReferenceFileName"), corr_reference_file_name, obj, QString("QString"));
+    }
     if((spectrum_config != nullptr) && (spectrum_config->isSet())){
         toJsonValue(QString("spectrumConfig"), spectrum_config, obj, QString("SWGGLSpectrum"));
     }
@@ -399,6 +411,16 @@ SWGChannelAnalyzerSettings::setTitle(QString* title) {
     this->m_title_isSet = true;
 }
 
+QString*
+SWGChannelAnalyzerSettings::getCorrReferenceFileName() {
+    return corr_reference_file_name;
+}
+void
+SWGChannelAnalyzerSettings::setCorrReferenceFileName(QString* corr_reference_file_name) {
+    this->corr_reference_file_name = corr_reference_file_name;
+    this->m_corr_reference_file_name_isSet = true;
+}
+
 SWGGLSpectrum*
 SWGChannelAnalyzerSettings::getSpectrumConfig() {
     return spectrum_config;
@@ -469,6 +491,9 @@ SWGChannelAnalyzerSettings::isSet(){
         if(title && *title != QString("")){
             isObjectUpdated = true; break;
         }
+        if(corr_reference_file_name && *corr_reference_file_name != QString("")){
+            isObjectUpdated = true; break;
+        }
         if(spectrum_config && spectrum_config->isSet()){
             isObjectUpdated = true; break;
         }
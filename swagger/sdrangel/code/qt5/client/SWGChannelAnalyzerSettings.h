@@ -89,6 +89,9 @@ public:
     QString* getTitle();
     void setTitle(QString* title);
 
+    QString* getCorrReferenceFileName();
+    void setCorrReferenceFileName(QString* corr_reference_file_name);
+
     SWGGLSpectrum* getSpectrumConfig();
     void setSpectrumConfig(SWGGLSpectrum* spectrum_config);
 
@@ -144,6 +147,9 @@ private:
     QString* title;
     bool m_title_isSet;
 
+    QString* corr_reference_file_name;
+    bool m_corr_reference_file_name_isSet;
+
     SWGGLSpectrum* spectrum_config;
     bool m_spectrum_config_isSet;
 
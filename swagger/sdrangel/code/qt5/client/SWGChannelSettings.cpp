@@ -36,6 +36,8 @@ SWGChannelSettings::SWGChannelSettings() {
     m_originator_device_set_index_isSet = false;
     originator_channel_index = 0;
     m_originator_channel_index_isSet = false;
+    mix_gain = 0.0f;
+    m_mix_gain_isSet = false;
     am_demod_settings = nullptr;
     m_am_demod_settings_isSet = false;
     am_mod_settings = nullptr;
@@ -102,6 +104,8 @@ SWGChannelSettings::init() {
     m_originator_device_set_index_isSet = false;
     originator_channel_index = 0;
     m_originator_channel_index_isSet = false;
+    mix_gain = 0.0f;
+    m_mix_gain_isSet = false;
     am_demod_settings = new SWGAMDemodSettings();
     m_am_demod_settings_isSet = false;
     am_mod_settings = new SWGAMModSettings();
@@ -258,6 +262,8 @@ SWGChannelSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&originator_channel_index, pJson["originatorChannelIndex"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&mix_gain, pJson["mixGain"], "float", "");
+    
     ::SWGSDRangel::setValue(&am_demod_settings, pJson["AMDemodSettings"], "SWGAMDemodSettings", "SWGAMDemodSettings");
     
     ::SWGSDRangel::setValue(&am_mod_settings, pJson["AMModSettings"], "SWGAMModSettings", "SWGAMModSettings");
@@ -336,6 +342,9 @@ SWGChannelSettings::asJsonObject() {
     if(m_originator_channel_index_isSet){
         obj->insert("originatorChannelIndex", QJsonValue(originator_channel_index));
     }
+    if(m_mix_gain_isSet){
+        obj->insert("mixGain", QJsonValue(mix_gain));
+    }
     if((am_demod_settings != nullptr) && (am_demod_settings->isSet())){
         toJsonValue(QString("AMDemodSettings"), am_demod_settings, obj, QString("SWGAMDemodSettings"));
     }
@@ -455,6 +464,16 @@ SWGChannelSettings::setOriginatorChannelIndex(qint32 originator_channel_index) {
     this->m_originator_channel_index_isSet = true;
 }
 
+float
+SWGChannelSettings::getMixGain() {
+    return mix_gain;
+}
+void
+SWGChannelSettings::setMixGain(float mix_gain) {
+    this->mix_gain = mix_gain;
+    this->m_mix_gain_isSet = true;
+}
+
 SWGAMDemodSettings*
 SWGChannelSettings::getAmDemodSettings() {
     return am_demod_settings;
@@ -722,6 +741,9 @@ SWGChannelSettings::isSet(){
         if(m_originator_channel_index_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_mix_gain_isSet){
+            isObjectUpdated = true; break;
+        }
         if(am_demod_settings && am_demod_settings->isSet()){
             isObjectUpdated = true; break;
         }
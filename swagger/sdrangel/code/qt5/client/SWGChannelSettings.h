@@ -79,6 +79,9 @@ public:
     qint32 getOriginatorChannelIndex();
     void setOriginatorChannelIndex(qint32 originator_channel_index);
 
+    float getMixGain();
+    void setMixGain(float mix_gain);
+
     SWGAMDemodSettings* getAmDemodSettings();
     void setAmDemodSettings(SWGAMDemodSettings* am_demod_settings);
 
@@ -170,6 +173,9 @@ private:
     qint32 originator_channel_index;
     bool m_originator_channel_index_isSet;
 
+    float mix_gain;
+    bool m_mix_gain_isSet;
+
     SWGAMDemodSettings* am_demod_settings;
     bool m_am_demod_settings_isSet;
 
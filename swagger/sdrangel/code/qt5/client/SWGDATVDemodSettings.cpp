@@ -74,6 +74,12 @@ SWGDATVDemodSettings::SWGDATVDemodSettings() {
     m_udp_ts_port_isSet = false;
     udp_ts = 0;
     m_udp_ts_isSet = false;
+    ldpc_threads = 0;
+    m_ldpc_threads_isSet = false;
+    ldpc_max_iterations = 0;
+    m_ldpc_max_iterations_isSet = false;
+    pipelined_decoding = 0;
+    m_pipelined_decoding_isSet = false;
 }
 
 SWGDATVDemodSettings::~SWGDATVDemodSettings() {
@@ -128,6 +134,12 @@ SWGDATVDemodSettings::init() {
     m_udp_ts_port_isSet = false;
     udp_ts = 0;
     m_udp_ts_isSet = false;
+    ldpc_threads = 0;
+    m_ldpc_threads_isSet = false;
+    ldpc_max_iterations = 0;
+    m_ldpc_max_iterations_isSet = false;
+    pipelined_decoding = 0;
+    m_pipelined_decoding_isSet = false;
 }
 
 void
@@ -220,6 +232,12 @@ SWGDATVDemodSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&udp_ts, pJson["udpTS"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&ldpc_threads, pJson["ldpcThreads"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&ldpc_max_iterations, pJson["ldpcMaxIterations"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&pipelined_decoding, pJson["pipelinedDecoding"], "qint32", "");
+    
 }
 
 QString
@@ -305,6 +323,15 @@ SWGDATVDemodSettings::asJsonObject() {
     if(m_udp_ts_isSet){
         obj->insert("udpTS", QJsonValue(udp_ts));
     }
+    if(m_ldpc_threads_isSet){
+        obj->insert("ldpcThreads", QJsonValue(ldpc_threads));
+    }
+    if(m_ldpc_max_iterations_isSet){
+        obj->insert("ldpcMaxIterations", QJsonValue(ldpc_max_iterations));
+    }
+    if(m_pipelined_decoding_isSet){
+        obj->insert("pipelinedDecoding", QJsonValue(pipelined_decoding));
+    }
 
     return obj;
 }
@@ -539,6 +566,36 @@ SWGDATVDemodSettings::setUdpTs(qint32 udp_ts) {
     this->m_udp_ts_isSet = true;
 }
 
+qint32
+SWGDATVDemodSettings::getLdpcThreads() {
+    return ldpc_threads;
+}
+void
+SWGDATVDemodSettings::setLdpcThreads(qint32 ldpc_threads) {
+    this->ldpc_threads = ldpc_threads;
+    this->m_ldpc_threads_isSet = true;
+}
+
+qint32
+SWGDATVDemodSettings::getLdpcMaxIterations() {
+    return ldpc_max_iterations;
+}
+void
+SWGDATVDemodSettings::setLdpcMaxIterations(qint32 ldpc_max_iterations) {
+    this->ldpc_max_iterations = ldpc_max_iterations;
+    this->m_ldpc_max_iterations_isSet = true;
+}
+
+qint32
+SWGDATVDemodSettings::getPipelinedDecoding() {
+    return pipelined_decoding;
+}
+void
+SWGDATVDemodSettings::setPipelinedDecoding(qint32 pipelined_decoding) {
+    this->pipelined_decoding = pipelined_decoding;
+    this->m_pipelined_decoding_isSet = true;
+}
+
 
 bool
 SWGDATVDemodSettings::isSet(){
@@ -613,6 +670,15 @@ SWGDATVDemodSettings::isSet(){
         if(m_udp_ts_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_ldpc_threads_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_ldpc_max_iterations_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_pipelined_decoding_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
@@ -111,6 +111,15 @@ public:
     qint32 getUdpTs();
     void setUdpTs(qint32 udp_ts);
 
+    qint32 getLdpcThreads();
+    void setLdpcThreads(qint32 ldpc_threads);
+
+    qint32 getLdpcMaxIterations();
+    void setLdpcMaxIterations(qint32 ldpc_max_iterations);
+
+    qint32 getPipelinedDecoding();
+    void setPipelinedDecoding(qint32 pipelined_decoding);
+
 
     virtual bool isSet() override;
 
@@ -184,6 +193,15 @@ private:
     qint32 udp_ts;
     bool m_udp_ts_isSet;
 
+    qint32 ldpc_threads;
+    bool m_ldpc_threads_isSet;
+
+    qint32 ldpc_max_iterations;
+    bool m_ldpc_max_iterations_isSet;
+
+    qint32 pipelined_decoding;
+    bool m_pipelined_decoding_isSet;
+
 };
 
 }
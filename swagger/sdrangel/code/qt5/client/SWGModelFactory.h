@@ -154,6 +154,7 @@
 #include "SWGSSBModSettings.h"
 #include "SWGSampleRate.h"
 #include "SWGSamplingDevice.h"
+#include "SWGScopeServer.h"
 #include "SWGSoapySDRFrequencySetting.h"
 #include "SWGSoapySDRGainSetting.h"
 #include "SWGSoapySDRInputSettings.h"
@@ -599,6 +600,9 @@ namespace SWGSDRangel {
     if(QString("SWGSamplingDevice").compare(type) == 0) {
       return new SWGSamplingDevice();
     }
+    if(QString("SWGScopeServer").compare(type) == 0) {
+      return new SWGScopeServer();
+    }
     if(QString("SWGSoapySDRFrequencySetting").compare(type) == 0) {
       return new SWGSoapySDRFrequencySetting();
     }
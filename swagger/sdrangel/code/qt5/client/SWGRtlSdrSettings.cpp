@@ -62,6 +62,10 @@ SWGRtlSdrSettings::SWGRtlSdrSettings() {
     m_rf_bandwidth_isSet = false;
     bias_tee = 0;
     m_bias_tee_isSet = false;
+    resample_rate = 0;
+    m_resample_rate_isSet = false;
+    pipelined = 0;
+    m_pipelined_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = nullptr;
@@ -112,6 +116,10 @@ SWGRtlSdrSettings::init() {
     m_rf_bandwidth_isSet = false;
     bias_tee = 0;
     m_bias_tee_isSet = false;
+    resample_rate = 0;
+    m_resample_rate_isSet = false;
+    pipelined = 0;
+    m_pipelined_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = new QString("");
@@ -194,6 +202,10 @@ SWGRtlSdrSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&bias_tee, pJson["biasTee"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&resample_rate, pJson["resampleRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&pipelined, pJson["pipelined"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&use_reverse_api, pJson["useReverseAPI"], "qint32", "");
     
     ::SWGSDRangel::setValue(&reverse_api_address, pJson["reverseAPIAddress"], "QString", "QString");
@@ -269,6 +281,12 @@ SWGRtlSdrSettings::asJsonObject() {
     if(m_bias_tee_isSet){
         obj->insert("biasTee", QJsonValue(bias_tee));
     }
+    if(m_resample_rate_isSet){
+        obj->insert("resampleRate", QJsonValue(resample_rate));
+    }
+    if(m_pipelined_isSet){
+        obj->insert("pipelined", QJsonValue(pipelined));
+    }
     if(m_use_reverse_api_isSet){
         obj->insert("useReverseAPI", QJsonValue(use_reverse_api));
     }
@@ -455,6 +473,26 @@ SWGRtlSdrSettings::setBiasTee(qint32 bias_tee) {
     this->m_bias_tee_isSet = true;
 }
 
+qint32
+SWGRtlSdrSettings::getResampleRate() {
+    return resample_rate;
+}
+void
+SWGRtlSdrSettings::setResampleRate(qint32 resample_rate) {
+    this->resample_rate = resample_rate;
+    this->m_resample_rate_isSet = true;
+}
+
+qint32
+SWGRtlSdrSettings::getPipelined() {
+    return pipelined;
+}
+void
+SWGRtlSdrSettings::setPipelined(qint32 pipelined) {
+    this->pipelined = pipelined;
+    this->m_pipelined_isSet = true;
+}
+
 qint32
 SWGRtlSdrSettings::getUseReverseApi() {
     return use_reverse_api;
@@ -551,6 +589,12 @@ SWGRtlSdrSettings::isSet(){
         if(m_bias_tee_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_resample_rate_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_pipelined_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_use_reverse_api_isSet){
             isObjectUpdated = true; break;
         }
@@ -93,6 +93,12 @@ public:
     qint32 getBiasTee();
     void setBiasTee(qint32 bias_tee);
 
+    qint32 getResampleRate();
+    void setResampleRate(qint32 resample_rate);
+
+    qint32 getPipelined();
+    void setPipelined(qint32 pipelined);
+
     qint32 getUseReverseApi();
     void setUseReverseApi(qint32 use_reverse_api);
 
@@ -160,6 +166,12 @@ private:
     qint32 bias_tee;
     bool m_bias_tee_isSet;
 
+    qint32 resample_rate;
+    bool m_resample_rate_isSet;
+
+    qint32 pipelined;
+    bool m_pipelined_isSet;
+
     qint32 use_reverse_api;
     bool m_use_reverse_api_isSet;
 
@@ -0,0 +1,133 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.15.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGScopeServer.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGScopeServer::SWGScopeServer(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGScopeServer::SWGScopeServer() {
+    listening_address = nullptr;
+    m_listening_address_isSet = false;
+    port = 0;
+    m_port_isSet = false;
+}
+
+SWGScopeServer::~SWGScopeServer() {
+    this->cleanup();
+}
+
+void
+SWGScopeServer::init() {
+    listening_address = new QString("");
+    m_listening_address_isSet = false;
+    port = 0;
+    m_port_isSet = false;
+}
+
+void
+SWGScopeServer::cleanup() {
+    if(listening_address != nullptr) { 
+        delete listening_address;
+    }
+
+}
+
+SWGScopeServer*
+SWGScopeServer::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGScopeServer::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&listening_address, pJson["listeningAddress"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&port, pJson["port"], "qint32", "");
+    
+}
+
+QString
+SWGScopeServer::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGScopeServer::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(listening_address != nullptr && *listening_address != QString("")){
+        toJsonValue(QString("listeningAddress"), listening_address, obj, QString("QString"));
+    }
+    if(m_port_isSet){
+        obj->insert("port", QJsonValue(port));
+    }
+
+    return obj;
+}
+
+QString*
+SWGScopeServer::getListeningAddress() {
+    return listening_address;
+}
+void
+SWGScopeServer::setListeningAddress(QString* listening_address) {
+    this->listening_address = listening_address;
+    this->m_listening_address_isSet = true;
+}
+
+qint32
+SWGScopeServer::getPort() {
+    return port;
+}
+void
+SWGScopeServer::setPort(qint32 port) {
+    this->port = port;
+    this->m_port_isSet = true;
+}
+
+
+bool
+SWGScopeServer::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(listening_address && *listening_address != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_port_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+